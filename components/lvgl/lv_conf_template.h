@@ -72,6 +72,50 @@ typedef int16_t lv_coord_t;
 /* Maximum buffer size to allocate for rotation. Only used if software rotation is enabled. */
 #define LV_DISP_ROT_MAX_BUF  (10U * 1024U)
 
+/* 1: Keep the invalidated areas in a bitmap of tiles instead of a list of
+ * `LV_INV_BUF_SIZE` rectangles. Many small invalidations then never fall back
+ * to a full screen redraw and need no joining; the dirty tiles are turned
+ * into a few rectangles right before drawing. */
+#define LV_USE_INV_TILES     0
+#if LV_USE_INV_TILES
+/* Tile size in pixels. At run time the height is raised to the smallest
+ * divisor of the display buffer's height in lines (buffer size / hor. res.)
+ * so that tile rows don't straddle the drawn bands. */
+#  define LV_INV_TILE_W      16
+#  define LV_INV_TILE_H      8
+#endif
+
+/* 1: Render the two halves of every band on two threads. The display driver
+ * has to provide `worker_start_cb`, `worker_wait_cb` and `worker_lock_cb`
+ * (e.g. a task pinned to the other core). Displays with `set_px_cb` are
+ * always drawn on one thread. */
+#define LV_USE_REFR_WORKER   0
+#if LV_USE_REFR_WORKER
+/* Storage class of the variables each rendering thread has its own copy of */
+#  define LV_REFR_WORKER_TLS __thread
+/* Don't split bands with fewer lines than this */
+#  define LV_REFR_WORKER_MIN_ROWS 8
+#endif
+
+/* 1: Pick the height of the drawn bands at run time. With two display buffers
+ * the next band is drawn while the previous one is flushed; smaller and larger
+ * bands are tried and the one that refreshes faster is kept. The time spent
+ * waiting for the flush is reported by `lv_disp_get_refr_stall_us()`.
+ * Needs a microsecond time source. */
+#define LV_USE_REFR_ADAPTIVE_BAND   0
+#if LV_USE_REFR_ADAPTIVE_BAND
+#  define LV_REFR_TIME_US_INCLUDE  "Arduino.h"      /*Header for the time function*/
+#  define LV_REFR_TIME_US_EXPR     (micros())       /*Expression evaluating to a free running 32 bit time in us*/
+/* Never draw fewer lines than this at once */
+#  define LV_REFR_BAND_MIN_ROWS    4
+#endif
+
+/* 1: Before drawing a band find the parts of it covered by opaque objects and skip the objects
+ * drawn earlier under them, or clip their drawing to the visible part. Without it only the objects
+ * under the topmost object which covers the whole band are skipped.
+ * `lv_disp_get_refr_overdraw()` tells how many times the pixels were drawn in the last refresh. */
+#define LV_USE_REFR_OCCLUSION   0
+
 /*=========================
    Memory manager settings
  *=========================*/
@@ -94,6 +138,16 @@ typedef int16_t lv_coord_t;
 
 /* Automatically defrag. on free. Defrag. means joining the adjacent free cells. */
 #  define LV_MEM_AUTO_DEFRAG  1
+
+/* 1: Find the free cells in segregated lists by size (TLSF) in constant time instead of walking all the cells.
+ * The adjacent free cells are always joined on free (`LV_MEM_AUTO_DEFRAG` is not used).
+ * Every allocation takes at least 3 pointers of data, so first fit (0) can be better for very small heaps. */
+#  define LV_MEM_TLSF         1
+
+/* 1: Get the memory pool once with `LV_MEM_POOL_ALLOC(size)` instead of a static array if `LV_MEM_ADR == 0`.
+ * E.g. `heap_caps_malloc(size, MALLOC_CAP_SPIRAM)` to have it in external RAM. */
+#  define LV_MEM_USE_POOL_ALLOC   0
+#  define LV_MEM_POOL_ALLOC       malloc
 #else       /*LV_MEM_CUSTOM*/
 #  define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
 #  define LV_MEM_CUSTOM_ALLOC   malloc       /*Wrapper to malloc*/
@@ -104,6 +158,17 @@ typedef int16_t lv_coord_t;
  * The standard functions might or might not be faster depending on their implementation. */
 #define LV_MEMCPY_MEMSET_STD    0
 
+/* Keep this many bytes of temporary draw buffers between the refreshes.
+ * The buffers have power of 2 sizes and as many of each size are kept as were used at once,
+ * so the refreshes don't allocate them again once they are warmed up. 0: free them after every refresh*/
+#define LV_MEM_BUF_KEEP_SIZE    4096
+
+/* 1: Allocate the nodes of the object and task lists in slabs of nodes shared by the lists of the same type
+ * instead of one `lv_mem_alloc` per node. The nodes created after each other will be next to each other.
+ * The slabs are freed when all of their nodes are deleted. Needs one extra pointer in every `lv_ll_t`
+ * and the partly used slabs hold more memory than single nodes, so 0 can be better for very small heaps.*/
+#define LV_LL_POOL              0
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #define LV_ENABLE_GC 0
@@ -143,6 +208,12 @@ typedef int16_t lv_coord_t;
 /* Gesture min velocity at release before swipe (pixels)*/
 #define LV_INDEV_DEF_GESTURE_MIN_VELOCITY 3
 
+/* 1: Find the pressed object through a grid of the clickable objects of each screen
+ * instead of testing every object of the screen. The grid is rebuilt on the next press
+ * after an object was created, deleted, moved or resized, so it helps screens with many objects
+ * which don't change while they are used. Needs a few bytes per clickable object per screen.*/
+#define LV_INDEV_HIT_INDEX                0
+
 /*==================
  * Feature usage
  *==================*/
@@ -164,8 +235,21 @@ typedef void * lv_anim_user_data_t;
  * where shadow size is `shadow_width + radius`
  * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
 #define LV_SHADOW_CACHE_SIZE    0
+
+/* The blurred corners of the last used shadows are kept until they take this many bytes.
+ * A corner needs ~(shadow size)^2 bytes*/
+#define LV_SHADOW_CACHE_MEM_SIZE    4096
+
+/* Allocate the cached corners with these functions, e.g. to keep them in external RAM*/
+#define LV_SHADOW_CACHE_ALLOC   lv_mem_alloc
+#define LV_SHADOW_CACHE_FREE    lv_mem_free
 #endif
 
+/* Keep the anti-aliased corners of the rounded rectangles to not calculate them again in every frame.
+ * LV_RADIUS_CACHE_SIZE is the RAM in bytes the corners can use (the render worker has one more cache).
+ * A radius needs ~(12 * radius + 16) bytes. 0: calculate the corners when they are drawn*/
+#define LV_RADIUS_CACHE_SIZE    2048
+
 /*1: enable outline drawing on rectangles*/
 #define LV_USE_OUTLINE  1
 
@@ -178,9 +262,22 @@ typedef void * lv_anim_user_data_t;
 /* 1: Use other blend modes than normal (`LV_BLEND_MODE_...`)*/
 #define LV_USE_BLEND_MODES      1
 
+/* 1: Blend rows with the vector instructions of the CPU (AVX2, SSE2 or NEON with 32 bit color)
+ * or two RGB565 pixels per 32 bit word (16 bit color). The result is the same as with `lv_color_mix`*/
+#define LV_USE_BLEND_SIMD       1
+
 /* 1: Use the `opa_scale` style property to set the opacity of an object and its children at once*/
 #define LV_USE_OPA_SCALE        1
 
+/* 1: Start the properties of the styles with an index to find them without walking through the style.
+ * It needs ~(4 * groups + 2 * different properties + 4) bytes for each style*/
+#define LV_STYLE_INDEX          1
+
+/* 1: Keep the draw descriptors of the object parts resolved from their styles
+ * to fill them by copying while the styles don't change.
+ * It needs ~(sizeof the rectangle, label, image and line descriptors) bytes for each drawn part*/
+#define LV_STYLE_DSC_CACHE      0
+
 /* 1: Use image zoom and rotation*/
 #define LV_USE_IMG_TRANSFORM    1
 
@@ -245,6 +342,22 @@ typedef void * lv_fs_drv_user_data_t;
  * Set it to 0 to disable caching */
 #define LV_IMG_CACHE_DEF_SIZE       1
 
+/* RAM in bytes the cached images can use including the memory allocated by the image decoders.
+ * The least recently used images are closed above it. 0: limit only the number of images*/
+#define LV_IMG_CACHE_MEM_SIZE       (16 * 1024)
+
+/* The built-in decoder decodes the image files and the indexed and alpha images once into RAM
+ * if they fit into this many bytes together. Later they are drawn directly from there.
+ * The others are decoded line by line in every redraw. 0: always decode line by line.
+ * Works only with LV_IMG_CACHE_DEF_SIZE >= 1. The decoded images count into LV_IMG_CACHE_MEM_SIZE too.
+ * An image needs (width * height * pixel size) bytes, where pixel size is LV_IMG_PX_SIZE_ALPHA_BYTE
+ * for the indexed and alpha images*/
+#define LV_IMG_DECODED_MEM_SIZE     0
+
+/* Allocate the decoded images with these functions, e.g. to keep them in external RAM*/
+#define LV_IMG_DECODED_ALLOC    lv_mem_alloc
+#define LV_IMG_DECODED_FREE     lv_mem_free
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_img_decoder_user_data_t;
 
@@ -427,11 +540,32 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
  * but with > 10,000 characters if you see issues probably you need to enable it.*/
 #define LV_FONT_FMT_TXT_LARGE   0
 
+/* Find the glyphs and kern pairs of the fonts in lookup tables instead of searching them.
+ * The tables of a font are built when it's first used and need ~(2 * last Latin-1 letter +
+ * 12..24 * letters above 255 of the sparse ranges + 4 * glyphs with kern pairs) bytes.
+ * 0: search the letters every time*/
+#define LV_FONT_FMT_TXT_LOOKUP  1
+
+/* Allocate the lookup tables with these functions, e.g. to keep them in external RAM*/
+#define LV_FONT_FMT_TXT_LOOKUP_ALLOC    lv_mem_alloc
+#define LV_FONT_FMT_TXT_LOOKUP_FREE     lv_mem_free
+
 /* Enables/disables support for compressed fonts. If it's disabled, compressed
  * glyphs cannot be processed by the library and won't be rendered.
  */
 #define LV_USE_FONT_COMPRESSED 1
 
+#if LV_USE_FONT_COMPRESSED
+/* Keep the decompressed glyphs of the compressed fonts to not decompress them again in every frame.
+ * LV_FONT_GLYPH_CACHE_SIZE is the RAM in bytes the glyphs can use (the render worker has one more cache).
+ * A glyph needs ~(box_w * box_h * bpp / 8 + 40) bytes. 0: decompress the glyphs when they are drawn*/
+#define LV_FONT_GLYPH_CACHE_SIZE    (4 * 1024)
+
+/* Allocate the cached glyphs with these functions, e.g. to keep them in external RAM*/
+#define LV_FONT_GLYPH_CACHE_ALLOC   lv_mem_alloc
+#define LV_FONT_GLYPH_CACHE_FREE    lv_mem_free
+#endif
+
 /* Enable subpixel rendering */
 #define LV_USE_FONT_SUBPX 1
 #if LV_USE_FONT_SUBPX
@@ -648,6 +782,10 @@ typedef void * lv_obj_user_data_t;
 
 /*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
 #  define LV_LABEL_LONG_TXT_HINT          0
+
+/*Keep the line starts and widths of the labels (8 bytes per line) to draw only the visible lines
+ *without breaking the text again on every refresh*/
+#  define LV_LABEL_LAYOUT_CACHE           1
 #endif
 
 /*LED (dependencies: -)*/
@@ -179,6 +179,116 @@
 #  endif
 #endif
 
+/* 1: Keep the invalidated areas in a bitmap of tiles instead of a list of
+ * `LV_INV_BUF_SIZE` rectangles. Many small invalidations then never fall back
+ * to a full screen redraw and need no joining; the dirty tiles are turned
+ * into a few rectangles right before drawing. */
+#ifndef LV_USE_INV_TILES
+#  ifdef CONFIG_LV_USE_INV_TILES
+#    define LV_USE_INV_TILES CONFIG_LV_USE_INV_TILES
+#  else
+#    define  LV_USE_INV_TILES     0
+#  endif
+#endif
+#if LV_USE_INV_TILES
+/* Tile size in pixels. At run time the height is raised to the smallest
+ * divisor of the display buffer's height in lines (buffer size / hor. res.)
+ * so that tile rows don't straddle the drawn bands. */
+#ifndef LV_INV_TILE_W
+#  ifdef CONFIG_LV_INV_TILE_W
+#    define LV_INV_TILE_W CONFIG_LV_INV_TILE_W
+#  else
+#    define  LV_INV_TILE_W      16
+#  endif
+#endif
+#ifndef LV_INV_TILE_H
+#  ifdef CONFIG_LV_INV_TILE_H
+#    define LV_INV_TILE_H CONFIG_LV_INV_TILE_H
+#  else
+#    define  LV_INV_TILE_H      8
+#  endif
+#endif
+#endif
+
+/* 1: Render the two halves of every band on two threads. The display driver
+ * has to provide `worker_start_cb`, `worker_wait_cb` and `worker_lock_cb`
+ * (e.g. a task pinned to the other core). Displays with `set_px_cb` are
+ * always drawn on one thread. */
+#ifndef LV_USE_REFR_WORKER
+#  ifdef CONFIG_LV_USE_REFR_WORKER
+#    define LV_USE_REFR_WORKER CONFIG_LV_USE_REFR_WORKER
+#  else
+#    define  LV_USE_REFR_WORKER   0
+#  endif
+#endif
+#if LV_USE_REFR_WORKER
+/* Storage class of the variables each rendering thread has its own copy of */
+#ifndef LV_REFR_WORKER_TLS
+#  ifdef CONFIG_LV_REFR_WORKER_TLS
+#    define LV_REFR_WORKER_TLS CONFIG_LV_REFR_WORKER_TLS
+#  else
+#    define  LV_REFR_WORKER_TLS __thread
+#  endif
+#endif
+/* Don't split bands with fewer lines than this */
+#ifndef LV_REFR_WORKER_MIN_ROWS
+#  ifdef CONFIG_LV_REFR_WORKER_MIN_ROWS
+#    define LV_REFR_WORKER_MIN_ROWS CONFIG_LV_REFR_WORKER_MIN_ROWS
+#  else
+#    define  LV_REFR_WORKER_MIN_ROWS 8
+#  endif
+#endif
+#endif
+
+/* 1: Pick the height of the drawn bands at run time. With two display buffers
+ * the next band is drawn while the previous one is flushed; smaller and larger
+ * bands are tried and the one that refreshes faster is kept. The time spent
+ * waiting for the flush is reported by `lv_disp_get_refr_stall_us()`.
+ * Needs a microsecond time source. */
+#ifndef LV_USE_REFR_ADAPTIVE_BAND
+#  ifdef CONFIG_LV_USE_REFR_ADAPTIVE_BAND
+#    define LV_USE_REFR_ADAPTIVE_BAND CONFIG_LV_USE_REFR_ADAPTIVE_BAND
+#  else
+#    define  LV_USE_REFR_ADAPTIVE_BAND   0
+#  endif
+#endif
+#if LV_USE_REFR_ADAPTIVE_BAND
+#ifndef LV_REFR_TIME_US_INCLUDE
+#  ifdef CONFIG_LV_REFR_TIME_US_INCLUDE
+#    define LV_REFR_TIME_US_INCLUDE CONFIG_LV_REFR_TIME_US_INCLUDE
+#  else
+#    define  LV_REFR_TIME_US_INCLUDE  "Arduino.h"      /*Header for the time function*/
+#  endif
+#endif
+#ifndef LV_REFR_TIME_US_EXPR
+#  ifdef CONFIG_LV_REFR_TIME_US_EXPR
+#    define LV_REFR_TIME_US_EXPR CONFIG_LV_REFR_TIME_US_EXPR
+#  else
+#    define  LV_REFR_TIME_US_EXPR     (micros())       /*Expression evaluating to a free running 32 bit time in us*/
+#  endif
+#endif
+/* Never draw fewer lines than this at once */
+#ifndef LV_REFR_BAND_MIN_ROWS
+#  ifdef CONFIG_LV_REFR_BAND_MIN_ROWS
+#    define LV_REFR_BAND_MIN_ROWS CONFIG_LV_REFR_BAND_MIN_ROWS
+#  else
+#    define  LV_REFR_BAND_MIN_ROWS    4
+#  endif
+#endif
+#endif
+
+/* 1: Before drawing a band find the parts of it covered by opaque objects and skip the objects
+ * drawn earlier under them, or clip their drawing to the visible part. Without it only the objects
+ * under the topmost object which covers the whole band are skipped.
+ * `lv_disp_get_refr_overdraw()` tells how many times the pixels were drawn in the last refresh. */
+#ifndef LV_USE_REFR_OCCLUSION
+#  ifdef CONFIG_LV_USE_REFR_OCCLUSION
+#    define LV_USE_REFR_OCCLUSION CONFIG_LV_USE_REFR_OCCLUSION
+#  else
+#    define  LV_USE_REFR_OCCLUSION   0
+#  endif
+#endif
+
 /*=========================
    Memory manager settings
  *=========================*/
@@ -231,6 +341,34 @@
 #    define  LV_MEM_AUTO_DEFRAG  1
 #  endif
 #endif
+
+/* 1: Find the free cells in segregated lists by size (TLSF) in constant time instead of walking all the cells.
+ * The adjacent free cells are always joined on free (`LV_MEM_AUTO_DEFRAG` is not used).
+ * Every allocation takes at least 3 pointers of data, so first fit (0) can be better for very small heaps. */
+#ifndef LV_MEM_TLSF
+#  ifdef CONFIG_LV_MEM_TLSF
+#    define LV_MEM_TLSF CONFIG_LV_MEM_TLSF
+#  else
+#    define  LV_MEM_TLSF         1
+#  endif
+#endif
+
+/* 1: Get the memory pool once with `LV_MEM_POOL_ALLOC(size)` instead of a static array if `LV_MEM_ADR == 0`.
+ * E.g. `heap_caps_malloc(size, MALLOC_CAP_SPIRAM)` to have it in external RAM. */
+#ifndef LV_MEM_USE_POOL_ALLOC
+#  ifdef CONFIG_LV_MEM_USE_POOL_ALLOC
+#    define LV_MEM_USE_POOL_ALLOC CONFIG_LV_MEM_USE_POOL_ALLOC
+#  else
+#    define  LV_MEM_USE_POOL_ALLOC   0
+#  endif
+#endif
+#ifndef LV_MEM_POOL_ALLOC
+#  ifdef CONFIG_LV_MEM_POOL_ALLOC
+#    define LV_MEM_POOL_ALLOC CONFIG_LV_MEM_POOL_ALLOC
+#  else
+#    define  LV_MEM_POOL_ALLOC       malloc
+#  endif
+#endif
 #else       /*LV_MEM_CUSTOM*/
 #ifndef LV_MEM_CUSTOM_INCLUDE
 #  ifdef CONFIG_LV_MEM_CUSTOM_INCLUDE
@@ -265,6 +403,29 @@
 #  endif
 #endif
 
+/* Keep this many bytes of temporary draw buffers between the refreshes.
+ * The buffers have power of 2 sizes and as many of each size are kept as were used at once,
+ * so the refreshes don't allocate them again once they are warmed up. 0: free them after every refresh*/
+#ifndef LV_MEM_BUF_KEEP_SIZE
+#  ifdef CONFIG_LV_MEM_BUF_KEEP_SIZE
+#    define LV_MEM_BUF_KEEP_SIZE CONFIG_LV_MEM_BUF_KEEP_SIZE
+#  else
+#    define  LV_MEM_BUF_KEEP_SIZE    4096
+#  endif
+#endif
+
+/* 1: Allocate the nodes of the object and task lists in slabs of nodes shared by the lists of the same type
+ * instead of one `lv_mem_alloc` per node. The nodes created after each other will be next to each other.
+ * The slabs are freed when all of their nodes are deleted. Needs one extra pointer in every `lv_ll_t`
+ * and the partly used slabs hold more memory than single nodes, so 0 can be better for very small heaps.*/
+#ifndef LV_LL_POOL
+#  ifdef CONFIG_LV_LL_POOL
+#    define LV_LL_POOL CONFIG_LV_LL_POOL
+#  else
+#    define  LV_LL_POOL              0
+#  endif
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #ifndef LV_ENABLE_GC
@@ -370,6 +531,18 @@
 #  endif
 #endif
 
+/* 1: Find the pressed object through a grid of the clickable objects of each screen
+ * instead of testing every object of the screen. The grid is rebuilt on the next press
+ * after an object was created, deleted, moved or resized, so it helps screens with many objects
+ * which don't change while they are used. Needs a few bytes per clickable object per screen.*/
+#ifndef LV_INDEV_HIT_INDEX
+#  ifdef CONFIG_LV_INDEV_HIT_INDEX
+#    define LV_INDEV_HIT_INDEX CONFIG_LV_INDEV_HIT_INDEX
+#  else
+#    define  LV_INDEV_HIT_INDEX                0
+#  endif
+#endif
+
 /*==================
  * Feature usage
  *==================*/
@@ -408,6 +581,43 @@
 #    define  LV_SHADOW_CACHE_SIZE    0
 #  endif
 #endif
+
+/* The blurred corners of the last used shadows are kept until they take this many bytes.
+ * A corner needs ~(shadow size)^2 bytes*/
+#ifndef LV_SHADOW_CACHE_MEM_SIZE
+#  ifdef CONFIG_LV_SHADOW_CACHE_MEM_SIZE
+#    define LV_SHADOW_CACHE_MEM_SIZE CONFIG_LV_SHADOW_CACHE_MEM_SIZE
+#  else
+#    define  LV_SHADOW_CACHE_MEM_SIZE    4096
+#  endif
+#endif
+
+/* Allocate the cached corners with these functions, e.g. to keep them in external RAM*/
+#ifndef LV_SHADOW_CACHE_ALLOC
+#  ifdef CONFIG_LV_SHADOW_CACHE_ALLOC
+#    define LV_SHADOW_CACHE_ALLOC CONFIG_LV_SHADOW_CACHE_ALLOC
+#  else
+#    define  LV_SHADOW_CACHE_ALLOC   lv_mem_alloc
+#  endif
+#endif
+#ifndef LV_SHADOW_CACHE_FREE
+#  ifdef CONFIG_LV_SHADOW_CACHE_FREE
+#    define LV_SHADOW_CACHE_FREE CONFIG_LV_SHADOW_CACHE_FREE
+#  else
+#    define  LV_SHADOW_CACHE_FREE    lv_mem_free
+#  endif
+#endif
+#endif
+
+/* Keep the anti-aliased corners of the rounded rectangles to not calculate them again in every frame.
+ * LV_RADIUS_CACHE_SIZE is the RAM in bytes the corners can use (the render worker has one more cache).
+ * A radius needs ~(12 * radius + 16) bytes. 0: calculate the corners when they are drawn*/
+#ifndef LV_RADIUS_CACHE_SIZE
+#  ifdef CONFIG_LV_RADIUS_CACHE_SIZE
+#    define LV_RADIUS_CACHE_SIZE CONFIG_LV_RADIUS_CACHE_SIZE
+#  else
+#    define  LV_RADIUS_CACHE_SIZE    2048
+#  endif
 #endif
 
 /*1: enable outline drawing on rectangles*/
@@ -446,6 +656,16 @@
 #  endif
 #endif
 
+/* 1: Blend rows with the vector instructions of the CPU (AVX2, SSE2 or NEON with 32 bit color)
+ * or two RGB565 pixels per 32 bit word (16 bit color). The result is the same as with `lv_color_mix`*/
+#ifndef LV_USE_BLEND_SIMD
+#  ifdef CONFIG_LV_USE_BLEND_SIMD
+#    define LV_USE_BLEND_SIMD CONFIG_LV_USE_BLEND_SIMD
+#  else
+#    define  LV_USE_BLEND_SIMD       1
+#  endif
+#endif
+
 /* 1: Use the `opa_scale` style property to set the opacity of an object and its children at once*/
 #ifndef LV_USE_OPA_SCALE
 #  ifdef CONFIG_LV_USE_OPA_SCALE
@@ -455,6 +675,27 @@
 #  endif
 #endif
 
+/* 1: Start the properties of the styles with an index to find them without walking through the style.
+ * It needs ~(4 * groups + 2 * different properties + 4) bytes for each style*/
+#ifndef LV_STYLE_INDEX
+#  ifdef CONFIG_LV_STYLE_INDEX
+#    define LV_STYLE_INDEX CONFIG_LV_STYLE_INDEX
+#  else
+#    define  LV_STYLE_INDEX          1
+#  endif
+#endif
+
+/* 1: Keep the draw descriptors of the object parts resolved from their styles
+ * to fill them by copying while the styles don't change.
+ * It needs ~(sizeof the rectangle, label, image and line descriptors) bytes for each drawn part*/
+#ifndef LV_STYLE_DSC_CACHE
+#  ifdef CONFIG_LV_STYLE_DSC_CACHE
+#    define LV_STYLE_DSC_CACHE CONFIG_LV_STYLE_DSC_CACHE
+#  else
+#    define  LV_STYLE_DSC_CACHE      0
+#  endif
+#endif
+
 /* 1: Use image zoom and rotation*/
 #ifndef LV_USE_IMG_TRANSFORM
 #  ifdef CONFIG_LV_USE_IMG_TRANSFORM
@@ -613,6 +854,46 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* RAM in bytes the cached images can use including the memory allocated by the image decoders.
+ * The least recently used images are closed above it. 0: limit only the number of images*/
+#ifndef LV_IMG_CACHE_MEM_SIZE
+#  ifdef CONFIG_LV_IMG_CACHE_MEM_SIZE
+#    define LV_IMG_CACHE_MEM_SIZE CONFIG_LV_IMG_CACHE_MEM_SIZE
+#  else
+#    define  LV_IMG_CACHE_MEM_SIZE       (16 * 1024)
+#  endif
+#endif
+
+/* The built-in decoder decodes the image files and the indexed and alpha images once into RAM
+ * if they fit into this many bytes together. Later they are drawn directly from there.
+ * The others are decoded line by line in every redraw. 0: always decode line by line.
+ * Works only with LV_IMG_CACHE_DEF_SIZE >= 1. The decoded images count into LV_IMG_CACHE_MEM_SIZE too.
+ * An image needs (width * height * pixel size) bytes, where pixel size is LV_IMG_PX_SIZE_ALPHA_BYTE
+ * for the indexed and alpha images*/
+#ifndef LV_IMG_DECODED_MEM_SIZE
+#  ifdef CONFIG_LV_IMG_DECODED_MEM_SIZE
+#    define LV_IMG_DECODED_MEM_SIZE CONFIG_LV_IMG_DECODED_MEM_SIZE
+#  else
+#    define  LV_IMG_DECODED_MEM_SIZE     0
+#  endif
+#endif
+
+/* Allocate the decoded images with these functions, e.g. to keep them in external RAM*/
+#ifndef LV_IMG_DECODED_ALLOC
+#  ifdef CONFIG_LV_IMG_DECODED_ALLOC
+#    define LV_IMG_DECODED_ALLOC CONFIG_LV_IMG_DECODED_ALLOC
+#  else
+#    define  LV_IMG_DECODED_ALLOC    lv_mem_alloc
+#  endif
+#endif
+#ifndef LV_IMG_DECODED_FREE
+#  ifdef CONFIG_LV_IMG_DECODED_FREE
+#    define LV_IMG_DECODED_FREE CONFIG_LV_IMG_DECODED_FREE
+#  else
+#    define  LV_IMG_DECODED_FREE     lv_mem_free
+#  endif
+#endif
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 
 /*=====================
@@ -1104,6 +1385,34 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Find the glyphs and kern pairs of the fonts in lookup tables instead of searching them.
+ * The tables of a font are built when it's first used and need ~(2 * last Latin-1 letter +
+ * 12..24 * letters above 255 of the sparse ranges + 4 * glyphs with kern pairs) bytes.
+ * 0: search the letters every time*/
+#ifndef LV_FONT_FMT_TXT_LOOKUP
+#  ifdef CONFIG_LV_FONT_FMT_TXT_LOOKUP
+#    define LV_FONT_FMT_TXT_LOOKUP CONFIG_LV_FONT_FMT_TXT_LOOKUP
+#  else
+#    define  LV_FONT_FMT_TXT_LOOKUP  1
+#  endif
+#endif
+
+/* Allocate the lookup tables with these functions, e.g. to keep them in external RAM*/
+#ifndef LV_FONT_FMT_TXT_LOOKUP_ALLOC
+#  ifdef CONFIG_LV_FONT_FMT_TXT_LOOKUP_ALLOC
+#    define LV_FONT_FMT_TXT_LOOKUP_ALLOC CONFIG_LV_FONT_FMT_TXT_LOOKUP_ALLOC
+#  else
+#    define  LV_FONT_FMT_TXT_LOOKUP_ALLOC    lv_mem_alloc
+#  endif
+#endif
+#ifndef LV_FONT_FMT_TXT_LOOKUP_FREE
+#  ifdef CONFIG_LV_FONT_FMT_TXT_LOOKUP_FREE
+#    define LV_FONT_FMT_TXT_LOOKUP_FREE CONFIG_LV_FONT_FMT_TXT_LOOKUP_FREE
+#  else
+#    define  LV_FONT_FMT_TXT_LOOKUP_FREE     lv_mem_free
+#  endif
+#endif
+
 /* Enables/disables support for compressed fonts. If it's disabled, compressed
  * glyphs cannot be processed by the library and won't be rendered.
  */
@@ -1115,6 +1424,35 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+#if LV_USE_FONT_COMPRESSED
+/* Keep the decompressed glyphs of the compressed fonts to not decompress them again in every frame.
+ * LV_FONT_GLYPH_CACHE_SIZE is the RAM in bytes the glyphs can use (the render worker has one more cache).
+ * A glyph needs ~(box_w * box_h * bpp / 8 + 40) bytes. 0: decompress the glyphs when they are drawn*/
+#ifndef LV_FONT_GLYPH_CACHE_SIZE
+#  ifdef CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+#    define LV_FONT_GLYPH_CACHE_SIZE CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+#  else
+#    define  LV_FONT_GLYPH_CACHE_SIZE    (4 * 1024)
+#  endif
+#endif
+
+/* Allocate the cached glyphs with these functions, e.g. to keep them in external RAM*/
+#ifndef LV_FONT_GLYPH_CACHE_ALLOC
+#  ifdef CONFIG_LV_FONT_GLYPH_CACHE_ALLOC
+#    define LV_FONT_GLYPH_CACHE_ALLOC CONFIG_LV_FONT_GLYPH_CACHE_ALLOC
+#  else
+#    define  LV_FONT_GLYPH_CACHE_ALLOC   lv_mem_alloc
+#  endif
+#endif
+#ifndef LV_FONT_GLYPH_CACHE_FREE
+#  ifdef CONFIG_LV_FONT_GLYPH_CACHE_FREE
+#    define LV_FONT_GLYPH_CACHE_FREE CONFIG_LV_FONT_GLYPH_CACHE_FREE
+#  else
+#    define  LV_FONT_GLYPH_CACHE_FREE    lv_mem_free
+#  endif
+#endif
+#endif
+
 /* Enable subpixel rendering */
 #ifndef LV_USE_FONT_SUBPX
 #  ifdef CONFIG_LV_USE_FONT_SUBPX
@@ -1677,6 +2015,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_LABEL_LONG_TXT_HINT          0
 #  endif
 #endif
+
+/*Keep the line starts and widths of the labels (8 bytes per line) to draw only the visible lines
+ *without breaking the text again on every refresh*/
+#ifndef LV_LABEL_LAYOUT_CACHE
+#  ifdef CONFIG_LV_LABEL_LAYOUT_CACHE
+#    define LV_LABEL_LAYOUT_CACHE CONFIG_LV_LABEL_LAYOUT_CACHE
+#  else
+#    define  LV_LABEL_LAYOUT_CACHE           1
+#  endif
+#endif
 #endif
 
 /*LED (dependencies: -)*/
@@ -35,6 +35,95 @@ extern "C" {
 #endif
 #endif
 
+/*******************
+ * LV_MEM_TLSF
+ *******************/
+
+/*Kconfig doesn't define the disabled bools so the default (1) would be used*/
+#if defined (ESP_PLATFORM) && !defined (CONFIG_LV_MEM_TLSF)
+#define CONFIG_LV_MEM_TLSF      0
+#endif
+
+/*******************
+ * LV_USE_BLEND_SIMD
+ *******************/
+
+#if defined (ESP_PLATFORM) && !defined (CONFIG_LV_USE_BLEND_SIMD)
+#define CONFIG_LV_USE_BLEND_SIMD    0
+#endif
+
+/*******************
+ * LV_STYLE_INDEX
+ *******************/
+
+#if defined (ESP_PLATFORM) && !defined (CONFIG_LV_STYLE_INDEX)
+#define CONFIG_LV_STYLE_INDEX   0
+#endif
+
+/*******************
+ * LV_MEM_POOL_ALLOC
+ *******************/
+
+#if defined (CONFIG_LV_MEM_POOL_SPIRAM) && defined (ESP_PLATFORM)
+#include "esp_heap_caps.h"
+#define CONFIG_LV_MEM_USE_POOL_ALLOC        1
+#define CONFIG_LV_MEM_POOL_ALLOC(size)      heap_caps_malloc(size, MALLOC_CAP_SPIRAM)
+#endif
+
+/*******************
+ * LV_SHADOW_CACHE_ALLOC
+ *******************/
+
+#if defined (CONFIG_LV_SHADOW_CACHE_SPIRAM) && defined (ESP_PLATFORM)
+#include "esp_heap_caps.h"
+#define CONFIG_LV_SHADOW_CACHE_ALLOC(size)  heap_caps_malloc(size, MALLOC_CAP_SPIRAM)
+#define CONFIG_LV_SHADOW_CACHE_FREE         heap_caps_free
+#endif
+
+/*******************
+ * LV_IMG_DECODED_ALLOC
+ *******************/
+
+#if defined (CONFIG_LV_IMG_DECODED_SPIRAM) && defined (ESP_PLATFORM)
+#include "esp_heap_caps.h"
+#define CONFIG_LV_IMG_DECODED_ALLOC(size)   heap_caps_malloc(size, MALLOC_CAP_SPIRAM)
+#define CONFIG_LV_IMG_DECODED_FREE          heap_caps_free
+#endif
+
+/*******************
+ * LV_FONT_FMT_TXT_LOOKUP
+ *******************/
+
+/*Kconfig doesn't define the disabled bools so the default (1) would be used*/
+#if defined (ESP_PLATFORM) && !defined (CONFIG_LV_FONT_FMT_TXT_LOOKUP)
+#define CONFIG_LV_FONT_FMT_TXT_LOOKUP   0
+#endif
+
+#if defined (CONFIG_LV_FONT_FMT_TXT_LOOKUP_SPIRAM) && defined (ESP_PLATFORM)
+#include "esp_heap_caps.h"
+#define CONFIG_LV_FONT_FMT_TXT_LOOKUP_ALLOC(size)   heap_caps_malloc(size, MALLOC_CAP_SPIRAM)
+#define CONFIG_LV_FONT_FMT_TXT_LOOKUP_FREE          heap_caps_free
+#endif
+
+/*******************
+ * LV_LABEL_LAYOUT_CACHE
+ *******************/
+
+/*Kconfig doesn't define the disabled bools so the default (1) would be used*/
+#if defined (ESP_PLATFORM) && !defined (CONFIG_LV_LABEL_LAYOUT_CACHE)
+#define CONFIG_LV_LABEL_LAYOUT_CACHE    0
+#endif
+
+/*******************
+ * LV_FONT_GLYPH_CACHE_ALLOC
+ *******************/
+
+#if defined (CONFIG_LV_FONT_GLYPH_CACHE_SPIRAM) && defined (ESP_PLATFORM)
+#include "esp_heap_caps.h"
+#define CONFIG_LV_FONT_GLYPH_CACHE_ALLOC(size)  heap_caps_malloc(size, MALLOC_CAP_SPIRAM)
+#define CONFIG_LV_FONT_GLYPH_CACHE_FREE         heap_caps_free
+#endif
+
 /*******************
  * LV COLOR TRANSP
  *******************/
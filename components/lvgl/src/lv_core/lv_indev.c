@@ -15,6 +15,7 @@
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_gc.h"
 
 /*********************
  *      DEFINES
@@ -24,9 +25,35 @@
     #warning "LV_INDEV_DRAG_THROW must be greater than 0"
 #endif
 
+#if LV_INDEV_HIT_INDEX
+#define HIT_GRID_MAX    16  /*Max. number of columns and rows of a grid*/
+#define HIT_WIDE_DIV    4   /*Objects on more than 1/4 of the cells are listed once instead of on every cell*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_INDEV_HIT_INDEX
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t area;     /*Where `obj` can be hit: its click area clipped to the click areas of its parents*/
+} hit_entry_t;
+
+typedef struct {
+    lv_area_t area;         /*Click area of the root, covered by the cells*/
+    lv_coord_t cell_w;
+    lv_coord_t cell_h;
+    uint16_t cols;
+    uint16_t rows;
+    uint32_t entry_cnt;
+    uint32_t wide_cnt;
+    uint32_t list_cnt;
+    hit_entry_t * entries;  /*The clickable objects in the order the recursive search would find them*/
+    uint16_t * cell_start;  /*Index of the first item of each cell in `cell_list` and the end of the last cell*/
+    uint16_t * cell_list;   /*Indexes of the entries on each cell in ascending order*/
+    uint16_t * wide_list;   /*Indexes of the entries on too many cells to list them on every cell*/
+} hit_grid_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -45,12 +72,28 @@ static void indev_drag_throw(lv_indev_proc_t * proc);
 static lv_obj_t * get_dragged_obj(lv_obj_t * obj);
 static void indev_gesture(lv_indev_proc_t * proc);
 static bool indev_reset_check(lv_indev_proc_t * proc);
+static lv_obj_t * search_obj(lv_obj_t * obj, lv_point_t * point);
+static bool obj_takes_click(lv_obj_t * obj);
+#if LV_INDEV_HIT_INDEX
+static hit_grid_t * hit_grid_get(lv_obj_t * root);
+static hit_grid_t * hit_grid_build(lv_obj_t * root);
+static void hit_grid_walk(hit_grid_t * grid, lv_obj_t * obj, const lv_area_t * clip, bool fill);
+static void hit_grid_get_cells(const hit_grid_t * grid, const lv_area_t * area, lv_area_t * cells);
+static lv_obj_t * hit_grid_search(const hit_grid_t * grid, lv_point_t * point);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static lv_indev_t * indev_act;
 static lv_obj_t * indev_obj_act = NULL;
+#if LV_INDEV_HIT_INDEX
+static uint32_t hit_gen;        /*Incremented on every change which makes the grids outdated*/
+static bool hit_searching;      /*A grid is being searched so it can't be freed*/
+static uint32_t hit_query_cnt;
+static uint32_t hit_visit_cnt;
+static uint32_t hit_build_cnt;
+#endif
 
 /**********************
  *      MACROS
@@ -66,6 +109,15 @@ static lv_obj_t * indev_obj_act = NULL;
 void _lv_indev_init(void)
 {
     lv_indev_reset(NULL, NULL); /*Reset all input devices*/
+
+    _lv_memset_00(LV_GC_ROOT(_lv_indev_hit_index), sizeof(LV_GC_ROOT(_lv_indev_hit_index)));
+#if LV_INDEV_HIT_INDEX
+    hit_gen = 0;
+    hit_searching = false;
+    hit_query_cnt = 0;
+    hit_visit_cnt = 0;
+    hit_build_cnt = 0;
+#endif
 }
 
 /**
@@ -402,6 +454,69 @@ lv_task_t * lv_indev_get_read_task(lv_disp_t * indev)
     return indev->refr_task;
 }
 
+/**
+ * Search the most top, clickable object by a point
+ * @param obj pointer to a start object, typically the screen
+ * @param point pointer to a point for searching the most top child
+ * @return pointer to the found object or NULL if there was no suitable object
+ */
+lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
+{
+#if LV_INDEV_HIT_INDEX
+    hit_query_cnt++;
+
+    /*Screens and layers are searched in their grid*/
+    if(lv_obj_get_parent(obj) == NULL) {
+        hit_grid_t * grid = hit_grid_get(obj);
+        if(grid && _lv_area_is_point_on(&grid->area, point, 0)) {
+            hit_searching = true;
+            lv_obj_t * found = hit_grid_search(grid, point);
+            hit_searching = false;
+            return found;
+        }
+    }
+#endif
+
+    return search_obj(obj, point);
+}
+
+#if LV_INDEV_HIT_INDEX
+/**
+ * Mark the hit indexes of all screens outdated and free them.
+ * Called by the objects when they are created, deleted, moved, resized (`LV_SIGNAL_COORD_CHG`)
+ * or their clickability changes.
+ */
+void _lv_indev_hit_index_invalidate(void)
+{
+    hit_gen++;
+
+    /*Don't keep the grids of the deleted screens. If an advanced hit test changed the objects
+     *the grid being searched is freed on its next use instead.*/
+    if(hit_searching) return;
+
+    _lv_indev_hit_index_t * slots = LV_GC_ROOT(_lv_indev_hit_index);
+    uint32_t i;
+    for(i = 0; i < _LV_INDEV_HIT_INDEX_SLOTS; i++) {
+        if(slots[i].grid) {
+            lv_mem_free(slots[i].grid);
+            slots[i].grid = NULL;
+        }
+    }
+}
+
+/**
+ * Give information about the searches of the pressed objects since `lv_init`
+ * @param mon_p pointer to a `lv_indev_hit_monitor_t` variable, the result will be stored here
+ */
+void lv_indev_hit_monitor(lv_indev_hit_monitor_t * mon_p)
+{
+    mon_p->query_cnt = hit_query_cnt;
+    mon_p->visit_cnt = hit_visit_cnt;
+    mon_p->build_cnt = hit_build_cnt;
+    mon_p->visit_avg = hit_query_cnt ? (hit_visit_cnt + hit_query_cnt / 2) / hit_query_cnt : 0;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -1139,21 +1254,25 @@ static void indev_proc_reset_query_handler(lv_indev_t * indev)
     }
 }
 /**
- * Search the most top, clickable object by a point
- * @param obj pointer to a start object, typically the screen
+ * Search the most top, clickable object by a point by testing the children of `obj` recursively
+ * @param obj pointer to a start object
  * @param point pointer to a point for searching the most top child
  * @return pointer to the found object or NULL if there was no suitable object
  */
-lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
+static lv_obj_t * search_obj(lv_obj_t * obj, lv_point_t * point)
 {
     lv_obj_t * found_p = NULL;
 
+#if LV_INDEV_HIT_INDEX
+    hit_visit_cnt++;
+#endif
+
     /*If the point is on this object check its children too*/
     if(lv_obj_hittest(obj, point)) {
         lv_obj_t * i;
 
         _LV_LL_READ(obj->child_ll, i) {
-            found_p = lv_indev_search_obj(i, point);
+            found_p = search_obj(i, point);
 
             /*If a child was found then break*/
             if(found_p != NULL) {
@@ -1163,25 +1282,259 @@ lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
 
         /*If then the children was not ok, and this obj is clickable
          * and it or its parent is not hidden then save this object*/
-        if(found_p == NULL && lv_obj_get_click(obj) != false) {
-            lv_obj_t * hidden_i = obj;
-            while(hidden_i != NULL) {
-                if(lv_obj_get_hidden(hidden_i) == true) break;
-                hidden_i = lv_obj_get_parent(hidden_i);
-            }
-            /*No parent found with hidden == true*/
-            if(lv_obj_is_protected(obj, LV_PROTECT_EVENT_TO_DISABLED) == false) {
-                if(hidden_i == NULL && (lv_obj_get_state(obj, LV_OBJ_PART_MAIN) & LV_STATE_DISABLED) == false) found_p = obj;
+        if(found_p == NULL && obj_takes_click(obj)) found_p = obj;
+    }
+
+    return found_p;
+}
+
+/**
+ * Check if an object can be the pressed object if the point is on it
+ * @param obj pointer to an object
+ * @return true: `obj` is clickable, it and its parents are not hidden and it's not disabled
+ */
+static bool obj_takes_click(lv_obj_t * obj)
+{
+    if(lv_obj_get_click(obj) == false) return false;
+
+    lv_obj_t * hidden_i = obj;
+    while(hidden_i != NULL) {
+        if(lv_obj_get_hidden(hidden_i) == true) return false;
+        hidden_i = lv_obj_get_parent(hidden_i);
+    }
+
+    /*No parent found with hidden == true*/
+    if(lv_obj_is_protected(obj, LV_PROTECT_EVENT_TO_DISABLED) == false) {
+        if(lv_obj_get_state(obj, LV_OBJ_PART_MAIN) & LV_STATE_DISABLED) return false;
+    }
+
+    return true;
+}
+
+#if LV_INDEV_HIT_INDEX
+/**
+ * Get the grid of a screen and build it if it's missing or outdated
+ * @param root pointer to a screen or layer
+ * @return pointer to the grid or NULL if it couldn't be built
+ */
+static hit_grid_t * hit_grid_get(lv_obj_t * root)
+{
+    _lv_indev_hit_index_t * slots = LV_GC_ROOT(_lv_indev_hit_index);
+    _lv_indev_hit_index_t * slot = NULL;
+    _lv_indev_hit_index_t * oldest = &slots[0];
+    uint32_t i;
+    for(i = 0; i < _LV_INDEV_HIT_INDEX_SLOTS; i++) {
+        if(slots[i].root == root) {
+            slot = &slots[i];
+            break;
+        }
+        if(slots[i].last_use < oldest->last_use) oldest = &slots[i];
+    }
+
+    /*Reuse the slot of the screen searched the longest ago*/
+    if(slot == NULL) {
+        slot = oldest;
+        if(slot->grid) lv_mem_free(slot->grid);
+        slot->grid = NULL;
+        slot->root = root;
+    }
+
+    slot->last_use = hit_query_cnt;
+
+    if(slot->grid == NULL || slot->gen != hit_gen) {
+        if(slot->grid) lv_mem_free(slot->grid);
+        slot->grid = hit_grid_build(root);
+        slot->gen = hit_gen;
+        hit_build_cnt++;
+    }
+
+    return slot->grid;
+}
+
+/**
+ * Collect the clickable objects of a screen and sort them to the cells they can be hit on
+ * @param root pointer to a screen or layer
+ * @return pointer to the new grid or NULL if it couldn't be allocated
+ */
+static hit_grid_t * hit_grid_build(lv_obj_t * root)
+{
+    hit_grid_t g;
+    _lv_memset_00(&g, sizeof(g));
+
+    _lv_obj_get_click_area(root, &g.area);
+    lv_coord_t w = lv_area_get_width(&g.area);
+    lv_coord_t h = lv_area_get_height(&g.area);
+    if(w <= 0 || h <= 0) return NULL;
+
+    g.cols = LV_MATH_MIN(w, HIT_GRID_MAX);
+    g.rows = LV_MATH_MIN(h, HIT_GRID_MAX);
+    g.cell_w = (w + g.cols - 1) / g.cols;
+    g.cell_h = (h + g.rows - 1) / g.rows;
+    g.cols = (w + g.cell_w - 1) / g.cell_w;
+    g.rows = (h + g.cell_h - 1) / g.cell_h;
+
+    /*Count the entries first to allocate everything at once*/
+    hit_grid_walk(&g, root, &g.area, false);
+    if(g.entry_cnt > UINT16_MAX || g.list_cnt > UINT16_MAX) return NULL;
+
+    uint32_t cell_cnt = (uint32_t)g.cols * g.rows;
+    uint32_t size = sizeof(hit_grid_t) + g.entry_cnt * sizeof(hit_entry_t) +
+                    (cell_cnt + 1 + g.list_cnt + g.wide_cnt) * sizeof(uint16_t);
+
+    /*Not an error: the recursive search is used without a grid*/
+    hit_grid_t * grid = lv_mem_alloc(size);
+    if(grid == NULL) return NULL;
+
+    *grid = g;
+    grid->entries = (hit_entry_t *)(grid + 1);
+    grid->cell_start = (uint16_t *)(grid->entries + g.entry_cnt);
+    grid->cell_list = grid->cell_start + cell_cnt + 1;
+    grid->wide_list = grid->cell_list + g.list_cnt;
+    grid->entry_cnt = 0;
+    grid->wide_cnt = 0;
+    _lv_memset_00(grid->cell_start, (cell_cnt + 1) * sizeof(uint16_t));
+
+    /*Save the entries and count the entries of each cell in `cell_start[cell + 1]`*/
+    hit_grid_walk(grid, root, &grid->area, true);
+
+    uint32_t c;
+    for(c = 0; c < cell_cnt; c++) grid->cell_start[c + 1] += grid->cell_start[c];
+
+    /*Put the entries to their cells. `cell_start[cell]` moves to the start of the next cell meanwhile*/
+    uint32_t e;
+    for(e = 0; e < grid->entry_cnt; e++) {
+        lv_area_t cells;
+        hit_grid_get_cells(grid, &grid->entries[e].area, &cells);
+        if((uint32_t)lv_area_get_size(&cells) * HIT_WIDE_DIV > cell_cnt) continue;
+
+        lv_coord_t x;
+        lv_coord_t y;
+        for(y = cells.y1; y <= cells.y2; y++) {
+            for(x = cells.x1; x <= cells.x2; x++) {
+                c = (uint32_t)y * grid->cols + x;
+                grid->cell_list[grid->cell_start[c]] = e;
+                grid->cell_start[c]++;
             }
-            else {
-                if(hidden_i == NULL) found_p = obj;
+        }
+    }
+
+    for(c = cell_cnt; c > 0; c--) grid->cell_start[c] = grid->cell_start[c - 1];
+    grid->cell_start[0] = 0;
+
+    return grid;
+}
+
+/**
+ * Visit the objects in the order of the recursive search and count or save the clickable ones
+ * @param grid pointer to a grid
+ * @param obj pointer to the object to visit
+ * @param clip the click areas of the parents of `obj` intersected
+ * @param fill false: only count the entries; true: save the entries too
+ */
+static void hit_grid_walk(hit_grid_t * grid, lv_obj_t * obj, const lv_area_t * clip, bool fill)
+{
+    /*The advanced hit test can't be predicted so it's checked on search*/
+    lv_area_t area;
+    if(obj->adv_hittest) {
+        lv_area_copy(&area, clip);
+    }
+    else {
+        lv_area_t click_area;
+        _lv_obj_get_click_area(obj, &click_area);
+        if(_lv_area_intersect(&area, clip, &click_area) == false) return;
+    }
+
+    lv_obj_t * child;
+    _LV_LL_READ(obj->child_ll, child) {
+        hit_grid_walk(grid, child, &area, fill);
+    }
+
+    if(obj->click == 0) return;
+
+    lv_area_t cells;
+    hit_grid_get_cells(grid, &area, &cells);
+    uint32_t cell_cnt = (uint32_t)grid->cols * grid->rows;
+    bool wide = (uint32_t)lv_area_get_size(&cells) * HIT_WIDE_DIV > cell_cnt;
+
+    if(fill) {
+        hit_entry_t * entry = &grid->entries[grid->entry_cnt];
+        entry->obj = obj;
+        lv_area_copy(&entry->area, &area);
+
+        if(wide) {
+            grid->wide_list[grid->wide_cnt] = grid->entry_cnt;
+        }
+        else {
+            lv_coord_t x;
+            lv_coord_t y;
+            for(y = cells.y1; y <= cells.y2; y++) {
+                for(x = cells.x1; x <= cells.x2; x++) {
+                    grid->cell_start[(uint32_t)y * grid->cols + x + 1]++;
+                }
             }
         }
     }
+    else if(!wide) {
+        grid->list_cnt += lv_area_get_size(&cells);
+    }
 
-    return found_p;
+    if(wide) grid->wide_cnt++;
+    grid->entry_cnt++;
 }
 
+/**
+ * Get the cells an area is on
+ * @param grid pointer to a grid
+ * @param area an area on the grid's area
+ * @param cells the first and last column (x1, x2) and row (y1, y2) will be stored here
+ */
+static void hit_grid_get_cells(const hit_grid_t * grid, const lv_area_t * area, lv_area_t * cells)
+{
+    cells->x1 = (area->x1 - grid->area.x1) / grid->cell_w;
+    cells->x2 = (area->x2 - grid->area.x1) / grid->cell_w;
+    cells->y1 = (area->y1 - grid->area.y1) / grid->cell_h;
+    cells->y2 = (area->y2 - grid->area.y1) / grid->cell_h;
+}
+
+/**
+ * Find the pressed object among the entries on the point's cell
+ * @param grid pointer to a grid
+ * @param point pointer to a point on the grid's area
+ * @return the same object as the recursive search or NULL if there was no suitable object
+ */
+static lv_obj_t * hit_grid_search(const hit_grid_t * grid, lv_point_t * point)
+{
+    uint32_t c = (uint32_t)((point->y - grid->area.y1) / grid->cell_h) * grid->cols +
+                 (point->x - grid->area.x1) / grid->cell_w;
+    uint32_t i = grid->cell_start[c];
+    uint32_t i_end = grid->cell_start[c + 1];
+    uint32_t w = 0;
+
+    /*Merge the cell's and the wide entries to check them in the order of the recursive search*/
+    while(i < i_end || w < grid->wide_cnt) {
+        uint32_t e;
+        if(w >= grid->wide_cnt || (i < i_end && grid->cell_list[i] < grid->wide_list[w])) e = grid->cell_list[i++];
+        else e = grid->wide_list[w++];
+
+        hit_visit_cnt++;
+
+        const hit_entry_t * entry = &grid->entries[e];
+        if(_lv_area_is_point_on(&entry->area, point, 0) == false) continue;
+        if(obj_takes_click(entry->obj) == false) continue;
+
+        /*The point is on the click area of all parents so only the advanced hit tests are left*/
+        lv_obj_t * par = entry->obj;
+        while(par != NULL) {
+            if(par->adv_hittest && lv_obj_hittest(par, point) == false) break;
+            par = lv_obj_get_parent(par);
+        }
+        if(par == NULL) return entry->obj;
+    }
+
+    return NULL;
+}
+#endif
+
 /**
  * Handle focus/defocus on click for POINTER input devices
  * @param proc pointer to the state of the indev
@@ -21,10 +21,38 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*Number of screens (layers included) which can have a hit index at once*/
+#define _LV_INDEV_HIT_INDEX_SLOTS   4
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * Grid of the clickable objects of a screen to find the pressed object quickly.
+ * Defined even if `LV_INDEV_HIT_INDEX == 0` to keep the GC roots the same.
+ */
+typedef struct {
+    struct _lv_obj_t * root;    /**< The screen or layer the grid belongs to*/
+    void * grid;                /**< The objects, their areas and the cells in one allocation*/
+    uint32_t gen;               /**< Changes of the objects counted when the grid was built*/
+    uint32_t last_use;          /**< Query count at the last use to reuse the slot used the longest ago*/
+} _lv_indev_hit_index_t;
+
+typedef _lv_indev_hit_index_t _lv_indev_hit_index_arr_t[_LV_INDEV_HIT_INDEX_SLOTS];
+
+#if LV_INDEV_HIT_INDEX
+/**
+ * Hit testing information.
+ */
+typedef struct {
+    uint32_t query_cnt;     /**< Number of searches for the pressed object*/
+    uint32_t visit_cnt;     /**< Number of objects checked by the searches*/
+    uint32_t build_cnt;     /**< Number of times a grid was (re)built*/
+    uint32_t visit_avg;     /**< Objects checked per search on average*/
+} lv_indev_hit_monitor_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -164,6 +192,21 @@ lv_obj_t * lv_indev_get_obj_act(void);
  */
 lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point);
 
+#if LV_INDEV_HIT_INDEX
+/**
+ * Mark the hit indexes of all screens outdated and free them.
+ * Called by the objects when they are created, deleted, moved, resized (`LV_SIGNAL_COORD_CHG`)
+ * or their clickability changes.
+ */
+void _lv_indev_hit_index_invalidate(void);
+
+/**
+ * Give information about the searches of the pressed objects since `lv_init`
+ * @param mon_p pointer to a `lv_indev_hit_monitor_t` variable, the result will be stored here
+ */
+void lv_indev_hit_monitor(lv_indev_hit_monitor_t * mon_p);
+#endif
+
 /**
  * Get a pointer to the indev read task to
  * modify its parameters with `lv_task_...` functions.
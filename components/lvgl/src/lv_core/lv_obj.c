@@ -47,6 +47,13 @@
 #define LV_OBJ_DEF_WIDTH    (LV_DPX(100))
 #define LV_OBJ_DEF_HEIGHT   (LV_DPX(50))
 
+#if LV_STYLE_DSC_CACHE
+#define DSC_CACHE_RECT      0x01
+#define DSC_CACHE_LABEL     0x02
+#define DSC_CACHE_IMG       0x04
+#define DSC_CACHE_LINE      0x08
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -110,6 +117,17 @@ typedef enum {
     STYLE_COMPARE_DIFF,
 } style_snapshot_res_t;
 
+#if LV_STYLE_DSC_CACHE
+/*The draw descriptors resolved from a style list in the current state of the object*/
+typedef struct {
+    lv_draw_rect_dsc_t rect;
+    lv_draw_label_dsc_t label;
+    lv_draw_img_dsc_t img;
+    lv_draw_line_dsc_t line;
+    uint8_t valid;      /*OR-ed `DSC_CACHE_...` flags of the descriptors resolved since the last change*/
+} dsc_cache_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -140,8 +158,17 @@ static void obj_del_core(lv_obj_t * obj);
 static void update_style_cache(lv_obj_t * obj, uint8_t part, uint16_t prop);
 static void update_style_cache_children(lv_obj_t * obj);
 static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static bool style_prop_needs_real_refr(lv_style_property_t prop);
 static void style_snapshot(lv_obj_t * obj, uint8_t part, style_snapshot_t * shot);
 static style_snapshot_res_t style_snapshot_compare(style_snapshot_t * shot1, style_snapshot_t * shot2);
+static void init_draw_rect_dsc(lv_obj_t * obj, uint8_t part, lv_draw_rect_dsc_t * draw_dsc);
+static void init_draw_label_dsc(lv_obj_t * obj, uint8_t part, lv_draw_label_dsc_t * draw_dsc);
+static void init_draw_img_dsc(lv_obj_t * obj, uint8_t part, lv_draw_img_dsc_t * draw_dsc);
+static void init_draw_line_dsc(lv_obj_t * obj, uint8_t part, lv_draw_line_dsc_t * draw_dsc);
+#if LV_STYLE_DSC_CACHE
+static dsc_cache_t * dsc_cache_get(lv_obj_t * obj, uint8_t part, uint8_t type);
+static void dsc_cache_invalidate(lv_obj_t * obj, bool children);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -149,6 +176,10 @@ static style_snapshot_res_t style_snapshot_compare(style_snapshot_t * shot1, sty
 static bool lv_initialized = false;
 static lv_event_temp_data_t * event_temp_data_head;
 static const void * event_act_data;
+#if LV_USE_ANIMATION
+static lv_obj_t * trans_inv_obj;    /*The object invalidated last by a transition...*/
+static uint32_t trans_inv_round;    /*...in this animation round*/
+#endif
 
 /**********************
  *      MACROS
@@ -202,6 +233,7 @@ void lv_init(void)
     _lv_ll_init(&LV_GC_ROOT(_lv_obj_style_trans_ll), sizeof(lv_style_trans_t));
 
     _lv_ll_init(&LV_GC_ROOT(_lv_disp_ll), sizeof(lv_disp_t));
+    _lv_ll_pool_init(&LV_GC_ROOT(_lv_obj_ll_pool), sizeof(lv_obj_t));
     _lv_ll_init(&LV_GC_ROOT(_lv_indev_ll), sizeof(lv_indev_t));
 
     lv_theme_t * th = LV_THEME_DEFAULT_INIT(LV_THEME_DEFAULT_COLOR_PRIMARY, LV_THEME_DEFAULT_COLOR_SECONDARY,
@@ -239,6 +271,8 @@ void lv_init(void)
  */
 void lv_deinit(void)
 {
+    /*The fonts would keep pointing to their freed lookup tables*/
+    _lv_font_fmt_txt_lookup_free_all();
     _lv_gc_clear_roots();
 
     lv_disp_set_default(NULL);
@@ -336,7 +370,7 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         }
     }
 
-    _lv_ll_init(&(new_obj->child_ll), sizeof(lv_obj_t));
+    _lv_ll_init_pooled(&(new_obj->child_ll), &LV_GC_ROOT(_lv_obj_ll_pool));
 
     new_obj->ext_draw_pad = 0;
 
@@ -450,6 +484,10 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         }
     }
 
+#if LV_INDEV_HIT_INDEX
+    _lv_indev_hit_index_invalidate();
+#endif
+
     /*Send a signal to the parent to notify it about the new child*/
     if(parent != NULL) {
         parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, new_obj);
@@ -484,6 +522,10 @@ lv_res_t lv_obj_del(lv_obj_t * obj)
 
     obj_del_core(obj);
 
+#if LV_INDEV_HIT_INDEX
+    _lv_indev_hit_index_invalidate();
+#endif
+
     /*Send a signal to the parent to notify it about the child delete*/
     if(par) {
         par->signal_cb(par, LV_SIGNAL_CHILD_CHG, NULL);
@@ -685,6 +727,15 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     _lv_ll_chg_list(&obj->parent->child_ll, &parent->child_ll, obj, true);
     obj->parent = parent;
 
+#if LV_INDEV_HIT_INDEX
+    _lv_indev_hit_index_invalidate();
+#endif
+
+#if LV_STYLE_DSC_CACHE
+    /*The inherited properties come from the new parent*/
+    dsc_cache_invalidate(obj, true);
+#endif
+
     if(new_base_dir != LV_BIDI_DIR_RTL) {
         lv_obj_set_pos(obj, old_pos.x, old_pos.y);
     }
@@ -720,6 +771,10 @@ void lv_obj_move_foreground(lv_obj_t * obj)
 
     _lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, true);
 
+#if LV_INDEV_HIT_INDEX
+    _lv_indev_hit_index_invalidate();
+#endif
+
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
 
@@ -743,6 +798,10 @@ void lv_obj_move_background(lv_obj_t * obj)
 
     _lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, false);
 
+#if LV_INDEV_HIT_INDEX
+    _lv_indev_hit_index_invalidate();
+#endif
+
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
 
@@ -1163,6 +1222,10 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, lv_coord_t left, lv_coord_t right
     (void)top;    /*Unused*/
     (void)bottom; /*Unused*/
 #endif
+
+#if LV_INDEV_HIT_INDEX
+    _lv_indev_hit_index_invalidate();
+#endif
 }
 
 /*---------------------
@@ -1357,8 +1420,13 @@ bool lv_obj_remove_style_local_prop(lv_obj_t * obj, uint8_t part, lv_style_prope
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
     lv_style_t * style = lv_obj_get_local_style(obj, part);
-    if(style) return lv_style_remove_prop(style, prop);
-    else return false;
+    if(style == NULL) return false;
+
+    bool res = lv_style_remove_prop(style, prop);
+#if LV_STYLE_DSC_CACHE
+    if(res) dsc_cache_invalidate(obj, (prop & LV_STYLE_INHERIT_MASK) != 0);
+#endif
+    return res;
 }
 
 /**
@@ -1374,49 +1442,7 @@ void lv_obj_refresh_style(lv_obj_t * obj, uint8_t part, lv_style_property_t prop
     invalidate_style_cache(obj, part, prop);
 
     /*If a real style refresh is required*/
-    bool real_refr = false;
-    switch(prop) {
-        case LV_STYLE_PROP_ALL:
-        case LV_STYLE_CLIP_CORNER:
-        case LV_STYLE_SIZE:
-        case LV_STYLE_TRANSFORM_WIDTH:
-        case LV_STYLE_TRANSFORM_HEIGHT:
-        case LV_STYLE_TRANSFORM_ANGLE:
-        case LV_STYLE_TRANSFORM_ZOOM:
-        case LV_STYLE_PAD_TOP:
-        case LV_STYLE_PAD_BOTTOM:
-        case LV_STYLE_PAD_LEFT:
-        case LV_STYLE_PAD_RIGHT:
-        case LV_STYLE_PAD_INNER:
-        case LV_STYLE_MARGIN_TOP:
-        case LV_STYLE_MARGIN_BOTTOM:
-        case LV_STYLE_MARGIN_LEFT:
-        case LV_STYLE_MARGIN_RIGHT:
-        case LV_STYLE_OUTLINE_WIDTH:
-        case LV_STYLE_OUTLINE_PAD:
-        case LV_STYLE_OUTLINE_OPA:
-        case LV_STYLE_SHADOW_WIDTH:
-        case LV_STYLE_SHADOW_OPA:
-        case LV_STYLE_SHADOW_OFS_X:
-        case LV_STYLE_SHADOW_OFS_Y:
-        case LV_STYLE_SHADOW_SPREAD:
-        case LV_STYLE_VALUE_LETTER_SPACE:
-        case LV_STYLE_VALUE_LINE_SPACE:
-        case LV_STYLE_VALUE_OFS_X:
-        case LV_STYLE_VALUE_OFS_Y:
-        case LV_STYLE_VALUE_ALIGN:
-        case LV_STYLE_VALUE_STR:
-        case LV_STYLE_VALUE_FONT:
-        case LV_STYLE_VALUE_OPA:
-        case LV_STYLE_TEXT_LETTER_SPACE:
-        case LV_STYLE_TEXT_LINE_SPACE:
-        case LV_STYLE_TEXT_FONT:
-        case LV_STYLE_LINE_WIDTH:
-            real_refr = true;
-            break;
-        default:
-            real_refr = false;
-    }
+    bool real_refr = style_prop_needs_real_refr(prop);
 
     if(real_refr) {
         lv_obj_invalidate(obj);
@@ -1513,6 +1539,10 @@ void lv_obj_set_adv_hittest(lv_obj_t * obj, bool en)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
     obj->adv_hittest = en == false ? 0 : 1;
+
+#if LV_INDEV_HIT_INDEX
+    _lv_indev_hit_index_invalidate();
+#endif
 }
 
 /**
@@ -1525,6 +1555,10 @@ void lv_obj_set_click(lv_obj_t * obj, bool en)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
     obj->click = (en == true ? 1 : 0);
+
+#if LV_INDEV_HIT_INDEX
+    _lv_indev_hit_index_invalidate();
+#endif
 }
 
 /**
@@ -1726,6 +1760,11 @@ void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
 
     obj->state = new_state;
 
+#if LV_STYLE_DSC_CACHE
+    /*The snapshots don't contain every property (e.g. the selection colors), so resolve everything again*/
+    dsc_cache_invalidate(obj, true);
+#endif
+
     if(cmp_res == STYLE_COMPARE_SAME) {
         return;
     }
@@ -3276,28 +3315,32 @@ bool lv_obj_is_focused(const lv_obj_t * obj)
  */
 bool lv_obj_is_point_on_coords(lv_obj_t * obj, const lv_point_t * point)
 {
-#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
-    lv_area_t ext_area;
-    ext_area.x1 = obj->coords.x1 - obj->ext_click_pad_hor;
-    ext_area.x2 = obj->coords.x2 + obj->ext_click_pad_hor;
-    ext_area.y1 = obj->coords.y1 - obj->ext_click_pad_ver;
-    ext_area.y2 = obj->coords.y2 + obj->ext_click_pad_ver;
+    lv_area_t click_area;
+    _lv_obj_get_click_area(obj, &click_area);
 
-    if(!_lv_area_is_point_on(&ext_area, point, 0)) {
-#elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
-    lv_area_t ext_area;
-    ext_area.x1 = obj->coords.x1 - obj->ext_click_pad.x1;
-    ext_area.x2 = obj->coords.x2 + obj->ext_click_pad.x2;
-    ext_area.y1 = obj->coords.y1 - obj->ext_click_pad.y1;
-    ext_area.y2 = obj->coords.y2 + obj->ext_click_pad.y2;
+    return _lv_area_is_point_on(&click_area, point, 0);
+}
 
-    if(!_lv_area_is_point_on(&ext_area, point, 0)) {
+/**
+ * Get the area where an object can be clicked: its coordinates with the extended click area
+ * @param obj pointer to an object
+ * @param area the result area will be stored here
+ */
+void _lv_obj_get_click_area(const lv_obj_t * obj, lv_area_t * area)
+{
+#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
+    area->x1 = obj->coords.x1 - obj->ext_click_pad_hor;
+    area->x2 = obj->coords.x2 + obj->ext_click_pad_hor;
+    area->y1 = obj->coords.y1 - obj->ext_click_pad_ver;
+    area->y2 = obj->coords.y2 + obj->ext_click_pad_ver;
+#elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
+    area->x1 = obj->coords.x1 - obj->ext_click_pad.x1;
+    area->x2 = obj->coords.x2 + obj->ext_click_pad.x2;
+    area->y1 = obj->coords.y1 - obj->ext_click_pad.y1;
+    area->y2 = obj->coords.y2 + obj->ext_click_pad.y2;
 #else
-    if(!_lv_area_is_point_on(&obj->coords, point, 0)) {
+    lv_area_copy(area, &obj->coords);
 #endif
-        return false;
-    }
-    return true;
 }
 
 /**
@@ -3347,264 +3390,167 @@ lv_res_t lv_obj_handle_get_type_signal(lv_obj_type_t * buf, const char * name)
  */
 void lv_obj_init_draw_rect_dsc(lv_obj_t * obj, uint8_t part, lv_draw_rect_dsc_t * draw_dsc)
 {
-    draw_dsc->radius = lv_obj_get_style_radius(obj, part);
-
-#if LV_USE_OPA_SCALE
-    lv_opa_t opa_scale = lv_obj_get_style_opa_scale(obj, part);
-    if(opa_scale <= LV_OPA_MIN) {
-        draw_dsc->bg_opa = LV_OPA_TRANSP;
-        draw_dsc->border_opa = LV_OPA_TRANSP;
-        draw_dsc->shadow_opa = LV_OPA_TRANSP;
-        draw_dsc->pattern_opa = LV_OPA_TRANSP;
-        draw_dsc->value_opa = LV_OPA_TRANSP;
+#if LV_STYLE_DSC_CACHE
+    _lv_refr_worker_lock();
+    dsc_cache_t * cache = dsc_cache_get(obj, part, DSC_CACHE_RECT);
+    if(cache) {
+        /*The callers disable some parts by presetting their opacity to `LV_OPA_TRANSP`*/
+        lv_opa_t bg_opa = draw_dsc->bg_opa;
+        lv_opa_t border_opa = draw_dsc->border_opa;
+        lv_opa_t outline_opa = draw_dsc->outline_opa;
+        lv_opa_t pattern_opa = draw_dsc->pattern_opa;
+        lv_opa_t shadow_opa = draw_dsc->shadow_opa;
+        lv_opa_t value_opa = draw_dsc->value_opa;
+        uint8_t border_post = draw_dsc->border_post;
+
+        _lv_memcpy(draw_dsc, &cache->rect, sizeof(lv_draw_rect_dsc_t));
+        _lv_refr_worker_unlock();
+
+        draw_dsc->border_post = border_post;
+        if(bg_opa == LV_OPA_TRANSP) draw_dsc->bg_opa = LV_OPA_TRANSP;
+        if(border_opa == LV_OPA_TRANSP) draw_dsc->border_opa = LV_OPA_TRANSP;
+        if(outline_opa == LV_OPA_TRANSP) draw_dsc->outline_opa = LV_OPA_TRANSP;
+        if(pattern_opa == LV_OPA_TRANSP) draw_dsc->pattern_opa = LV_OPA_TRANSP;
+        if(shadow_opa <= LV_OPA_MIN) draw_dsc->shadow_opa = LV_OPA_TRANSP;
+        if(value_opa <= LV_OPA_MIN) draw_dsc->value_opa = LV_OPA_TRANSP;
         return;
     }
+    _lv_refr_worker_unlock();
 #endif
 
-    if(draw_dsc->bg_opa != LV_OPA_TRANSP) {
-        draw_dsc->bg_opa = lv_obj_get_style_bg_opa(obj, part);
-        if(draw_dsc->bg_opa > LV_OPA_MIN) {
-            draw_dsc->bg_color = lv_obj_get_style_bg_color(obj, part);
-            draw_dsc->bg_grad_dir =  lv_obj_get_style_bg_grad_dir(obj, part);
-            if(draw_dsc->bg_grad_dir != LV_GRAD_DIR_NONE) {
-                draw_dsc->bg_grad_color = lv_obj_get_style_bg_grad_color(obj, part);
-                draw_dsc->bg_main_color_stop =  lv_obj_get_style_bg_main_stop(obj, part);
-                draw_dsc->bg_grad_color_stop =  lv_obj_get_style_bg_grad_stop(obj, part);
-            }
+    init_draw_rect_dsc(obj, part, draw_dsc);
+}
 
+void lv_obj_init_draw_label_dsc(lv_obj_t * obj, uint8_t part, lv_draw_label_dsc_t * draw_dsc)
+{
+#if LV_STYLE_DSC_CACHE
+    _lv_refr_worker_lock();
+    dsc_cache_t * cache = dsc_cache_get(obj, part, DSC_CACHE_LABEL);
+    if(cache) {
+        /*Copy only the fields set from the styles. The others (e.g. selection, offset, flags) are set by the caller*/
+        const lv_draw_label_dsc_t * res = &cache->label;
+        draw_dsc->opa = res->opa;
+        if(res->opa > LV_OPA_MIN) {
+            draw_dsc->color = res->color;
+            draw_dsc->letter_space = res->letter_space;
+            draw_dsc->line_space = res->line_space;
+            draw_dsc->decor = res->decor;
 #if LV_USE_BLEND_MODES
-            draw_dsc->bg_blend_mode = lv_obj_get_style_bg_blend_mode(obj, part);
+            draw_dsc->blend_mode = res->blend_mode;
 #endif
-        }
-    }
-
-    draw_dsc->border_width = lv_obj_get_style_border_width(obj, part);
-    if(draw_dsc->border_width) {
-        if(draw_dsc->border_opa != LV_OPA_TRANSP) {
-            draw_dsc->border_opa = lv_obj_get_style_border_opa(obj, part);
-            if(draw_dsc->border_opa > LV_OPA_MIN) {
-                draw_dsc->border_side = lv_obj_get_style_border_side(obj, part);
-                draw_dsc->border_color = lv_obj_get_style_border_color(obj, part);
+            draw_dsc->font = res->font;
+            if(draw_dsc->sel_start != LV_DRAW_LABEL_NO_TXT_SEL && draw_dsc->sel_end != LV_DRAW_LABEL_NO_TXT_SEL) {
+                draw_dsc->sel_color = res->sel_color;
+                draw_dsc->sel_bg_color = res->sel_bg_color;
             }
-#if LV_USE_BLEND_MODES
-            draw_dsc->border_blend_mode = lv_obj_get_style_border_blend_mode(obj, part);
-#endif
         }
-    }
+        _lv_refr_worker_unlock();
 
-#if LV_USE_OUTLINE
-    draw_dsc->outline_width = lv_obj_get_style_outline_width(obj, part);
-    if(draw_dsc->outline_width) {
-        if(draw_dsc->outline_opa != LV_OPA_TRANSP) {
-            draw_dsc->outline_opa = lv_obj_get_style_outline_opa(obj, part);
-            if(draw_dsc->outline_opa > LV_OPA_MIN) {
-                draw_dsc->outline_pad = lv_obj_get_style_outline_pad(obj, part);
-                draw_dsc->outline_color = lv_obj_get_style_outline_color(obj, part);
-            }
-#if LV_USE_BLEND_MODES
-            draw_dsc->outline_blend_mode = lv_obj_get_style_outline_blend_mode(obj, part);
+#if LV_USE_BIDI
+        /*The base direction is not a style property*/
+        if(draw_dsc->opa > LV_OPA_MIN) draw_dsc->bidi_dir = lv_obj_get_base_dir(obj);
 #endif
-        }
+        return;
     }
+    _lv_refr_worker_unlock();
 #endif
 
-#if LV_USE_PATTERN
-    draw_dsc->pattern_image = lv_obj_get_style_pattern_image(obj, part);
-    if(draw_dsc->pattern_image) {
-        if(draw_dsc->pattern_opa != LV_OPA_TRANSP) {
-            draw_dsc->pattern_opa = lv_obj_get_style_pattern_opa(obj, part);
-            if(draw_dsc->pattern_opa > LV_OPA_MIN) {
-                draw_dsc->pattern_recolor_opa = lv_obj_get_style_pattern_recolor_opa(obj, part);
-                draw_dsc->pattern_repeat = lv_obj_get_style_pattern_repeat(obj, part);
-                if(lv_img_src_get_type(draw_dsc->pattern_image) == LV_IMG_SRC_SYMBOL) {
-                    draw_dsc->pattern_recolor = lv_obj_get_style_pattern_recolor(obj, part);
-                    draw_dsc->pattern_font = lv_obj_get_style_text_font(obj, part);
-                }
-                else if(draw_dsc->pattern_recolor_opa > LV_OPA_MIN) {
-                    draw_dsc->pattern_recolor = lv_obj_get_style_pattern_recolor(obj, part);
-                }
+    init_draw_label_dsc(obj, part, draw_dsc);
+}
+
+void lv_obj_init_draw_img_dsc(lv_obj_t * obj, uint8_t part, lv_draw_img_dsc_t * draw_dsc)
+{
+#if LV_STYLE_DSC_CACHE
+    _lv_refr_worker_lock();
+    dsc_cache_t * cache = dsc_cache_get(obj, part, DSC_CACHE_IMG);
+    if(cache) {
+        const lv_draw_img_dsc_t * res = &cache->img;
+        draw_dsc->opa = res->opa;
+        if(res->opa > LV_OPA_MIN) {
+            draw_dsc->angle = 0;
+            draw_dsc->zoom = LV_IMG_ZOOM_NONE;
+            draw_dsc->recolor_opa = res->recolor_opa;
+            if(res->recolor_opa > 0) draw_dsc->recolor = res->recolor;
 #if LV_USE_BLEND_MODES
-                draw_dsc->pattern_blend_mode = lv_obj_get_style_pattern_blend_mode(obj, part);
+            draw_dsc->blend_mode = res->blend_mode;
 #endif
-            }
         }
-    }
-#endif
+        _lv_refr_worker_unlock();
 
-#if LV_USE_SHADOW
-    draw_dsc->shadow_width = lv_obj_get_style_shadow_width(obj, part);
-    if(draw_dsc->shadow_width) {
-        if(draw_dsc->shadow_opa > LV_OPA_MIN) {
-            draw_dsc->shadow_opa = lv_obj_get_style_shadow_opa(obj, part);
-            if(draw_dsc->shadow_opa > LV_OPA_MIN) {
-                draw_dsc->shadow_ofs_x = lv_obj_get_style_shadow_ofs_x(obj, part);
-                draw_dsc->shadow_ofs_y = lv_obj_get_style_shadow_ofs_y(obj, part);
-                draw_dsc->shadow_spread = lv_obj_get_style_shadow_spread(obj, part);
-                draw_dsc->shadow_color = lv_obj_get_style_shadow_color(obj, part);
-#if LV_USE_BLEND_MODES
-                draw_dsc->shadow_blend_mode = lv_obj_get_style_shadow_blend_mode(obj, part);
-#endif
-            }
+        /*The pivot depends on the size, not on the styles*/
+        if(draw_dsc->opa > LV_OPA_MIN) {
+            draw_dsc->pivot.x = lv_area_get_width(&obj->coords) / 2;
+            draw_dsc->pivot.y = lv_area_get_height(&obj->coords) / 2;
         }
+        return;
     }
+    _lv_refr_worker_unlock();
 #endif
 
-#if LV_USE_VALUE_STR
-    draw_dsc->value_str = lv_obj_get_style_value_str(obj, part);
-    if(draw_dsc->value_str) {
-        if(draw_dsc->value_opa > LV_OPA_MIN) {
-            draw_dsc->value_opa = lv_obj_get_style_value_opa(obj, part);
-            if(draw_dsc->value_opa > LV_OPA_MIN) {
-                draw_dsc->value_ofs_x = lv_obj_get_style_value_ofs_x(obj, part);
-                draw_dsc->value_ofs_y = lv_obj_get_style_value_ofs_y(obj, part);
-                draw_dsc->value_color = lv_obj_get_style_value_color(obj, part);
-                draw_dsc->value_font = lv_obj_get_style_value_font(obj, part);
-                draw_dsc->value_letter_space = lv_obj_get_style_value_letter_space(obj, part);
-                draw_dsc->value_line_space = lv_obj_get_style_value_line_space(obj, part);
-                draw_dsc->value_align = lv_obj_get_style_value_align(obj, part);
+    init_draw_img_dsc(obj, part, draw_dsc);
+}
+
+void lv_obj_init_draw_line_dsc(lv_obj_t * obj, uint8_t part, lv_draw_line_dsc_t * draw_dsc)
+{
+#if LV_STYLE_DSC_CACHE
+    _lv_refr_worker_lock();
+    dsc_cache_t * cache = dsc_cache_get(obj, part, DSC_CACHE_LINE);
+    if(cache) {
+        const lv_draw_line_dsc_t * res = &cache->line;
+        draw_dsc->width = res->width;
+        if(res->width) draw_dsc->opa = res->opa;
+        if(res->width && res->opa > LV_OPA_MIN) {
+            draw_dsc->color = res->color;
+            draw_dsc->dash_width = res->dash_width;
+            if(res->dash_width) draw_dsc->dash_gap = res->dash_gap;
+            draw_dsc->round_start = res->round_start;
+            draw_dsc->round_end = res->round_end;
 #if LV_USE_BLEND_MODES
-                draw_dsc->value_blend_mode = lv_obj_get_style_value_blend_mode(obj, part);
+            draw_dsc->blend_mode = res->blend_mode;
 #endif
-            }
         }
+        _lv_refr_worker_unlock();
+        return;
     }
+    _lv_refr_worker_unlock();
 #endif
 
-#if LV_USE_OPA_SCALE
-    if(opa_scale < LV_OPA_MAX) {
-        draw_dsc->bg_opa = (uint16_t)((uint16_t)draw_dsc->bg_opa * opa_scale) >> 8;
-        draw_dsc->border_opa = (uint16_t)((uint16_t)draw_dsc->border_opa * opa_scale) >> 8;
-        draw_dsc->shadow_opa = (uint16_t)((uint16_t)draw_dsc->shadow_opa * opa_scale) >> 8;
-        draw_dsc->pattern_opa = (uint16_t)((uint16_t)draw_dsc->pattern_opa * opa_scale) >> 8;
-        draw_dsc->value_opa = (uint16_t)((uint16_t)draw_dsc->value_opa * opa_scale) >> 8;
-    }
-#endif
+    init_draw_line_dsc(obj, part, draw_dsc);
 }
 
-void lv_obj_init_draw_label_dsc(lv_obj_t * obj, uint8_t part, lv_draw_label_dsc_t * draw_dsc)
+/**
+ * Get the required extra size (around the object's part) to draw shadow, outline, value etc.
+ * @param obj pointer to an object
+ * @param part part of the object
+ */
+lv_coord_t lv_obj_get_draw_rect_ext_pad_size(lv_obj_t * obj, uint8_t part)
 {
-    draw_dsc->opa = lv_obj_get_style_text_opa(obj, part);
-    if(draw_dsc->opa <= LV_OPA_MIN) return;
+    lv_coord_t s = 0;
 
-#if LV_USE_OPA_SCALE
-    lv_opa_t opa_scale = lv_obj_get_style_opa_scale(obj, part);
-    if(opa_scale < LV_OPA_MAX) {
-        draw_dsc->opa = (uint16_t)((uint16_t)draw_dsc->opa * opa_scale) >> 8;
+    lv_coord_t sh_width = lv_obj_get_style_shadow_width(obj, part);
+    if(sh_width) {
+        lv_opa_t sh_opa = lv_obj_get_style_shadow_opa(obj, part);
+        if(sh_opa > LV_OPA_MIN) {
+            sh_width = sh_width / 2;    /*THe blur adds only half width*/
+            sh_width++;
+            sh_width += lv_obj_get_style_shadow_spread(obj, part);
+            lv_style_int_t sh_ofs_x = lv_obj_get_style_shadow_ofs_x(obj, part);
+            lv_style_int_t sh_ofs_y = lv_obj_get_style_shadow_ofs_y(obj, part);
+            sh_width += LV_MATH_MAX(LV_MATH_ABS(sh_ofs_x), LV_MATH_ABS(sh_ofs_y));
+            s = LV_MATH_MAX(s, sh_width);
+        }
     }
-    if(draw_dsc->opa <= LV_OPA_MIN) return;
-#endif
-
-    draw_dsc->color = lv_obj_get_style_text_color(obj, part);
-    draw_dsc->letter_space = lv_obj_get_style_text_letter_space(obj, part);
-    draw_dsc->line_space = lv_obj_get_style_text_line_space(obj, part);
-    draw_dsc->decor = lv_obj_get_style_text_decor(obj, part);
-#if LV_USE_BLEND_MODES
-    draw_dsc->blend_mode = lv_obj_get_style_text_blend_mode(obj, part);
-#endif
 
-    draw_dsc->font = lv_obj_get_style_text_font(obj, part);
+    const char * value_str = lv_obj_get_style_value_str(obj, part);
+    if(value_str) {
+        lv_opa_t value_opa = lv_obj_get_style_value_opa(obj, part);
+        if(value_opa > LV_OPA_MIN) {
+            lv_style_int_t letter_space = lv_obj_get_style_value_letter_space(obj, part);
+            lv_style_int_t line_space = lv_obj_get_style_value_letter_space(obj, part);
+            const lv_font_t * font = lv_obj_get_style_value_font(obj, part);
 
-    if(draw_dsc->sel_start != LV_DRAW_LABEL_NO_TXT_SEL && draw_dsc->sel_end != LV_DRAW_LABEL_NO_TXT_SEL) {
-        draw_dsc->sel_color = lv_obj_get_style_text_sel_color(obj, part);
-        draw_dsc->sel_bg_color = lv_obj_get_style_text_sel_bg_color(obj, part);
-    }
-
-#if LV_USE_BIDI
-    draw_dsc->bidi_dir = lv_obj_get_base_dir(obj);
-#endif
-}
-
-void lv_obj_init_draw_img_dsc(lv_obj_t * obj, uint8_t part, lv_draw_img_dsc_t * draw_dsc)
-{
-    draw_dsc->opa = lv_obj_get_style_image_opa(obj, part);
-    if(draw_dsc->opa <= LV_OPA_MIN)  return;
-
-#if LV_USE_OPA_SCALE
-    lv_opa_t opa_scale = lv_obj_get_style_opa_scale(obj, part);
-    if(opa_scale < LV_OPA_MAX) {
-        draw_dsc->opa = (uint16_t)((uint16_t)draw_dsc->opa * opa_scale) >> 8;
-    }
-    if(draw_dsc->opa <= LV_OPA_MIN)  return;
-#endif
-
-    draw_dsc->angle = 0;
-    draw_dsc->zoom = LV_IMG_ZOOM_NONE;
-    draw_dsc->pivot.x = lv_area_get_width(&obj->coords) / 2;
-    draw_dsc->pivot.y = lv_area_get_height(&obj->coords) / 2;
-
-    draw_dsc->recolor_opa = lv_obj_get_style_image_recolor_opa(obj, part);
-    if(draw_dsc->recolor_opa > 0) {
-        draw_dsc->recolor = lv_obj_get_style_image_recolor(obj, part);
-    }
-#if LV_USE_BLEND_MODES
-    draw_dsc->blend_mode = lv_obj_get_style_image_blend_mode(obj, part);
-#endif
-}
-
-void lv_obj_init_draw_line_dsc(lv_obj_t * obj, uint8_t part, lv_draw_line_dsc_t * draw_dsc)
-{
-    draw_dsc->width = lv_obj_get_style_line_width(obj, part);
-    if(draw_dsc->width == 0) return;
-
-    draw_dsc->opa = lv_obj_get_style_line_opa(obj, part);
-    if(draw_dsc->opa <= LV_OPA_MIN)  return;
-
-#if LV_USE_OPA_SCALE
-    lv_opa_t opa_scale = lv_obj_get_style_opa_scale(obj, part);
-    if(opa_scale < LV_OPA_MAX) {
-        draw_dsc->opa = (uint16_t)((uint16_t)draw_dsc->opa * opa_scale) >> 8;
-    }
-    if(draw_dsc->opa <= LV_OPA_MIN)  return;
-#endif
-
-    draw_dsc->color = lv_obj_get_style_line_color(obj, part);
-
-    draw_dsc->dash_width = lv_obj_get_style_line_dash_width(obj, part);
-    if(draw_dsc->dash_width) {
-        draw_dsc->dash_gap = lv_obj_get_style_line_dash_gap(obj, part);
-    }
-
-    draw_dsc->round_start = lv_obj_get_style_line_rounded(obj, part);
-    draw_dsc->round_end = draw_dsc->round_start;
-
-#if LV_USE_BLEND_MODES
-    draw_dsc->blend_mode = lv_obj_get_style_line_blend_mode(obj, part);
-#endif
-}
-
-/**
- * Get the required extra size (around the object's part) to draw shadow, outline, value etc.
- * @param obj pointer to an object
- * @param part part of the object
- */
-lv_coord_t lv_obj_get_draw_rect_ext_pad_size(lv_obj_t * obj, uint8_t part)
-{
-    lv_coord_t s = 0;
-
-    lv_coord_t sh_width = lv_obj_get_style_shadow_width(obj, part);
-    if(sh_width) {
-        lv_opa_t sh_opa = lv_obj_get_style_shadow_opa(obj, part);
-        if(sh_opa > LV_OPA_MIN) {
-            sh_width = sh_width / 2;    /*THe blur adds only half width*/
-            sh_width++;
-            sh_width += lv_obj_get_style_shadow_spread(obj, part);
-            lv_style_int_t sh_ofs_x = lv_obj_get_style_shadow_ofs_x(obj, part);
-            lv_style_int_t sh_ofs_y = lv_obj_get_style_shadow_ofs_y(obj, part);
-            sh_width += LV_MATH_MAX(LV_MATH_ABS(sh_ofs_x), LV_MATH_ABS(sh_ofs_y));
-            s = LV_MATH_MAX(s, sh_width);
-        }
-    }
-
-    const char * value_str = lv_obj_get_style_value_str(obj, part);
-    if(value_str) {
-        lv_opa_t value_opa = lv_obj_get_style_value_opa(obj, part);
-        if(value_opa > LV_OPA_MIN) {
-            lv_style_int_t letter_space = lv_obj_get_style_value_letter_space(obj, part);
-            lv_style_int_t line_space = lv_obj_get_style_value_letter_space(obj, part);
-            const lv_font_t * font = lv_obj_get_style_value_font(obj, part);
-
-            lv_point_t txt_size;
-            _lv_txt_get_size(&txt_size, value_str, font, letter_space, line_space, LV_COORD_MAX, LV_TXT_FLAG_NONE);
+            lv_point_t txt_size;
+            _lv_txt_get_size(&txt_size, value_str, font, letter_space, line_space, LV_COORD_MAX, LV_TXT_FLAG_NONE);
 
             lv_area_t value_area;
             value_area.x1 = 0;
@@ -3814,17 +3760,19 @@ static void obj_del_core(lv_obj_t * obj)
 
     /*Remove the object from parent's children list*/
     lv_obj_t * par = lv_obj_get_parent(obj);
+    lv_ll_t * ll;
     if(par == NULL) { /*It is a screen*/
         lv_disp_t * d = lv_obj_get_disp(obj);
-        _lv_ll_remove(&d->scr_ll, obj);
+        ll = &d->scr_ll;
     }
     else {
-        _lv_ll_remove(&(par->child_ll), obj);
+        ll = &par->child_ll;
     }
+    _lv_ll_remove(ll, obj);
 
     /*Delete the base objects*/
     if(obj->ext_attr != NULL) lv_mem_free(obj->ext_attr);
-    lv_mem_free(obj); /*Free the object itself*/
+    _lv_ll_free_node(ll, obj); /*Free the object itself*/
 }
 
 /**
@@ -3981,6 +3929,12 @@ static lv_res_t lv_obj_signal(lv_obj_t * obj, lv_signal_t sign, void * param)
         lv_coord_t d = lv_obj_get_draw_rect_ext_pad_size(obj, LV_OBJ_PART_MAIN);
         obj->ext_draw_pad = LV_MATH_MAX(obj->ext_draw_pad, d);
     }
+#if LV_INDEV_HIT_INDEX
+    else if(sign == LV_SIGNAL_COORD_CHG) {
+        /*Sent also by the widgets which set their coordinates directly (e.g. the fit of `lv_cont`)*/
+        _lv_indev_hit_index_invalidate();
+    }
+#endif
 #if LV_USE_OBJ_REALIGN
     else if(sign == LV_SIGNAL_PARENT_SIZE_CHG) {
         if(obj->realign.auto_realign) {
@@ -4458,8 +4412,19 @@ static void trans_anim_cb(lv_style_trans_t * tr, lv_anim_value_t v)
         else x = tr->end_value._ptr;
         _lv_style_set_ptr(style, tr->prop, x);
     }
-    lv_obj_refresh_style(tr->obj, tr->part, tr->prop);
 
+    /*The transitions of an object usually run together. If an other transition has already
+     *invalidated the object in this round it's enough to drop the cached style values*/
+    uint32_t round = _lv_anim_get_round();
+    if(round != 0 && round == trans_inv_round && tr->obj == trans_inv_obj &&
+       style_prop_needs_real_refr(tr->prop) == false) {
+        invalidate_style_cache(tr->obj, tr->part, tr->prop);
+    }
+    else {
+        lv_obj_refresh_style(tr->obj, tr->part, tr->prop);
+        trans_inv_obj = tr->obj;
+        trans_inv_round = round;
+    }
 }
 
 static void trans_anim_start_cb(lv_anim_t * a)
@@ -4511,6 +4476,9 @@ static void trans_anim_ready_cb(lv_anim_t * a)
         lv_style_list_t * list = lv_obj_get_style_list(tr->obj, tr->part);
         lv_style_t * style_trans = _lv_style_list_get_transition_style(list);
         lv_style_remove_prop(style_trans, tr->prop);
+#if LV_STYLE_DSC_CACHE
+        dsc_cache_invalidate(tr->obj, (tr->prop & LV_STYLE_INHERIT_MASK) != 0);
+#endif
     }
 
     _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
@@ -4525,6 +4493,9 @@ static void opa_scale_anim(lv_obj_t * obj, lv_anim_value_t v)
 static void fade_in_anim_ready(lv_anim_t * a)
 {
     lv_style_remove_prop(lv_obj_get_local_style(a->var, LV_OBJ_PART_MAIN), LV_STYLE_OPA_SCALE);
+#if LV_STYLE_DSC_CACHE
+    dsc_cache_invalidate(a->var, true);
+#endif
 }
 
 #endif
@@ -4725,6 +4696,56 @@ static void update_style_cache_children(lv_obj_t * obj)
 
 }
 
+/**
+ * Tell whether a property can change the size or layout of an object or its children
+ * @param prop a style property
+ * @return true: the object needs a real refresh when `prop` changes; false: invalidating it is enough
+ */
+static bool style_prop_needs_real_refr(lv_style_property_t prop)
+{
+    switch(prop) {
+        case LV_STYLE_PROP_ALL:
+        case LV_STYLE_CLIP_CORNER:
+        case LV_STYLE_SIZE:
+        case LV_STYLE_TRANSFORM_WIDTH:
+        case LV_STYLE_TRANSFORM_HEIGHT:
+        case LV_STYLE_TRANSFORM_ANGLE:
+        case LV_STYLE_TRANSFORM_ZOOM:
+        case LV_STYLE_PAD_TOP:
+        case LV_STYLE_PAD_BOTTOM:
+        case LV_STYLE_PAD_LEFT:
+        case LV_STYLE_PAD_RIGHT:
+        case LV_STYLE_PAD_INNER:
+        case LV_STYLE_MARGIN_TOP:
+        case LV_STYLE_MARGIN_BOTTOM:
+        case LV_STYLE_MARGIN_LEFT:
+        case LV_STYLE_MARGIN_RIGHT:
+        case LV_STYLE_OUTLINE_WIDTH:
+        case LV_STYLE_OUTLINE_PAD:
+        case LV_STYLE_OUTLINE_OPA:
+        case LV_STYLE_SHADOW_WIDTH:
+        case LV_STYLE_SHADOW_OPA:
+        case LV_STYLE_SHADOW_OFS_X:
+        case LV_STYLE_SHADOW_OFS_Y:
+        case LV_STYLE_SHADOW_SPREAD:
+        case LV_STYLE_VALUE_LETTER_SPACE:
+        case LV_STYLE_VALUE_LINE_SPACE:
+        case LV_STYLE_VALUE_OFS_X:
+        case LV_STYLE_VALUE_OFS_Y:
+        case LV_STYLE_VALUE_ALIGN:
+        case LV_STYLE_VALUE_STR:
+        case LV_STYLE_VALUE_FONT:
+        case LV_STYLE_VALUE_OPA:
+        case LV_STYLE_TEXT_LETTER_SPACE:
+        case LV_STYLE_TEXT_LINE_SPACE:
+        case LV_STYLE_TEXT_FONT:
+        case LV_STYLE_LINE_WIDTH:
+            return true;
+        default:
+            return false;
+    }
+}
+
 /**
  * Mark the object and all of it's children's style lists as invalid.
  * The cache will be updated when a cached property asked nest time
@@ -4732,6 +4753,11 @@ static void update_style_cache_children(lv_obj_t * obj)
  */
 static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
+#if LV_STYLE_DSC_CACHE
+    /*The resolved descriptors depend on every property. The children resolve the inherited ones too.*/
+    dsc_cache_invalidate(obj, prop == LV_STYLE_PROP_ALL || (prop & LV_STYLE_INHERIT_MASK));
+#endif
+
     if(style_prop_is_cacheble(prop) == false) return;
 
     for(part = 0; part < _LV_OBJ_PART_REAL_FIRST; part++) {
@@ -4753,6 +4779,316 @@ static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_proper
     }
 }
 
+static void init_draw_rect_dsc(lv_obj_t * obj, uint8_t part, lv_draw_rect_dsc_t * draw_dsc)
+{
+    draw_dsc->radius = lv_obj_get_style_radius(obj, part);
+
+#if LV_USE_OPA_SCALE
+    lv_opa_t opa_scale = lv_obj_get_style_opa_scale(obj, part);
+    if(opa_scale <= LV_OPA_MIN) {
+        draw_dsc->bg_opa = LV_OPA_TRANSP;
+        draw_dsc->border_opa = LV_OPA_TRANSP;
+        draw_dsc->shadow_opa = LV_OPA_TRANSP;
+        draw_dsc->pattern_opa = LV_OPA_TRANSP;
+        draw_dsc->value_opa = LV_OPA_TRANSP;
+        return;
+    }
+#endif
+
+    if(draw_dsc->bg_opa != LV_OPA_TRANSP) {
+        draw_dsc->bg_opa = lv_obj_get_style_bg_opa(obj, part);
+        if(draw_dsc->bg_opa > LV_OPA_MIN) {
+            draw_dsc->bg_color = lv_obj_get_style_bg_color(obj, part);
+            draw_dsc->bg_grad_dir =  lv_obj_get_style_bg_grad_dir(obj, part);
+            if(draw_dsc->bg_grad_dir != LV_GRAD_DIR_NONE) {
+                draw_dsc->bg_grad_color = lv_obj_get_style_bg_grad_color(obj, part);
+                draw_dsc->bg_main_color_stop =  lv_obj_get_style_bg_main_stop(obj, part);
+                draw_dsc->bg_grad_color_stop =  lv_obj_get_style_bg_grad_stop(obj, part);
+            }
+
+#if LV_USE_BLEND_MODES
+            draw_dsc->bg_blend_mode = lv_obj_get_style_bg_blend_mode(obj, part);
+#endif
+        }
+    }
+
+    draw_dsc->border_width = lv_obj_get_style_border_width(obj, part);
+    if(draw_dsc->border_width) {
+        if(draw_dsc->border_opa != LV_OPA_TRANSP) {
+            draw_dsc->border_opa = lv_obj_get_style_border_opa(obj, part);
+            if(draw_dsc->border_opa > LV_OPA_MIN) {
+                draw_dsc->border_side = lv_obj_get_style_border_side(obj, part);
+                draw_dsc->border_color = lv_obj_get_style_border_color(obj, part);
+            }
+#if LV_USE_BLEND_MODES
+            draw_dsc->border_blend_mode = lv_obj_get_style_border_blend_mode(obj, part);
+#endif
+        }
+    }
+
+#if LV_USE_OUTLINE
+    draw_dsc->outline_width = lv_obj_get_style_outline_width(obj, part);
+    if(draw_dsc->outline_width) {
+        if(draw_dsc->outline_opa != LV_OPA_TRANSP) {
+            draw_dsc->outline_opa = lv_obj_get_style_outline_opa(obj, part);
+            if(draw_dsc->outline_opa > LV_OPA_MIN) {
+                draw_dsc->outline_pad = lv_obj_get_style_outline_pad(obj, part);
+                draw_dsc->outline_color = lv_obj_get_style_outline_color(obj, part);
+            }
+#if LV_USE_BLEND_MODES
+            draw_dsc->outline_blend_mode = lv_obj_get_style_outline_blend_mode(obj, part);
+#endif
+        }
+    }
+#endif
+
+#if LV_USE_PATTERN
+    draw_dsc->pattern_image = lv_obj_get_style_pattern_image(obj, part);
+    if(draw_dsc->pattern_image) {
+        if(draw_dsc->pattern_opa != LV_OPA_TRANSP) {
+            draw_dsc->pattern_opa = lv_obj_get_style_pattern_opa(obj, part);
+            if(draw_dsc->pattern_opa > LV_OPA_MIN) {
+                draw_dsc->pattern_recolor_opa = lv_obj_get_style_pattern_recolor_opa(obj, part);
+                draw_dsc->pattern_repeat = lv_obj_get_style_pattern_repeat(obj, part);
+                if(lv_img_src_get_type(draw_dsc->pattern_image) == LV_IMG_SRC_SYMBOL) {
+                    draw_dsc->pattern_recolor = lv_obj_get_style_pattern_recolor(obj, part);
+                    draw_dsc->pattern_font = lv_obj_get_style_text_font(obj, part);
+                }
+                else if(draw_dsc->pattern_recolor_opa > LV_OPA_MIN) {
+                    draw_dsc->pattern_recolor = lv_obj_get_style_pattern_recolor(obj, part);
+                }
+#if LV_USE_BLEND_MODES
+                draw_dsc->pattern_blend_mode = lv_obj_get_style_pattern_blend_mode(obj, part);
+#endif
+            }
+        }
+    }
+#endif
+
+#if LV_USE_SHADOW
+    draw_dsc->shadow_width = lv_obj_get_style_shadow_width(obj, part);
+    if(draw_dsc->shadow_width) {
+        if(draw_dsc->shadow_opa > LV_OPA_MIN) {
+            draw_dsc->shadow_opa = lv_obj_get_style_shadow_opa(obj, part);
+            if(draw_dsc->shadow_opa > LV_OPA_MIN) {
+                draw_dsc->shadow_ofs_x = lv_obj_get_style_shadow_ofs_x(obj, part);
+                draw_dsc->shadow_ofs_y = lv_obj_get_style_shadow_ofs_y(obj, part);
+                draw_dsc->shadow_spread = lv_obj_get_style_shadow_spread(obj, part);
+                draw_dsc->shadow_color = lv_obj_get_style_shadow_color(obj, part);
+#if LV_USE_BLEND_MODES
+                draw_dsc->shadow_blend_mode = lv_obj_get_style_shadow_blend_mode(obj, part);
+#endif
+            }
+        }
+    }
+#endif
+
+#if LV_USE_VALUE_STR
+    draw_dsc->value_str = lv_obj_get_style_value_str(obj, part);
+    if(draw_dsc->value_str) {
+        if(draw_dsc->value_opa > LV_OPA_MIN) {
+            draw_dsc->value_opa = lv_obj_get_style_value_opa(obj, part);
+            if(draw_dsc->value_opa > LV_OPA_MIN) {
+                draw_dsc->value_ofs_x = lv_obj_get_style_value_ofs_x(obj, part);
+                draw_dsc->value_ofs_y = lv_obj_get_style_value_ofs_y(obj, part);
+                draw_dsc->value_color = lv_obj_get_style_value_color(obj, part);
+                draw_dsc->value_font = lv_obj_get_style_value_font(obj, part);
+                draw_dsc->value_letter_space = lv_obj_get_style_value_letter_space(obj, part);
+                draw_dsc->value_line_space = lv_obj_get_style_value_line_space(obj, part);
+                draw_dsc->value_align = lv_obj_get_style_value_align(obj, part);
+#if LV_USE_BLEND_MODES
+                draw_dsc->value_blend_mode = lv_obj_get_style_value_blend_mode(obj, part);
+#endif
+            }
+        }
+    }
+#endif
+
+#if LV_USE_OPA_SCALE
+    if(opa_scale < LV_OPA_MAX) {
+        draw_dsc->bg_opa = (uint16_t)((uint16_t)draw_dsc->bg_opa * opa_scale) >> 8;
+        draw_dsc->border_opa = (uint16_t)((uint16_t)draw_dsc->border_opa * opa_scale) >> 8;
+        draw_dsc->shadow_opa = (uint16_t)((uint16_t)draw_dsc->shadow_opa * opa_scale) >> 8;
+        draw_dsc->pattern_opa = (uint16_t)((uint16_t)draw_dsc->pattern_opa * opa_scale) >> 8;
+        draw_dsc->value_opa = (uint16_t)((uint16_t)draw_dsc->value_opa * opa_scale) >> 8;
+    }
+#endif
+}
+
+static void init_draw_label_dsc(lv_obj_t * obj, uint8_t part, lv_draw_label_dsc_t * draw_dsc)
+{
+    draw_dsc->opa = lv_obj_get_style_text_opa(obj, part);
+    if(draw_dsc->opa <= LV_OPA_MIN) return;
+
+#if LV_USE_OPA_SCALE
+    lv_opa_t opa_scale = lv_obj_get_style_opa_scale(obj, part);
+    if(opa_scale < LV_OPA_MAX) {
+        draw_dsc->opa = (uint16_t)((uint16_t)draw_dsc->opa * opa_scale) >> 8;
+    }
+    if(draw_dsc->opa <= LV_OPA_MIN) return;
+#endif
+
+    draw_dsc->color = lv_obj_get_style_text_color(obj, part);
+    draw_dsc->letter_space = lv_obj_get_style_text_letter_space(obj, part);
+    draw_dsc->line_space = lv_obj_get_style_text_line_space(obj, part);
+    draw_dsc->decor = lv_obj_get_style_text_decor(obj, part);
+#if LV_USE_BLEND_MODES
+    draw_dsc->blend_mode = lv_obj_get_style_text_blend_mode(obj, part);
+#endif
+
+    draw_dsc->font = lv_obj_get_style_text_font(obj, part);
+
+    if(draw_dsc->sel_start != LV_DRAW_LABEL_NO_TXT_SEL && draw_dsc->sel_end != LV_DRAW_LABEL_NO_TXT_SEL) {
+        draw_dsc->sel_color = lv_obj_get_style_text_sel_color(obj, part);
+        draw_dsc->sel_bg_color = lv_obj_get_style_text_sel_bg_color(obj, part);
+    }
+
+#if LV_USE_BIDI
+    draw_dsc->bidi_dir = lv_obj_get_base_dir(obj);
+#endif
+}
+
+static void init_draw_img_dsc(lv_obj_t * obj, uint8_t part, lv_draw_img_dsc_t * draw_dsc)
+{
+    draw_dsc->opa = lv_obj_get_style_image_opa(obj, part);
+    if(draw_dsc->opa <= LV_OPA_MIN)  return;
+
+#if LV_USE_OPA_SCALE
+    lv_opa_t opa_scale = lv_obj_get_style_opa_scale(obj, part);
+    if(opa_scale < LV_OPA_MAX) {
+        draw_dsc->opa = (uint16_t)((uint16_t)draw_dsc->opa * opa_scale) >> 8;
+    }
+    if(draw_dsc->opa <= LV_OPA_MIN)  return;
+#endif
+
+    draw_dsc->angle = 0;
+    draw_dsc->zoom = LV_IMG_ZOOM_NONE;
+    draw_dsc->pivot.x = lv_area_get_width(&obj->coords) / 2;
+    draw_dsc->pivot.y = lv_area_get_height(&obj->coords) / 2;
+
+    draw_dsc->recolor_opa = lv_obj_get_style_image_recolor_opa(obj, part);
+    if(draw_dsc->recolor_opa > 0) {
+        draw_dsc->recolor = lv_obj_get_style_image_recolor(obj, part);
+    }
+#if LV_USE_BLEND_MODES
+    draw_dsc->blend_mode = lv_obj_get_style_image_blend_mode(obj, part);
+#endif
+}
+
+static void init_draw_line_dsc(lv_obj_t * obj, uint8_t part, lv_draw_line_dsc_t * draw_dsc)
+{
+    draw_dsc->width = lv_obj_get_style_line_width(obj, part);
+    if(draw_dsc->width == 0) return;
+
+    draw_dsc->opa = lv_obj_get_style_line_opa(obj, part);
+    if(draw_dsc->opa <= LV_OPA_MIN)  return;
+
+#if LV_USE_OPA_SCALE
+    lv_opa_t opa_scale = lv_obj_get_style_opa_scale(obj, part);
+    if(opa_scale < LV_OPA_MAX) {
+        draw_dsc->opa = (uint16_t)((uint16_t)draw_dsc->opa * opa_scale) >> 8;
+    }
+    if(draw_dsc->opa <= LV_OPA_MIN)  return;
+#endif
+
+    draw_dsc->color = lv_obj_get_style_line_color(obj, part);
+
+    draw_dsc->dash_width = lv_obj_get_style_line_dash_width(obj, part);
+    if(draw_dsc->dash_width) {
+        draw_dsc->dash_gap = lv_obj_get_style_line_dash_gap(obj, part);
+    }
+
+    draw_dsc->round_start = lv_obj_get_style_line_rounded(obj, part);
+    draw_dsc->round_end = draw_dsc->round_start;
+
+#if LV_USE_BLEND_MODES
+    draw_dsc->blend_mode = lv_obj_get_style_line_blend_mode(obj, part);
+#endif
+}
+
+#if LV_STYLE_DSC_CACHE
+/**
+ * Get the resolved draw descriptors of an object's part and resolve the requested one if required.
+ * Call it with `_lv_refr_worker_lock()` taken.
+ * @param obj pointer to an object
+ * @param part part of the object
+ * @param type `DSC_CACHE_RECT/LABEL/IMG/LINE`
+ * @return the resolved descriptors or NULL if they can't be used now
+ */
+static dsc_cache_t * dsc_cache_get(lv_obj_t * obj, uint8_t part, uint8_t type)
+{
+    lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+    if(list == NULL) return NULL;
+
+    /*The style snapshots of the transitions read the styles directly*/
+    if(list->ignore_cache || list->skip_trans) return NULL;
+
+    dsc_cache_t * cache = list->dsc_cache;
+    if(cache == NULL) {
+        cache = lv_mem_alloc(sizeof(dsc_cache_t));
+        if(cache == NULL) return NULL;
+        cache->valid = 0;
+        list->dsc_cache = cache;
+    }
+
+    if(cache->valid & type) return cache;
+
+    switch(type) {
+        case DSC_CACHE_RECT:
+            lv_draw_rect_dsc_init(&cache->rect);
+            init_draw_rect_dsc(obj, part, &cache->rect);
+            break;
+        case DSC_CACHE_LABEL:
+            /*Resolve the selection colors too*/
+            lv_draw_label_dsc_init(&cache->label);
+            cache->label.sel_start = 0;
+            cache->label.sel_end = 1;
+            init_draw_label_dsc(obj, part, &cache->label);
+            break;
+        case DSC_CACHE_IMG:
+            lv_draw_img_dsc_init(&cache->img);
+            init_draw_img_dsc(obj, part, &cache->img);
+            break;
+        case DSC_CACHE_LINE:
+            lv_draw_line_dsc_init(&cache->line);
+            init_draw_line_dsc(obj, part, &cache->line);
+            break;
+    }
+
+    cache->valid |= type;
+    return cache;
+}
+
+/**
+ * Mark the resolved draw descriptors of all parts of an object as outdated
+ * @param obj pointer to an object
+ * @param children true: do the same with all children recursively (for inherited properties)
+ */
+static void dsc_cache_invalidate(lv_obj_t * obj, bool children)
+{
+    uint8_t part;
+    for(part = 0; part < _LV_OBJ_PART_REAL_FIRST; part++) {
+        lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+        if(list == NULL) break;
+        if(list->dsc_cache) ((dsc_cache_t *)list->dsc_cache)->valid = 0;
+    }
+
+    for(part = _LV_OBJ_PART_REAL_FIRST; part < 0xFF; part++) {
+        lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+        if(list == NULL) break;
+        if(list->dsc_cache) ((dsc_cache_t *)list->dsc_cache)->valid = 0;
+    }
+
+    if(children == false) return;
+
+    lv_obj_t * child = lv_obj_get_child(obj, NULL);
+    while(child) {
+        dsc_cache_invalidate(child, true);
+        child = lv_obj_get_child(obj, child);
+    }
+}
+#endif
+
 static void style_snapshot(lv_obj_t * obj, uint8_t part, style_snapshot_t * shot)
 {
     _lv_obj_disable_style_caching(obj, true);
@@ -1342,6 +1342,13 @@ lv_event_cb_t lv_obj_get_event_cb(const lv_obj_t * obj);
  */
 bool lv_obj_is_point_on_coords(lv_obj_t * obj, const lv_point_t * point);
 
+/**
+ * Get the area where an object can be clicked: its coordinates with the extended click area
+ * @param obj pointer to an object
+ * @param area the result area will be stored here
+ */
+void _lv_obj_get_click_area(const lv_obj_t * obj, lv_area_t * area);
+
 /**
  * Hit-test an object given a particular point in screen space.
  * @param obj object to hit-test
@@ -1430,6 +1437,8 @@ lv_res_t lv_obj_handle_get_type_signal(lv_obj_type_t * buf, const char * name);
  * @param draw_dsc the descriptor the initialize
  * @note Only the relevant fields will be set.
  * E.g. if `border width == 0` the other border properties won't be evaluated.
+ * @note Presetting `bg/border/outline/pattern/shadow/value_opa` to `LV_OPA_TRANSP` disables that part
+ * (also if the descriptors are copied from the resolved ones with `LV_STYLE_DSC_CACHE`).
  */
 void lv_obj_init_draw_rect_dsc(lv_obj_t * obj, uint8_t type, lv_draw_rect_dsc_t * draw_dsc);
 
@@ -15,6 +15,7 @@
 #include "../lv_misc/lv_mem.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_debug.h"
 #include "../lv_draw/lv_draw.h"
 #include "../lv_font/lv_font_fmt_txt.h"
 #include "../lv_gpu/lv_gpu_stm32_dma2d.h"
@@ -23,33 +24,105 @@
     #include "../lv_widgets/lv_label.h"
 #endif
 
+#if LV_USE_REFR_ADAPTIVE_BAND
+    #include LV_REFR_TIME_US_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
 /* Draw translucent random colored areas on the invalidated (redrawn) areas*/
 #define MASK_AREA_DEBUG 0
 
+#if LV_USE_REFR_ADAPTIVE_BAND
+#define REFR_TIME_US() ((uint32_t)(LV_REFR_TIME_US_EXPR))
+
+/*Measure a band size on at least this many bands before comparing it to an other*/
+#define BAND_SAMPLES 8
+
+/*Measurements to wait before trying an other size again when the last try wasn't better*/
+#define BAND_HOLD 8
+#endif
+
+#if LV_USE_REFR_OCCLUSION
+#define OCCL_RECT_MAX   8   /*Covered rectangles kept while checking a band*/
+#define OCCL_CULL_MAX   16  /*Objects whose drawing can be skipped or clipped in a band*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_REFR_OCCLUSION
+typedef struct {
+    const lv_obj_t * obj;
+    lv_area_t main_area;    /*Draw the main part only here. Empty (x1 > x2): skip the main part*/
+    uint8_t all : 1;        /*Skip the object with its children*/
+} occl_cull_t;
+
+typedef struct {
+    lv_area_t rects[OCCL_RECT_MAX];     /*Areas covered by the objects checked so far*/
+    occl_cull_t cull[OCCL_CULL_MAX];
+    uint8_t rect_cnt;
+    uint8_t cull_cnt;
+} occl_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_USE_INV_TILES
+static void inv_tiles_mark(lv_disp_t * disp, const lv_area_t * area_p);
+static void lv_refr_tiles_to_areas(void);
+#else
 static void lv_refr_join_area(void);
+#endif
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(const lv_area_t * area_p);
+static void lv_refr_clip(const lv_area_t * clip_p);
+#if LV_USE_REFR_WORKER
+static bool lv_refr_worker_can_split(const lv_area_t * clip_p);
+static void lv_refr_split(const lv_area_t * clip_p);
+static void lv_refr_worker_job(void * clip_p);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
+#if LV_USE_REFR_OCCLUSION
+static void occl_collect(const lv_area_t * clip_p, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr);
+static void occl_younger(lv_obj_t * obj, const lv_area_t * mask_p);
+static void occl_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p, bool occlude);
+static bool occl_get_inner(const lv_obj_t * obj, const lv_area_t * mask_p, lv_area_t * inner);
+static bool occl_clip(const lv_area_t * area_p, lv_area_t * res_p);
+static void occl_rect_add(const lv_area_t * area_p);
+static void occl_cull_add(const lv_obj_t * obj, bool all, const lv_area_t * main_area);
+static const occl_cull_t * occl_cull_find(const lv_obj_t * obj);
+#endif
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
 static void lv_refr_vdb_flush(void);
+static void lv_refr_wait_flushing(lv_disp_buf_t * vdb);
+#if LV_USE_REFR_ADAPTIVE_BAND
+static bool lv_refr_band_can_adapt(void);
+static void lv_refr_band_adapt(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
+static _LV_REFR_LOCAL uint32_t draw_px;     /*Pixels blended in the refresh*/
+#if LV_USE_REFR_OCCLUSION
+    static _LV_REFR_LOCAL occl_t occl;      /*Covered areas and skipped objects of the band being drawn*/
+#endif
+#if LV_USE_REFR_ADAPTIVE_BAND
+    static uint32_t stall_us;
+#endif
 static lv_disp_t * disp_refr; /*Display being refreshed*/
+#if LV_USE_REFR_WORKER
+    static lv_gc_local_roots_t worker_roots;  /*Mask list and buffers of the worker thread*/
+    static lv_area_t worker_clip;            /*The part of the band the worker draws*/
+    static bool worker_busy;
+    static uint32_t worker_draw_px;         /*`draw_px` of the worker's last job*/
+#endif
 #if LV_USE_PERF_MONITOR
     static uint32_t fps_sum_cnt;
     static uint32_t fps_sum_all;
@@ -111,6 +184,9 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         disp->inv_p = 0;
+#if LV_USE_INV_TILES
+        _lv_memset_00(disp->inv_tiles, sizeof(disp->inv_tiles));
+#endif
         return;
     }
 
@@ -129,6 +205,10 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     if(suc != false) {
         if(disp->driver.rounder_cb) disp->driver.rounder_cb(&disp->driver, &com_area);
 
+#if LV_USE_INV_TILES
+        inv_tiles_mark(disp, &com_area);
+        disp->inv_p = 1;
+#else
         /*Save only if this area is not in one of the saved areas*/
         uint16_t i;
         for(i = 0; i < disp->inv_p; i++) {
@@ -144,10 +224,46 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
             lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
         }
         disp->inv_p++;
+#endif
         lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
     }
 }
 
+#if LV_USE_INV_TILES
+/**
+ * Choose the tile height for a display from its buffer. Called on driver registration and update.
+ * @param disp pointer to a display
+ */
+void _lv_refr_inv_tiles_init(lv_disp_t * disp)
+{
+    lv_disp_buf_t * vdb = disp->driver.buffer;
+    lv_coord_t hor_res = lv_disp_get_hor_res(disp);
+    lv_coord_t band_h;
+
+    if(lv_disp_is_true_double_buf(disp)) band_h = lv_disp_get_ver_res(disp);
+    else band_h = hor_res > 0 ? vdb->size / hor_res : 0;
+    if(band_h > lv_disp_get_ver_res(disp)) band_h = lv_disp_get_ver_res(disp);
+
+    /*Smallest divisor of the band height which is still at least LV_INV_TILE_H
+     *or, for very short bands, the smallest multiple of it*/
+    lv_coord_t tile_h = LV_INV_TILE_H;
+    if(band_h >= LV_INV_TILE_H) {
+        while(band_h % tile_h) tile_h++;
+    }
+    else if(band_h > 0) {
+        tile_h = ((LV_INV_TILE_H + band_h - 1) / band_h) * band_h;
+    }
+
+    disp->inv_tile_h = tile_h;
+
+    /*The map is sized from LV_HOR_RES_MAX and LV_VER_RES_MAX. On a larger display the last column and row
+     *would take the rest of the screen, which works but invalidates much more than needed.*/
+    LV_DEBUG_ASSERT((hor_res + LV_INV_TILE_W - 1) / LV_INV_TILE_W <= _LV_INV_TILE_COL_MAX &&
+                    (lv_disp_get_ver_res(disp) + tile_h - 1) / tile_h <= _LV_INV_TILE_ROW_MAX,
+                    "The display is larger than LV_HOR_RES_MAX x LV_VER_RES_MAX", hor_res);
+}
+#endif
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -157,6 +273,15 @@ lv_disp_t * _lv_refr_get_disp_refreshing(void)
     return disp_refr;
 }
 
+/**
+ * Count pixels blended while refreshing a display. The drawing functions call it.
+ * @param px number of pixels
+ */
+void _lv_refr_add_draw_px(uint32_t px)
+{
+    draw_px += px;
+}
+
 /**
  * Set the display which is being refreshed.
  * It shouldn't be used directly by the user.
@@ -168,6 +293,34 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp)
     disp_refr = disp;
 }
 
+#if LV_USE_REFR_WORKER
+/**
+ * Take the display driver's lock while the worker thread renders too. Do nothing otherwise.
+ * Guards the state shared by the rendering threads, e.g. the heap and the image cache.
+ */
+void _lv_refr_worker_lock(void)
+{
+    if(worker_busy) disp_refr->driver.worker_lock_cb(&disp_refr->driver, true);
+}
+
+/**
+ * Give back the lock taken by `_lv_refr_worker_lock`
+ */
+void _lv_refr_worker_unlock(void)
+{
+    if(worker_busy) disp_refr->driver.worker_lock_cb(&disp_refr->driver, false);
+}
+
+/**
+ * Tell if the worker thread is rendering too
+ * @return true: an other thread might draw the same objects now
+ */
+bool _lv_refr_worker_busy(void)
+{
+    return worker_busy;
+}
+#endif
+
 /**
  * Called periodically to handle the refreshing
  * @param task pointer to the task itself
@@ -190,11 +343,15 @@ void _lv_disp_refr_task(lv_task_t * task)
 
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
-        disp_refr->inv_p = 0;
+        _lv_inv_area(disp_refr, NULL);
         return;
     }
 
+#if LV_USE_INV_TILES
+    lv_refr_tiles_to_areas();
+#else
     lv_refr_join_area();
+#endif
 
     lv_refr_areas();
 
@@ -262,6 +419,11 @@ void _lv_disp_refr_task(lv_task_t * task)
         _lv_memset_00(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
         _lv_memset_00(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
         disp_refr->inv_p = 0;
+        disp_refr->refr_px_num = px_num;
+        disp_refr->refr_draw_px_num = draw_px;
+#if LV_USE_REFR_ADAPTIVE_BAND
+        disp_refr->refr_stall_us = stall_us;
+#endif
 
         elaps = lv_tick_elaps(start);
         /*Call monitor cb if present*/
@@ -270,6 +432,12 @@ void _lv_disp_refr_task(lv_task_t * task)
         }
     }
 
+#if LV_USE_REFR_WORKER
+    /*The worker is idle now, release its buffers too*/
+    _lv_gc_local_roots = &worker_roots;
+    _lv_mem_buf_free_all();
+    _lv_gc_local_roots = NULL;
+#endif
     _lv_mem_buf_free_all();
     _lv_font_clean_up_fmt_txt();
 
@@ -332,6 +500,121 @@ uint32_t lv_refr_get_fps_avg(void)
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_USE_INV_TILES
+/**
+ * Set the bits of the tiles an area touches.
+ * The parts of a display larger than the map are marked in the last column and row.
+ * @param disp pointer to the display
+ * @param area_p the area, already clipped to the screen
+ */
+static void inv_tiles_mark(lv_disp_t * disp, const lv_area_t * area_p)
+{
+    uint32_t col2 = LV_MATH_MIN(area_p->x2 / LV_INV_TILE_W, _LV_INV_TILE_COL_MAX - 1);
+    uint32_t row2 = LV_MATH_MIN(area_p->y2 / disp->inv_tile_h, _LV_INV_TILE_ROW_MAX - 1);
+    uint32_t col1 = LV_MATH_MIN((uint32_t)(area_p->x1 / LV_INV_TILE_W), col2);
+    uint32_t row1 = LV_MATH_MIN((uint32_t)(area_p->y1 / disp->inv_tile_h), row2);
+    uint32_t w;
+
+    for(w = col1 >> 5; w <= col2 >> 5; w++) {
+        /*Bits of this word from `col1` to `col2`*/
+        uint32_t mask = 0xFFFFFFFF;
+        if(w == col1 >> 5) mask &= 0xFFFFFFFF << (col1 & 0x1F);
+        if(w == col2 >> 5) mask &= 0xFFFFFFFF >> (31 - (col2 & 0x1F));
+
+        uint32_t row;
+        for(row = row1; row <= row2; row++) {
+            disp->inv_tiles[row][w] |= mask;
+        }
+    }
+}
+
+/**
+ * Turn the dirty tiles into rectangles in `inv_areas`.
+ * Each tile row is cut into runs of dirty tiles and a run continues the
+ * area above it if that area covers exactly the same columns.
+ * The result is a few rectangles with no pixel drawn twice.
+ */
+static void lv_refr_tiles_to_areas(void)
+{
+    lv_disp_t * disp = disp_refr;
+    if(disp->inv_p == 0) return;
+
+    lv_coord_t hor_res = lv_disp_get_hor_res(disp);
+    lv_coord_t ver_res = lv_disp_get_ver_res(disp);
+    lv_coord_t tile_h = disp->inv_tile_h;
+    uint32_t col_cnt = LV_MATH_MIN((hor_res + LV_INV_TILE_W - 1) / LV_INV_TILE_W, _LV_INV_TILE_COL_MAX);
+    uint32_t row_cnt = LV_MATH_MIN((ver_res + tile_h - 1) / tile_h, _LV_INV_TILE_ROW_MAX);
+    uint32_t row;
+    uint32_t area_cnt = 0;
+
+    for(row = 0; row < row_cnt; row++) {
+        uint32_t * bits = disp->inv_tiles[row];
+        uint32_t col = 0;
+        while(col < col_cnt) {
+            if(bits[col >> 5] == 0 && (col & 0x1F) == 0) {
+                col += 32;
+                continue;
+            }
+            if((bits[col >> 5] & (1UL << (col & 0x1F))) == 0) {
+                col++;
+                continue;
+            }
+
+            uint32_t col_start = col;
+            while(col < col_cnt && (bits[col >> 5] & (1UL << (col & 0x1F)))) col++;
+
+            /*The last column and row reach the edge of the screen, even if it's larger than the map*/
+            lv_area_t a;
+            a.x1 = col_start * LV_INV_TILE_W;
+            a.x2 = (col == col_cnt ? (uint32_t)hor_res : col * LV_INV_TILE_W) - 1;
+            a.y1 = row * tile_h;
+            a.y2 = (row == row_cnt - 1 ? (uint32_t)ver_res : (row + 1) * tile_h) - 1;
+
+            /*Continue an area of the previous row with the same columns*/
+            uint32_t i;
+            for(i = 0; i < area_cnt; i++) {
+                lv_area_t * prev = &disp->inv_areas[i];
+                if(prev->y2 == a.y1 - 1 && prev->x1 == a.x1 && prev->x2 == a.x2) {
+                    prev->y2 = a.y2;
+                    break;
+                }
+            }
+            if(i < area_cnt) continue;
+
+            if(area_cnt < LV_INV_BUF_SIZE) {
+                lv_area_copy(&disp->inv_areas[area_cnt], &a);
+                area_cnt++;
+            }
+            else {
+                /*Out of rectangles: grow the one which gets the least bigger*/
+                uint32_t best = 0;
+                uint32_t best_grow = UINT32_MAX;
+                for(i = 0; i < area_cnt; i++) {
+                    lv_area_t joined;
+                    _lv_area_join(&joined, &disp->inv_areas[i], &a);
+                    uint32_t grow = lv_area_get_size(&joined) - lv_area_get_size(&disp->inv_areas[i]);
+                    if(grow < best_grow) {
+                        best_grow = grow;
+                        best = i;
+                    }
+                }
+                _lv_area_join(&disp->inv_areas[best], &disp->inv_areas[best], &a);
+            }
+        }
+    }
+
+    /*The tiles might not be aligned to the display's rounding rules*/
+    if(disp->driver.rounder_cb) {
+        uint32_t i;
+        for(i = 0; i < area_cnt; i++) disp->driver.rounder_cb(&disp->driver, &disp->inv_areas[i]);
+    }
+
+    _lv_memset_00(disp->inv_area_joined, sizeof(disp->inv_area_joined));
+    _lv_memset_00(disp->inv_tiles, sizeof(disp->inv_tiles));
+    disp->inv_p = area_cnt;
+}
+
+#else
 /**
  * Join the areas which has got common parts
  */
@@ -368,6 +651,7 @@ static void lv_refr_join_area(void)
         }
     }
 }
+#endif
 
 /**
  * Refresh the joined areas
@@ -375,9 +659,17 @@ static void lv_refr_join_area(void)
 static void lv_refr_areas(void)
 {
     px_num = 0;
+    draw_px = 0;
+#if LV_USE_REFR_ADAPTIVE_BAND
+    stall_us = 0;
+#endif
 
     if(disp_refr->inv_p == 0) return;
 
+#if LV_USE_REFR_ADAPTIVE_BAND
+    uint32_t refr_start = REFR_TIME_US();
+#endif
+
     /*Find the last area which will be drawn*/
     int32_t i;
     int32_t last_i = 0;
@@ -402,6 +694,13 @@ static void lv_refr_areas(void)
             px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
         }
     }
+
+#if LV_USE_REFR_ADAPTIVE_BAND
+    /*The last band is still being flushed. Assume it takes as long as the previous one.*/
+    disp_refr->band_sum_us += REFR_TIME_US() - refr_start + disp_refr->driver.buffer->flush_time;
+    disp_refr->band_sum_px += px_num;
+    lv_refr_band_adapt();
+#endif
 }
 
 /**
@@ -430,7 +729,11 @@ static void lv_refr_area(const lv_area_t * area_p)
         lv_coord_t y2 =
             area_p->y2 >= lv_disp_get_ver_res(disp_refr) ? lv_disp_get_ver_res(disp_refr) - 1 : area_p->y2;
 
-        int32_t max_row = (uint32_t)vdb->size / w;
+        uint32_t band_px = vdb->size;
+#if LV_USE_REFR_ADAPTIVE_BAND
+        if(disp_refr->band_px != 0 && disp_refr->band_px < band_px) band_px = disp_refr->band_px;
+#endif
+        int32_t max_row = band_px / w;
 
         if(max_row > h) max_row = h;
 
@@ -503,25 +806,49 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     /*In non double buffered mode, before rendering the next part wait until the previous image is
      * flushed*/
     if(lv_disp_is_double_buf(disp_refr) == false) {
-        while(vdb->flushing) {
-            if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
-        }
+        lv_refr_wait_flushing(vdb);
     }
 
-    lv_obj_t * top_act_scr = NULL;
-    lv_obj_t * top_prev_scr = NULL;
-
     /*Get the new mask from the original area and the act. VDB
      It will be a part of 'area_p'*/
     lv_area_t start_mask;
     _lv_area_intersect(&start_mask, area_p, &vdb->area);
 
+#if LV_USE_REFR_WORKER
+    if(lv_refr_worker_can_split(&start_mask)) lv_refr_split(&start_mask);
+    else lv_refr_clip(&start_mask);
+#else
+    lv_refr_clip(&start_mask);
+#endif
+
+    /* In true double buffered mode flush only once when all areas were rendered.
+     * In normal mode flush after every area */
+    if(lv_disp_is_true_double_buf(disp_refr) == false) {
+        lv_refr_vdb_flush();
+    }
+}
+
+/**
+ * Draw the screens and the layers on a part of the VDB
+ * @param clip_p the area to draw, it's on the VDB
+ */
+static void lv_refr_clip(const lv_area_t * clip_p)
+{
+    lv_obj_t * top_act_scr = NULL;
+    lv_obj_t * top_prev_scr = NULL;
+    lv_area_t start_mask;
+    lv_area_copy(&start_mask, clip_p);
+
     /*Get the most top object which is not covered by others*/
     top_act_scr = lv_refr_get_top_obj(&start_mask, lv_disp_get_scr_act(disp_refr));
     if(disp_refr->prev_scr) {
         top_prev_scr = lv_refr_get_top_obj(&start_mask, disp_refr->prev_scr);
     }
 
+#if LV_USE_REFR_OCCLUSION
+    occl_collect(&start_mask, top_act_scr, top_prev_scr);
+#endif
+
     /*Draw a display background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
         if(disp_refr->bg_img) {
@@ -569,13 +896,61 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     /*Also refresh top and sys layer unconditionally*/
     lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
     lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
+}
 
-    /* In true double buffered mode flush only once when all areas were rendered.
-     * In normal mode flush after every area */
-    if(lv_disp_is_true_double_buf(disp_refr) == false) {
-        lv_refr_vdb_flush();
-    }
+#if LV_USE_REFR_WORKER
+/**
+ * Tell if a part of the VDB can be drawn by two threads
+ * @param clip_p the area to draw
+ * @return true: split it with `lv_refr_split`
+ */
+static bool lv_refr_worker_can_split(const lv_area_t * clip_p)
+{
+    lv_disp_drv_t * drv = &disp_refr->driver;
+    if(drv->worker_start_cb == NULL || drv->worker_wait_cb == NULL || drv->worker_lock_cb == NULL) return false;
+
+    /*The layout of the buffer is unknown*/
+    if(drv->set_px_cb) return false;
+
+    return lv_area_get_height(clip_p) >= 2 * LV_REFR_WORKER_MIN_ROWS;
+}
+
+/**
+ * Draw the top half of an area on this thread and the bottom half on the worker.
+ * The halves are disjoint lines of the VDB so the threads never write the same pixel.
+ * @param clip_p the area to draw, it's on the VDB
+ */
+static void lv_refr_split(const lv_area_t * clip_p)
+{
+    lv_area_t clip_top;
+    lv_area_copy(&clip_top, clip_p);
+    lv_area_copy(&worker_clip, clip_p);
+    clip_top.y2 = clip_p->y1 + lv_area_get_height(clip_p) / 2 - 1;
+    worker_clip.y1 = clip_top.y2 + 1;
+
+    worker_busy = true;
+    disp_refr->driver.worker_start_cb(&disp_refr->driver, lv_refr_worker_job, &worker_clip);
+    lv_refr_clip(&clip_top);
+    disp_refr->driver.worker_wait_cb(&disp_refr->driver);
+    worker_busy = false;
+    draw_px += worker_draw_px;
+
+    _lv_mem_buf_join_stat(&worker_roots._lv_mem_buf);
+}
+
+/**
+ * Runs on the worker thread
+ * @param clip_p the area to draw
+ */
+static void lv_refr_worker_job(void * clip_p)
+{
+    _lv_gc_local_roots = &worker_roots;
+    draw_px = 0;
+    lv_refr_clip(clip_p);
+    worker_draw_px = draw_px;
+    _lv_gc_local_roots = NULL;
 }
+#endif
 
 /**
  * Search the most top object which fully covers an area
@@ -619,6 +994,289 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
     return found_p;
 }
 
+#if LV_USE_REFR_OCCLUSION
+/**
+ * Collect the parts of an area which are covered by opaque objects and
+ * mark the objects which are drawn under them. `lv_refr_obj` uses the marks to skip or clip the drawing.
+ * The objects are checked in the reverse order of the drawing.
+ * @param clip_p the area to draw, it's on the VDB
+ * @param top_act_scr the top object of the active screen or NULL
+ * @param top_prev_scr the top object of the previous screen or NULL
+ */
+static void occl_collect(const lv_area_t * clip_p, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr)
+{
+    occl.rect_cnt = 0;
+    occl.cull_cnt = 0;
+
+    if(top_act_scr == NULL) top_act_scr = disp_refr->act_scr;
+    if(disp_refr->prev_scr && top_prev_scr == NULL) top_prev_scr = disp_refr->prev_scr;
+
+    lv_obj_t * tops[4];
+    tops[0] = lv_disp_get_layer_sys(disp_refr);
+    tops[1] = lv_disp_get_layer_top(disp_refr);
+    tops[2] = top_act_scr;
+    tops[3] = top_prev_scr;
+
+    uint8_t i;
+    for(i = 0; i < sizeof(tops) / sizeof(tops[0]); i++) {
+        if(tops[i] == NULL) continue;
+        occl_younger(tops[i], clip_p);
+        occl_obj(tops[i], clip_p, true);
+    }
+}
+
+/**
+ * Check the 'younger' siblings of an object and of its parents,
+ * i.e. the objects `lv_refr_obj_and_children` draws after the object.
+ * @param obj pointer to an object
+ * @param mask_p pointer to an area, the objects will be drawn only here
+ */
+static void occl_younger(lv_obj_t * obj, const lv_area_t * mask_p)
+{
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    if(par == NULL) return;
+
+    /*The younger siblings of the parent are drawn after the siblings of `obj`*/
+    occl_younger(par, mask_p);
+
+    lv_obj_t * i = _lv_ll_get_head(&par->child_ll);
+    while(i != NULL && i != obj) {
+        occl_obj(i, mask_p, true);
+        i = _lv_ll_get_next(&par->child_ll, i);
+    }
+}
+
+/**
+ * Check an object and its children in the reverse order of `lv_refr_obj`.
+ * Mark the object if the already collected areas cover it and add the area it covers.
+ * @param obj pointer to an object
+ * @param mask_ori_p pointer to an area, the object will be drawn only here
+ * @param occlude false: the object can't cover the others (e.g. a parent masks it)
+ */
+static void occl_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p, bool occlude)
+{
+    if(obj->hidden != 0) return;
+
+    lv_area_t obj_area;
+    lv_area_t obj_ext_mask;
+    lv_coord_t ext_size = obj->ext_draw_pad;
+    lv_obj_get_coords(obj, &obj_area);
+    obj_area.x1 -= ext_size;
+    obj_area.y1 -= ext_size;
+    obj_area.x2 += ext_size;
+    obj_area.y2 += ext_size;
+    if(_lv_area_intersect(&obj_ext_mask, mask_ori_p, &obj_area) == false) return;
+
+    /*Skip the object with its children if the objects drawn later cover it*/
+    lv_area_t visible;
+    if(occl_clip(&obj_ext_mask, &visible) == false) {
+        occl_cull_add(obj, true, NULL);
+        return;
+    }
+
+    lv_design_res_t design_res = LV_DESIGN_RES_NOT_COVER;
+    lv_area_t inner;
+    bool inner_ok = false;
+    lv_area_t obj_mask;
+    if(_lv_area_intersect(&obj_mask, mask_ori_p, &obj->coords)) {
+        inner_ok = occl_get_inner(obj, &obj_mask, &inner);
+        if(obj->design_cb) {
+            design_res = obj->design_cb(obj, inner_ok ? &inner : &obj_mask, LV_DESIGN_COVER_CHK);
+        }
+#if LV_USE_OPA_SCALE
+        if(design_res == LV_DESIGN_RES_COVER && lv_obj_get_style_opa_scale(obj, LV_OBJ_PART_MAIN) != LV_OPA_COVER) {
+            design_res = LV_DESIGN_RES_NOT_COVER;
+        }
+#endif
+
+        /*The children of a masked object are drawn only where the mask lets them*/
+        bool child_occlude = occlude;
+        if(design_res == LV_DESIGN_RES_MASKED || lv_obj_get_style_clip_corner(obj, LV_OBJ_PART_MAIN)) {
+            child_occlude = false;
+        }
+
+        lv_area_t mask_child;
+        lv_area_t child_area;
+        lv_obj_t * child_p;
+        _LV_LL_READ(obj->child_ll, child_p) {
+            lv_obj_get_coords(child_p, &child_area);
+            ext_size = child_p->ext_draw_pad;
+            child_area.x1 -= ext_size;
+            child_area.y1 -= ext_size;
+            child_area.x2 += ext_size;
+            child_area.y2 += ext_size;
+            if(_lv_area_intersect(&mask_child, &obj_mask, &child_area)) {
+                occl_obj(child_p, &mask_child, child_occlude);
+            }
+        }
+    }
+
+    /*The children might cover the main part too.
+     *The main part of a masked object stays visible because its children were not collected*/
+    if(occl_clip(&obj_ext_mask, &visible) == false) {
+        occl_cull_add(obj, false, NULL);
+    }
+    else if(visible.x1 != obj_ext_mask.x1 || visible.y1 != obj_ext_mask.y1 ||
+            visible.x2 != obj_ext_mask.x2 || visible.y2 != obj_ext_mask.y2) {
+        occl_cull_add(obj, false, &visible);
+    }
+
+    if(occlude && inner_ok && design_res == LV_DESIGN_RES_COVER) occl_rect_add(&inner);
+}
+
+/**
+ * Get the largest rectangle of an object which can't be on a rounded corner.
+ * @param obj pointer to an object
+ * @param mask_p the part of the object to check
+ * @param inner store the rectangle here
+ * @return false: the rectangle is not on `mask_p`
+ */
+static bool occl_get_inner(const lv_obj_t * obj, const lv_area_t * mask_p, lv_area_t * inner)
+{
+    lv_coord_t w = lv_obj_get_width(obj);
+    lv_coord_t h = lv_obj_get_height(obj);
+    lv_coord_t r = lv_obj_get_style_radius(obj, LV_OBJ_PART_MAIN);
+    lv_coord_t short_side = LV_MATH_MIN(w, h);
+    if(r > short_side / 2) r = short_side / 2;
+
+    /*`_lv_area_is_in` checks the corners with the row/column of the radius too*/
+    lv_coord_t d = r > 0 ? r + 1 : 0;
+
+    lv_area_t bar;
+    lv_area_t hor;
+    lv_area_t ver;
+    lv_area_set(&bar, obj->coords.x1, obj->coords.y1 + d, obj->coords.x2, obj->coords.y2 - d);
+    bool hor_ok = _lv_area_intersect(&hor, mask_p, &bar);
+    if(d == 0) {
+        if(hor_ok) lv_area_copy(inner, &hor);
+        return hor_ok;
+    }
+
+    lv_area_set(&bar, obj->coords.x1 + d, obj->coords.y1, obj->coords.x2 - d, obj->coords.y2);
+    bool ver_ok = _lv_area_intersect(&ver, mask_p, &bar);
+
+    if(hor_ok && (!ver_ok || lv_area_get_size(&hor) >= lv_area_get_size(&ver))) lv_area_copy(inner, &hor);
+    else if(ver_ok) lv_area_copy(inner, &ver);
+
+    return hor_ok || ver_ok;
+}
+
+/**
+ * Remove the parts of an area which are covered by the collected rectangles.
+ * Only the rectangles which span a whole side of the area can make it smaller.
+ * @param area_p pointer to an area
+ * @param res_p store the remaining area here
+ * @return false: the area is fully covered
+ */
+static bool occl_clip(const lv_area_t * area_p, lv_area_t * res_p)
+{
+    lv_area_copy(res_p, area_p);
+
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        uint8_t i;
+        for(i = 0; i < occl.rect_cnt; i++) {
+            const lv_area_t * r = &occl.rects[i];
+            if(r->x1 <= res_p->x1 && r->x2 >= res_p->x2) {
+                if(r->y1 <= res_p->y1 && r->y2 >= res_p->y1) {
+                    res_p->y1 = r->y2 + 1;
+                    changed = true;
+                }
+                else if(r->y1 <= res_p->y2 && r->y2 >= res_p->y2) {
+                    res_p->y2 = r->y1 - 1;
+                    changed = true;
+                }
+            }
+            else if(r->y1 <= res_p->y1 && r->y2 >= res_p->y2) {
+                if(r->x1 <= res_p->x1 && r->x2 >= res_p->x1) {
+                    res_p->x1 = r->x2 + 1;
+                    changed = true;
+                }
+                else if(r->x1 <= res_p->x2 && r->x2 >= res_p->x2) {
+                    res_p->x2 = r->x1 - 1;
+                    changed = true;
+                }
+            }
+
+            if(res_p->x1 > res_p->x2 || res_p->y1 > res_p->y2) return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Save an area which is covered by an opaque object.
+ * If there is no free slot the smallest area is replaced.
+ * @param area_p pointer to an area
+ */
+static void occl_rect_add(const lv_area_t * area_p)
+{
+    uint8_t i;
+    for(i = 0; i < occl.rect_cnt; i++) {
+        if(_lv_area_is_in(area_p, &occl.rects[i], 0)) return;
+    }
+
+    /*Remove the areas which are in the new one*/
+    i = 0;
+    while(i < occl.rect_cnt) {
+        if(_lv_area_is_in(&occl.rects[i], area_p, 0)) {
+            occl.rect_cnt--;
+            lv_area_copy(&occl.rects[i], &occl.rects[occl.rect_cnt]);
+        }
+        else i++;
+    }
+
+    if(occl.rect_cnt < OCCL_RECT_MAX) {
+        lv_area_copy(&occl.rects[occl.rect_cnt], area_p);
+        occl.rect_cnt++;
+        return;
+    }
+
+    uint8_t min_i = 0;
+    for(i = 1; i < OCCL_RECT_MAX; i++) {
+        if(lv_area_get_size(&occl.rects[i]) < lv_area_get_size(&occl.rects[min_i])) min_i = i;
+    }
+
+    if(lv_area_get_size(&occl.rects[min_i]) < lv_area_get_size(area_p)) lv_area_copy(&occl.rects[min_i], area_p);
+}
+
+/**
+ * Mark an object to skip or clip its drawing. Nothing happens if there is no free slot.
+ * @param obj pointer to an object
+ * @param all true: skip the object with its children
+ * @param main_area draw the main part only here. NULL: skip the main part
+ */
+static void occl_cull_add(const lv_obj_t * obj, bool all, const lv_area_t * main_area)
+{
+    if(occl.cull_cnt >= OCCL_CULL_MAX) return;
+
+    occl_cull_t * c = &occl.cull[occl.cull_cnt];
+    c->obj = obj;
+    c->all = all ? 1 : 0;
+    if(main_area) lv_area_copy(&c->main_area, main_area);
+    else lv_area_set(&c->main_area, 0, 0, -1, -1);
+
+    occl.cull_cnt++;
+}
+
+/**
+ * Get the mark of an object
+ * @param obj pointer to an object
+ * @return pointer to the mark or NULL if the object is drawn normally
+ */
+static const occl_cull_t * occl_cull_find(const lv_obj_t * obj)
+{
+    uint8_t i;
+    for(i = 0; i < occl.cull_cnt; i++) {
+        if(occl.cull[i].obj == obj) return &occl.cull[i];
+    }
+
+    return NULL;
+}
+#endif
+
 /**
  * Make the refreshing from an object. Draw all its children and the youngers too.
  * @param top_p pointer to an objects. Start the drawing from it.
@@ -673,6 +1331,12 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
     /*Do not refresh hidden objects*/
     if(obj->hidden != 0) return;
 
+#if LV_USE_REFR_OCCLUSION
+    /*Do not refresh the objects covered by the ones drawn later*/
+    const occl_cull_t * cull = occl_cull_find(obj);
+    if(cull && cull->all) return;
+#endif
+
     bool union_ok; /* Store the return value of area_union */
     /* Truncate the original mask to the coordinates of the parent
      * because the parent and its children are visible only here */
@@ -691,7 +1355,13 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
     if(union_ok != false) {
 
         /* Redraw the object */
-        if(obj->design_cb) obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
+        lv_area_t main_mask;
+        lv_area_copy(&main_mask, &obj_ext_mask);
+#if LV_USE_REFR_OCCLUSION
+        /*Only a part or nothing is visible if the children or the objects drawn later cover the rest*/
+        if(cull) union_ok = _lv_area_intersect(&main_mask, &obj_ext_mask, &cull->main_area);
+#endif
+        if(union_ok && obj->design_cb) obj->design_cb(obj, &main_mask, LV_DESIGN_DRAW_MAIN);
 
 #if MASK_AREA_DEBUG
         static lv_color_t debug_color = LV_COLOR_RED;
@@ -909,9 +1579,7 @@ static void lv_refr_vdb_flush(void)
     /*In double buffered mode wait until the other buffer is flushed before flushing the current
      * one*/
     if(lv_disp_is_double_buf(disp_refr)) {
-        while(vdb->flushing) {
-            if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
-        }
+        lv_refr_wait_flushing(vdb);
     }
 
     vdb->flushing = 1;
@@ -923,6 +1591,10 @@ static void lv_refr_vdb_flush(void)
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
     if(disp->driver.gpu_wait_cb) disp->driver.gpu_wait_cb(&disp->driver);
 
+#if LV_USE_REFR_ADAPTIVE_BAND
+    vdb->flush_start = REFR_TIME_US();
+#endif
+
     if(disp->driver.flush_cb) {
         /*Rotate the buffer to the display's native orientation if necessary*/
         if(disp->driver.rotated != LV_DISP_ROT_NONE && disp->driver.sw_rotate) {
@@ -938,3 +1610,111 @@ static void lv_refr_vdb_flush(void)
             vdb->buf_act = vdb->buf1;
     }
 }
+
+/**
+ * Wait until the flushing of the VDB is finished
+ * @param vdb pointer to the VDB of the display being refreshed
+ */
+static void lv_refr_wait_flushing(lv_disp_buf_t * vdb)
+{
+#if LV_USE_REFR_ADAPTIVE_BAND
+    if(vdb->flushing) {
+        uint32_t wait_start = REFR_TIME_US();
+        while(vdb->flushing) {
+            if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
+        }
+        stall_us += REFR_TIME_US() - wait_start;
+    }
+#else
+    while(vdb->flushing) {
+        if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
+    }
+#endif
+}
+
+#if LV_USE_REFR_ADAPTIVE_BAND
+/**
+ * Tell whether drawing a band overlaps with flushing the previous one on the display being refreshed
+ * @return true: the band size can be adjusted
+ */
+static bool lv_refr_band_can_adapt(void)
+{
+    if(lv_disp_is_double_buf(disp_refr) == false) return false;
+
+    /*Only one band per frame*/
+    if(lv_disp_is_true_double_buf(disp_refr)) return false;
+
+    /*The rotated chunks are flushed one after the other while drawing waits*/
+    if(disp_refr->driver.rotated != LV_DISP_ROT_NONE && disp_refr->driver.sw_rotate) return false;
+
+    return true;
+}
+
+/**
+ * Adjust the size of the bands to the measured refresh time.
+ * Smaller bands let the display start sooner and shorten the flush of the last band
+ * but have more overhead per pixel in drawing and flushing, and more waiting if the flushing is slower.
+ * The best size depends on the display, the driver and the screen's content so step by step
+ * sizes are tried and kept if they refresh faster.
+ */
+static void lv_refr_band_adapt(void)
+{
+    lv_disp_t * disp = disp_refr;
+    uint32_t size = lv_disp_get_buf(disp)->size;
+
+    if(lv_refr_band_can_adapt() == false) {
+        disp->band_px = 0;
+        disp->band_sum_us = 0;
+        disp->band_sum_px = 0;
+        return;
+    }
+
+    if(disp->band_px == 0) {
+        disp->band_px = size;
+        disp->band_base_px = size;
+        disp->band_base_cost = 0;
+        disp->band_dir = -1;
+        disp->band_hold = 0;
+    }
+
+    if(disp->band_sum_px < BAND_SAMPLES * disp->band_px) return;
+
+    uint32_t cost = (uint32_t)(((uint64_t)disp->band_sum_us << 16) / disp->band_sum_px);
+    disp->band_sum_us = 0;
+    disp->band_sum_px = 0;
+
+    if(disp->band_px != disp->band_base_px) {
+        /*Keep the new size only if it's faster by more than the noise*/
+        if(cost + cost / 16 < disp->band_base_cost) {
+            disp->band_base_px = disp->band_px;
+            disp->band_base_cost = cost;
+        }
+        else {
+            disp->band_px = disp->band_base_px;
+            disp->band_dir = -disp->band_dir;
+            disp->band_hold = BAND_HOLD;
+        }
+        return;
+    }
+
+    disp->band_base_cost = cost;
+    if(disp->band_hold > 0) {
+        disp->band_hold--;
+        return;
+    }
+
+    /*Try a 25% smaller or larger band*/
+    uint32_t hres = lv_disp_get_hor_res(disp);
+    uint32_t rows_max = size / hres;
+    uint32_t rows_min = LV_MATH_MIN(LV_REFR_BAND_MIN_ROWS, rows_max);
+    uint32_t rows = disp->band_px / hres;
+    if(disp->band_dir < 0 && rows <= rows_min) disp->band_dir = 1;
+    else if(disp->band_dir > 0 && rows >= rows_max) disp->band_dir = -1;
+
+    uint32_t step = LV_MATH_MAX(rows / 4, 1);
+    if(disp->band_dir < 0) rows = rows > rows_min + step ? rows - step : rows_min;
+    else rows += step;
+
+    disp->band_px = LV_MATH_MIN(rows * hres, size);
+}
+#endif
@@ -64,12 +64,26 @@ void lv_refr_now(lv_disp_t * disp);
  */
 void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
 
+#if LV_USE_INV_TILES
+/**
+ * Choose the tile height for a display from its buffer. Called on driver registration and update.
+ * @param disp pointer to a display
+ */
+void _lv_refr_inv_tiles_init(lv_disp_t * disp);
+#endif
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
  */
 lv_disp_t * _lv_refr_get_disp_refreshing(void);
 
+/**
+ * Count pixels blended while refreshing a display. The drawing functions call it.
+ * @param px number of pixels
+ */
+void _lv_refr_add_draw_px(uint32_t px);
+
 /**
  * Set the display which is being refreshed.
  * It shouldn't be used directly by the user.
@@ -78,6 +92,29 @@ lv_disp_t * _lv_refr_get_disp_refreshing(void);
  */
 void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 
+#if LV_USE_REFR_WORKER
+/**
+ * Take the display driver's lock while the worker thread renders too. Do nothing otherwise.
+ * Guards the state shared by the rendering threads, e.g. the heap and the image cache.
+ */
+void _lv_refr_worker_lock(void);
+
+/**
+ * Give back the lock taken by `_lv_refr_worker_lock`
+ */
+void _lv_refr_worker_unlock(void);
+
+/**
+ * Tell if the worker thread is rendering too
+ * @return true: an other thread might draw the same objects now
+ */
+bool _lv_refr_worker_busy(void);
+#else
+#define _lv_refr_worker_lock()
+#define _lv_refr_worker_unlock()
+#define _lv_refr_worker_busy() false
+#endif
+
 #if LV_USE_PERF_MONITOR
 /**
  * Get the average FPS since start up
@@ -17,17 +17,42 @@
  *      TYPEDEFS
  **********************/
 
+/* The properties are sorted by their ID in the map of a style.
+ * (The same ID in different states follow each other.)*/
+
+#if LV_STYLE_INDEX
+/* The map starts with an index to find the properties without walking the map:
+ * - `style_index_t`
+ * - a `style_index_group_t` for each group having properties
+ * - the byte index of each different property ID in the map (`uint16_t`)*/
+typedef struct {
+    uint16_t group_mask;    /*Bit `g` is set if there are properties with `0xg0..0xgF` ID*/
+    uint16_t props_ofs;     /*Byte index of the first property in the map (the size of the index)*/
+} style_index_t;
+
+typedef struct {
+    uint16_t id_mask;       /*Bit `i` is set if the property with `0xgi` ID is in the style*/
+    uint16_t slot;          /*Number of different property IDs in the groups before*/
+} style_index_group_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 LV_ATTRIBUTE_FAST_MEM static inline int32_t get_property_index(const lv_style_t * style, lv_style_property_t prop);
 static lv_style_t * get_alloc_local_style(lv_style_list_t * list);
-static inline bool style_resize(lv_style_t * style, size_t sz);
+static bool style_rebuild(lv_style_t * style, size_t pos, const void * ins, size_t ins_size, size_t del_size);
+static void map_move(uint8_t * dst, const uint8_t * src, size_t len);
+static void style_add_prop(lv_style_t * style, lv_style_property_t prop, const void * value, size_t value_size);
+static inline size_t get_props_start(const lv_style_t * style);
 static inline lv_style_property_t get_style_prop(const lv_style_t * style, size_t idx);
 static inline uint8_t get_style_prop_id(const lv_style_t * style, size_t idx);
 static inline uint8_t get_style_prop_attr(const lv_style_t * style, size_t idx);
 static inline size_t get_prop_size(uint8_t prop_id);
 static inline size_t get_next_prop_index(uint8_t prop_id, size_t id);
+#if LV_STYLE_INDEX
+static inline uint32_t bit_cnt(uint32_t x);
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -93,18 +118,7 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_property_t prop)
         attr_goal = (prop >> 8) & 0xFFU;
 
         if(LV_STYLE_ATTR_GET_STATE(attr_found) == LV_STYLE_ATTR_GET_STATE(attr_goal)) {
-            uint32_t map_size = _lv_style_get_mem_size(style);
-            uint8_t prop_size = get_prop_size(prop);
-
-            /*Move the props to fill the space of the property to delete*/
-            uint32_t i;
-            for(i = id; i < map_size - prop_size; i++) {
-                style->map[i] = style->map[i + prop_size];
-            }
-
-            style_resize(style, map_size - prop_size);
-
-            return true;
+            return style_rebuild(style, id, NULL, 0, get_prop_size(prop));
         }
     }
 
@@ -294,6 +308,10 @@ void _lv_style_list_reset(lv_style_list_t * list)
 
     if(list->style_cnt > 0) lv_mem_free(list->style_list);
     list->style_list = NULL;
+#if LV_STYLE_DSC_CACHE
+    lv_mem_free(list->dsc_cache);
+    list->dsc_cache = NULL;
+#endif
     list->style_cnt = 0;
     list->has_local = 0;
     list->has_trans = 0;
@@ -324,7 +342,7 @@ uint16_t _lv_style_get_mem_size(const lv_style_t * style)
 
     if(style == NULL || style->map == NULL) return 0;
 
-    size_t i = 0;
+    size_t i = get_props_start(style);
     uint8_t prop_id;
     while((prop_id = get_style_prop_id(style, i)) != _LV_STYLE_CLOSING_PROP) {
         i = get_next_prop_index(prop_id, i);
@@ -361,19 +379,7 @@ void _lv_style_set_int(lv_style_t * style, lv_style_property_t prop, lv_style_in
     }
 
     /*Add new property if not exists yet*/
-    uint8_t new_prop_size = sizeof(lv_style_property_t) + sizeof(lv_style_int_t);
-    lv_style_property_t end_mark = _LV_STYLE_CLOSING_PROP;
-    uint8_t end_mark_size = sizeof(end_mark);
-
-    uint16_t size = _lv_style_get_mem_size(style);
-    if(size == 0) size += end_mark_size;
-
-    size += new_prop_size;
-    if(!style_resize(style, size)) return;
-
-    _lv_memcpy_small(style->map + size - new_prop_size - end_mark_size, &prop, sizeof(lv_style_property_t));
-    _lv_memcpy_small(style->map + size - sizeof(lv_style_int_t) - end_mark_size, &value, sizeof(lv_style_int_t));
-    _lv_memcpy_small(style->map + size - end_mark_size, &end_mark, sizeof(end_mark));
+    style_add_prop(style, prop, &value, sizeof(lv_style_int_t));
 }
 
 /**
@@ -404,19 +410,7 @@ void _lv_style_set_color(lv_style_t * style, lv_style_property_t prop, lv_color_
     }
 
     /*Add new property if not exists yet*/
-    uint8_t new_prop_size = sizeof(lv_style_property_t) + sizeof(lv_color_t);
-    lv_style_property_t end_mark = _LV_STYLE_CLOSING_PROP;
-    uint8_t end_mark_size = sizeof(end_mark);
-
-    uint16_t size = _lv_style_get_mem_size(style);
-    if(size == 0) size += end_mark_size;
-
-    size += new_prop_size;
-    if(!style_resize(style, size)) return;
-
-    _lv_memcpy_small(style->map + size - new_prop_size - end_mark_size, &prop, sizeof(lv_style_property_t));
-    _lv_memcpy_small(style->map + size - sizeof(lv_color_t) - end_mark_size, &color, sizeof(lv_color_t));
-    _lv_memcpy_small(style->map + size - end_mark_size, &end_mark, sizeof(end_mark));
+    style_add_prop(style, prop, &color, sizeof(lv_color_t));
 }
 
 /**
@@ -447,19 +441,7 @@ void _lv_style_set_opa(lv_style_t * style, lv_style_property_t prop, lv_opa_t op
     }
 
     /*Add new property if not exists yet*/
-    uint8_t new_prop_size = sizeof(lv_style_property_t) + sizeof(lv_opa_t);
-    lv_style_property_t end_mark = _LV_STYLE_CLOSING_PROP;
-    uint8_t end_mark_size = sizeof(end_mark);
-
-    uint16_t size = _lv_style_get_mem_size(style);
-    if(size == 0) size += end_mark_size;
-
-    size += new_prop_size;
-    if(!style_resize(style, size)) return;
-
-    _lv_memcpy_small(style->map + size - new_prop_size - end_mark_size, &prop, sizeof(lv_style_property_t));
-    _lv_memcpy_small(style->map + size - sizeof(lv_opa_t) - end_mark_size, &opa, sizeof(lv_opa_t));
-    _lv_memcpy_small(style->map + size - end_mark_size, &end_mark, sizeof(end_mark));
+    style_add_prop(style, prop, &opa, sizeof(lv_opa_t));
 }
 
 /**
@@ -490,19 +472,7 @@ void _lv_style_set_ptr(lv_style_t * style, lv_style_property_t prop, const void
     }
 
     /*Add new property if not exists yet*/
-    uint8_t new_prop_size = sizeof(lv_style_property_t) + sizeof(const void *);
-    lv_style_property_t end_mark = _LV_STYLE_CLOSING_PROP;
-    uint8_t end_mark_size = sizeof(end_mark);
-
-    uint16_t size = _lv_style_get_mem_size(style);
-    if(size == 0) size += end_mark_size;
-
-    size += new_prop_size;
-    if(!style_resize(style, size)) return;
-
-    _lv_memcpy_small(style->map + size - new_prop_size - end_mark_size, &prop, sizeof(lv_style_property_t));
-    _lv_memcpy_small(style->map + size - sizeof(const void *) - end_mark_size, &p, sizeof(const void *));
-    _lv_memcpy_small(style->map + size - end_mark_size, &end_mark, sizeof(end_mark));
+    style_add_prop(style, prop, &p, sizeof(const void *));
 }
 
 /**
@@ -999,35 +969,54 @@ LV_ATTRIBUTE_FAST_MEM static inline int32_t get_property_index(const lv_style_t
     lv_style_attr_t attr;
     attr = (prop >> 8) & 0xFF;
 
+#if LV_STYLE_INDEX
+    /*Reject the missing properties by the bits of the group and the ID*/
+    const style_index_t * index = (const style_index_t *)style->map;
+    uint32_t group_bit = 1UL << (id_to_find >> 4);
+    if((index->group_mask & group_bit) == 0) return -1;
+
+    const style_index_group_t * groups = (const style_index_group_t *)(index + 1);
+    const style_index_group_t * group = &groups[bit_cnt(index->group_mask & (group_bit - 1))];
+    uint32_t id_bit = 1UL << (id_to_find & 0xF);
+    if((group->id_mask & id_bit) == 0) return -1;
+
+    /*Get the first entry of the property and check its states*/
+    const uint16_t * prop_index = (const uint16_t *)(groups + bit_cnt(index->group_mask));
+    size_t i = prop_index[group->slot + bit_cnt(group->id_mask & (id_bit - 1))];
+#else
+    /*The properties are sorted so stop at the first larger ID*/
+    size_t i = 0;
+    uint8_t prop_id;
+    while((prop_id = get_style_prop_id(style, i)) < id_to_find) {
+        i = get_next_prop_index(prop_id, i);
+    }
+    if(prop_id != id_to_find) return -1;
+#endif
+
     int16_t weight = -1;
     int16_t id_guess = -1;
 
-    size_t i = 0;
-
-    uint8_t prop_id;
-    while((prop_id = get_style_prop_id(style, i)) != _LV_STYLE_CLOSING_PROP) {
-        if(prop_id == id_to_find) {
-            lv_style_attr_t attr_i;
-            attr_i = get_style_prop_attr(style, i);
+    do {
+        lv_style_attr_t attr_i;
+        attr_i = get_style_prop_attr(style, i);
 
-            /*If the state perfectly matches return this property*/
-            if(LV_STYLE_ATTR_GET_STATE(attr_i) == LV_STYLE_ATTR_GET_STATE(attr)) {
-                return i;
-            }
-            /* Be sure the property not specifies other state than the requested.
-             * E.g. For HOVER+PRESS, HOVER only is OK, but HOVER+FOCUS not*/
-            else if((LV_STYLE_ATTR_GET_STATE(attr_i) & (~LV_STYLE_ATTR_GET_STATE(attr))) == 0) {
-                /* Use this property if it describes better the requested state than the current candidate.
-                 * E.g. for HOVER+FOCUS+PRESS prefer HOVER+FOCUS over FOCUS*/
-                if(LV_STYLE_ATTR_GET_STATE(attr_i) > weight) {
-                    weight = LV_STYLE_ATTR_GET_STATE(attr_i);
-                    id_guess = i;
-                }
+        /*If the state perfectly matches return this property*/
+        if(LV_STYLE_ATTR_GET_STATE(attr_i) == LV_STYLE_ATTR_GET_STATE(attr)) {
+            return i;
+        }
+        /* Be sure the property not specifies other state than the requested.
+         * E.g. For HOVER+PRESS, HOVER only is OK, but HOVER+FOCUS not*/
+        else if((LV_STYLE_ATTR_GET_STATE(attr_i) & (~LV_STYLE_ATTR_GET_STATE(attr))) == 0) {
+            /* Use this property if it describes better the requested state than the current candidate.
+             * E.g. for HOVER+FOCUS+PRESS prefer HOVER+FOCUS over FOCUS*/
+            if(LV_STYLE_ATTR_GET_STATE(attr_i) > weight) {
+                weight = LV_STYLE_ATTR_GET_STATE(attr_i);
+                id_guess = i;
             }
         }
 
-        i = get_next_prop_index(prop_id, i);
-    }
+        i = get_next_prop_index(id_to_find, i);
+    } while(get_style_prop_id(style, i) == id_to_find);
 
     return id_guess;
 }
@@ -1059,18 +1048,191 @@ static lv_style_t * get_alloc_local_style(lv_style_list_t * list)
 }
 
 /**
- * Resizes a style map. Useful entry point for debugging.
- * @param style pointer to the style to be resized.
- * @param size new size
+ * Rebuild the map of a style with a property inserted and/or removed.
+ * The index is recreated for the new properties.
+ * @param style pointer to a style
+ * @param pos where to insert and remove (byte index of a property in `style->map`)
+ * @param ins the property to insert (ID and value) or `NULL`
+ * @param ins_size size of `ins` in bytes
+ * @param del_size number of bytes to remove from `pos`
+ * @return true: the map is rebuilt; false: out of memory, the style is not changed
  */
-static inline bool style_resize(lv_style_t * style, size_t sz)
+static bool style_rebuild(lv_style_t * style, size_t pos, const void * ins, size_t ins_size, size_t del_size)
 {
-    uint8_t * new_map = lv_mem_realloc(style->map, sz);
-    if(sz && new_map == NULL) return false;
-    style->map = new_map;
+    size_t start = get_props_start(style);
+    size_t end = style->map ? _lv_style_get_mem_size(style) - sizeof(lv_style_property_t) : 0;
+
+    size_t props_size = end - start - del_size + ins_size;
+    if(props_size == 0) {
+        lv_mem_free(style->map);
+        style->map = NULL;
+        return true;
+    }
+
+#if LV_STYLE_INDEX
+    /*Collect the IDs of the new properties*/
+    uint16_t id_masks[16];
+    _lv_memset_00(id_masks, sizeof(id_masks));
+    if(ins) {
+        lv_style_property_t ins_prop;
+        _lv_memcpy_small(&ins_prop, ins, sizeof(lv_style_property_t));
+        id_masks[(ins_prop & 0xFF) >> 4] |= 1 << (ins_prop & 0xF);
+    }
+
+    size_t i = start;
+    while(i < end) {
+        if(i == pos && del_size) {
+            i += del_size;
+            continue;
+        }
+        uint8_t prop_id = get_style_prop_id(style, i);
+        id_masks[prop_id >> 4] |= 1 << (prop_id & 0xF);
+        i = get_next_prop_index(prop_id, i);
+    }
+
+    style_index_t index;
+    uint32_t group_cnt = 0;
+    uint32_t id_cnt = 0;
+    index.group_mask = 0;
+    uint32_t g;
+    for(g = 0; g < 16; g++) {
+        if(id_masks[g] == 0) continue;
+        index.group_mask |= 1 << g;
+        group_cnt++;
+        id_cnt += bit_cnt(id_masks[g]);
+    }
+    index.props_ofs = sizeof(style_index_t) + group_cnt * sizeof(style_index_group_t) + id_cnt * sizeof(uint16_t);
+    size_t index_size = index.props_ofs;
+#else
+    size_t index_size = 0;
+#endif
+
+    /*Move the properties before and after `pos` in place to make room for the index and `ins`*/
+    size_t old_size = end + sizeof(lv_style_property_t);
+    size_t new_size = index_size + props_size + sizeof(lv_style_property_t);
+    uint8_t * map = style->map;
+    if(map == NULL) {
+        /*Start from a map having only the closing property*/
+        map = lv_mem_alloc(new_size);
+        LV_ASSERT_MEM(map);
+        if(map == NULL) return false;
+        lv_style_property_t end_mark = _LV_STYLE_CLOSING_PROP;
+        _lv_memcpy_small(map, &end_mark, sizeof(end_mark));
+    }
+    else if(new_size > old_size) {
+        map = lv_mem_realloc(map, new_size);
+        LV_ASSERT_MEM(map);
+        if(map == NULL) return false;
+    }
+
+    int32_t head_shift = (int32_t)index_size - (int32_t)start;
+    int32_t tail_shift = head_shift + (int32_t)ins_size - (int32_t)del_size;
+    if(tail_shift >= head_shift) {
+        map_move(map + pos + del_size + tail_shift, map + pos + del_size, old_size - pos - del_size);
+        map_move(map + start + head_shift, map + start, pos - start);
+    }
+    else {
+        map_move(map + start + head_shift, map + start, pos - start);
+        map_move(map + pos + del_size + tail_shift, map + pos + del_size, old_size - pos - del_size);
+    }
+    if(ins) _lv_memcpy_small(map + pos + head_shift, ins, ins_size);
+
+    if(new_size < old_size) {
+        uint8_t * new_map = lv_mem_realloc(map, new_size);
+        if(new_map) map = new_map;
+    }
+    style->map = map;
+
+#if LV_STYLE_INDEX
+    /*Create the index*/
+    _lv_memcpy_small(map, &index, sizeof(index));
+    style_index_group_t * groups = (style_index_group_t *)(map + sizeof(style_index_t));
+    uint16_t slot = 0;
+    for(g = 0; g < 16; g++) {
+        if(id_masks[g] == 0) continue;
+        groups->id_mask = id_masks[g];
+        groups->slot = slot;
+        slot += bit_cnt(id_masks[g]);
+        groups++;
+    }
+
+    uint16_t * prop_index = (uint16_t *)groups;
+    uint8_t prev_id = _LV_STYLE_CLOSING_PROP;
+    uint8_t prop_id;
+    i = index.props_ofs;
+    while((prop_id = get_style_prop_id(style, i)) != _LV_STYLE_CLOSING_PROP) {
+        if(prop_id != prev_id) {
+            *prop_index = i;
+            prop_index++;
+            prev_id = prop_id;
+        }
+        i = get_next_prop_index(prop_id, i);
+    }
+#endif
+
     return true;
 }
 
+/**
+ * Move bytes in a map. The source and destination can overlap.
+ * @param dst where to move
+ * @param src what to move
+ * @param len number of bytes to move
+ */
+static void map_move(uint8_t * dst, const uint8_t * src, size_t len)
+{
+    size_t i;
+    if(dst < src) {
+        for(i = 0; i < len; i++) dst[i] = src[i];
+    }
+    else if(dst > src) {
+        for(i = len; i > 0; i--) dst[i - 1] = src[i - 1];
+    }
+}
+
+/**
+ * Add a new property to a style after the properties with the same or lower ID.
+ * @param style pointer to a style
+ * @param prop a style property ORed with a state.
+ * @param value pointer to the value
+ * @param value_size size of the value
+ */
+static void style_add_prop(lv_style_t * style, lv_style_property_t prop, const void * value, size_t value_size)
+{
+    uint8_t new_prop[sizeof(lv_style_property_t) + sizeof(const void *)];
+    _lv_memcpy_small(new_prop, &prop, sizeof(lv_style_property_t));
+    _lv_memcpy_small(new_prop + sizeof(lv_style_property_t), value, value_size);
+
+    size_t pos = get_props_start(style);
+    if(style->map) {
+        uint8_t prop_id;
+        while((prop_id = get_style_prop_id(style, pos)) != _LV_STYLE_CLOSING_PROP && prop_id <= (prop & 0xFF)) {
+            pos = get_next_prop_index(prop_id, pos);
+        }
+    }
+
+    style_rebuild(style, pos, new_prop, sizeof(lv_style_property_t) + value_size, 0);
+}
+
+/**
+ * Get where the properties start in the map of a style (after the index)
+ * @param style pointer to style
+ * @return byte index of the first property in `style->map`, 0 if there is no map
+ */
+static inline size_t get_props_start(const lv_style_t * style)
+{
+#if LV_STYLE_INDEX
+    if(style->map == NULL) return 0;
+
+    style_index_t index;
+    _lv_memcpy_small(&index, style->map, sizeof(style_index_t));
+    return index.props_ofs;
+#else
+    LV_UNUSED(style);
+    return 0;
+#endif
+}
+
 /**
  * Get style property in index.
  * @param style pointer to style.
@@ -1132,3 +1294,24 @@ static inline size_t get_next_prop_index(uint8_t prop_id, size_t idx)
 {
     return idx + get_prop_size(prop_id);
 }
+
+#if LV_STYLE_INDEX
+/**
+ * Count the set bits
+ * @param x a value
+ * @return number of 1 bits in `x`
+ */
+static inline uint32_t bit_cnt(uint32_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_popcount(x);
+#else
+    uint32_t cnt = 0;
+    while(x) {
+        x &= x - 1;
+        cnt++;
+    }
+    return cnt;
+#endif
+}
+#endif
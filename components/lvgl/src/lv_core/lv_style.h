@@ -221,6 +221,9 @@ typedef struct {
     lv_style_t ** style_list;
 #if LV_USE_ASSERT_STYLE
     uint32_t sentinel;
+#endif
+#if LV_STYLE_DSC_CACHE
+    void * dsc_cache;                /*Draw descriptors resolved from the list. Managed by `lv_obj.c`*/
 #endif
     uint32_t style_cnt     : 6;
     uint32_t has_local     : 1;
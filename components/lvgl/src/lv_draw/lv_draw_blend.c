@@ -20,15 +20,64 @@
     #include "../lv_gpu/lv_gpu_stm32_dma2d.h"
 #endif
 
+#if defined(_LV_BLEND_SIMD_AVX2)
+    #include <immintrin.h>
+    #include <string.h>
+#elif defined(_LV_BLEND_SIMD_SSE2)
+    #include <emmintrin.h>
+    #include <string.h>
+#elif defined(_LV_BLEND_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
 /*********************
  *      DEFINES
  *********************/
 #define GPU_SIZE_LIMIT      240
 
+#if defined(_LV_BLEND_SIMD_AVX2)
+    #define VEC_PX              8
+    #define VEC(op)             _mm256_##op
+    #define VEC_ZERO()          _mm256_setzero_si256()
+    #define VEC_LOAD(p)         _mm256_loadu_si256((const __m256i *)(p))
+    #define VEC_STORE(p, v)     _mm256_storeu_si256((__m256i *)(p), v)
+    #define VEC_OR(a, b)        _mm256_or_si256(a, b)
+    #define VEC_SEL(m, a, b)    _mm256_blendv_epi8(b, a, m)
+    #define VEC_SAME(a, b)      (_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) == -1)
+#elif defined(_LV_BLEND_SIMD_SSE2)
+    #define VEC_PX              4
+    #define VEC(op)             _mm_##op
+    #define VEC_ZERO()          _mm_setzero_si128()
+    #define VEC_LOAD(p)         _mm_loadu_si128((const __m128i *)(p))
+    #define VEC_STORE(p, v)     _mm_storeu_si128((__m128i *)(p), v)
+    #define VEC_OR(a, b)        _mm_or_si128(a, b)
+    #define VEC_SEL(m, a, b)    _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b))
+    #define VEC_SAME(a, b)      (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xFFFF)
+#elif defined(_LV_BLEND_SIMD_SWAR16)
+    /*Two RGB565 pixels in a word: one channel of both pixels is handled in the two 16 bit lanes.
+     *Convert to and from the byte swapped format with the same swap*/
+    #if LV_COLOR_16_SWAP
+        #define SWAR16_SWAP(w)  ((((w) & 0x00FF00FFu) << 8) | (((w) >> 8) & 0x00FF00FFu))
+    #else
+        #define SWAR16_SWAP(w)  (w)
+    #endif
+    #define SWAR16_LANES        0x00010001u
+    /*Same as `LV_MATH_UDIV255` in both lanes. A lane holds at most 63 * 255 + 128*/
+    #define SWAR16_DIV255(x)    ((((x) + SWAR16_LANES + (((x) >> 8) & 0x00FF00FFu)) >> 8) & 0x00FF00FFu)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if defined(_LV_BLEND_SIMD_AVX2)
+typedef __m256i vec_t;
+typedef uint64_t vec_mask_t;    /*Mask values of `VEC_PX` pixels*/
+#elif defined(_LV_BLEND_SIMD_SSE2)
+typedef __m128i vec_t;
+typedef uint32_t vec_mask_t;    /*Mask values of `VEC_PX` pixels*/
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -66,6 +115,42 @@ static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color
 static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 #endif
 
+#if LV_COLOR_SCREEN_TRANSP
+static void row_scr_transp(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_color_t color,
+                           const lv_opa_t * mask, lv_opa_t opa, lv_opa_t full);
+#endif
+
+LV_ATTRIBUTE_FAST_MEM static inline void row_mask_scalar(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                         lv_color_t color, const lv_opa_t * mask, lv_opa_t opa,
+                                                         lv_opa_t full);
+
+#if defined(_LV_BLEND_SIMD_AVX2) || defined(_LV_BLEND_SIMD_SSE2)
+static inline vec_t vec_div255(vec_t x);
+static inline vec_t vec_mix(vec_t fg, vec_t bg, vec_t a);
+static inline vec_t vec_mask_load(vec_mask_t mask);
+static inline int32_t fill_row_vec(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa);
+static inline int32_t map_row_vec(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa);
+static inline int32_t row_mask_vec(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_color_t color,
+                                   const lv_opa_t * mask, lv_opa_t opa, lv_opa_t full);
+#elif defined(_LV_BLEND_SIMD_NEON)
+static inline uint8x8_t neon_div255(uint16x8_t x);
+static inline int32_t fill_row_neon(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa);
+static inline int32_t map_row_neon(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa);
+static inline int32_t row_mask_neon(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_color_t color,
+                                    const lv_opa_t * mask, lv_opa_t opa, lv_opa_t full);
+#elif defined(_LV_BLEND_SIMD_SWAR16)
+LV_ATTRIBUTE_FAST_MEM static inline uint32_t swar16_mix(uint32_t fg_r, uint32_t fg_g, uint32_t fg_b, uint32_t bg,
+                                                         uint32_t opa_inv);
+LV_ATTRIBUTE_FAST_MEM static inline uint32_t swar16_mix_pair(uint32_t fg, uint32_t bg, uint32_t opa);
+LV_ATTRIBUTE_FAST_MEM static inline int32_t fill_row_swar16(lv_color_t * dest, int32_t len, lv_color_t color,
+                                                            lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static inline int32_t map_row_swar16(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                           lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static inline int32_t row_mask_swar16(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                            lv_color_t color, const lv_opa_t * mask, lv_opa_t opa,
+                                                            lv_opa_t full);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -78,38 +163,6 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
  *      MACROS
  **********************/
 
-#define FILL_NORMAL_MASK_PX(out_x,  color)                                                          \
-    if(*mask_tmp_x) {          \
-        if(*mask_tmp_x == LV_OPA_COVER) disp_buf_first[out_x] = color;                                 \
-        else disp_buf_first[out_x] = lv_color_mix(color, disp_buf_first[out_x], *mask_tmp_x);            \
-    }                                                                                               \
-    mask_tmp_x++;
-
-#define FILL_NORMAL_MASK_PX_SCR_TRANSP(out_x,  color)                                               \
-    if(*mask_tmp_x) {          \
-        if(*mask_tmp_x == LV_OPA_COVER) disp_buf_first[out_x] = color;                                 \
-        else if(disp->driver.screen_transp) lv_color_mix_with_alpha(disp_buf_first[out_x], disp_buf_first[out_x].ch.alpha,              \
-                                                                        color, *mask_tmp_x, &disp_buf_first[out_x], &disp_buf_first[out_x].ch.alpha);           \
-        else disp_buf_first[out_x] = lv_color_mix(color, disp_buf_first[out_x], *mask_tmp_x);            \
-    }                                                                                                      \
-    mask_tmp_x++;
-
-#define MAP_NORMAL_MASK_PX(x)                                                          \
-    if(*mask_tmp_x) {          \
-        if(*mask_tmp_x == LV_OPA_COVER) disp_buf_first[x] = map_buf_first[x];                                 \
-        else disp_buf_first[x] = lv_color_mix(map_buf_first[x], disp_buf_first[x], *mask_tmp_x);            \
-    }                                                                                               \
-    mask_tmp_x++;
-
-#define MAP_NORMAL_MASK_PX_SCR_TRANSP(x)                        \
-    if(*mask_tmp_x) {          \
-        if(*mask_tmp_x == LV_OPA_COVER) disp_buf_first[x] = map_buf_first[x];                                 \
-        else if(disp->driver.screen_transp) lv_color_mix_with_alpha(disp_buf_first[x], disp_buf_first[x].ch.alpha,              \
-                                                                        map_buf_first[x], *mask_tmp_x, &disp_buf_first[x], &disp_buf_first[x].ch.alpha);                  \
-        else disp_buf_first[x] = lv_color_mix(map_buf_first[x], disp_buf_first[x], *mask_tmp_x);            \
-    }                                                                                               \
-    mask_tmp_x++;
-
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
@@ -149,6 +202,8 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
     is_common = _lv_area_intersect(&draw_area, clip_area, fill_area);
     if(!is_common) return;
 
+    _lv_refr_add_draw_px(lv_area_get_size(&draw_area));
+
     /* Now `draw_area` has absolute coordinates.
      * Make it relative to `disp_area` to simplify draw to `disp_buf`*/
     draw_area.x1 -= disp_area->x1;
@@ -210,6 +265,8 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
     is_common = _lv_area_intersect(&draw_area, clip_area, map_area);
     if(!is_common) return;
 
+    _lv_refr_add_draw_px(lv_area_get_size(&draw_area));
+
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
     const lv_area_t * disp_area = &vdb->area;
@@ -248,6 +305,122 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
 #endif
 }
 
+/**
+ * Fill a row of pixels with a color. The result is the same as `lv_color_mix(color, dest[i], opa)`.
+ * @param dest pointer to the first pixel of the row
+ * @param len number of pixels
+ * @param color fill color
+ * @param opa opacity in 0x00..0xff range
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill_row(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa)
+{
+    /*`lv_color_fill` can't fill 0 pixels*/
+    if(len <= 0) return;
+
+    if(opa > LV_OPA_MAX) {
+        lv_color_fill(dest, color, len);
+        return;
+    }
+
+    int32_t x = 0;
+#if defined(_LV_BLEND_SIMD_AVX2) || defined(_LV_BLEND_SIMD_SSE2)
+    x = fill_row_vec(dest, len, color, opa);
+#elif defined(_LV_BLEND_SIMD_NEON)
+    x = fill_row_neon(dest, len, color, opa);
+#elif defined(_LV_BLEND_SIMD_SWAR16)
+    x = fill_row_swar16(dest, len, color, opa);
+#endif
+    if(x >= len) return;
+
+    /*Buffer the result color to avoid recalculating the same color*/
+    uint16_t color_premult[3];
+    lv_color_premult(color, opa, color_premult);
+    lv_opa_t opa_inv = 255 - opa;
+    lv_color_t last_dest_color = dest[x];
+    lv_color_t last_res_color = lv_color_mix_premult(color_premult, last_dest_color, opa_inv);
+
+    for(; x < len; x++) {
+        if(last_dest_color.full != dest[x].full) {
+            last_dest_color = dest[x];
+            last_res_color = lv_color_mix_premult(color_premult, dest[x], opa_inv);
+        }
+        dest[x] = last_res_color;
+    }
+}
+
+/**
+ * Fill a row of pixels with a color through a mask.
+ * @param dest pointer to the first pixel of the row
+ * @param len number of pixels
+ * @param color fill color
+ * @param mask opacity of each pixel (`len` values)
+ * @param opa overall opacity in 0x00..0xff range
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill_row_mask(lv_color_t * dest, int32_t len, lv_color_t color,
+                                                   const lv_opa_t * mask, lv_opa_t opa)
+{
+    int32_t x = 0;
+#if defined(_LV_BLEND_SIMD_AVX2) || defined(_LV_BLEND_SIMD_SSE2)
+    x = row_mask_vec(dest, NULL, len, color, mask, opa, LV_OPA_COVER);
+#elif defined(_LV_BLEND_SIMD_NEON)
+    x = row_mask_neon(dest, NULL, len, color, mask, opa, LV_OPA_COVER);
+#elif defined(_LV_BLEND_SIMD_SWAR16)
+    x = row_mask_swar16(dest, NULL, len, color, mask, opa, LV_OPA_COVER);
+#endif
+    row_mask_scalar(dest + x, NULL, len - x, color, mask + x, opa, LV_OPA_COVER);
+}
+
+/**
+ * Blend a row of pixels onto an other. The result is the same as `lv_color_mix(src[i], dest[i], opa)`.
+ * @param dest pointer to the first pixel of the destination row
+ * @param src pointer to the first pixel to blend
+ * @param len number of pixels
+ * @param opa opacity in 0x00..0xff range
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_map_row(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa)
+{
+    if(opa > LV_OPA_MAX) {
+        _lv_memcpy(dest, src, len * sizeof(lv_color_t));
+        return;
+    }
+
+    int32_t x = 0;
+#if defined(_LV_BLEND_SIMD_AVX2) || defined(_LV_BLEND_SIMD_SSE2)
+    x = map_row_vec(dest, src, len, opa);
+#elif defined(_LV_BLEND_SIMD_NEON)
+    x = map_row_neon(dest, src, len, opa);
+#elif defined(_LV_BLEND_SIMD_SWAR16)
+    x = map_row_swar16(dest, src, len, opa);
+#endif
+
+    for(; x < len; x++) {
+        dest[x] = lv_color_mix(src[x], dest[x], opa);
+    }
+}
+
+/**
+ * Blend a row of pixels onto an other through a mask.
+ * @param dest pointer to the first pixel of the destination row
+ * @param src pointer to the first pixel to blend
+ * @param len number of pixels
+ * @param mask opacity of each pixel (`len` values)
+ * @param opa overall opacity in 0x00..0xff range
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_map_row_mask(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                  const lv_opa_t * mask, lv_opa_t opa)
+{
+    int32_t x = 0;
+    lv_color_t no_color = LV_COLOR_BLACK;   /*Only `src` is used*/
+#if defined(_LV_BLEND_SIMD_AVX2) || defined(_LV_BLEND_SIMD_SSE2)
+    x = row_mask_vec(dest, src, len, no_color, mask, opa, LV_OPA_MAX);
+#elif defined(_LV_BLEND_SIMD_NEON)
+    x = row_mask_neon(dest, src, len, no_color, mask, opa, LV_OPA_MAX);
+#elif defined(_LV_BLEND_SIMD_SWAR16)
+    x = row_mask_swar16(dest, src, len, no_color, mask, opa, LV_OPA_MAX);
+#endif
+    row_mask_scalar(dest + x, src + x, len - x, no_color, mask + x, opa, LV_OPA_MAX);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -325,7 +498,6 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
     /*Create a temp. disp_buf which always point to the first pixel of the destination area*/
     lv_color_t * disp_buf_first = disp_buf + disp_w * draw_area->y1 + draw_area->x1;
 
-    int32_t x;
     int32_t y;
 
     /*Simple fill (maybe with opacity), no masking*/
@@ -377,6 +549,7 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
             }
 #elif LV_USE_GPU
             if(disp->driver.gpu_blend_cb && lv_area_get_size(draw_area) > GPU_SIZE_LIMIT) {
+                int32_t x;
                 for(x = 0; x < draw_area_w ; x++) blend_buf[x].full = color.full;
 
                 for(y = draw_area->y1; y <= draw_area->y2; y++) {
@@ -405,31 +578,12 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 return;
             }
 #endif
-            lv_color_t last_dest_color = LV_COLOR_BLACK;
-            lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
-
-            uint16_t color_premult[3];
-            lv_color_premult(color, opa, color_premult);
-            lv_opa_t opa_inv = 255 - opa;
-
             for(y = 0; y < draw_area_h; y++) {
-                for(x = 0; x < draw_area_w; x++) {
-                    if(last_dest_color.full != disp_buf_first[x].full) {
-                        last_dest_color = disp_buf_first[x];
-
 #if LV_COLOR_SCREEN_TRANSP
-                        if(disp->driver.screen_transp) {
-                            lv_color_mix_with_alpha(disp_buf_first[x], disp_buf_first[x].ch.alpha, color, opa, &last_res_color,
-                                                    &last_res_color.ch.alpha);
-                        }
-                        else
+                if(disp->driver.screen_transp) row_scr_transp(disp_buf_first, NULL, draw_area_w, color, NULL, opa, 0);
+                else
 #endif
-                        {
-                            last_res_color = lv_color_mix_premult(color_premult, disp_buf_first[x], opa_inv);
-                        }
-                    }
-                    disp_buf_first[x] = last_res_color;
-                }
+                    _lv_blend_fill_row(disp_buf_first, draw_area_w, color, opa);
                 disp_buf_first += disp_w;
             }
         }
@@ -444,107 +598,14 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
         }
 #endif
 
-        /*Buffer the result color to avoid recalculating the same color*/
-        lv_color_t last_dest_color;
-        lv_color_t last_res_color;
-        lv_opa_t last_mask = LV_OPA_TRANSP;
-        last_dest_color.full = disp_buf_first[0].full;
-        last_res_color.full = disp_buf_first[0].full;
-
-        int32_t x_end4 = draw_area_w - 4;
-
-        /*Only the mask matters*/
-        if(opa > LV_OPA_MAX) {
-            for(y = 0; y < draw_area_h; y++) {
-                const lv_opa_t * mask_tmp_x = mask;
-#if 0
-                for(x = 0; x < draw_area_w; x++) {
-#if LV_COLOR_SCREEN_TRANSP
-                    FILL_NORMAL_MASK_PX_SCR_TRANSP(x, color)
-#else
-                    FILL_NORMAL_MASK_PX(x, color)
-#endif
-                }
-#else
-                for(x = 0; x < draw_area_w && ((lv_uintptr_t)mask_tmp_x & 0x3); x++) {
-#if LV_COLOR_SCREEN_TRANSP
-                    FILL_NORMAL_MASK_PX_SCR_TRANSP(x, color)
-#else
-                    FILL_NORMAL_MASK_PX(x, color)
-#endif
-                }
-
-                uint32_t * mask32 = (uint32_t *) mask_tmp_x;
-                for(; x <= x_end4; x += 4) {
-                    if(*mask32) {
-                        if((*mask32) == 0xFFFFFFFF) {
-                            disp_buf_first[x] = color;
-                            disp_buf_first[x + 1] = color;
-                            disp_buf_first[x + 2] = color;
-                            disp_buf_first[x + 3] = color;
-                        }
-                        else {
-                            mask_tmp_x = (const lv_opa_t *)mask32;
+        for(y = 0; y < draw_area_h; y++) {
 #if LV_COLOR_SCREEN_TRANSP
-                            FILL_NORMAL_MASK_PX_SCR_TRANSP(x, color)
-                            FILL_NORMAL_MASK_PX_SCR_TRANSP(x + 1, color)
-                            FILL_NORMAL_MASK_PX_SCR_TRANSP(x + 2, color)
-                            FILL_NORMAL_MASK_PX_SCR_TRANSP(x + 3, color)
-#else
-                            FILL_NORMAL_MASK_PX(x, color)
-                            FILL_NORMAL_MASK_PX(x + 1, color)
-                            FILL_NORMAL_MASK_PX(x + 2, color)
-                            FILL_NORMAL_MASK_PX(x + 3, color)
+            if(disp->driver.screen_transp) row_scr_transp(disp_buf_first, NULL, draw_area_w, color, mask, opa, LV_OPA_COVER);
+            else
 #endif
-                        }
-                    }
-                    mask32++;
-                }
-
-                mask_tmp_x = (const lv_opa_t *)mask32;
-                for(; x < draw_area_w ; x++) {
-#if LV_COLOR_SCREEN_TRANSP
-                    FILL_NORMAL_MASK_PX_SCR_TRANSP(x, color)
-#else
-                    FILL_NORMAL_MASK_PX(x, color)
-#endif
-                }
-#endif
-                disp_buf_first += disp_w;
-                mask += draw_area_w;
-            }
-        }
-        /*Handle opa and mask values too*/
-        else {
-            lv_opa_t opa_tmp = LV_OPA_TRANSP;
-            for(y = draw_area->y1; y <= draw_area->y2; y++) {
-                const lv_opa_t * mask_tmp_x = mask;
-                for(x = 0; x < draw_area_w; x++) {
-                    if(*mask_tmp_x) {
-                        if(*mask_tmp_x != last_mask) opa_tmp = *mask_tmp_x == LV_OPA_COVER ? opa :
-                                                                   (uint32_t)((uint32_t)(*mask_tmp_x) * opa) >> 8;
-                        if(*mask_tmp_x != last_mask || last_dest_color.full != disp_buf_first[x].full) {
-#if LV_COLOR_SCREEN_TRANSP
-                            if(disp->driver.screen_transp) {
-                                lv_color_mix_with_alpha(disp_buf_first[x], disp_buf_first[x].ch.alpha, color, opa_tmp, &last_res_color,
-                                                        &last_res_color.ch.alpha);
-                            }
-                            else
-#endif
-                            {
-                                if(opa_tmp == LV_OPA_COVER) last_res_color = color;
-                                else last_res_color = lv_color_mix(color, disp_buf_first[x], opa_tmp);
-                            }
-                            last_mask = *mask_tmp_x;
-                            last_dest_color.full = disp_buf_first[x].full;
-                        }
-                        disp_buf_first[x] = last_res_color;
-                    }
-                    mask_tmp_x++;
-                }
-                disp_buf_first += disp_w;
-                mask += draw_area_w;
-            }
+                _lv_blend_fill_row_mask(disp_buf_first, draw_area_w, color, mask, opa);
+            disp_buf_first += disp_w;
+            mask += draw_area_w;
         }
     }
 }
@@ -731,7 +792,6 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
 #endif
 
-    int32_t x;
     int32_t y;
 
     /*Simple fill (maybe with opacity), no masking*/
@@ -841,20 +901,13 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
 #endif
 
             /*Software rendering*/
-
             for(y = 0; y < draw_area_h; y++) {
-                for(x = 0; x < draw_area_w; x++) {
 #if LV_COLOR_SCREEN_TRANSP
-                    if(disp->driver.screen_transp) {
-                        lv_color_mix_with_alpha(disp_buf_first[x], disp_buf_first[x].ch.alpha, map_buf_first[x], opa, &disp_buf_first[x],
-                                                &disp_buf_first[x].ch.alpha);
-                    }
-                    else
+                if(disp->driver.screen_transp) row_scr_transp(disp_buf_first, map_buf_first, draw_area_w, LV_COLOR_BLACK, NULL,
+                                                                  opa, 0);
+                else
 #endif
-                    {
-                        disp_buf_first[x] = lv_color_mix(map_buf_first[x], disp_buf_first[x], opa);
-                    }
-                }
+                    _lv_blend_map_row(disp_buf_first, map_buf_first, draw_area_w, opa);
                 disp_buf_first += disp_w;
                 map_buf_first += map_w;
             }
@@ -862,93 +915,20 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
     }
     /*Masked*/
     else {
-        /*Only the mask matters*/
-        if(opa > LV_OPA_MAX) {
-            /*Go to the first pixel of the row */
-
-            int32_t x_end4 = draw_area_w - 4;
-
-            for(y = 0; y < draw_area_h; y++) {
-                const lv_opa_t * mask_tmp_x = mask;
-#if 0
-                for(x = 0; x < draw_area_w; x++) {
-                    MAP_NORMAL_MASK_PX(x);
-                }
-#else
-                for(x = 0; x < draw_area_w && ((lv_uintptr_t)mask_tmp_x & 0x3); x++) {
+        for(y = 0; y < draw_area_h; y++) {
 #if LV_COLOR_SCREEN_TRANSP
-                    MAP_NORMAL_MASK_PX_SCR_TRANSP(x)
-#else
-                    MAP_NORMAL_MASK_PX(x)
-#endif
-                }
-
-                uint32_t * mask32 = (uint32_t *) mask_tmp_x;
-                for(; x < x_end4; x += 4) {
-                    if(*mask32) {
-                        if((*mask32) == 0xFFFFFFFF) {
-                            disp_buf_first[x] = map_buf_first[x];
-                            disp_buf_first[x + 1] = map_buf_first[x + 1];
-                            disp_buf_first[x + 2] = map_buf_first[x + 2];
-                            disp_buf_first[x + 3] = map_buf_first[x + 3];
-                        }
-                        else {
-                            mask_tmp_x = (const lv_opa_t *)mask32;
-#if LV_COLOR_SCREEN_TRANSP
-                            MAP_NORMAL_MASK_PX_SCR_TRANSP(x)
-                            MAP_NORMAL_MASK_PX_SCR_TRANSP(x + 1)
-                            MAP_NORMAL_MASK_PX_SCR_TRANSP(x + 2)
-                            MAP_NORMAL_MASK_PX_SCR_TRANSP(x + 3)
-#else
-                            MAP_NORMAL_MASK_PX(x)
-                            MAP_NORMAL_MASK_PX(x + 1)
-                            MAP_NORMAL_MASK_PX(x + 2)
-                            MAP_NORMAL_MASK_PX(x + 3)
-#endif
-                        }
-                    }
-                    mask32++;
-                }
-
-                mask_tmp_x = (const lv_opa_t *)mask32;
-                for(; x < draw_area_w ; x++) {
-#if LV_COLOR_SCREEN_TRANSP
-                    MAP_NORMAL_MASK_PX_SCR_TRANSP(x)
-#else
-                    MAP_NORMAL_MASK_PX(x)
-#endif
-                }
+            if(disp->driver.screen_transp) row_scr_transp(disp_buf_first, map_buf_first, draw_area_w, LV_COLOR_BLACK, mask,
+                                                              opa, LV_OPA_MAX);
+            else
 #endif
-                disp_buf_first += disp_w;
-                mask += draw_area_w;
-                map_buf_first += map_w;
-            }
-        }
-        /*Handle opa and mask values too*/
-        else {
-            for(y = 0; y < draw_area_h; y++) {
-                for(x = 0; x < draw_area_w; x++) {
-                    if(mask[x]) {
-                        lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
-#if LV_COLOR_SCREEN_TRANSP
-                        if(disp->driver.screen_transp) {
-                            lv_color_mix_with_alpha(disp_buf_first[x], disp_buf_first[x].ch.alpha, map_buf_first[x], opa_tmp, &disp_buf_first[x],
-                                                    &disp_buf_first[x].ch.alpha);
-                        }
-                        else
-#endif
-                        {
-                            disp_buf_first[x] = lv_color_mix(map_buf_first[x], disp_buf_first[x], opa_tmp);
-                        }
-                    }
-                }
-                disp_buf_first += disp_w;
-                mask += draw_area_w;
-                map_buf_first += map_w;
-            }
+                _lv_blend_map_row_mask(disp_buf_first, map_buf_first, draw_area_w, mask, opa);
+            disp_buf_first += disp_w;
+            mask += draw_area_w;
+            map_buf_first += map_w;
         }
     }
 }
+
 #if LV_USE_BLEND_MODES
 static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
                         const lv_area_t * map_area, const lv_color_t * map_buf, lv_opa_t opa,
@@ -1101,3 +1081,509 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
     return lv_color_mix(fg, bg, opa);
 }
 #endif
+
+#if LV_COLOR_SCREEN_TRANSP
+/**
+ * Blend a row on a screen with transparent background. The alpha channel of the destination is mixed too.
+ * @param dest pointer to the first pixel of the destination row
+ * @param src pointer to the first pixel to blend or NULL to fill with `color`
+ * @param len number of pixels
+ * @param color fill color if `src == NULL`
+ * @param mask opacity of each pixel or NULL if there is no mask
+ * @param opa overall opacity in 0x00..0xff range
+ * @param full mask values from this use `opa` as it is
+ */
+static void row_scr_transp(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_color_t color,
+                           const lv_opa_t * mask, lv_opa_t opa, lv_opa_t full)
+{
+    int32_t x;
+    for(x = 0; x < len; x++) {
+        lv_opa_t opa_tmp = opa;
+        if(mask) {
+            if(mask[x] == LV_OPA_TRANSP) continue;
+            if(opa > LV_OPA_MAX) opa_tmp = mask[x];
+            else if(mask[x] < full) opa_tmp = (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+        }
+
+        lv_color_t fg = src ? src[x] : color;
+        if(opa_tmp == LV_OPA_COVER) dest[x] = fg;
+        else lv_color_mix_with_alpha(dest[x], dest[x].ch.alpha, fg, opa_tmp, &dest[x], &dest[x].ch.alpha);
+    }
+}
+#endif
+
+/**
+ * Blend a row through a mask pixel by pixel. Used if there are no row kernels and for the last pixels.
+ * @param dest pointer to the first pixel of the destination row
+ * @param src pointer to the first pixel to blend or NULL to fill with `color`
+ * @param len number of pixels
+ * @param color fill color if `src == NULL`
+ * @param mask opacity of each pixel
+ * @param opa overall opacity in 0x00..0xff range
+ * @param full mask values from this use `opa` as it is
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void row_mask_scalar(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                         lv_color_t color, const lv_opa_t * mask, lv_opa_t opa,
+                                                         lv_opa_t full)
+{
+    int32_t x = 0;
+    while(x < len) {
+        /*Skip or copy 4 pixels at once where the mask is aligned*/
+        if(((lv_uintptr_t)&mask[x] & 0x3) == 0 && x + 4 <= len) {
+            uint32_t mask32 = *((const uint32_t *)&mask[x]);
+            if(mask32 == 0) {
+                x += 4;
+                continue;
+            }
+            if(mask32 == 0xFFFFFFFF && opa > LV_OPA_MAX) {
+                int32_t x_end = x + 4;
+                for(; x < x_end; x++) dest[x] = src ? src[x] : color;
+                continue;
+            }
+        }
+
+        lv_opa_t m = mask[x];
+        if(m) {
+            lv_color_t fg = src ? src[x] : color;
+            if(opa > LV_OPA_MAX) {
+                if(m == LV_OPA_COVER) dest[x] = fg;
+                else dest[x] = lv_color_mix(fg, dest[x], m);
+            }
+            else {
+                lv_opa_t opa_tmp = m >= full ? opa : (uint32_t)((uint32_t)m * opa) >> 8;
+                dest[x] = lv_color_mix(fg, dest[x], opa_tmp);
+            }
+        }
+        x++;
+    }
+}
+
+#if defined(_LV_BLEND_SIMD_AVX2) || defined(_LV_BLEND_SIMD_SSE2)
+
+/**
+ * Divide every 16 bit lane by 255 the same way as `LV_MATH_UDIV255`
+ */
+static inline vec_t vec_div255(vec_t x)
+{
+    return VEC(srli_epi16)(VEC(mulhi_epu16)(x, VEC(set1_epi16)((short)0x8081)), 7);
+}
+
+/**
+ * Mix `VEC_PX` pixels like `lv_color_mix`
+ * @param fg the foreground pixels
+ * @param bg the background pixels
+ * @param a the opacity of each pixel in the 32 bit lanes (0..255)
+ * @return the mixed pixels
+ */
+static inline vec_t vec_mix(vec_t fg, vec_t bg, vec_t a)
+{
+    const vec_t zero = VEC_ZERO();
+
+    /*Repeat the opacity on the 4 channels of the pixel*/
+    a = VEC_OR(a, VEC(slli_epi32)(a, 16));
+    vec_t a_lo = VEC(unpacklo_epi32)(a, a);
+    vec_t a_hi = VEC(unpackhi_epi32)(a, a);
+    vec_t a_inv_lo = VEC(sub_epi16)(VEC(set1_epi16)(255), a_lo);
+    vec_t a_inv_hi = VEC(sub_epi16)(VEC(set1_epi16)(255), a_hi);
+
+    vec_t lo = VEC(add_epi16)(VEC(mullo_epi16)(VEC(unpacklo_epi8)(fg, zero), a_lo),
+                              VEC(mullo_epi16)(VEC(unpacklo_epi8)(bg, zero), a_inv_lo));
+    vec_t hi = VEC(add_epi16)(VEC(mullo_epi16)(VEC(unpackhi_epi8)(fg, zero), a_hi),
+                              VEC(mullo_epi16)(VEC(unpackhi_epi8)(bg, zero), a_inv_hi));
+
+    return VEC_OR(VEC(packus_epi16)(vec_div255(lo), vec_div255(hi)), VEC(set1_epi32)((int)0xFF000000));
+}
+
+/**
+ * Put the mask values of `VEC_PX` pixels to the 32 bit lanes
+ */
+static inline vec_t vec_mask_load(vec_mask_t mask)
+{
+#if defined(_LV_BLEND_SIMD_AVX2)
+    return _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long)mask));
+#else
+    const vec_t zero = VEC_ZERO();
+    vec_t m = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)mask), zero);
+    return _mm_unpacklo_epi16(m, zero);
+#endif
+}
+
+/**
+ * Fill the pixels of a row in groups of `VEC_PX`
+ * @return number of pixels filled
+ */
+static inline int32_t fill_row_vec(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa)
+{
+    const vec_t zero = VEC_ZERO();
+    const vec_t opa_inv = VEC(set1_epi16)(255 - opa);
+    const vec_t alpha = VEC(set1_epi32)((int)0xFF000000);
+
+    /*The part of the color is the same in every pixel*/
+    vec_t fg = VEC(set1_epi32)((int)color.full);
+    vec_t fg_premult = VEC(mullo_epi16)(VEC(unpacklo_epi8)(fg, zero), VEC(set1_epi16)(opa));
+
+    /*Buffer the result to avoid recalculating it on a uniform background*/
+    vec_t last_bg = zero;
+    vec_t last_res = VEC_OR(VEC(packus_epi16)(vec_div255(fg_premult), vec_div255(fg_premult)), alpha);
+
+    int32_t x;
+    for(x = 0; x + VEC_PX <= len; x += VEC_PX) {
+        vec_t bg = VEC_LOAD(&dest[x]);
+        if(!VEC_SAME(bg, last_bg)) {
+            last_bg = bg;
+            vec_t lo = VEC(add_epi16)(fg_premult, VEC(mullo_epi16)(VEC(unpacklo_epi8)(bg, zero), opa_inv));
+            vec_t hi = VEC(add_epi16)(fg_premult, VEC(mullo_epi16)(VEC(unpackhi_epi8)(bg, zero), opa_inv));
+            last_res = VEC_OR(VEC(packus_epi16)(vec_div255(lo), vec_div255(hi)), alpha);
+        }
+        VEC_STORE(&dest[x], last_res);
+    }
+
+    return x;
+}
+
+/**
+ * Blend the pixels of a row in groups of `VEC_PX`
+ * @return number of pixels blended
+ */
+static inline int32_t map_row_vec(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa)
+{
+    const vec_t a = VEC(set1_epi32)(opa);
+
+    int32_t x;
+    for(x = 0; x + VEC_PX <= len; x += VEC_PX) {
+        VEC_STORE(&dest[x], vec_mix(VEC_LOAD(&src[x]), VEC_LOAD(&dest[x]), a));
+    }
+
+    return x;
+}
+
+/**
+ * Blend the pixels of a row through a mask in groups of `VEC_PX`
+ * @param src pointer to the first pixel to blend or NULL to fill with `color`
+ * @param full mask values from this use `opa` as it is
+ * @return number of pixels blended
+ */
+static inline int32_t row_mask_vec(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_color_t color,
+                                   const lv_opa_t * mask, lv_opa_t opa, lv_opa_t full)
+{
+    const vec_t zero = VEC_ZERO();
+    const vec_t v_opa = VEC(set1_epi32)(opa);
+    const vec_t v_full = VEC(set1_epi32)(full - 1);
+    const vec_t v_cover = VEC(set1_epi32)(LV_OPA_COVER);
+    const bool cover = opa > LV_OPA_MAX;
+
+    vec_t fg = VEC(set1_epi32)((int)color.full);
+
+    int32_t x;
+    for(x = 0; x + VEC_PX <= len; x += VEC_PX) {
+        vec_mask_t mask_vec;
+        memcpy(&mask_vec, &mask[x], sizeof(mask_vec));
+        if(mask_vec == 0) continue;
+
+        if(src) fg = VEC_LOAD(&src[x]);
+        if(cover && mask_vec == (vec_mask_t)(-1)) {
+            VEC_STORE(&dest[x], fg);
+            continue;
+        }
+
+        vec_t m = vec_mask_load(mask_vec);
+        vec_t a;
+        if(cover) {
+            a = m;
+        }
+        else {
+            vec_t m_opa = VEC(srli_epi32)(VEC(mullo_epi16)(m, v_opa), 8);
+            a = VEC_SEL(VEC(cmpgt_epi32)(m, v_full), v_opa, m_opa);
+        }
+
+        vec_t bg = VEC_LOAD(&dest[x]);
+        vec_t res = vec_mix(fg, bg, a);
+        if(cover) res = VEC_SEL(VEC(cmpeq_epi32)(m, v_cover), fg, res);
+        res = VEC_SEL(VEC(cmpeq_epi32)(m, zero), bg, res);
+        VEC_STORE(&dest[x], res);
+    }
+
+    return x;
+}
+
+#elif defined(_LV_BLEND_SIMD_NEON)
+
+/**
+ * Divide every 16 bit lane by 255 the same way as `LV_MATH_UDIV255` and narrow to 8 bit.
+ * `(x + 1 + (x >> 8)) >> 8` is equal to it below 65535.
+ */
+static inline uint8x8_t neon_div255(uint16x8_t x)
+{
+    return vshrn_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+/**
+ * Fill the pixels of a row in groups of 8
+ * @return number of pixels filled
+ */
+static inline int32_t fill_row_neon(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa)
+{
+    const uint8x8_t opa_inv = vdup_n_u8(255 - opa);
+    const uint16x8_t b_premult = vmull_u8(vdup_n_u8(color.ch.blue), vdup_n_u8(opa));
+    const uint16x8_t g_premult = vmull_u8(vdup_n_u8(color.ch.green), vdup_n_u8(opa));
+    const uint16x8_t r_premult = vmull_u8(vdup_n_u8(color.ch.red), vdup_n_u8(opa));
+
+    int32_t x;
+    for(x = 0; x + 8 <= len; x += 8) {
+        uint8x8x4_t px = vld4_u8((const uint8_t *)&dest[x]);
+        px.val[0] = neon_div255(vmlal_u8(b_premult, px.val[0], opa_inv));
+        px.val[1] = neon_div255(vmlal_u8(g_premult, px.val[1], opa_inv));
+        px.val[2] = neon_div255(vmlal_u8(r_premult, px.val[2], opa_inv));
+        px.val[3] = vdup_n_u8(0xFF);
+        vst4_u8((uint8_t *)&dest[x], px);
+    }
+
+    return x;
+}
+
+/**
+ * Blend the pixels of a row in groups of 8
+ * @return number of pixels blended
+ */
+static inline int32_t map_row_neon(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa)
+{
+    const uint8x8_t a = vdup_n_u8(opa);
+    const uint8x8_t opa_inv = vdup_n_u8(255 - opa);
+
+    int32_t x;
+    for(x = 0; x + 8 <= len; x += 8) {
+        uint8x8x4_t fg = vld4_u8((const uint8_t *)&src[x]);
+        uint8x8x4_t px = vld4_u8((const uint8_t *)&dest[x]);
+        uint8_t c;
+        for(c = 0; c < 3; c++) {
+            px.val[c] = neon_div255(vmlal_u8(vmull_u8(fg.val[c], a), px.val[c], opa_inv));
+        }
+        px.val[3] = vdup_n_u8(0xFF);
+        vst4_u8((uint8_t *)&dest[x], px);
+    }
+
+    return x;
+}
+
+/**
+ * Blend the pixels of a row through a mask in groups of 8
+ * @param src pointer to the first pixel to blend or NULL to fill with `color`
+ * @param full mask values from this use `opa` as it is
+ * @return number of pixels blended
+ */
+static inline int32_t row_mask_neon(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_color_t color,
+                                    const lv_opa_t * mask, lv_opa_t opa, lv_opa_t full)
+{
+    const bool cover = opa > LV_OPA_MAX;
+    uint8x8x4_t fg;
+    fg.val[0] = vdup_n_u8(color.ch.blue);
+    fg.val[1] = vdup_n_u8(color.ch.green);
+    fg.val[2] = vdup_n_u8(color.ch.red);
+    fg.val[3] = vdup_n_u8(color.ch.alpha);
+
+    int32_t x;
+    for(x = 0; x + 8 <= len; x += 8) {
+        uint8x8_t m = vld1_u8(&mask[x]);
+        uint64_t mask64 = vget_lane_u64(vreinterpret_u64_u8(m), 0);
+        if(mask64 == 0) continue;
+
+        if(src) fg = vld4_u8((const uint8_t *)&src[x]);
+        if(cover && mask64 == UINT64_MAX) {
+            vst4_u8((uint8_t *)&dest[x], fg);
+            continue;
+        }
+
+        uint8x8_t a;
+        if(cover) a = m;
+        else a = vbsl_u8(vcgt_u8(m, vdup_n_u8(full - 1)), vdup_n_u8(opa), vshrn_n_u16(vmull_u8(m, vdup_n_u8(opa)), 8));
+        uint8x8_t a_inv = vmvn_u8(a);
+        uint8x8_t keep = vceq_u8(m, vdup_n_u8(LV_OPA_TRANSP));
+        uint8x8_t copy = cover ? vceq_u8(m, vdup_n_u8(LV_OPA_COVER)) : vdup_n_u8(0);
+
+        uint8x8x4_t bg = vld4_u8((const uint8_t *)&dest[x]);
+        uint8x8x4_t res;
+        uint8_t c;
+        for(c = 0; c < 3; c++) {
+            res.val[c] = neon_div255(vmlal_u8(vmull_u8(fg.val[c], a), bg.val[c], a_inv));
+        }
+        res.val[3] = vdup_n_u8(0xFF);
+        for(c = 0; c < 4; c++) {
+            res.val[c] = vbsl_u8(keep, bg.val[c], vbsl_u8(copy, fg.val[c], res.val[c]));
+        }
+        vst4_u8((uint8_t *)&dest[x], res);
+    }
+
+    return x;
+}
+
+#elif defined(_LV_BLEND_SIMD_SWAR16)
+
+/**
+ * Mix the two pixels of a word with the same opacity
+ * @param fg_r red channel of the foreground pixels in the 16 bit lanes already multiplied by the opacity
+ *             and with `LV_COLOR_MIX_ROUND_OFS` added
+ * @param fg_g green channel like `fg_r`
+ * @param fg_b blue channel like `fg_r`
+ * @param bg the background pixels as they are in the buffer
+ * @param opa_inv 255 - opacity
+ * @return the mixed pixels in the format of the buffer
+ */
+LV_ATTRIBUTE_FAST_MEM static inline uint32_t swar16_mix(uint32_t fg_r, uint32_t fg_g, uint32_t fg_b, uint32_t bg,
+                                                         uint32_t opa_inv)
+{
+    bg = SWAR16_SWAP(bg);
+    uint32_t r = SWAR16_DIV255(fg_r + ((bg >> 11) & 0x001F001Fu) * opa_inv);
+    uint32_t g = SWAR16_DIV255(fg_g + ((bg >> 5) & 0x003F003Fu) * opa_inv);
+    uint32_t b = SWAR16_DIV255(fg_b + (bg & 0x001F001Fu) * opa_inv);
+    return SWAR16_SWAP((r << 11) | (g << 5) | b);
+}
+
+/**
+ * Mix two foreground pixels on two background pixels with the same opacity
+ * @param fg the foreground pixels as they are in the buffer
+ * @param bg the background pixels as they are in the buffer
+ * @param opa opacity in 0x00..0xff range
+ * @return the mixed pixels in the format of the buffer
+ */
+LV_ATTRIBUTE_FAST_MEM static inline uint32_t swar16_mix_pair(uint32_t fg, uint32_t bg, uint32_t opa)
+{
+    const uint32_t ofs = LV_COLOR_MIX_ROUND_OFS * SWAR16_LANES;
+    fg = SWAR16_SWAP(fg);
+    return swar16_mix(((fg >> 11) & 0x001F001Fu) * opa + ofs, ((fg >> 5) & 0x003F003Fu) * opa + ofs,
+                      (fg & 0x001F001Fu) * opa + ofs, bg, 255 - opa);
+}
+
+/**
+ * Fill the pixels of a row two at once
+ * @return number of pixels filled
+ */
+LV_ATTRIBUTE_FAST_MEM static inline int32_t fill_row_swar16(lv_color_t * dest, int32_t len, lv_color_t color,
+                                                            lv_opa_t opa)
+{
+    if(len < 2) return 0;
+
+    int32_t x = 0;
+    if((lv_uintptr_t)dest & 0x3) {
+        dest[0] = lv_color_mix(color, dest[0], opa);
+        x = 1;
+    }
+
+    /*The part of the color is the same in every pixel*/
+    const uint32_t ofs = LV_COLOR_MIX_ROUND_OFS * SWAR16_LANES;
+    uint32_t c = SWAR16_SWAP(color.full * SWAR16_LANES);
+    uint32_t fg_r = ((c >> 11) & 0x001F001Fu) * opa + ofs;
+    uint32_t fg_g = ((c >> 5) & 0x003F003Fu) * opa + ofs;
+    uint32_t fg_b = (c & 0x001F001Fu) * opa + ofs;
+    uint32_t opa_inv = 255 - opa;
+
+    /*Buffer the result to avoid recalculating it on a uniform background*/
+    uint32_t last_bg = 0;
+    uint32_t last_res = swar16_mix(fg_r, fg_g, fg_b, last_bg, opa_inv);
+
+    uint32_t * dest32 = (uint32_t *)&dest[x];
+    for(; x + 2 <= len; x += 2) {
+        if(*dest32 != last_bg) {
+            last_bg = *dest32;
+            last_res = swar16_mix(fg_r, fg_g, fg_b, last_bg, opa_inv);
+        }
+        *dest32 = last_res;
+        dest32++;
+    }
+
+    return x;
+}
+
+/**
+ * Blend the pixels of a row two at once
+ * @return number of pixels blended
+ */
+LV_ATTRIBUTE_FAST_MEM static inline int32_t map_row_swar16(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                           lv_opa_t opa)
+{
+    if(len < 2) return 0;
+
+    int32_t x = 0;
+    if((lv_uintptr_t)dest & 0x3) {
+        dest[0] = lv_color_mix(src[0], dest[0], opa);
+        x = 1;
+    }
+
+    /*`src` might be not aligned to 4 bytes so read it by pixels (little endian)*/
+    uint32_t * dest32 = (uint32_t *)&dest[x];
+    for(; x + 2 <= len; x += 2) {
+        uint32_t fg = src[x].full | ((uint32_t)src[x + 1].full << 16);
+        *dest32 = swar16_mix_pair(fg, *dest32, opa);
+        dest32++;
+    }
+
+    return x;
+}
+
+/**
+ * Blend the pixels of a row through a mask two at once. Pixel pairs with different opacity are mixed one by one.
+ * @param src pointer to the first pixel to blend or NULL to fill with `color`
+ * @param full mask values from this use `opa` as it is
+ * @return number of pixels blended
+ */
+LV_ATTRIBUTE_FAST_MEM static inline int32_t row_mask_swar16(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                            lv_color_t color, const lv_opa_t * mask, lv_opa_t opa,
+                                                            lv_opa_t full)
+{
+    if(len < 2) return 0;
+
+    int32_t x = 0;
+    if((lv_uintptr_t)dest & 0x3) {
+        row_mask_scalar(dest, src, 1, color, mask, opa, full);
+        x = 1;
+    }
+
+    const bool cover = opa > LV_OPA_MAX;
+    const uint32_t ofs = LV_COLOR_MIX_ROUND_OFS * SWAR16_LANES;
+    uint32_t c = SWAR16_SWAP(color.full * SWAR16_LANES);
+    uint32_t fg = color.full * SWAR16_LANES;
+
+    /*The part of the fill color changes only with the opacity*/
+    uint32_t last_a = 0;
+    uint32_t fg_r = ofs;
+    uint32_t fg_g = ofs;
+    uint32_t fg_b = ofs;
+
+    uint32_t * dest32 = (uint32_t *)&dest[x];
+    for(; x + 2 <= len; x += 2, dest32++) {
+        lv_opa_t m0 = mask[x];
+        lv_opa_t m1 = mask[x + 1];
+        if((m0 | m1) == LV_OPA_TRANSP) continue;
+
+        if(src) fg = src[x].full | ((uint32_t)src[x + 1].full << 16);
+        if(cover && (m0 & m1) == LV_OPA_COVER) {
+            *dest32 = fg;
+            continue;
+        }
+
+        if(m0 != m1) {
+            row_mask_scalar(&dest[x], src ? &src[x] : NULL, 2, color, &mask[x], opa, full);
+            continue;
+        }
+
+        uint32_t a;
+        if(cover) a = m0;
+        else a = m0 >= full ? opa : (uint32_t)((uint32_t)m0 * opa) >> 8;
+
+        if(src) {
+            *dest32 = swar16_mix_pair(fg, *dest32, a);
+        }
+        else {
+            if(a != last_a) {
+                last_a = a;
+                fg_r = ((c >> 11) & 0x001F001Fu) * a + ofs;
+                fg_g = ((c >> 5) & 0x003F003Fu) * a + ofs;
+                fg_b = (c & 0x001F001Fu) * a + ofs;
+            }
+            *dest32 = swar16_mix(fg_r, fg_g, fg_b, *dest32, 255 - a);
+        }
+    }
+
+    return x;
+}
+
+#endif
@@ -21,6 +21,23 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*Instruction set of the row blending functions. Selected from the target of the compiler*/
+#if LV_USE_BLEND_SIMD && LV_COLOR_DEPTH == 32 && defined(__AVX2__)
+#define _LV_BLEND_SIMD_AVX2     1
+#define _LV_BLEND_SIMD_NAME     "AVX2"
+#elif LV_USE_BLEND_SIMD && LV_COLOR_DEPTH == 32 && (defined(__SSE2__) || defined(_M_X64))
+#define _LV_BLEND_SIMD_SSE2     1
+#define _LV_BLEND_SIMD_NAME     "SSE2"
+#elif LV_USE_BLEND_SIMD && LV_COLOR_DEPTH == 32 && defined(__ARM_NEON)
+#define _LV_BLEND_SIMD_NEON     1
+#define _LV_BLEND_SIMD_NAME     "NEON"
+#elif LV_USE_BLEND_SIMD && LV_COLOR_DEPTH == 16
+#define _LV_BLEND_SIMD_SWAR16   1
+#define _LV_BLEND_SIMD_NAME     "RGB565 x2"
+#else
+#define _LV_BLEND_SIMD_NAME     "scalar"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -46,6 +63,16 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
                                          const lv_color_t * map_buf,
                                          lv_opa_t * mask, lv_draw_mask_res_t mask_res, lv_opa_t opa, lv_blend_mode_t mode);
 
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill_row(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa);
+
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill_row_mask(lv_color_t * dest, int32_t len, lv_color_t color,
+                                                   const lv_opa_t * mask, lv_opa_t opa);
+
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_map_row(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa);
+
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_map_row_mask(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                  const lv_opa_t * mask, lv_opa_t opa);
+
 //! @endcond
 /**********************
  *      MACROS
@@ -81,8 +81,11 @@ void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask, const void *
 
     if(dsc->opa <= LV_OPA_MIN) return;
 
+    /*The image cache and the decoders are shared by the rendering threads*/
     lv_res_t res;
+    _lv_refr_worker_lock();
     res = lv_img_draw_core(coords, mask, src, dsc);
+    _lv_refr_worker_unlock();
 
     if(res == LV_RES_INV) {
         LV_LOG_WARN("Image draw error");
@@ -12,6 +12,7 @@
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_bidi.h"
 #include "../lv_misc/lv_debug.h"
+#include "../lv_misc/lv_gc.h"
 
 /*********************
  *      DEFINES
@@ -128,10 +129,19 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, mask);
     if(!clip_ok) return;
 
+    /*Use the saved lines if they are the lines of this text*/
+    const lv_txt_layout_t * layout = dsc->layout;
+    if(!_lv_txt_layout_is_valid(layout, txt, font, dsc->letter_space, lv_area_get_width(coords), dsc->flag)) {
+        layout = NULL;
+    }
+
     if((dsc->flag & LV_TXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
     }
+    else if(layout) {
+        w = layout->size.x;
+    }
     else {
         /*If EXAPND is enabled then not limit the text's width to the object's width*/
         lv_point_t p;
@@ -157,6 +167,11 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 
     uint32_t line_start     = 0;
     int32_t last_line_start = -1;
+    uint32_t line_id = 0;
+    uint32_t line_end;
+
+    /*No need for the hint if the lines are known*/
+    if(layout) hint = NULL;
 
     /*Check the hint to use the cached info*/
     if(hint && y_ofs == 0 && coords->y1 < 0) {
@@ -173,10 +188,23 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+    if(layout) {
+        /*Jump to the first visible line*/
+        if(pos.y + line_height_font < mask->y1) {
+            if(line_height <= 0) return;
+            line_id = (mask->y1 - pos.y - line_height_font + line_height - 1) / line_height;
+            if(line_id >= layout->line_cnt) return;
+            pos.y += line_id * line_height;
+        }
+        line_start = layout->lines[line_id].start;
+        line_end = layout->lines[line_id + 1].start;
+    }
+    else {
+        line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+    }
 
     /*Go the first visible line*/
-    while(pos.y + line_height_font < mask->y1) {
+    while(layout == NULL && pos.y + line_height_font < mask->y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
@@ -194,14 +222,18 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 
     /*Align to middle*/
     if(dsc->flag & LV_TXT_FLAG_CENTER) {
-        line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(layout) line_width = layout->lines[line_id].width;
+        else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space,
+                                            dsc->flag);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(dsc->flag & LV_TXT_FLAG_RIGHT) {
-        line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(layout) line_width = layout->lines[line_id].width;
+        else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space,
+                                            dsc->flag);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -355,21 +387,30 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        if(layout) {
+            line_id++;
+            if(line_id >= layout->line_cnt) break;
+            line_end = layout->lines[line_id + 1].start;
+        }
+        else {
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(dsc->flag & LV_TXT_FLAG_CENTER) {
-            line_width =
-                _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(layout) line_width = layout->lines[line_id].width;
+            else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space,
+                                                dsc->flag);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(dsc->flag & LV_TXT_FLAG_RIGHT) {
-            line_width =
-                _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(layout) line_width = layout->lines[line_id].width;
+            else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space,
+                                                dsc->flag);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -484,9 +525,10 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
             return; /*Invalid bpp. Can't render the letter*/
     }
 
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
+    /*One per rendering thread*/
+    static _LV_REFR_LOCAL lv_opa_t opa_table[256];
+    static _LV_REFR_LOCAL lv_opa_t prev_opa = LV_OPA_TRANSP;
+    static _LV_REFR_LOCAL uint32_t prev_bpp = 0;
     if(opa < LV_OPA_MAX) {
         if(prev_opa != opa || prev_bpp != bpp) {
             uint32_t i;
@@ -15,10 +15,20 @@
 /*********************
  *      DEFINES
  *********************/
+/*Columns left of the rectangle checked when a circle is cached. Its edge reaches at most 1 column out.*/
+#define RADIUS_CACHE_PAD        2
+/*Anti-aliased columns of the rows on average. It's ~2 even with large radii.*/
+#define RADIUS_CACHE_OPA_ROW    4
 
 /**********************
  *      TYPEDEFS
  **********************/
+/*A row of a cached circle's top left corner. They follow `_lv_draw_mask_radius_circle_t` in its allocation.*/
+typedef struct {
+    uint32_t opa_ofs;   /*Index of the row's first opacity in the opacities after the rows*/
+    int16_t start;      /*The first not transparent column. 0: the left edge of the rectangle*/
+    uint16_t len;       /*Anti-aliased columns from `start` with the opacities. Fully covered after them.*/
+} radius_row_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -29,6 +39,15 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_line(lv_opa_t * mas
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_radius(lv_opa_t * mask_buf, lv_coord_t abs_x,
                                                                     lv_coord_t abs_y, lv_coord_t len,
                                                                     lv_draw_mask_radius_param_t * param);
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_corner_calc(lv_opa_t * mask_buf, int32_t k, int32_t abs_y,
+                                                                   lv_coord_t len, lv_draw_mask_radius_param_t * p);
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_corner_cached(lv_opa_t * mask_buf, int32_t k, int32_t w,
+                                                                     lv_coord_t len,
+                                                                     const _lv_draw_mask_radius_circle_t * circle,
+                                                                     int32_t row, bool outer);
+static const _lv_draw_mask_radius_circle_t * radius_cache_get(lv_coord_t radius);
+static bool radius_circle_calc(_lv_draw_mask_radius_circle_t * circle, lv_coord_t radius, uint32_t size);
+static void radius_cache_trim(_lv_draw_mask_radius_cache_t * cache, uint32_t size);
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_angle(lv_opa_t * mask_buf, lv_coord_t abs_x,
                                                                    lv_coord_t abs_y, lv_coord_t len,
                                                                    lv_draw_mask_angle_param_t * param);
@@ -52,6 +71,7 @@ LV_ATTRIBUTE_FAST_MEM static inline void sqrt_approx(lv_sqrt_res_t * q, lv_sqrt_
 /**********************
  *  STATIC VARIABLES
  **********************/
+static uint32_t radius_cache_max = LV_RADIUS_CACHE_SIZE;
 
 /**********************
  *      MACROS
@@ -72,7 +92,7 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
     /*Look for a free entry*/
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).param == NULL) break;
+        if(LV_GC_ROOT_LOCAL(_lv_draw_mask_list)[i].param == NULL) break;
     }
 
     if(i >= _LV_MASK_MAX_NUM) {
@@ -80,8 +100,8 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
         return LV_MASK_ID_INV;
     }
 
-    LV_GC_ROOT(_lv_draw_mask_list[i]).param = param;
-    LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = custom_id;
+    LV_GC_ROOT_LOCAL(_lv_draw_mask_list)[i].param = param;
+    LV_GC_ROOT_LOCAL(_lv_draw_mask_list)[i].custom_id = custom_id;
 
     return i;
 }
@@ -103,7 +123,7 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf,
     bool changed = false;
     lv_draw_mask_common_dsc_t * dsc;
 
-    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+    _lv_draw_mask_saved_t * m = LV_GC_ROOT_LOCAL(_lv_draw_mask_list);
 
     while(m->param) {
         dsc = m->param;
@@ -129,9 +149,9 @@ void * lv_draw_mask_remove_id(int16_t id)
     void * p = NULL;
 
     if(id != LV_MASK_ID_INV) {
-        p = LV_GC_ROOT(_lv_draw_mask_list[id]).param;
-        LV_GC_ROOT(_lv_draw_mask_list[id]).param = NULL;
-        LV_GC_ROOT(_lv_draw_mask_list[id]).custom_id = NULL;
+        p = LV_GC_ROOT_LOCAL(_lv_draw_mask_list)[id].param;
+        LV_GC_ROOT_LOCAL(_lv_draw_mask_list)[id].param = NULL;
+        LV_GC_ROOT_LOCAL(_lv_draw_mask_list)[id].custom_id = NULL;
     }
 
     return p;
@@ -148,10 +168,10 @@ void * lv_draw_mask_remove_custom(void * custom_id)
     void * p = NULL;
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id == custom_id) {
-            p = LV_GC_ROOT(_lv_draw_mask_list[i]).param;
-            LV_GC_ROOT(_lv_draw_mask_list[i]).param = NULL;
-            LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = NULL;
+        if(LV_GC_ROOT_LOCAL(_lv_draw_mask_list)[i].custom_id == custom_id) {
+            p = LV_GC_ROOT_LOCAL(_lv_draw_mask_list)[i].param;
+            LV_GC_ROOT_LOCAL(_lv_draw_mask_list)[i].param = NULL;
+            LV_GC_ROOT_LOCAL(_lv_draw_mask_list)[i].custom_id = NULL;
         }
     }
     return p;
@@ -166,7 +186,7 @@ LV_ATTRIBUTE_FAST_MEM uint8_t lv_draw_mask_get_cnt(void)
     uint8_t cnt = 0;
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).param) cnt++;
+        if(LV_GC_ROOT_LOCAL(_lv_draw_mask_list)[i].param) cnt++;
     }
     return cnt;
 }
@@ -378,6 +398,19 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
     param->y_prev_x.i = 0;
 }
 
+/**
+ * Set the RAM the radius masks can use to keep the corners of their circles.
+ * The render worker thread has an other cache of the same size.
+ * @param size the size in bytes, 0: calculate every corner row when it's drawn
+ */
+void lv_draw_mask_radius_cache_set_size(uint32_t size)
+{
+    radius_cache_max = size;
+
+    /*The worker thread frees its circles the next time it draws a corner*/
+    radius_cache_trim(&LV_GC_ROOT_LOCAL(_lv_draw_mask_radius_cache), size);
+}
+
 /**
  * Initialize a fade mask.
  * @param param pointer to a `lv_draw_mask_param_t` to initialize
@@ -927,200 +960,389 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_radius(lv_opa_t * m
     int32_t k = rect.x1 - abs_x; /*First relevant coordinate on the of the mask*/
     int32_t w = lv_area_get_width(&rect);
     int32_t h = lv_area_get_height(&rect);
-    abs_x -= rect.x1;
     abs_y -= rect.y1;
 
-    uint32_t r2 = p->cfg.radius * p->cfg.radius;
-
     /*Handle corner areas*/
     if(abs_y < radius || abs_y > h - radius - 1) {
+        const _lv_draw_mask_radius_circle_t * circle = radius_cache_get(radius);
+        if(circle) {
+            int32_t row = abs_y < radius ? abs_y : h - abs_y - 1;
+            return radius_corner_cached(mask_buf, k, w, len, circle, row, outer);
+        }
+
+        return radius_corner_calc(mask_buf, k, abs_y, len, p);
+    }
+
+    return LV_DRAW_MASK_RES_CHANGED;
+}
+
+/**
+ * Calculate a row of a corner of a radius mask
+ * @param mask_buf the mask of the row
+ * @param k the index of the rectangle's left edge in `mask_buf`
+ * @param abs_y the row relative to the rectangle's top edge. Has to be in a corner.
+ * @param len length of `mask_buf`
+ * @param p the mask's parameter
+ * @return `LV_DRAW_MASK_RES_TRANSP` or `LV_DRAW_MASK_RES_CHANGED`
+ */
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_corner_calc(lv_opa_t * mask_buf, int32_t k, int32_t abs_y,
+                                                                   lv_coord_t len, lv_draw_mask_radius_param_t * p)
+{
+    bool outer = p->cfg.outer;
+    int32_t radius = p->cfg.radius;
+    int32_t w = lv_area_get_width(&p->cfg.rect);
+    int32_t h = lv_area_get_height(&p->cfg.rect);
+    uint32_t r2 = p->cfg.radius * p->cfg.radius;
+
+    uint32_t sqrt_mask;
+    if(radius <= 32) sqrt_mask = 0x200;
+    if(radius <= 256) sqrt_mask = 0x800;
+    else sqrt_mask = 0x8000;
+
+    lv_sqrt_res_t x0;
+    lv_sqrt_res_t x1;
+    /* y = 0 should mean the top of the circle */
+    int32_t y;
+    if(abs_y < radius) {
+        y = radius - abs_y;
+
+        /* Get the x intersection points for `abs_y` and `abs_y-1`
+         * Use the circle's equation x = sqrt(r^2 - y^2)
+         * Try to use the values from the previous run*/
+        if(y == p->y_prev) {
+            x0.f = p->y_prev_x.f;
+            x0.i = p->y_prev_x.i;
+        }
+        else {
+            _lv_sqrt(r2 - (y * y), &x0, sqrt_mask);
+        }
+        _lv_sqrt(r2 - ((y - 1) * (y - 1)), &x1, sqrt_mask);
+        p->y_prev = y - 1;
+        p->y_prev_x.f = x1.f;
+        p->y_prev_x.i = x1.i;
+    }
+    else {
+        y = radius - (h - abs_y) + 1;
+
+        /* Get the x intersection points for `abs_y` and `abs_y-1`
+         * Use the circle's equation x = sqrt(r^2 - y^2)
+         * Try to use the values from the previous run*/
+        if((y - 1) == p->y_prev) {
+            x1.f = p->y_prev_x.f;
+            x1.i = p->y_prev_x.i;
+        }
+        else {
+            _lv_sqrt(r2 - ((y - 1) * (y - 1)), &x1, sqrt_mask);
+        }
 
-        uint32_t sqrt_mask;
-        if(radius <= 32) sqrt_mask = 0x200;
-        if(radius <= 256) sqrt_mask = 0x800;
-        else sqrt_mask = 0x8000;
-
-        lv_sqrt_res_t x0;
-        lv_sqrt_res_t x1;
-        /* y = 0 should mean the top of the circle */
-        int32_t y;
-        if(abs_y < radius) {
-            y = radius - abs_y;
-
-            /* Get the x intersection points for `abs_y` and `abs_y-1`
-             * Use the circle's equation x = sqrt(r^2 - y^2)
-             * Try to use the values from the previous run*/
-            if(y == p->y_prev) {
-                x0.f = p->y_prev_x.f;
-                x0.i = p->y_prev_x.i;
+        _lv_sqrt(r2 - (y * y), &x0, sqrt_mask);
+        p->y_prev = y;
+        p->y_prev_x.f = x0.f;
+        p->y_prev_x.i = x0.i;
+    }
+
+    /* If x1 is on the next round coordinate (e.g. x0: 3.5, x1:4.0)
+     * then treat x1 as x1: 3.99 to handle them as they were on the same pixel*/
+    if(x0.i == x1.i - 1 && x1.f == 0) {
+        x1.i--;
+        x1.f = 0xFF;
+    }
+
+    /*If the two x intersections are on the same x then just get average of the fractions*/
+    if(x0.i == x1.i) {
+        lv_opa_t m = (x0.f + x1.f) >> 1;
+        if(outer) m = 255 - m;
+        int32_t ofs = radius - x0.i - 1;
+
+        /*Left corner*/
+        int32_t kl = k + ofs;
+
+        if(kl >= 0 && kl < len) {
+            mask_buf[kl] = mask_mix(mask_buf[kl], m);
+        }
+
+        /*Right corner*/
+        int32_t kr = k + (w - ofs - 1);
+        if(kr >= 0 && kr < len) {
+            mask_buf[kr] = mask_mix(mask_buf[kr], m);
+        }
+
+        /*Clear the unused parts*/
+        if(outer == false) {
+            kr++;
+            if(kl > len)  {
+                return LV_DRAW_MASK_RES_TRANSP;
             }
-            else {
-                _lv_sqrt(r2 - (y * y), &x0, sqrt_mask);
+            if(kl >= 0) {
+                _lv_memset_00(&mask_buf[0], kl);
+            }
+            if(kr < 0) {
+                return LV_DRAW_MASK_RES_TRANSP;
+            }
+            if(kr <= len) {
+                _lv_memset_00(&mask_buf[kr], len - kr);
             }
-            _lv_sqrt(r2 - ((y - 1) * (y - 1)), &x1, sqrt_mask);
-            p->y_prev = y - 1;
-            p->y_prev_x.f = x1.f;
-            p->y_prev_x.i = x1.i;
         }
         else {
-            y = radius - (h - abs_y) + 1;
-
-            /* Get the x intersection points for `abs_y` and `abs_y-1`
-             * Use the circle's equation x = sqrt(r^2 - y^2)
-             * Try to use the values from the previous run*/
-            if((y - 1) == p->y_prev) {
-                x1.f = p->y_prev_x.f;
-                x1.i = p->y_prev_x.i;
+            kl++;
+            int32_t first = kl;
+            if(first < 0) first = 0;
+
+            int32_t len_tmp = kr - first;
+            if(len_tmp + first > len) len_tmp = len - first;
+            if(first < len && len_tmp >= 0) {
+                _lv_memset_00(&mask_buf[first], len_tmp);
             }
-            else {
-                _lv_sqrt(r2 - ((y - 1) * (y - 1)), &x1, sqrt_mask);
+        }
+    }
+    /*Multiple pixels are affected. Get y intersection of the pixels*/
+    else {
+        int32_t ofs = radius - (x0.i + 1);
+        int32_t kl = k + ofs;
+        int32_t kr = k + (w - ofs - 1);
+
+        if(outer) {
+            int32_t first = kl + 1;
+            if(first < 0) first = 0;
+
+            int32_t len_tmp = kr - first;
+            if(len_tmp + first > len) len_tmp = len - first;
+            if(first < len && len_tmp >= 0) {
+                _lv_memset_00(&mask_buf[first], len_tmp);
             }
+        }
 
-            _lv_sqrt(r2 - (y * y), &x0, sqrt_mask);
-            p->y_prev = y;
-            p->y_prev_x.f = x0.f;
-            p->y_prev_x.i = x0.i;
+        uint32_t i = x0.i + 1;
+        lv_opa_t m;
+        lv_sqrt_res_t y_prev;
+        lv_sqrt_res_t y_next;
+
+        _lv_sqrt(r2 - (x0.i * x0.i), &y_prev, sqrt_mask);
+
+        if(y_prev.f == 0) {
+            y_prev.i--;
+            y_prev.f = 0xFF;
         }
 
-        /* If x1 is on the next round coordinate (e.g. x0: 3.5, x1:4.0)
-         * then treat x1 as x1: 3.99 to handle them as they were on the same pixel*/
-        if(x0.i == x1.i - 1 && x1.f == 0) {
-            x1.i--;
-            x1.f = 0xFF;
+        /*The first y intersection is special as it might be in the previous line*/
+        if(y_prev.i >= y) {
+            _lv_sqrt(r2 - (i * i), &y_next, sqrt_mask);
+            m = 255 - (((255 - x0.f) * (255 - y_next.f)) >> 9);
+
+            if(outer) m = 255 - m;
+            if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
+            if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
+            kl--;
+            kr++;
+            y_prev.f = y_next.f;
+            i++;
         }
 
-        /*If the two x intersections are on the same x then just get average of the fractions*/
-        if(x0.i == x1.i) {
-            lv_opa_t m = (x0.f + x1.f) >> 1;
+        /*Set all points which are crossed by the circle*/
+        for(; i <= x1.i; i++) {
+            /* These values are very close to each other. It's enough to approximate sqrt
+             * The non-approximated version is lv_sqrt(r2 - (i * i), &y_next, sqrt_mask); */
+            sqrt_approx(&y_next, &y_prev, r2 - (i * i));
+
+            m = (y_prev.f + y_next.f) >> 1;
             if(outer) m = 255 - m;
-            int32_t ofs = radius - x0.i - 1;
+            if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
+            if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
+            kl--;
+            kr++;
+            y_prev.f = y_next.f;
+        }
 
-            /*Left corner*/
-            int32_t kl = k + ofs;
+        /*If the last pixel was left in its middle therefore
+         * the circle still has parts on the next one*/
+        if(y_prev.f) {
+            m = (y_prev.f * x1.f) >> 9;
+            if(outer) m = 255 - m;
+            if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
+            if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
+            kl--;
+            kr++;
+        }
 
-            if(kl >= 0 && kl < len) {
-                mask_buf[kl] = mask_mix(mask_buf[kl], m);
+        if(outer == 0) {
+            kl++;
+            if(kl > len) {
+                return LV_DRAW_MASK_RES_TRANSP;
             }
+            if(kl >= 0) _lv_memset_00(&mask_buf[0], kl);
 
-            /*Right corner*/
-            int32_t kr = k + (w - ofs - 1);
-            if(kr >= 0 && kr < len) {
-                mask_buf[kr] = mask_mix(mask_buf[kr], m);
+            if(kr < 0) {
+                return LV_DRAW_MASK_RES_TRANSP;
             }
+            if(kr < len) _lv_memset_00(&mask_buf[kr], len - kr);
+        }
+    }
 
-            /*Clear the unused parts*/
-            if(outer == false) {
-                kr++;
-                if(kl > len)  {
-                    return LV_DRAW_MASK_RES_TRANSP;
-                }
-                if(kl >= 0) {
-                    _lv_memset_00(&mask_buf[0], kl);
-                }
-                if(kr < 0) {
-                    return LV_DRAW_MASK_RES_TRANSP;
-                }
-                if(kr <= len) {
-                    _lv_memset_00(&mask_buf[kr], len - kr);
-                }
-            }
-            else {
-                kl++;
-                int32_t first = kl;
-                if(first < 0) first = 0;
-
-                int32_t len_tmp = kr - first;
-                if(len_tmp + first > len) len_tmp = len - first;
-                if(first < len && len_tmp >= 0) {
-                    _lv_memset_00(&mask_buf[first], len_tmp);
-                }
+    return LV_DRAW_MASK_RES_CHANGED;
+}
+
+/**
+ * Set a row of a corner of a radius mask from a cached circle
+ * @param mask_buf the mask of the row
+ * @param k the index of the rectangle's left edge in `mask_buf`
+ * @param w width of the rectangle
+ * @param len length of `mask_buf`
+ * @param circle the circle with the mask's radius
+ * @param row index of the row from the top or bottom edge of the rectangle
+ * @param outer true: keep the pixels outside of the rectangle
+ * @return `LV_DRAW_MASK_RES_TRANSP` or `LV_DRAW_MASK_RES_CHANGED`
+ */
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_corner_cached(lv_opa_t * mask_buf, int32_t k, int32_t w,
+                                                                     lv_coord_t len,
+                                                                     const _lv_draw_mask_radius_circle_t * circle,
+                                                                     int32_t row, bool outer)
+{
+    const radius_row_t * rows = (const radius_row_t *)(circle + 1);
+    const lv_opa_t * opa = (const lv_opa_t *)(rows + circle->radius) + rows[row].opa_ofs;
+    int32_t aa_len = rows[row].len;
+    int32_t kl = k + rows[row].start;           /*The first anti-aliased column on the left*/
+    int32_t kr = k + w - 1 - rows[row].start;   /*The same on the right*/
+
+    if(outer == false) {
+        if(kl >= len || kr < 0) return LV_DRAW_MASK_RES_TRANSP;
+        if(kl > 0) _lv_memset_00(&mask_buf[0], kl);
+        if(kr + 1 < len) _lv_memset_00(&mask_buf[kr + 1], len - kr - 1);
+    }
+    else {
+        /*Clear between the anti-aliased columns*/
+        int32_t first = LV_MATH_MAX(kl + aa_len, 0);
+        int32_t last = LV_MATH_MIN(kr - aa_len + 1, len);
+        if(first < last) _lv_memset_00(&mask_buf[first], last - first);
+    }
+
+    int32_t i;
+    for(i = 0; i < aa_len; i++) {
+        lv_opa_t m = outer ? 255 - opa[i] : opa[i];
+        if(kl + i >= 0 && kl + i < len) mask_buf[kl + i] = mask_mix(mask_buf[kl + i], m);
+        if(kr - i >= 0 && kr - i < len) mask_buf[kr - i] = mask_mix(mask_buf[kr - i], m);
+    }
+
+    return LV_DRAW_MASK_RES_CHANGED;
+}
+
+/**
+ * Get the circle of a radius from the cache of the calling thread. Calculate and add it if it's not there yet.
+ * @param radius a radius
+ * @return the circle or NULL if it doesn't fit into the cache
+ */
+static const _lv_draw_mask_radius_circle_t * radius_cache_get(lv_coord_t radius)
+{
+    _lv_draw_mask_radius_cache_t * cache = &LV_GC_ROOT_LOCAL(_lv_draw_mask_radius_cache);
+    if(cache->size > radius_cache_max) radius_cache_trim(cache, radius_cache_max);
+
+    _lv_draw_mask_radius_circle_t * prev = NULL;
+    _lv_draw_mask_radius_circle_t * circle;
+    for(circle = cache->first; circle; circle = circle->next) {
+        if(circle->radius == radius) {
+            if(prev) {
+                prev->next = circle->next;
+                circle->next = cache->first;
+                cache->first = circle;
             }
+            return circle;
         }
-        /*Multiple pixels are affected. Get y intersection of the pixels*/
-        else {
-            int32_t ofs = radius - (x0.i + 1);
-            int32_t kl = k + ofs;
-            int32_t kr = k + (w - ofs - 1);
-
-            if(outer) {
-                int32_t first = kl + 1;
-                if(first < 0) first = 0;
-
-                int32_t len_tmp = kr - first;
-                if(len_tmp + first > len) len_tmp = len - first;
-                if(first < len && len_tmp >= 0) {
-                    _lv_memset_00(&mask_buf[first], len_tmp);
-                }
-            }
+        prev = circle;
+    }
 
-            uint32_t i = x0.i + 1;
-            lv_opa_t m;
-            lv_sqrt_res_t y_prev;
-            lv_sqrt_res_t y_next;
+    uint32_t size = sizeof(_lv_draw_mask_radius_circle_t) + radius * (sizeof(radius_row_t) + RADIUS_CACHE_OPA_ROW);
+    if(size > radius_cache_max) return NULL;
 
-            _lv_sqrt(r2 - (x0.i * x0.i), &y_prev, sqrt_mask);
+    /*Free the least recently used circles to make room for the new one*/
+    radius_cache_trim(cache, radius_cache_max - size);
 
-            if(y_prev.f == 0) {
-                y_prev.i--;
-                y_prev.f = 0xFF;
-            }
+    circle = lv_mem_alloc(size);
+    if(circle == NULL) return NULL;
+    if(radius_circle_calc(circle, radius, size) == false) {
+        LV_LOG_WARN("radius_cache_get: the corner of the circle doesn't fit into its buffer");
+        lv_mem_free(circle);
+        return NULL;
+    }
 
-            /*The first y intersection is special as it might be in the previous line*/
-            if(y_prev.i >= y) {
-                _lv_sqrt(r2 - (i * i), &y_next, sqrt_mask);
-                m = 255 - (((255 - x0.f) * (255 - y_next.f)) >> 9);
-
-                if(outer) m = 255 - m;
-                if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
-                if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
-                kl--;
-                kr++;
-                y_prev.f = y_next.f;
-                i++;
-            }
+    /*Give back the opacities not used*/
+    circle = lv_mem_realloc(circle, circle->size);
+    LV_ASSERT_MEM(circle);
+    if(circle == NULL) return NULL;
 
-            /*Set all points which are crossed by the circle*/
-            for(; i <= x1.i; i++) {
-                /* These values are very close to each other. It's enough to approximate sqrt
-                 * The non-approximated version is lv_sqrt(r2 - (i * i), &y_next, sqrt_mask); */
-                sqrt_approx(&y_next, &y_prev, r2 - (i * i));
-
-                m = (y_prev.f + y_next.f) >> 1;
-                if(outer) m = 255 - m;
-                if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
-                if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
-                kl--;
-                kr++;
-                y_prev.f = y_next.f;
-            }
+    circle->next = cache->first;
+    cache->first = circle;
+    cache->size += circle->size;
+    return circle;
+}
 
-            /*If the last pixel was left in its middle therefore
-             * the circle still has parts on the next one*/
-            if(y_prev.f) {
-                m = (y_prev.f * x1.f) >> 9;
-                if(outer) m = 255 - m;
-                if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
-                if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
-                kl--;
-                kr++;
-            }
+/**
+ * Calculate the top left corner of a circle with `radius_corner_calc`
+ * @param circle store the circle here
+ * @param radius the radius of the circle
+ * @param size size of `circle` in bytes
+ * @return true: the corner fit into `size`
+ */
+static bool radius_circle_calc(_lv_draw_mask_radius_circle_t * circle, lv_coord_t radius, uint32_t size)
+{
+    radius_row_t * rows = (radius_row_t *)(circle + 1);
+    lv_opa_t * opas = (lv_opa_t *)(rows + radius);
+    uint32_t opa_max = size - ((uint8_t *)opas - (uint8_t *)circle);
+    uint32_t opa_cnt = 0;
 
-            if(outer == 0) {
-                kl++;
-                if(kl > len) {
-                    return LV_DRAW_MASK_RES_TRANSP;
-                }
-                if(kl >= 0) _lv_memset_00(&mask_buf[0], kl);
+    /*Calculate the corners of a circle as a rounded rectangle's*/
+    lv_area_t rect;
+    lv_area_set(&rect, RADIUS_CACHE_PAD, 0, RADIUS_CACHE_PAD + 2 * radius - 1, 2 * radius - 1);
+    lv_draw_mask_radius_param_t p;
+    lv_draw_mask_radius_init(&p, &rect, radius, false);
+
+    int32_t buf_len = RADIUS_CACHE_PAD + radius;
+    lv_opa_t * buf = _lv_mem_buf_get(buf_len);
+    bool fit = true;
+    int32_t y;
+    for(y = 0; y < radius; y++) {
+        _lv_memset_ff(buf, buf_len);
+        if(radius_corner_calc(buf, RADIUS_CACHE_PAD, y, buf_len, &p) == LV_DRAW_MASK_RES_TRANSP) {
+            _lv_memset_00(buf, buf_len);
+        }
 
-                if(kr < 0) {
-                    return LV_DRAW_MASK_RES_TRANSP;
-                }
-                if(kr < len) _lv_memset_00(&mask_buf[kr], len - kr);
-            }
+        /*The row is transparent, anti-aliased then fully covered from left to right*/
+        int32_t first = 0;
+        while(first < buf_len && buf[first] == LV_OPA_TRANSP) first++;
+        int32_t last = buf_len;
+        while(last > first && buf[last - 1] == LV_OPA_COVER) last--;
+
+        if(first == 0 || opa_cnt + (last - first) > opa_max) {
+            fit = false;
+            break;
         }
+
+        rows[y].opa_ofs = opa_cnt;
+        rows[y].start = first - RADIUS_CACHE_PAD;
+        rows[y].len = last - first;
+        _lv_memcpy_small(&opas[opa_cnt], &buf[first], last - first);
+        opa_cnt += last - first;
     }
+    _lv_mem_buf_release(buf);
 
-    return LV_DRAW_MASK_RES_CHANGED;
+    circle->radius = radius;
+    circle->size = (uint32_t)((uint8_t *)opas - (uint8_t *)circle) + opa_cnt;
+    return fit;
+}
+
+/**
+ * Free the least recently used circles of a cache
+ * @param cache a radius cache
+ * @param size free circles until the cache is not larger than this
+ */
+static void radius_cache_trim(_lv_draw_mask_radius_cache_t * cache, uint32_t size)
+{
+    while(cache->size > size) {
+        _lv_draw_mask_radius_circle_t ** last = &cache->first;
+        while((*last)->next) last = &(*last)->next;
+
+        cache->size -= (*last)->size;
+        lv_mem_free(*last);
+        *last = NULL;
+    }
 }
 
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_fade(lv_opa_t * mask_buf, lv_coord_t abs_x,
@@ -167,6 +167,19 @@ typedef struct {
 
 typedef _lv_draw_mask_saved_t _lv_draw_mask_saved_arr_t[_LV_MASK_MAX_NUM];
 
+/*The anti-aliased corner of a circle. The rows of the corner and their opacities follow it in the same allocation*/
+typedef struct _lv_draw_mask_radius_circle_t {
+    struct _lv_draw_mask_radius_circle_t * next;
+    uint32_t size;      /*Bytes allocated for the circle*/
+    lv_coord_t radius;
+} _lv_draw_mask_radius_circle_t;
+
+/*The circles of the radius masks, see `LV_RADIUS_CACHE_SIZE`*/
+typedef struct {
+    _lv_draw_mask_radius_circle_t * first;  /*The most recently used circle first*/
+    uint32_t size;                          /*Bytes used by the circles*/
+} _lv_draw_mask_radius_cache_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -270,6 +283,13 @@ void lv_draw_mask_angle_init(lv_draw_mask_angle_param_t * param, lv_coord_t vert
  */
 void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area_t * rect, lv_coord_t radius, bool inv);
 
+/**
+ * Set the RAM the radius masks can use to keep the corners of their circles.
+ * The render worker thread has an other cache of the same size.
+ * @param size the size in bytes, 0: calculate every corner row when it's drawn
+ */
+void lv_draw_mask_radius_cache_set_size(uint32_t size);
+
 /**
  * Initialize a fade mask.
  * @param param pointer to a `lv_draw_mask_param_t` to initialize
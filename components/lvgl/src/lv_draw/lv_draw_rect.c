@@ -13,6 +13,7 @@
 #include "../lv_misc/lv_txt_ap.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_debug.h"
+#include "../lv_misc/lv_gc.h"
 
 /*********************
  *      DEFINES
@@ -42,6 +43,11 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
 LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords,  uint16_t * sh_buf, lv_coord_t s,
                                                          lv_coord_t r);
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+#if LV_SHADOW_CACHE_SIZE
+    static lv_opa_t * shadow_cache_get(const lv_area_t * sh_rect_area, lv_coord_t sw, lv_coord_t r);
+    static void shadow_cache_add(const lv_area_t * sh_rect_area, lv_coord_t sw, lv_coord_t r, const lv_opa_t * sh_buf);
+    static void shadow_cache_trim(_lv_draw_shadow_cache_t * cache, uint32_t size);
+#endif
 #endif
 
 #if LV_USE_PATTERN
@@ -59,9 +65,7 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t
  *  STATIC VARIABLES
  **********************/
 #if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
+    static uint32_t shadow_cache_max = LV_SHADOW_CACHE_MEM_SIZE;
 #endif
 
 /**********************
@@ -125,6 +129,43 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * clip, const lv_dra
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+/**
+ * Set the RAM the blurred corners of the shadows can use.
+ * The least recently used corners are freed if they take more.
+ * @param size the size in bytes, 0: calculate the corner of every shadow when it's drawn
+ */
+void lv_draw_rect_shadow_cache_set_size(uint32_t size)
+{
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    _lv_refr_worker_lock();
+    shadow_cache_max = size;
+    shadow_cache_trim(&LV_GC_ROOT(_lv_draw_shadow_cache), size);
+    _lv_refr_worker_unlock();
+#else
+    LV_UNUSED(size);
+#endif
+}
+
+/**
+ * Get how many shadows were drawn with a cached corner since `lv_init`
+ * @param hit_cnt store the number of shadows drawn with a cached corner here (can be NULL)
+ * @param miss_cnt store the number of shadows whose corner was calculated here (can be NULL)
+ * @return the hit rate in percentage (0..100), 0 if no shadows were drawn
+ */
+uint8_t lv_draw_rect_shadow_cache_get_hit_rate(uint32_t * hit_cnt, uint32_t * miss_cnt)
+{
+    _lv_refr_worker_lock();
+    uint32_t hit = LV_GC_ROOT(_lv_draw_shadow_cache).hit_cnt;
+    uint32_t miss = LV_GC_ROOT(_lv_draw_shadow_cache).miss_cnt;
+    _lv_refr_worker_unlock();
+
+    if(hit_cnt) *hit_cnt = hit;
+    if(miss_cnt) *miss_cnt = miss;
+    if(hit + miss == 0) return 0;
+
+    return (uint64_t)hit * 100 / (hit + miss);
+}
+
 /**
  * Draw a pixel
  * @param point the coordinates of the point to draw
@@ -591,22 +632,13 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = _lv_mem_buf_get(corner_size * corner_size);
-        _lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
-    }
-    else {
+    /*Use the cache if available*/
+    sh_buf = shadow_cache_get(&sh_rect_area, sw, r_sh);
+    if(sh_buf == NULL) {
         /*A larger buffer is required for calculation */
         sh_buf = _lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&sh_rect_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if(corner_size * corner_size < sizeof(sh_cache)) {
-            _lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
-        }
+        shadow_cache_add(&sh_rect_area, sw, r_sh, sh_buf);
     }
 #else
     sh_buf = _lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
@@ -1157,6 +1189,122 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
     _lv_mem_buf_release(sh_ups_blur_buf);
 }
 
+#if LV_SHADOW_CACHE_SIZE
+
+/**
+ * Copy the corner of a shadow from the cache into a `_lv_mem_buf`
+ * @param sh_rect_area the rectangle of the shadow (`coords` with offset and spread)
+ * @param sw shadow width
+ * @param r radius of the shadow
+ * @return a buffer with the corner to release with `_lv_mem_buf_release` or NULL if it's not cached
+ */
+static lv_opa_t * shadow_cache_get(const lv_area_t * sh_rect_area, lv_coord_t sw, lv_coord_t r)
+{
+    /*Above twice the corner size the rectangle's other corners don't reach the calculated one*/
+    int32_t corner_size = sw + r;
+    lv_coord_t w = LV_MATH_MIN(lv_area_get_width(sh_rect_area), 2 * corner_size);
+    lv_coord_t h = LV_MATH_MIN(lv_area_get_height(sh_rect_area), 2 * corner_size);
+
+    /*The corners are shared with the render worker thread*/
+    _lv_refr_worker_lock();
+    _lv_draw_shadow_cache_t * cache = &LV_GC_ROOT(_lv_draw_shadow_cache);
+    _lv_draw_shadow_corner_t * prev = NULL;
+    _lv_draw_shadow_corner_t * corner;
+    for(corner = cache->first; corner; corner = corner->next) {
+        if(corner->sw == sw && corner->r == r && corner->w == w && corner->h == h) break;
+        prev = corner;
+    }
+
+    if(corner == NULL) {
+        cache->miss_cnt++;
+        _lv_refr_worker_unlock();
+        return NULL;
+    }
+
+    if(prev) {
+        prev->next = corner->next;
+        corner->next = cache->first;
+        cache->first = corner;
+    }
+    cache->hit_cnt++;
+
+    lv_opa_t * sh_buf = _lv_mem_buf_get(corner_size * corner_size);
+    _lv_memcpy(sh_buf, corner + 1, corner_size * corner_size);
+    _lv_refr_worker_unlock();
+
+    return sh_buf;
+}
+
+/**
+ * Add the calculated corner of a shadow to the cache if it fits.
+ * Free the least recently used corners to make room for it.
+ * @param sh_rect_area the rectangle of the shadow (`coords` with offset and spread)
+ * @param sw shadow width
+ * @param r radius of the shadow
+ * @param sh_buf the corner calculated by `shadow_draw_corner_buf`
+ */
+static void shadow_cache_add(const lv_area_t * sh_rect_area, lv_coord_t sw, lv_coord_t r, const lv_opa_t * sh_buf)
+{
+    int32_t corner_size = sw + r;
+    if(corner_size > LV_SHADOW_CACHE_SIZE) return;
+
+    lv_coord_t w = LV_MATH_MIN(lv_area_get_width(sh_rect_area), 2 * corner_size);
+    lv_coord_t h = LV_MATH_MIN(lv_area_get_height(sh_rect_area), 2 * corner_size);
+    uint32_t size = sizeof(_lv_draw_shadow_corner_t) + corner_size * corner_size;
+
+    _lv_refr_worker_lock();
+    _lv_draw_shadow_cache_t * cache = &LV_GC_ROOT(_lv_draw_shadow_cache);
+    if(size > shadow_cache_max) {
+        _lv_refr_worker_unlock();
+        return;
+    }
+
+    /*The other thread might have added the same corner in the meantime*/
+    _lv_draw_shadow_corner_t * corner;
+    for(corner = cache->first; corner; corner = corner->next) {
+        if(corner->sw == sw && corner->r == r && corner->w == w && corner->h == h) {
+            _lv_refr_worker_unlock();
+            return;
+        }
+    }
+
+    shadow_cache_trim(cache, shadow_cache_max - size);
+
+    corner = LV_SHADOW_CACHE_ALLOC(size);
+    if(corner) {
+        corner->size = size;
+        corner->sw = sw;
+        corner->r = r;
+        corner->w = w;
+        corner->h = h;
+        _lv_memcpy(corner + 1, sh_buf, corner_size * corner_size);
+
+        corner->next = cache->first;
+        cache->first = corner;
+        cache->size += size;
+    }
+    _lv_refr_worker_unlock();
+}
+
+/**
+ * Free the least recently used corners of the shadow cache
+ * @param cache the shadow cache
+ * @param size free corners until the cache is not larger than this
+ */
+static void shadow_cache_trim(_lv_draw_shadow_cache_t * cache, uint32_t size)
+{
+    while(cache->size > size) {
+        _lv_draw_shadow_corner_t ** last = &cache->first;
+        while((*last)->next) last = &(*last)->next;
+
+        cache->size -= (*last)->size;
+        LV_SHADOW_CACHE_FREE(*last);
+        *last = NULL;
+    }
+}
+
+#endif /*LV_SHADOW_CACHE_SIZE*/
+
 #endif
 
 #if LV_USE_OUTLINE
@@ -81,6 +81,24 @@ typedef struct {
     lv_blend_mode_t value_blend_mode;
 } lv_draw_rect_dsc_t;
 
+/*A blurred shadow corner. Its `(sw + r)^2` opacities follow it in the same allocation*/
+typedef struct _lv_draw_shadow_corner_t {
+    struct _lv_draw_shadow_corner_t * next;
+    uint32_t size;      /*Bytes allocated for the corner*/
+    lv_coord_t sw;      /*Shadow width*/
+    lv_coord_t r;       /*Radius of the shadow*/
+    lv_coord_t w;       /*Width and height of the shadow's rectangle (limited as it doesn't matter above a size)*/
+    lv_coord_t h;
+} _lv_draw_shadow_corner_t;
+
+/*The corners of the last drawn shadows, see `LV_SHADOW_CACHE_MEM_SIZE`*/
+typedef struct {
+    _lv_draw_shadow_corner_t * first;   /*The most recently used corner first*/
+    uint32_t size;                      /*Bytes used by the corners*/
+    uint32_t hit_cnt;                   /*Shadows drawn with a cached corner*/
+    uint32_t miss_cnt;                  /*Shadows whose corner was calculated*/
+} _lv_draw_shadow_cache_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -97,6 +115,21 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_rect_dsc_init(lv_draw_rect_dsc_t * dsc);
  */
 void lv_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_draw_rect_dsc_t * dsc);
 
+/**
+ * Set the RAM the blurred corners of the shadows can use.
+ * The least recently used corners are freed if they take more.
+ * @param size the size in bytes, 0: calculate the corner of every shadow when it's drawn
+ */
+void lv_draw_rect_shadow_cache_set_size(uint32_t size);
+
+/**
+ * Get how many shadows were drawn with a cached corner since `lv_init`
+ * @param hit_cnt store the number of shadows drawn with a cached corner here (can be NULL)
+ * @param miss_cnt store the number of shadows whose corner was calculated here (can be NULL)
+ * @return the hit rate in percentage (0..100), 0 if no shadows were drawn
+ */
+uint8_t lv_draw_rect_shadow_cache_get_hit_rate(uint32_t * hit_cnt, uint32_t * miss_cnt);
+
 /**
  * Draw a pixel
  * @param point the coordinates of the point to draw
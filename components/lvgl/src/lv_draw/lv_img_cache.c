@@ -11,20 +11,12 @@
 #include "lv_img_decoder.h"
 #include "lv_draw_img.h"
 #include "../lv_hal/lv_hal_tick.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_gc.h"
 
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value on every open*/
-#define LV_IMG_CACHE_AGING 1
-
-/*Boost life by this factor (multiply time_to_open with this value)*/
-#define LV_IMG_CACHE_LIFE_GAIN 1
-
-/*Don't let life to be greater than this limit because it would require a lot of time to
- * "die" from very high values */
-#define LV_IMG_CACHE_LIFE_LIMIT 1000
 
 /**********************
  *      TYPEDEFS
@@ -34,7 +26,11 @@
  *  STATIC PROTOTYPES
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
+static uint32_t lv_img_cache_hash(const void * src);
 static bool lv_img_cache_match(const void * src1, const void * src2);
+static void lv_img_cache_use(_lv_img_cache_t * cache, lv_img_cache_entry_t * entry);
+static void lv_img_cache_close(_lv_img_cache_t * cache, lv_img_cache_entry_t * entry);
+static void lv_img_cache_trim(_lv_img_cache_t * cache);
 #endif
 
 #if LV_IMG_CACHE_DEF_SIZE == 0
@@ -45,7 +41,8 @@ static bool lv_img_cache_match(const void * src1, const void * src2);
  *  STATIC VARIABLES
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
-    static uint16_t entry_cnt;
+    static uint16_t entry_max;
+    static uint32_t mem_max = LV_IMG_CACHE_MEM_SIZE;
 #endif
 
 /**********************
@@ -70,54 +67,41 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
     lv_img_cache_entry_t * cached_src = NULL;
 
 #if LV_IMG_CACHE_DEF_SIZE
-    if(entry_cnt == 0) {
+    _lv_img_cache_t * cache = &LV_GC_ROOT(_lv_img_cache);
+    if(entry_max == 0 || cache->buckets == NULL) {
         LV_LOG_WARN("lv_img_cache_open: the cache size is 0");
         return NULL;
     }
 
-    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
-    }
-
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
-           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            /* If opened increment its life.
-             * Image difficult to open should live longer to keep avoid frequent their recaching.
-             * Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
+    uint32_t hash = lv_img_cache_hash(src);
+    lv_img_cache_entry_t ** bucket = &cache->buckets[hash & (cache->bucket_cnt - 1)];
+    for(cached_src = *bucket; cached_src; cached_src = cached_src->hash_next) {
+        if(cached_src->hash == hash && color.full == cached_src->dec_dsc.color.full &&
+           lv_img_cache_match(src, cached_src->dec_dsc.src)) {
+            lv_img_cache_use(cache, cached_src);
+            cache->hit_cnt++;
             LV_LOG_TRACE("image draw: image found in the cache");
-            break;
+            return cached_src;
         }
     }
 
     /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
-
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
-        }
-    }
+    cache->miss_cnt++;
 
-    /*Close the decoder to reuse if it was opened (has a valid source)*/
-    if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
+    /*Close the least recently used image to reuse its place*/
+    if(cache->entry_cnt >= entry_max) {
+        lv_img_cache_close(cache, cache->lru_last);
+        cache->evict_cnt++;
         LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
     }
     else {
         LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
     }
+
+    cached_src = lv_mem_alloc(sizeof(lv_img_cache_entry_t));
+    LV_ASSERT_MEM(cached_src);
+    if(cached_src == NULL) return NULL;
+    _lv_memset_00(cached_src, sizeof(lv_img_cache_entry_t));
 #else
     cached_src = &cache_temp;
 #endif
@@ -126,13 +110,14 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
     lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color);
     if(open_res == LV_RES_INV) {
         LV_LOG_WARN("Image draw cannot open the image resource");
+#if LV_IMG_CACHE_DEF_SIZE
+        lv_mem_free(cached_src);
+#else
         _lv_memset_00(cached_src, sizeof(lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its use  */
+#endif
         return NULL;
     }
 
-    cached_src->life = 0;
-
     /*If `time_to_open` was not set in the open function set it here*/
     if(cached_src->dec_dsc.time_to_open == 0) {
         cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
@@ -140,6 +125,21 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
 
     if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
 
+#if LV_IMG_CACHE_DEF_SIZE
+    cached_src->hash = hash;
+    cached_src->size = sizeof(lv_img_cache_entry_t) + cached_src->dec_dsc.mem_size;
+    /*Count the copy of the file name too*/
+    if(cached_src->dec_dsc.src_type == LV_IMG_SRC_FILE) cached_src->size += strlen(cached_src->dec_dsc.src) + 1;
+
+    cached_src->hash_next = *bucket;
+    *bucket = cached_src;
+    lv_img_cache_use(cache, cached_src);
+    cache->entry_cnt++;
+    cache->size += cached_src->size;
+
+    lv_img_cache_trim(cache);
+#endif
+
     return cached_src;
 }
 
@@ -155,23 +155,49 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
     LV_UNUSED(new_entry_cnt);
     LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
 #else
-    if(LV_GC_ROOT(_lv_img_cache_array) != NULL) {
+    _lv_refr_worker_lock();
+    _lv_img_cache_t * cache = &LV_GC_ROOT(_lv_img_cache);
+    if(cache->buckets != NULL) {
         /*Clean the cache before free it*/
         lv_img_cache_invalidate_src(NULL);
-        lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
+        lv_mem_free(cache->buckets);
     }
 
-    /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt);
-    LV_ASSERT_MEM(LV_GC_ROOT(_lv_img_cache_array));
-    if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
-        entry_cnt = 0;
+    /*Reallocate the hash table. Have about one entry in a bucket when the cache is full.*/
+    cache->bucket_cnt = 1;
+    while(cache->bucket_cnt < new_entry_cnt) cache->bucket_cnt <<= 1;
+
+    cache->buckets = lv_mem_alloc(sizeof(lv_img_cache_entry_t *) * cache->bucket_cnt);
+    LV_ASSERT_MEM(cache->buckets);
+    if(cache->buckets == NULL) {
+        entry_max = 0;
+        _lv_refr_worker_unlock();
         return;
     }
-    entry_cnt = new_entry_cnt;
+    entry_max = new_entry_cnt;
 
     /*Clean the cache*/
-    _lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(lv_img_cache_entry_t));
+    _lv_memset_00(cache->buckets, sizeof(lv_img_cache_entry_t *) * cache->bucket_cnt);
+    _lv_refr_worker_unlock();
+#endif
+}
+
+/**
+ * Set the RAM the cached images can use, including the memory allocated by the image decoders.
+ * The least recently used images are closed if the cache gets larger.
+ * The last opened image is kept even if it's larger alone.
+ * @param size the size in bytes, 0: no limit, only the number of images is limited
+ */
+void lv_img_cache_set_mem_size(uint32_t size)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(size);
+    LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    _lv_refr_worker_lock();
+    mem_max = size;
+    lv_img_cache_trim(&LV_GC_ROOT(_lv_img_cache));
+    _lv_refr_worker_unlock();
 #endif
 }
 
@@ -183,18 +209,45 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
 void lv_img_cache_invalidate_src(const void * src)
 {
 #if LV_IMG_CACHE_DEF_SIZE
-    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
+    _lv_refr_worker_lock();
+    _lv_img_cache_t * cache = &LV_GC_ROOT(_lv_img_cache);
+    if(src == NULL) {
+        while(cache->lru_first) lv_img_cache_close(cache, cache->lru_first);
+    }
+    else if(cache->buckets) {
+        /*The same source might be cached with more colors*/
+        uint32_t hash = lv_img_cache_hash(src);
+        lv_img_cache_entry_t * entry = cache->buckets[hash & (cache->bucket_cnt - 1)];
+        while(entry) {
+            lv_img_cache_entry_t * next = entry->hash_next;
+            if(entry->hash == hash && lv_img_cache_match(src, entry->dec_dsc.src)) {
+                lv_img_cache_close(cache, entry);
             }
-
-            _lv_memset_00(&cache[i], sizeof(lv_img_cache_entry_t));
+            entry = next;
         }
     }
+    _lv_refr_worker_unlock();
+#else
+    LV_UNUSED(src);
+#endif
+}
+
+/**
+ * Get the statistics of the image cache. The counters are cumulated since `lv_init`.
+ * @param stat store the statistics here
+ */
+void lv_img_cache_get_stat(lv_img_cache_stat_t * stat)
+{
+    _lv_memset_00(stat, sizeof(lv_img_cache_stat_t));
+#if LV_IMG_CACHE_DEF_SIZE
+    _lv_refr_worker_lock();
+    _lv_img_cache_t * cache = &LV_GC_ROOT(_lv_img_cache);
+    stat->hit_cnt = cache->hit_cnt;
+    stat->miss_cnt = cache->miss_cnt;
+    stat->evict_cnt = cache->evict_cnt;
+    stat->entry_cnt = cache->entry_cnt;
+    stat->size = cache->size;
+    _lv_refr_worker_unlock();
 #endif
 }
 
@@ -203,6 +256,26 @@ void lv_img_cache_invalidate_src(const void * src)
  **********************/
 
 #if LV_IMG_CACHE_DEF_SIZE
+/**
+ * Hash an image source: the address of a variable or the characters of a file name
+ */
+static uint32_t lv_img_cache_hash(const void * src)
+{
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) {
+        return (uint32_t)((lv_uintptr_t)src >> 2) * 2654435761u;
+    }
+
+    /*FNV-1a*/
+    const uint8_t * txt = src;
+    uint32_t hash = 2166136261u;
+    while(*txt) {
+        hash = (hash ^ *txt) * 16777619u;
+        txt++;
+    }
+
+    return hash;
+}
+
 static bool lv_img_cache_match(const void * src1, const void * src2)
 {
     lv_img_src_t src_type = lv_img_src_get_type(src1);
@@ -214,4 +287,58 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+/**
+ * Move an entry to the front of the LRU list
+ */
+static void lv_img_cache_use(_lv_img_cache_t * cache, lv_img_cache_entry_t * entry)
+{
+    if(cache->lru_first == entry) return;
+
+    /*Unlink if it's in the list*/
+    if(entry->lru_prev) entry->lru_prev->lru_next = entry->lru_next;
+    if(entry->lru_next) entry->lru_next->lru_prev = entry->lru_prev;
+    if(cache->lru_last == entry) cache->lru_last = entry->lru_prev;
+
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_first;
+    if(cache->lru_first) cache->lru_first->lru_prev = entry;
+    cache->lru_first = entry;
+    if(cache->lru_last == NULL) cache->lru_last = entry;
+}
+
+/**
+ * Close the image of an entry and remove the entry from the cache
+ */
+static void lv_img_cache_close(_lv_img_cache_t * cache, lv_img_cache_entry_t * entry)
+{
+    lv_img_cache_entry_t ** next_p = &cache->buckets[entry->hash & (cache->bucket_cnt - 1)];
+    while(*next_p != entry) next_p = &(*next_p)->hash_next;
+    *next_p = entry->hash_next;
+
+    if(entry->lru_prev) entry->lru_prev->lru_next = entry->lru_next;
+    else cache->lru_first = entry->lru_next;
+    if(entry->lru_next) entry->lru_next->lru_prev = entry->lru_prev;
+    else cache->lru_last = entry->lru_prev;
+
+    cache->entry_cnt--;
+    cache->size -= entry->size;
+
+    lv_img_decoder_close(&entry->dec_dsc);
+    lv_mem_free(entry);
+}
+
+/**
+ * Close the least recently used images until the cache fits into `mem_max`.
+ * Keep the last used image.
+ */
+static void lv_img_cache_trim(_lv_img_cache_t * cache)
+{
+    if(mem_max == 0) return;
+
+    while(cache->size > mem_max && cache->lru_last != cache->lru_first) {
+        lv_img_cache_close(cache, cache->lru_last);
+        cache->evict_cnt++;
+    }
+}
 #endif
@@ -28,15 +28,40 @@ extern "C" {
  *
  * To avoid repeating this heavy load images can be cached.
  */
-typedef struct {
+typedef struct _lv_img_cache_entry_t {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information */
 
-    /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused */
-    int32_t life;
+    struct _lv_img_cache_entry_t * hash_next;   /**< Next entry in the same hash bucket*/
+    struct _lv_img_cache_entry_t * lru_prev;    /**< More recently used entry*/
+    struct _lv_img_cache_entry_t * lru_next;    /**< Less recently used entry*/
+    uint32_t hash;                              /**< Hash of `dec_dsc.src`*/
+    uint32_t size;                              /**< Bytes used by the entry and its opened image*/
 } lv_img_cache_entry_t;
 
+/*The opened images, hashed by their source and ordered by their last use*/
+typedef struct {
+    lv_img_cache_entry_t ** buckets;    /*`bucket_cnt` lists of entries with the same hash*/
+    lv_img_cache_entry_t * lru_first;   /*The most recently used entry*/
+    lv_img_cache_entry_t * lru_last;    /*The least recently used entry*/
+    uint32_t bucket_cnt;                /*Power of 2*/
+    uint32_t entry_cnt;
+    uint32_t size;                      /*Bytes used by the entries and their opened images*/
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
+    uint32_t evict_cnt;
+} _lv_img_cache_t;
+
+/**
+ * Statistics of the image cache
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Images found opened in the cache*/
+    uint32_t miss_cnt;      /**< Images opened because they weren't in the cache*/
+    uint32_t evict_cnt;     /**< Images closed to make room for others*/
+    uint32_t entry_cnt;     /**< Images opened in the cache now*/
+    uint32_t size;          /**< Bytes used by the cache now, including the memory of the image decoders*/
+} lv_img_cache_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -59,6 +84,20 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color);
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Set the RAM the cached images can use, including the memory allocated by the image decoders.
+ * The least recently used images are closed if the cache gets larger.
+ * The last opened image is kept even if it's larger alone.
+ * @param size the size in bytes, 0: no limit, only the number of images is limited
+ */
+void lv_img_cache_set_mem_size(uint32_t size);
+
+/**
+ * Get the statistics of the image cache. The counters are cumulated since `lv_init`.
+ * @param stat store the statistics here
+ */
+void lv_img_cache_get_stat(lv_img_cache_stat_t * stat);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
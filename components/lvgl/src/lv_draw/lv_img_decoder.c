@@ -11,6 +11,7 @@
 #include "../lv_draw/lv_draw_img.h"
 #include "../lv_misc/lv_ll.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -27,6 +28,8 @@ typedef struct {
 #endif
     lv_color_t * palette;
     lv_opa_t * opa;
+    uint8_t * decoded;      /*The whole decoded image or NULL if it's read line by line*/
+    uint32_t decoded_size;
 } lv_img_decoder_built_in_data_t;
 
 /**********************
@@ -38,10 +41,17 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                      lv_coord_t len, uint8_t * buf);
+#if LV_IMG_CACHE_DEF_SIZE
+static void lv_img_decoder_built_in_decode(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_IMG_CACHE_DEF_SIZE
+static uint32_t decoded_mem_max = LV_IMG_DECODED_MEM_SIZE;
+static uint32_t decoded_mem_used;
+#endif
 
 /**********************
  *      MACROS
@@ -153,6 +163,7 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
         dsc->img_data  = NULL;
         dsc->user_data = NULL;
         dsc->time_to_open = 0;
+        dsc->mem_size = 0;
     }
 
     if(dsc->src_type == LV_IMG_SRC_FILE)
@@ -260,6 +271,38 @@ void lv_img_decoder_set_close_cb(lv_img_decoder_t * decoder, lv_img_decoder_clos
     decoder->close_cb = close_cb;
 }
 
+/**
+ * Set how much RAM the built-in decoder can use for the fully decoded images.
+ * The images opened later are decoded line by line if they don't fit.
+ * @param size the RAM in bytes. 0: always decode the images line by line
+ */
+void lv_img_decoder_set_decoded_mem_size(uint32_t size)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    _lv_refr_worker_lock();
+    decoded_mem_max = size;
+    _lv_refr_worker_unlock();
+#else
+    LV_UNUSED(size);
+#endif
+}
+
+/**
+ * Get how much RAM the fully decoded images of the built-in decoder use.
+ * @return the used RAM in bytes
+ */
+uint32_t lv_img_decoder_get_decoded_mem_used(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    _lv_refr_worker_lock();
+    uint32_t used = decoded_mem_used;
+    _lv_refr_worker_unlock();
+    return used;
+#else
+    return 0;
+#endif
+}
+
 /**
  * Get info about a built-in image
  * @param decoder the decoder where this function belongs
@@ -348,6 +391,7 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
                 return LV_RES_INV;
             }
             _lv_memset_00(dsc->user_data, sizeof(lv_img_decoder_built_in_data_t));
+            dsc->mem_size += sizeof(lv_img_decoder_built_in_data_t);
         }
 
         lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
@@ -375,6 +419,9 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
         }
         else {
             /*If it's a file it need to be read line by line later*/
+#if LV_IMG_CACHE_DEF_SIZE
+            lv_img_decoder_built_in_decode(decoder, dsc);
+#endif
             return LV_RES_OK;
         }
     }
@@ -394,6 +441,7 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
                 return LV_RES_INV;
             }
             _lv_memset_00(dsc->user_data, sizeof(lv_img_decoder_built_in_data_t));
+            dsc->mem_size += sizeof(lv_img_decoder_built_in_data_t);
         }
 
         lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
@@ -406,6 +454,7 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             lv_img_decoder_built_in_close(decoder, dsc);
             return LV_RES_INV;
         }
+        dsc->mem_size += palette_size * (sizeof(lv_color_t) + sizeof(lv_opa_t));
 
         if(dsc->src_type == LV_IMG_SRC_FILE) {
             /*Read the palette from file*/
@@ -434,6 +483,9 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             }
         }
 
+#if LV_IMG_CACHE_DEF_SIZE
+        lv_img_decoder_built_in_decode(decoder, dsc);
+#endif
         return LV_RES_OK;
 #else
         LV_LOG_WARN("Indexed (palette) images are not enabled in lv_conf.h. See LV_IMG_CF_INDEXED");
@@ -445,7 +497,10 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
     else if(cf == LV_IMG_CF_ALPHA_1BIT || cf == LV_IMG_CF_ALPHA_2BIT || cf == LV_IMG_CF_ALPHA_4BIT ||
             cf == LV_IMG_CF_ALPHA_8BIT) {
 #if LV_IMG_CF_ALPHA
-        return LV_RES_OK; /*Nothing to process*/
+#if LV_IMG_CACHE_DEF_SIZE
+        lv_img_decoder_built_in_decode(decoder, dsc);
+#endif
+        return LV_RES_OK; /*Nothing else to process*/
 #else
         LV_LOG_WARN("Alpha indexed images are not enabled in lv_conf.h. See LV_IMG_CF_ALPHA");
         lv_img_decoder_built_in_close(decoder, dsc);
@@ -521,6 +576,14 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
 #endif
         if(user_data->palette) lv_mem_free(user_data->palette);
         if(user_data->opa) lv_mem_free(user_data->opa);
+#if LV_IMG_CACHE_DEF_SIZE
+        if(user_data->decoded) {
+            LV_IMG_DECODED_FREE(user_data->decoded);
+            _lv_refr_worker_lock();
+            decoded_mem_used -= user_data->decoded_size;
+            _lv_refr_worker_unlock();
+        }
+#endif
 
         lv_mem_free(user_data);
         dsc->user_data = NULL;
@@ -765,3 +828,73 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     return LV_RES_INV;
 #endif
 }
+
+#if LV_IMG_CACHE_DEF_SIZE
+/**
+ * Decode the whole image into RAM to draw it directly instead of reading and converting its lines in every redraw.
+ * The image remains read line by line if it doesn't fit into `LV_IMG_DECODED_MEM_SIZE` or an error occurs.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to an opened decoder descriptor
+ */
+static void lv_img_decoder_built_in_decode(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    /*True color lines are read as they are, the others are converted to color + alpha byte*/
+    lv_img_cf_t cf = dsc->header.cf;
+    bool true_color = cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_ALPHA ||
+                      cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+    uint32_t px_size = true_color ? lv_img_cf_get_px_size(cf) >> 3 : LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint32_t line_size = (uint32_t)dsc->header.w * px_size;
+    uint32_t size = line_size * dsc->header.h;
+    if(size == 0) return;
+
+    _lv_refr_worker_lock();
+    bool fit = decoded_mem_used <= decoded_mem_max && size <= decoded_mem_max - decoded_mem_used;
+    if(fit) decoded_mem_used += size;
+    _lv_refr_worker_unlock();
+    if(!fit) return;
+
+    if(dsc->user_data == NULL) {
+        dsc->user_data = lv_mem_alloc(sizeof(lv_img_decoder_built_in_data_t));
+        if(dsc->user_data) {
+            _lv_memset_00(dsc->user_data, sizeof(lv_img_decoder_built_in_data_t));
+            dsc->mem_size += sizeof(lv_img_decoder_built_in_data_t);
+        }
+    }
+
+    uint8_t * buf = dsc->user_data ? LV_IMG_DECODED_ALLOC(size) : NULL;
+    lv_res_t res = buf ? LV_RES_OK : LV_RES_INV;
+    lv_coord_t y;
+    for(y = 0; y < dsc->header.h && res == LV_RES_OK; y++) {
+        res = lv_img_decoder_built_in_read_line(decoder, dsc, 0, y, dsc->header.w, buf + y * line_size);
+    }
+
+    if(res != LV_RES_OK) {
+        LV_LOG_WARN("Built-in image decoder: can't decode the whole image, read it line by line");
+        if(buf) LV_IMG_DECODED_FREE(buf);
+        _lv_refr_worker_lock();
+        decoded_mem_used -= size;
+        _lv_refr_worker_unlock();
+        return;
+    }
+
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    user_data->decoded = buf;
+    user_data->decoded_size = size;
+    dsc->img_data = buf;
+    dsc->mem_size += size;
+    if(!true_color) dsc->header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+
+    /*Only the decoded pixels are used from now on*/
+    if(user_data->palette) {
+        lv_mem_free(user_data->palette);
+        lv_mem_free(user_data->opa);
+        user_data->palette = NULL;
+        user_data->opa = NULL;
+        dsc->mem_size -= (1 << lv_img_cf_get_px_size(cf)) * (sizeof(lv_color_t) + sizeof(lv_opa_t));
+    }
+
+#if LV_USE_FILESYSTEM
+    if(dsc->src_type == LV_IMG_SRC_FILE) lv_fs_close(&user_data->f);
+#endif
+}
+#endif
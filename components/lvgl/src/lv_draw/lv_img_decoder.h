@@ -124,6 +124,10 @@ typedef struct _lv_img_decoder_dsc {
      * Can be set in `open` function or set NULL. */
     const char * error_msg;
 
+    /**RAM allocated by the decoder for the opened image in bytes (e.g. the decoded pixels).
+     * Should be set in `open` function to let the image cache count it.*/
+    uint32_t mem_size;
+
     /**Store any custom data here is required*/
     void * user_data;
 } lv_img_decoder_dsc_t;
@@ -221,6 +225,19 @@ void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_
  */
 void lv_img_decoder_set_close_cb(lv_img_decoder_t * decoder, lv_img_decoder_close_f_t close_cb);
 
+/**
+ * Set how much RAM the built-in decoder can use for the fully decoded images.
+ * The images opened later are decoded line by line if they don't fit.
+ * @param size the RAM in bytes. 0: always decode the images line by line
+ */
+void lv_img_decoder_set_decoded_mem_size(uint32_t size);
+
+/**
+ * Get how much RAM the fully decoded images of the built-in decoder use.
+ * @return the used RAM in bytes
+ */
+uint32_t lv_img_decoder_get_decoded_mem_used(void);
+
 /**
  * Get info about a built-in image
  * @param decoder the decoder where this function belongs
@@ -14,10 +14,16 @@
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_utils.h"
 #include "../lv_misc/lv_mem.h"
+#include "../lv_core/lv_refr.h"
 
 /*********************
  *      DEFINES
  *********************/
+#define GLYPH_CACHE_HASH(fdsc, gid) \
+    ((((lv_uintptr_t)(fdsc) >> 4) ^ (gid)) & (_LV_FONT_GLYPH_CACHE_BUCKET_CNT - 1))
+
+/*Fibonacci hashing of the letters in the lookup tables*/
+#define LOOKUP_HASH(lookup, letter) (((uint32_t)(letter) * 2654435761u) >> (lookup)->hash_shift)
 
 /**********************
  *      TYPEDEFS
@@ -32,6 +38,8 @@ typedef enum {
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t search_glyph_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter, bool skip_sparse);
+static void glyph_id_cache_set(lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter, uint32_t glyph_id);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
@@ -46,18 +54,51 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static inline uint8_t rle_next(void);
 #endif /* LV_USE_FONT_COMPRESSED */
 
+#if LV_FONT_FMT_TXT_LOOKUP
+    static const lv_font_fmt_txt_lookup_t * lookup_get(lv_font_fmt_txt_dsc_t * fdsc);
+    static lv_font_fmt_txt_lookup_t * lookup_build(const lv_font_fmt_txt_dsc_t * fdsc);
+    static uint32_t lookup_glyph_id(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_lookup_t * lookup,
+                                    uint32_t letter);
+    static void lookup_kern_pairs(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid_left, uint32_t * first,
+                                  uint32_t * cnt);
+    static inline uint32_t kern_pair_left(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t i);
+#endif
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_SIZE
+    static const uint8_t * glyph_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint32_t buf_size);
+    static void glyph_cache_use(_lv_font_glyph_cache_t * cache, _lv_font_glyph_t * glyph);
+    static void glyph_cache_trim(_lv_font_glyph_cache_t * cache, uint32_t size);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_USE_FONT_COMPRESSED
-    static uint32_t rle_rdp;
-    static const uint8_t * rle_in;
-    static uint8_t rle_bpp;
-    static uint8_t rle_prev_v;
-    static uint8_t rle_cnt;
-    static rle_state_t rle_state;
+    static _LV_REFR_LOCAL uint32_t rle_rdp;
+    static _LV_REFR_LOCAL const uint8_t * rle_in;
+    static _LV_REFR_LOCAL uint8_t rle_bpp;
+    static _LV_REFR_LOCAL uint8_t rle_prev_v;
+    static _LV_REFR_LOCAL uint8_t rle_cnt;
+    static _LV_REFR_LOCAL rle_state_t rle_state;
 #endif /* LV_USE_FONT_COMPRESSED */
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_SIZE
+    static uint32_t glyph_cache_max = LV_FONT_GLYPH_CACHE_SIZE;
+    static uint32_t glyph_cache_gen;
+#endif
+
+#if LV_FONT_FMT_TXT_LOOKUP
+    /*Used by the fonts whose lookup tables couldn't be allocated. They search every letter*/
+    static lv_font_fmt_txt_lookup_t lookup_none;
+#endif
+
+#if LV_USE_REFR_WORKER
+    /*The cache of the font descriptor would be shared by the rendering threads so keep one per thread*/
+    static _LV_REFR_LOCAL const lv_font_fmt_txt_dsc_t * cache_fdsc;
+    static _LV_REFR_LOCAL uint32_t cache_letter;
+    static _LV_REFR_LOCAL uint32_t cache_glyph_id;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -112,17 +153,23 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
-        if(_lv_mem_get_size(LV_GC_ROOT(_lv_font_decompr_buf)) < buf_size) {
-            uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
+#if LV_FONT_GLYPH_CACHE_SIZE
+        const uint8_t * cached = glyph_cache_get(fdsc, gid, buf_size);
+        if(cached) return cached;
+#endif
+
+        /*Decompress into the scratch buffer if the glyph can't be cached*/
+        if(_lv_mem_get_size(LV_GC_ROOT_LOCAL(_lv_font_decompr_buf)) < buf_size) {
+            uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT_LOCAL(_lv_font_decompr_buf), buf_size);
             LV_ASSERT_MEM(tmp);
             if(tmp == NULL) return NULL;
-            LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
+            LV_GC_ROOT_LOCAL(_lv_font_decompr_buf) = tmp;
         }
 
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
+        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT_LOCAL(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
-        return LV_GC_ROOT(_lv_font_decompr_buf);
+        return LV_GC_ROOT_LOCAL(_lv_font_decompr_buf);
 #else /* !LV_USE_FONT_COMPRESSED */
         return NULL;
 #endif
@@ -194,6 +241,87 @@ void _lv_font_clean_up_fmt_txt(void)
     }
 }
 
+/**
+ * Free the lookup tables of a font. Required before a loaded font is deleted.
+ * @param fdsc pointer to the font's descriptor
+ */
+void _lv_font_fmt_txt_lookup_free(lv_font_fmt_txt_dsc_t * fdsc)
+{
+#if LV_FONT_FMT_TXT_LOOKUP
+    lv_font_fmt_txt_lookup_t * lookup = fdsc->lookup;
+    fdsc->lookup = NULL;
+    if(lookup == NULL || lookup == &lookup_none) return;
+
+    lv_font_fmt_txt_lookup_t ** prev_next = &LV_GC_ROOT(_lv_font_fmt_txt_lookups);
+    while(*prev_next && *prev_next != lookup) prev_next = &(*prev_next)->next;
+    if(*prev_next) *prev_next = lookup->next;
+
+    LV_FONT_FMT_TXT_LOOKUP_FREE(lookup);
+#else
+    LV_UNUSED(fdsc);
+#endif
+}
+
+/**
+ * Free the lookup tables of every font.
+ */
+void _lv_font_fmt_txt_lookup_free_all(void)
+{
+#if LV_FONT_FMT_TXT_LOOKUP
+    while(LV_GC_ROOT(_lv_font_fmt_txt_lookups)) {
+        _lv_font_fmt_txt_lookup_free(LV_GC_ROOT(_lv_font_fmt_txt_lookups)->fdsc);
+    }
+#endif
+}
+
+/**
+ * Set the RAM the decompressed glyphs of the compressed fonts can use.
+ * The render worker thread has an other cache of the same size.
+ * @param size the size in bytes, 0: decompress the glyphs every time they are drawn
+ */
+void lv_font_glyph_cache_set_size(uint32_t size)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_SIZE
+    glyph_cache_max = size;
+
+    /*The worker thread frees its glyphs the next time it draws a compressed glyph*/
+    glyph_cache_trim(&LV_GC_ROOT_LOCAL(_lv_font_glyph_cache), size);
+#else
+    LV_UNUSED(size);
+#endif
+}
+
+/**
+ * Drop the decompressed glyphs of every font. Required before a font is deleted.
+ */
+void lv_font_glyph_cache_invalidate(void)
+{
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_SIZE
+    /*A new font might be allocated at the same address so the worker thread
+     *drops its glyphs too when it sees the new generation*/
+    glyph_cache_gen++;
+    glyph_cache_trim(&LV_GC_ROOT_LOCAL(_lv_font_glyph_cache), 0);
+#endif
+}
+
+/**
+ * Get the hit and miss count of the glyph cache of the calling thread
+ * @param hit_cnt store the number of glyphs found in the cache here (can be NULL)
+ * @param miss_cnt store the number of glyphs decompressed here (can be NULL)
+ * @return the hit rate in percent
+ */
+uint8_t lv_font_glyph_cache_get_hit_rate(uint32_t * hit_cnt, uint32_t * miss_cnt)
+{
+    uint32_t hit = LV_GC_ROOT_LOCAL(_lv_font_glyph_cache).hit_cnt;
+    uint32_t miss = LV_GC_ROOT_LOCAL(_lv_font_glyph_cache).miss_cnt;
+
+    if(hit_cnt) *hit_cnt = hit;
+    if(miss_cnt) *miss_cnt = miss;
+    if(hit + miss == 0) return 0;
+
+    return (uint64_t)hit * 100 / (hit + miss);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -205,14 +333,41 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
     /*Check the cache first*/
+#if LV_USE_REFR_WORKER
+    if(fdsc == cache_fdsc && letter == cache_letter) return cache_glyph_id;
+#else
     if(letter == fdsc->last_letter) return fdsc->last_glyph_id;
+#endif
 
+#if LV_FONT_FMT_TXT_LOOKUP
+    uint32_t glyph_id;
+    const lv_font_fmt_txt_lookup_t * lookup = lookup_get(fdsc);
+    if(lookup) glyph_id = lookup_glyph_id(fdsc, lookup, letter);
+    else glyph_id = search_glyph_id(fdsc, letter, false);
+#else
+    uint32_t glyph_id = search_glyph_id(fdsc, letter, false);
+#endif
+
+    /*Update the cache*/
+    glyph_id_cache_set(fdsc, letter, glyph_id);
+    return glyph_id;
+}
+
+/**
+ * Search a letter in the cmaps of a font
+ * @param fdsc pointer to the font's descriptor
+ * @param letter an UNICODE letter code
+ * @param skip_sparse true: don't search in the sparse cmaps
+ * @return the glyph id of the letter or 0 if it's not in the font
+ */
+static uint32_t search_glyph_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter, bool skip_sparse)
+{
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
         /*Relative code point*/
         uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
+        if(rcp >= fdsc->cmaps[i].range_length) continue;
         uint32_t glyph_id = 0;
         if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
             glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
@@ -221,6 +376,9 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             const uint8_t * gid_ofs_8 = fdsc->cmaps[i].glyph_id_ofs_list;
             glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_8[rcp];
         }
+        else if(skip_sparse) {
+            continue;
+        }
         else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
             uint16_t key = rcp;
             uint16_t * p = _lv_utils_bsearch(&key, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
@@ -243,16 +401,22 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             }
         }
 
-        /*Update the cache*/
-        fdsc->last_letter = letter;
-        fdsc->last_glyph_id = glyph_id;
         return glyph_id;
     }
 
-    fdsc->last_letter = letter;
-    fdsc->last_glyph_id = 0;
     return 0;
+}
 
+static void glyph_id_cache_set(lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter, uint32_t glyph_id)
+{
+#if LV_USE_REFR_WORKER
+    cache_fdsc = fdsc;
+    cache_letter = letter;
+    cache_glyph_id = glyph_id;
+#else
+    fdsc->last_letter = letter;
+    fdsc->last_glyph_id = glyph_id;
+#endif
 }
 
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
@@ -268,8 +432,13 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
             /* Use binary search to find the kern value.
              * The pairs are ordered left_id first, then right_id secondly. */
             const uint16_t * g_ids = kdsc->glyph_ids;
+            uint32_t first = 0;
+            uint32_t cnt = kdsc->pair_cnt;
+#if LV_FONT_FMT_TXT_LOOKUP
+            lookup_kern_pairs(fdsc, gid_left, &first, &cnt);
+#endif
             uint16_t g_id_both = (gid_right << 8) + gid_left; /*Create one number from the ids*/
-            uint16_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 2, kern_pair_8_compare);
+            uint16_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids + first, cnt, 2, kern_pair_8_compare);
 
             /*If the `g_id_both` were found get its index from the pointer*/
             if(kid_p) {
@@ -281,8 +450,13 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
             /* Use binary search to find the kern value.
              * The pairs are ordered left_id first, then right_id secondly. */
             const uint32_t * g_ids = kdsc->glyph_ids;
+            uint32_t first = 0;
+            uint32_t cnt = kdsc->pair_cnt;
+#if LV_FONT_FMT_TXT_LOOKUP
+            lookup_kern_pairs(fdsc, gid_left, &first, &cnt);
+#endif
             uint32_t g_id_both = (gid_right << 16) + gid_left; /*Create one number from the ids*/
-            uint32_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 4, kern_pair_16_compare);
+            uint32_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids + first, cnt, 4, kern_pair_16_compare);
 
             /*If the `g_id_both` were found get its index from the pointer*/
             if(kid_p) {
@@ -580,3 +754,293 @@ static int32_t unicode_list_compare(const void * ref, const void * element)
 {
     return ((int32_t)(*(uint16_t *)ref)) - ((int32_t)(*(uint16_t *)element));
 }
+
+#if LV_FONT_FMT_TXT_LOOKUP
+/**
+ * Get the lookup tables of a font. Build them when the font is first used.
+ * @param fdsc pointer to the font's descriptor
+ * @return the lookup tables or NULL if they aren't built yet
+ */
+static const lv_font_fmt_txt_lookup_t * lookup_get(lv_font_fmt_txt_dsc_t * fdsc)
+{
+    if(fdsc->lookup) return fdsc->lookup;
+
+    /*Build them only when no other thread renders, so nobody sees half built tables*/
+    if(_lv_refr_worker_busy()) return NULL;
+
+    lv_font_fmt_txt_lookup_t * lookup = lookup_build(fdsc);
+    if(lookup) {
+        lookup->fdsc = fdsc;
+        lookup->next = LV_GC_ROOT(_lv_font_fmt_txt_lookups);
+        LV_GC_ROOT(_lv_font_fmt_txt_lookups) = lookup;
+    }
+    else {
+        LV_LOG_WARN("lv_font_fmt_txt: couldn't allocate the lookup tables of a font");
+        lookup = &lookup_none;
+    }
+
+    fdsc->lookup = lookup;
+    return lookup;
+}
+
+/**
+ * Allocate and fill the lookup tables of a font
+ * @param fdsc pointer to the font's descriptor
+ * @return the lookup tables or NULL if there is not enough memory
+ */
+static lv_font_fmt_txt_lookup_t * lookup_build(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    /*The direct table ends at the last letter below 256*/
+    uint32_t direct_cnt = 256;
+    while(direct_cnt > 0 && search_glyph_id(fdsc, direct_cnt - 1, false) == 0) direct_cnt--;
+
+    /*Have at least twice as many slots as letters from 256 in the sparse cmaps*/
+    uint32_t sparse_cnt = 0;
+    uint16_t i;
+    uint32_t j;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(cmap->type != LV_FONT_FMT_TXT_CMAP_SPARSE_TINY && cmap->type != LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) continue;
+        for(j = 0; j < cmap->list_length; j++) {
+            if(cmap->range_start + cmap->unicode_list[j] >= 256) sparse_cnt++;
+        }
+    }
+
+    uint32_t slot_cnt = 0;
+    uint8_t hash_shift = 32;
+    if(sparse_cnt) {
+        slot_cnt = 1;
+        while(slot_cnt < 2 * sparse_cnt) {
+            slot_cnt <<= 1;
+            hash_shift--;
+        }
+    }
+
+    /*Index the kern pairs by their left glyph id. The kern classes need no search*/
+    const lv_font_fmt_txt_kern_pair_t * kdsc = NULL;
+    uint32_t kern_glyph_cnt = 0;
+    if(fdsc->kern_dsc && fdsc->kern_classes == 0) {
+        kdsc = fdsc->kern_dsc;
+        if(kdsc->pair_cnt && kdsc->glyph_ids_size <= 1) kern_glyph_cnt = kern_pair_left(kdsc, kdsc->pair_cnt - 1) + 1;
+    }
+
+    /*Allocate all tables at once. The 32 bit ones first to keep them aligned*/
+    uint32_t kern_size = kern_glyph_cnt ? (kern_glyph_cnt + 1) * sizeof(uint32_t) : 0;
+    uint32_t size = sizeof(lv_font_fmt_txt_lookup_t) + slot_cnt * sizeof(uint32_t) + kern_size +
+                    slot_cnt * sizeof(uint16_t) + direct_cnt * sizeof(uint16_t);
+    lv_font_fmt_txt_lookup_t * lookup = LV_FONT_FMT_TXT_LOOKUP_ALLOC(size);
+    if(lookup == NULL) return NULL;
+    _lv_memset_00(lookup, size);
+
+    uint8_t * p = (uint8_t *)(lookup + 1);
+    if(slot_cnt) {
+        lookup->hash_letter = (uint32_t *)p;
+        p += slot_cnt * sizeof(uint32_t);
+    }
+    if(kern_glyph_cnt) {
+        lookup->kern_first = (uint32_t *)p;
+        p += kern_size;
+    }
+    if(slot_cnt) {
+        lookup->hash_gid = (uint16_t *)p;
+        p += slot_cnt * sizeof(uint16_t);
+    }
+    lookup->direct_gid = (uint16_t *)p;
+    lookup->direct_cnt = direct_cnt;
+    lookup->hash_mask = slot_cnt - 1;
+    lookup->hash_shift = hash_shift;
+    lookup->kern_glyph_cnt = kern_glyph_cnt;
+
+    uint32_t letter;
+    for(letter = 0; letter < direct_cnt; letter++) {
+        lookup->direct_gid[letter] = search_glyph_id(fdsc, letter, false);
+    }
+
+    for(i = 0; i < fdsc->cmap_num && slot_cnt; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(cmap->type != LV_FONT_FMT_TXT_CMAP_SPARSE_TINY && cmap->type != LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) continue;
+        const uint16_t * gid_ofs_16 = cmap->glyph_id_ofs_list;
+        for(j = 0; j < cmap->list_length; j++) {
+            letter = cmap->range_start + cmap->unicode_list[j];
+            if(letter < 256) continue;
+
+            /*Like the search, the first cmap having the letter wins*/
+            uint32_t h = LOOKUP_HASH(lookup, letter);
+            while(lookup->hash_letter[h] && lookup->hash_letter[h] != letter) h = (h + 1) & lookup->hash_mask;
+            if(lookup->hash_letter[h]) continue;
+
+            lookup->hash_letter[h] = letter;
+            if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) lookup->hash_gid[h] = cmap->glyph_id_start + j;
+            else lookup->hash_gid[h] = cmap->glyph_id_start + gid_ofs_16[j];
+        }
+    }
+
+    /*The pairs are ordered by the left glyph id*/
+    uint32_t pair = 0;
+    uint32_t gid;
+    for(gid = 0; gid <= kern_glyph_cnt && kern_glyph_cnt; gid++) {
+        while(pair < kdsc->pair_cnt && kern_pair_left(kdsc, pair) < gid) pair++;
+        lookup->kern_first[gid] = pair;
+    }
+
+    return lookup;
+}
+
+/**
+ * Find the glyph id of a letter with the lookup tables of a font
+ * @param fdsc pointer to the font's descriptor
+ * @param lookup the lookup tables of the font
+ * @param letter an UNICODE letter code
+ * @return the glyph id of the letter or 0 if it's not in the font
+ */
+static uint32_t lookup_glyph_id(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_lookup_t * lookup,
+                                uint32_t letter)
+{
+    /*Not built, e.g. there was not enough memory*/
+    if(lookup->direct_gid == NULL) return search_glyph_id(fdsc, letter, false);
+
+    if(letter < 256) return letter < lookup->direct_cnt ? lookup->direct_gid[letter] : 0;
+
+    if(lookup->hash_letter) {
+        uint32_t h = LOOKUP_HASH(lookup, letter);
+        while(lookup->hash_letter[h]) {
+            if(lookup->hash_letter[h] == letter) return lookup->hash_gid[h];
+            h = (h + 1) & lookup->hash_mask;
+        }
+    }
+
+    /*Not in the sparse cmaps. Check the ranges, they need no search*/
+    return search_glyph_id(fdsc, letter, true);
+}
+
+/**
+ * Get the kern pairs having a given left glyph
+ * @param fdsc pointer to the font's descriptor
+ * @param gid_left the left glyph id
+ * @param first index of the first pair to search. Not changed if the font has no lookup tables.
+ * @param cnt number of pairs to search. Not changed if the font has no lookup tables.
+ */
+static void lookup_kern_pairs(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid_left, uint32_t * first,
+                              uint32_t * cnt)
+{
+    const lv_font_fmt_txt_lookup_t * lookup = fdsc->lookup;
+    if(lookup == NULL || lookup->kern_first == NULL) return;
+
+    if(gid_left >= lookup->kern_glyph_cnt) {
+        *cnt = 0;
+        return;
+    }
+
+    *first = lookup->kern_first[gid_left];
+    *cnt = lookup->kern_first[gid_left + 1] - *first;
+}
+
+static inline uint32_t kern_pair_left(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t i)
+{
+    if(kdsc->glyph_ids_size == 0) return ((const uint8_t *)kdsc->glyph_ids)[i * 2];
+    else return ((const uint16_t *)kdsc->glyph_ids)[i * 2];
+}
+#endif /*LV_FONT_FMT_TXT_LOOKUP*/
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_SIZE
+/**
+ * Get the decompressed bitmap of a glyph from the cache of the calling thread.
+ * Decompress and add it if it's not there yet.
+ * @param fdsc the font's descriptor
+ * @param gid the glyph's id
+ * @param buf_size size of the decompressed bitmap
+ * @return the bitmap or NULL if it doesn't fit into the cache
+ */
+static const uint8_t * glyph_cache_get(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint32_t buf_size)
+{
+    _lv_font_glyph_cache_t * cache = &LV_GC_ROOT_LOCAL(_lv_font_glyph_cache);
+    if(cache->gen != glyph_cache_gen) {
+        glyph_cache_trim(cache, 0);
+        cache->gen = glyph_cache_gen;
+    }
+    if(cache->size > glyph_cache_max) glyph_cache_trim(cache, glyph_cache_max);
+
+    _lv_font_glyph_t ** bucket = &cache->buckets[GLYPH_CACHE_HASH(fdsc, gid)];
+    _lv_font_glyph_t * glyph;
+    for(glyph = *bucket; glyph; glyph = glyph->hash_next) {
+        if(glyph->gid == gid && glyph->fdsc == fdsc) {
+            glyph_cache_use(cache, glyph);
+            cache->hit_cnt++;
+            return (const uint8_t *)(glyph + 1);
+        }
+    }
+
+    cache->miss_cnt++;
+
+    uint32_t size = sizeof(_lv_font_glyph_t) + buf_size;
+    if(size > glyph_cache_max) return NULL;
+
+    /*Free the least recently used glyphs to make room for the new one*/
+    glyph_cache_trim(cache, glyph_cache_max - size);
+
+    glyph = LV_FONT_GLYPH_CACHE_ALLOC(size);
+    if(glyph == NULL) return NULL;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+    decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], (uint8_t *)(glyph + 1), gdsc->box_w, gdsc->box_h,
+               (uint8_t)fdsc->bpp, prefilter);
+
+    glyph->fdsc = fdsc;
+    glyph->gid = gid;
+    glyph->size = size;
+    glyph->hash_next = *bucket;
+    *bucket = glyph;
+    glyph->lru_prev = NULL;
+    glyph->lru_next = NULL;
+    glyph_cache_use(cache, glyph);
+    cache->size += size;
+
+    return (const uint8_t *)(glyph + 1);
+}
+
+/**
+ * Make a glyph the most recently used one
+ * @param cache a glyph cache
+ * @param glyph a glyph of `cache` or a new glyph not on the LRU list yet
+ */
+static void glyph_cache_use(_lv_font_glyph_cache_t * cache, _lv_font_glyph_t * glyph)
+{
+    if(cache->lru_first == glyph) return;
+
+    /*Unlink*/
+    if(glyph->lru_prev) glyph->lru_prev->lru_next = glyph->lru_next;
+    if(glyph->lru_next) glyph->lru_next->lru_prev = glyph->lru_prev;
+    else if(cache->lru_last == glyph) cache->lru_last = glyph->lru_prev;
+
+    /*Put it to the front*/
+    glyph->lru_prev = NULL;
+    glyph->lru_next = cache->lru_first;
+    if(cache->lru_first) cache->lru_first->lru_prev = glyph;
+    cache->lru_first = glyph;
+    if(cache->lru_last == NULL) cache->lru_last = glyph;
+}
+
+/**
+ * Free the least recently used glyphs of a cache
+ * @param cache a glyph cache
+ * @param size free glyphs until the cache is not larger than this
+ */
+static void glyph_cache_trim(_lv_font_glyph_cache_t * cache, uint32_t size)
+{
+    while(cache->size > size) {
+        _lv_font_glyph_t * glyph = cache->lru_last;
+
+        _lv_font_glyph_t ** p = &cache->buckets[GLYPH_CACHE_HASH(glyph->fdsc, glyph->gid)];
+        while(*p != glyph) p = &(*p)->hash_next;
+        *p = glyph->hash_next;
+
+        cache->lru_last = glyph->lru_prev;
+        if(cache->lru_last) cache->lru_last->lru_next = NULL;
+        else cache->lru_first = NULL;
+
+        cache->size -= glyph->size;
+        LV_FONT_GLYPH_CACHE_FREE(glyph);
+    }
+}
+#endif
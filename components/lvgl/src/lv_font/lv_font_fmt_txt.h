@@ -21,6 +21,7 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+#define _LV_FONT_GLYPH_CACHE_BUCKET_CNT   32
 
 /**********************
  *      TYPEDEFS
@@ -150,8 +151,23 @@ typedef enum {
     LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 1,
 } lv_font_fmt_txt_bitmap_format_t;
 
+/*Lookup tables of a font to find its glyphs and kern pairs without searching.
+ *Built when the font is first used, see `LV_FONT_FMT_TXT_LOOKUP`*/
+typedef struct _lv_font_fmt_txt_lookup_t {
+    struct _lv_font_fmt_txt_lookup_t * next;    /*Lookup of an other font*/
+    struct _lv_font_fmt_txt_dsc_t * fdsc;       /*The font of this lookup*/
+    uint16_t * direct_gid;      /*Glyph id of the letters below `direct_cnt`. 0: not in the font*/
+    uint32_t * hash_letter;     /*Letters from 256 of the sparse cmaps with open addressing. 0: free slot*/
+    uint16_t * hash_gid;        /*Glyph id of the letters in `hash_letter`*/
+    uint32_t * kern_first;      /*Index of the first kern pair of the left glyph ids and `pair_cnt` at the end*/
+    uint32_t hash_mask;         /*Number of slots - 1*/
+    uint32_t kern_glyph_cnt;    /*Number of left glyph ids in `kern_first`*/
+    uint16_t direct_cnt;
+    uint8_t hash_shift;         /*32 - log2(number of slots)*/
+} lv_font_fmt_txt_lookup_t;
+
 /*Describe store additional data for fonts */
-typedef struct {
+typedef struct _lv_font_fmt_txt_dsc_t {
     /*The bitmaps of all glyphs*/
     const uint8_t * glyph_bitmap;
 
@@ -190,8 +206,32 @@ typedef struct {
     uint32_t last_letter;
     uint32_t last_glyph_id;
 
+    /*Built when the font is first used*/
+    lv_font_fmt_txt_lookup_t * lookup;
+
 } lv_font_fmt_txt_dsc_t;
 
+/*A decompressed glyph. Its bitmap follows it in the same allocation*/
+typedef struct _lv_font_glyph_t {
+    struct _lv_font_glyph_t * hash_next;    /*Next glyph in the same bucket*/
+    struct _lv_font_glyph_t * lru_prev;     /*More recently used glyph*/
+    struct _lv_font_glyph_t * lru_next;     /*Less recently used glyph*/
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    uint32_t gid;
+    uint32_t size;                          /*Bytes allocated for the glyph*/
+} _lv_font_glyph_t;
+
+/*The decompressed glyphs of the compressed fonts, see `LV_FONT_GLYPH_CACHE_SIZE`*/
+typedef struct {
+    _lv_font_glyph_t * buckets[_LV_FONT_GLYPH_CACHE_BUCKET_CNT];
+    _lv_font_glyph_t * lru_first;
+    _lv_font_glyph_t * lru_last;
+    uint32_t size;                          /*Bytes used by the glyphs*/
+    uint32_t gen;                           /*Glyphs of an other generation belong to deleted fonts*/
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
+} _lv_font_glyph_cache_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -220,6 +260,37 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+/**
+ * Free the lookup tables of a font. Required before a loaded font is deleted.
+ * @param fdsc pointer to the font's descriptor
+ */
+void _lv_font_fmt_txt_lookup_free(lv_font_fmt_txt_dsc_t * fdsc);
+
+/**
+ * Free the lookup tables of every font.
+ */
+void _lv_font_fmt_txt_lookup_free_all(void);
+
+/**
+ * Set the RAM the decompressed glyphs of the compressed fonts can use.
+ * The render worker thread has an other cache of the same size.
+ * @param size the size in bytes, 0: decompress the glyphs every time they are drawn
+ */
+void lv_font_glyph_cache_set_size(uint32_t size);
+
+/**
+ * Drop the decompressed glyphs of every font. Required before a font is deleted.
+ */
+void lv_font_glyph_cache_invalidate(void);
+
+/**
+ * Get the hit and miss count of the glyph cache of the calling thread
+ * @param hit_cnt store the number of glyphs found in the cache here (can be NULL)
+ * @param miss_cnt store the number of glyphs decompressed here (can be NULL)
+ * @return the hit rate in percent
+ */
+uint8_t lv_font_glyph_cache_get_hit_rate(uint32_t * hit_cnt, uint32_t * miss_cnt);
+
 /**********************
  *      MACROS
  **********************/
@@ -122,9 +122,13 @@ lv_font_t * lv_font_load(const char * font_name)
 void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
+        /*Don't find the glyphs of this font for an other one loaded to the same address later*/
+        lv_font_glyph_cache_invalidate();
+
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
         if(NULL != dsc) {
+            _lv_font_fmt_txt_lookup_free(dsc);
 
             if(dsc->kern_classes == 0) {
                 lv_font_fmt_txt_kern_pair_t * kern_dsc =
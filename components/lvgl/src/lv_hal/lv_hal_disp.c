@@ -18,6 +18,9 @@
 #include "../lv_core/lv_obj.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_themes/lv_theme.h"
+#if LV_USE_REFR_ADAPTIVE_BAND
+#include LV_REFR_TIME_US_INCLUDE
+#endif
 
 /*********************
  *      DEFINES
@@ -125,7 +128,7 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
     _lv_memset_00(disp, sizeof(lv_disp_t));
     _lv_memcpy(&disp->driver, driver, sizeof(lv_disp_drv_t));
 
-    _lv_ll_init(&disp->scr_ll, sizeof(lv_obj_t));
+    _lv_ll_init_pooled(&disp->scr_ll, &LV_GC_ROOT(_lv_obj_ll_pool));
     disp->last_activity_time = 0;
 
     if(disp_def == NULL) disp_def = disp;
@@ -140,6 +143,9 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
 
     disp->inv_p = 0;
     disp->last_activity_time = 0;
+#if LV_USE_INV_TILES
+    _lv_refr_inv_tiles_init(disp);
+#endif
 
     disp->bg_color = LV_COLOR_WHITE;
     disp->bg_img = NULL;
@@ -196,6 +202,16 @@ void lv_disp_drv_update(lv_disp_t * disp, lv_disp_drv_t * new_drv)
     _lv_memset_00(disp->inv_areas, sizeof(disp->inv_areas));
     _lv_memset_00(disp->inv_area_joined, sizeof(disp->inv_area_joined));
     disp->inv_p = 0;
+#if LV_USE_INV_TILES
+    _lv_inv_area(disp, NULL);
+    _lv_refr_inv_tiles_init(disp);
+#endif
+#if LV_USE_REFR_ADAPTIVE_BAND
+    /*The buffer might have changed too: start again from the full buffer*/
+    disp->band_px = 0;
+    disp->band_sum_us = 0;
+    disp->band_sum_px = 0;
+#endif
     if(disp->act_scr != NULL)
         lv_obj_invalidate(disp->act_scr);
 }
@@ -353,6 +369,9 @@ LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
     }
 #endif
 
+#if LV_USE_REFR_ADAPTIVE_BAND
+    disp_drv->buffer->flush_time = (uint32_t)(LV_REFR_TIME_US_EXPR) - disp_drv->buffer->flush_start;
+#endif
     disp_drv->buffer->flushing = 0;
     disp_drv->buffer->flushing_last = 0;
 }
@@ -393,7 +412,7 @@ lv_disp_buf_t * lv_disp_get_buf(lv_disp_t * disp)
 
 /**
  * Get the number of areas in the buffer
- * @return number of invalid areas
+ * @return number of invalid areas (with `LV_USE_INV_TILES` 1 if any tile is invalid, else 0)
  */
 uint16_t lv_disp_get_inv_buf_size(lv_disp_t * disp)
 {
@@ -401,18 +420,73 @@ uint16_t lv_disp_get_inv_buf_size(lv_disp_t * disp)
 }
 
 /**
- * Pop (delete) the last 'num' invalidated areas from the buffer
+ * Pop (delete) the last 'num' invalidated areas from the buffer.
+ * With `LV_USE_INV_TILES` the tiles of single areas can't be told apart: the buffer size is 1 while anything
+ * is invalid, and popping it clears every tile marked since the last refresh. Popping 0 keeps all of them.
  * @param num number of areas to delete
  */
 void _lv_disp_pop_from_inv_buf(lv_disp_t * disp, uint16_t num)
 {
-
+#if LV_USE_INV_TILES
+    /*Single tiles can't be taken back, only everything since the last refresh*/
+    if(num == 0 || num < disp->inv_p) return;
+    _lv_inv_area(disp, NULL);
+#else
     if(disp->inv_p < num)
         disp->inv_p = 0;
     else
         disp->inv_p -= num;
+#endif
+}
+
+/**
+ * Get the number of pixels redrawn in the last refresh of a display
+ * @param disp pointer to a display
+ * @return number of pixels
+ */
+uint32_t lv_disp_get_refr_px_num(lv_disp_t * disp)
+{
+    return disp->refr_px_num;
 }
 
+/**
+ * Get how many times the redrawn pixels were blended on average in the last refresh of a display
+ * @param disp pointer to a display
+ * @return blended pixels per redrawn pixels in percent. 100: every pixel was drawn once
+ */
+uint32_t lv_disp_get_refr_overdraw(lv_disp_t * disp)
+{
+    if(disp->refr_px_num == 0) return 0;
+
+    return (uint32_t)(((uint64_t)disp->refr_draw_px_num * 100) / disp->refr_px_num);
+}
+
+#if LV_USE_REFR_ADAPTIVE_BAND
+/**
+ * Get how long the last refresh of a display waited for the flushing to finish
+ * @param disp pointer to a display
+ * @return the time in microseconds
+ */
+uint32_t lv_disp_get_refr_stall_us(lv_disp_t * disp)
+{
+    return disp->refr_stall_us;
+}
+
+/**
+ * Get the number of lines drawn at once on a display
+ * @param disp pointer to a display
+ * @return number of lines of a band as wide as the display
+ */
+lv_coord_t lv_disp_get_band_height(lv_disp_t * disp)
+{
+    lv_disp_buf_t * vdb = disp->driver.buffer;
+    uint32_t px = vdb->size;
+    if(disp->band_px != 0 && disp->band_px < px) px = disp->band_px;
+
+    return (lv_coord_t)(px / lv_disp_get_hor_res(disp));
+}
+#endif
+
 /**
  * Check the driver configuration if it's double buffered (both `buf1` and `buf2` are set)
  * @param disp pointer to to display to check
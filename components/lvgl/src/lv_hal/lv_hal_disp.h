@@ -30,6 +30,14 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas */
 #endif
 
+#if LV_USE_INV_TILES
+/*The tile map is sized for the larger resolution so it fits in either orientation*/
+#define _LV_INV_TILE_RES_MAX  (LV_HOR_RES_MAX > LV_VER_RES_MAX ? LV_HOR_RES_MAX : LV_VER_RES_MAX)
+#define _LV_INV_TILE_COL_MAX  ((_LV_INV_TILE_RES_MAX + LV_INV_TILE_W - 1) / LV_INV_TILE_W)
+#define _LV_INV_TILE_ROW_MAX  ((_LV_INV_TILE_RES_MAX + LV_INV_TILE_H - 1) / LV_INV_TILE_H)
+#define _LV_INV_TILE_WORDS    ((_LV_INV_TILE_COL_MAX + 31) / 32)
+#endif
+
 #ifndef LV_ATTRIBUTE_FLUSH_READY
 #define LV_ATTRIBUTE_FLUSH_READY
 #endif
@@ -58,6 +66,10 @@ typedef struct {
     volatile int flushing_last;
     volatile uint32_t last_area         : 1; /*1: the last area is being rendered*/
     volatile uint32_t last_part         : 1; /*1: the last part of the current area is being rendered*/
+#if LV_USE_REFR_ADAPTIVE_BAND
+    uint32_t flush_start;           /*Time of the last `flush_cb` call [us]*/
+    volatile uint32_t flush_time;   /*Duration of the last finished flush [us]. Set in `lv_disp_flush_ready()`*/
+#endif
 } lv_disp_buf_t;
 
 
@@ -137,6 +149,19 @@ typedef struct _disp_drv_t {
                         const lv_area_t * fill_area, lv_color_t color);
 #endif
 
+#if LV_USE_REFR_WORKER
+    /** OPTIONAL: Call `job(job_p)` on an other thread (ideally on an other core) and return immediately.
+     * Bands are split between two threads only if all 3 `worker_..._cb`s are set.*/
+    void (*worker_start_cb)(struct _disp_drv_t * disp_drv, void (*job)(void *), void * job_p);
+
+    /** OPTIONAL: Block until the job started with `worker_start_cb` returns*/
+    void (*worker_wait_cb)(struct _disp_drv_t * disp_drv);
+
+    /** OPTIONAL: Take (`lock == true`) or give a recursive mutex.
+     * Used while both threads render to guard the heap and the caches they share.*/
+    void (*worker_lock_cb)(struct _disp_drv_t * disp_drv, bool lock);
+#endif
+
     /** On CHROMA_KEYED images this color will be transparent.
      * `LV_COLOR_TRANSP` by default. (lv_conf.h)*/
     lv_color_t color_chroma_key;
@@ -182,6 +207,27 @@ uint8_t del_prev  :
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
     uint32_t inv_p : 10;
 
+#if LV_USE_INV_TILES
+    /** Invalidated tiles, one bit per tile. Turned into `inv_areas` when refreshing.
+     * `inv_p` is only 0 or 1 until then.*/
+    uint32_t inv_tiles[_LV_INV_TILE_ROW_MAX][_LV_INV_TILE_WORDS];
+    lv_coord_t inv_tile_h;      /**< Tile height in use, at least `LV_INV_TILE_H`*/
+#endif
+
+    uint32_t refr_px_num;       /**< Number of pixels redrawn in the last refresh*/
+    uint32_t refr_draw_px_num;  /**< Number of pixels blended in the last refresh*/
+
+#if LV_USE_REFR_ADAPTIVE_BAND
+    uint32_t band_px;           /**< Pixels drawn at once, 0: not decided yet*/
+    uint32_t band_base_px;      /**< The best band size so far. `band_px` differs from it while trying an other*/
+    uint32_t band_base_cost;    /**< Time to refresh 64k pixels with `band_base_px` [us]*/
+    uint32_t band_sum_us;       /**< Time spent refreshing since the band size was last adjusted [us]*/
+    uint32_t band_sum_px;       /**< Pixels refreshed in that time*/
+    int8_t band_dir;            /**< 1: try larger bands next, -1: smaller ones*/
+    uint8_t band_hold;          /**< Adjustments to skip before trying an other size*/
+    uint32_t refr_stall_us;     /**< Time spent waiting for the flush in the last refresh*/
+#endif
+
     /*Miscellaneous data*/
     uint32_t last_activity_time; /**< Last time there was activity on this display */
 } lv_disp_t;
@@ -338,16 +384,48 @@ lv_disp_buf_t * lv_disp_get_buf(lv_disp_t * disp);
 
 /**
  * Get the number of areas in the buffer
- * @return number of invalid areas
+ * @return number of invalid areas (with `LV_USE_INV_TILES` 1 if any tile is invalid, else 0)
  */
 uint16_t lv_disp_get_inv_buf_size(lv_disp_t * disp);
 
 /**
- * Pop (delete) the last 'num' invalidated areas from the buffer
+ * Pop (delete) the last 'num' invalidated areas from the buffer.
+ * With `LV_USE_INV_TILES` the tiles of single areas can't be told apart: the buffer size is 1 while anything
+ * is invalid, and popping it clears every tile marked since the last refresh. Popping 0 keeps all of them.
  * @param num number of areas to delete
  */
 void _lv_disp_pop_from_inv_buf(lv_disp_t * disp, uint16_t num);
 
+/**
+ * Get the number of pixels redrawn in the last refresh of a display
+ * @param disp pointer to a display
+ * @return number of pixels
+ */
+uint32_t lv_disp_get_refr_px_num(lv_disp_t * disp);
+
+/**
+ * Get how many times the redrawn pixels were blended on average in the last refresh of a display
+ * @param disp pointer to a display
+ * @return blended pixels per redrawn pixels in percent. 100: every pixel was drawn once
+ */
+uint32_t lv_disp_get_refr_overdraw(lv_disp_t * disp);
+
+#if LV_USE_REFR_ADAPTIVE_BAND
+/**
+ * Get how long the last refresh of a display waited for the flushing to finish
+ * @param disp pointer to a display
+ * @return the time in microseconds
+ */
+uint32_t lv_disp_get_refr_stall_us(lv_disp_t * disp);
+
+/**
+ * Get the number of lines drawn at once on a display
+ * @param disp pointer to a display
+ * @return number of lines of a band as wide as the display
+ */
+lv_coord_t lv_disp_get_band_height(lv_disp_t * disp);
+#endif
+
 /**
  * Check the driver configuration if it's double buffered (both `buf1` and `buf2` are set)
  * @param disp pointer to to display to check
@@ -23,27 +23,77 @@
 #define LV_ANIM_RESOLUTION 1024
 #define LV_ANIM_RES_SHIFT 10
 #define LV_ANIM_TASK_PRIO LV_TASK_PRIO_HIGH
+#define LV_ANIM_POOL_BLOCK 8    /*Number of animation slots allocated at once*/
+#define LV_ANIM_LUT_SHIFT 4     /*The easing tables have an item for every 16th step*/
+#define LV_ANIM_LUT_SIZE ((LV_ANIM_RESOLUTION >> LV_ANIM_LUT_SHIFT) + 1)
 
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct _lv_anim_block_t {
+    struct _lv_anim_block_t * next;
+    lv_anim_t slots[LV_ANIM_POOL_BLOCK];
+} lv_anim_block_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void anim_task(lv_task_t * param);
 static void anim_mark_list_change(void);
-static void anim_ready_handler(lv_anim_t * a);
+static void anim_ready_handler(uint32_t id);
+static void anim_step_value(lv_anim_t * a);
+static lv_anim_t * anim_alloc(void);
+static void anim_free(uint32_t id);
+static void anim_compact(void);
+static int32_t anim_ease(const int16_t * lut, const lv_anim_t * a);
+static int32_t lut_step(const int16_t * lut, uint32_t t);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t last_task_run;
-static bool anim_list_changed;
-static bool anim_run_round;
+static bool anim_stepping;
+static uint32_t anim_round;
 static lv_task_t * _lv_anim_task;
 const lv_anim_path_t lv_anim_path_def = {.cb = lv_anim_path_linear};
 
+/*`_lv_bezier3()` of the built-in paths sampled at every 16th step of `LV_ANIM_RESOLUTION`*/
+static const int16_t ease_in_lut[LV_ANIM_LUT_SIZE] = {
+    0, 0, 0, 0, 0, 0, 0, 1, 2, 2, 3, 5, 6,
+    8, 10, 13, 16, 19, 22, 26, 31, 36, 41, 47, 54, 60,
+    68, 76, 85, 95, 105, 116, 128, 140, 153, 167, 182, 197, 214,
+    231, 250, 269, 289, 310, 332, 355, 380, 405, 432, 459, 488, 517,
+    549, 581, 615, 649, 686, 723, 762, 802, 843, 886, 930, 976, 1024
+};
+static const int16_t ease_out_lut[LV_ANIM_LUT_SIZE] = {
+    0, 46, 92, 135, 179, 219, 260, 299, 336, 371, 407, 440, 472,
+    503, 533, 562, 590, 616, 641, 665, 690, 711, 732, 752, 772, 788,
+    807, 823, 839, 854, 869, 880, 894, 904, 917, 926, 936, 944, 953,
+    959, 968, 974, 980, 985, 991, 994, 999, 1002, 1006, 1008, 1011, 1012,
+    1015, 1016, 1019, 1018, 1020, 1021, 1022, 1021, 1022, 1021, 1022, 1022, 1024
+};
+static const int16_t ease_in_out_lut[LV_ANIM_LUT_SIZE] = {
+    0, 4, 10, 17, 26, 33, 45, 55, 67, 79, 93, 107, 122,
+    136, 153, 170, 187, 204, 222, 241, 261, 280, 299, 319, 340, 360,
+    381, 402, 424, 445, 467, 488, 511, 532, 554, 575, 597, 617, 640,
+    659, 682, 701, 722, 741, 761, 779, 799, 816, 835, 851, 869, 883,
+    900, 914, 929, 941, 955, 966, 977, 986, 996, 1004, 1011, 1017, 1024
+};
+static const int16_t overshoot_lut[LV_ANIM_LUT_SIZE] = {
+    0, 45, 90, 134, 178, 220, 261, 301, 342, 378, 416, 452, 488,
+    521, 555, 587, 619, 649, 678, 707, 735, 761, 787, 811, 835, 856,
+    879, 898, 919, 938, 956, 972, 990, 1003, 1018, 1031, 1043, 1054, 1065,
+    1074, 1084, 1090, 1098, 1103, 1109, 1112, 1116, 1117, 1120, 1119, 1120, 1117,
+    1116, 1112, 1109, 1103, 1100, 1092, 1085, 1076, 1067, 1057, 1046, 1035, 1024
+};
+static const int16_t bounce_lut[LV_ANIM_LUT_SIZE] = {
+    1024, 1012, 1001, 990, 979, 969, 957, 946, 935, 923, 911, 899, 888,
+    875, 864, 850, 839, 825, 813, 799, 786, 773, 760, 745, 732, 717,
+    703, 689, 675, 659, 645, 629, 615, 598, 583, 567, 550, 533, 517,
+    499, 483, 466, 449, 431, 413, 394, 375, 356, 338, 318, 299, 279,
+    259, 239, 218, 197, 177, 156, 134, 111, 90, 67, 45, 22, 0
+};
+
 /**********************
  *      MACROS
  **********************/
@@ -57,10 +107,9 @@ const lv_anim_path_t lv_anim_path_def = {.cb = lv_anim_path_linear};
  */
 void _lv_anim_core_init(void)
 {
-    _lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
+    _lv_memset_00(&LV_GC_ROOT(_lv_anim_pool), sizeof(_lv_anim_pool_t));
     _lv_anim_task = lv_task_create(anim_task, LV_DISP_DEF_REFR_PERIOD, LV_ANIM_TASK_PRIO, NULL);
     anim_mark_list_change(); /*Turn off the animation task*/
-    anim_list_changed = false; /*The list has not actually changed*/
 }
 
 /**
@@ -91,28 +140,28 @@ void lv_anim_start(lv_anim_t * a)
     /* Do not let two animations for the same 'var' with the same 'fp'*/
     if(a->exec_cb != NULL) lv_anim_del(a->var, a->exec_cb); /*fp == NULL would delete all animations of var*/
 
-    /*If the list is empty the anim task was suspended and it's last run measure is invalid*/
-    if(_lv_ll_is_empty(&LV_GC_ROOT(_lv_anim_ll))) {
+    /*If there are no animations the anim task was suspended and it's last run measure is invalid*/
+    if(LV_GC_ROOT(_lv_anim_pool).used == 0) {
         last_task_run = lv_tick_get();
     }
 
-    /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = _lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
+    /*Take a slot from the pool. It's appended to the running animations*/
+    lv_anim_t * new_anim = anim_alloc();
     LV_ASSERT_MEM(new_anim);
     if(new_anim == NULL) return;
 
     /*Initialize the animation descriptor*/
     a->time_orig = a->time;
-    a->run_round = anim_run_round;
     _lv_memcpy(new_anim, a, sizeof(lv_anim_t));
+    new_anim->start_pending = 0;
+    new_anim->exec_pending = 0;
 
     /*Set the start value*/
     if(new_anim->early_apply) {
         if(new_anim->exec_cb && new_anim->var) new_anim->exec_cb(new_anim->var, new_anim->start);
     }
 
-    /* Creating an animation changed the linked list.
-     * It's important if it happens in a ready callback. (see `anim_task`)*/
+    /*Turn on the animation task if it was off*/
     anim_mark_list_change();
 
     LV_LOG_TRACE("animation created")
@@ -127,23 +176,21 @@ void lv_anim_start(lv_anim_t * a)
  */
 bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    lv_anim_t * a_next;
+    _lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
     bool del = false;
-    a        = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-    while(a != NULL) {
-        /*'a' might be deleted, so get the next object while 'a' is valid*/
-        a_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
-
-        if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-            lv_mem_free(a);
-            anim_mark_list_change(); /*Read by `anim_task`. It need to know if a delete occurred in
-                                         the linked list*/
+    uint32_t i;
+    for(i = 0; i < pool->cnt; i++) {
+        lv_anim_t * a = pool->act[i];
+        if(a && a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+            anim_free(i);
             del = true;
         }
+    }
 
-        a = a_next;
+    if(del) {
+        /*While stepping `anim_task` skips the deleted ones and compacts the list at the end*/
+        if(!anim_stepping) anim_compact();
+        anim_mark_list_change();
     }
 
     return del;
@@ -151,6 +198,8 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 
 /**
  * Get the animation of a variable and its `exec_cb`.
+ * If it's called from an animation's callback, the value of the returned animation is calculated again
+ * before it's applied in the same round, so the changes made through the pointer take effect.
  * @param var pointer to variable
  * @param exec_cb a function pointer which is animating 'var',
  *           or NULL to delete all the animations of 'var'
@@ -158,9 +207,12 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
  */
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    _LV_LL_READ(LV_GC_ROOT(_lv_anim_ll), a) {
-        if(a->var == var && a->exec_cb == exec_cb) {
+    _lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
+    uint32_t i;
+    for(i = 0; i < pool->cnt; i++) {
+        lv_anim_t * a = pool->act[i];
+        if(a && a->var == var && a->exec_cb == exec_cb) {
+            if(anim_stepping) a->value_stale = 1;
             return a;
         }
     }
@@ -174,11 +226,7 @@ lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
  */
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    _LV_LL_READ(LV_GC_ROOT(_lv_anim_ll), a) cnt++;
-
-    return cnt;
+    return LV_GC_ROOT(_lv_anim_pool).used;
 }
 
 /**
@@ -211,6 +259,16 @@ void lv_anim_refr_now(void)
     anim_task(NULL);
 }
 
+/**
+ * Get the identifier of the current animation round.
+ * An `exec_cb` can use it to do something only once while the animations are stepped together.
+ * @return a non-zero value while the animations are stepped, 0 otherwise
+ */
+uint32_t _lv_anim_get_round(void)
+{
+    return anim_stepping ? anim_round : 0;
+}
+
 /**
  * Calculate the current value of an animation applying linear characteristic
  * @param a pointer to an animation
@@ -242,17 +300,7 @@ lv_anim_value_t lv_anim_path_ease_in(const lv_anim_path_t * path, const lv_anim_
 {
     LV_UNUSED(path);
 
-    /*Calculate the current step*/
-
-    uint32_t t = _lv_map(a->act_time, 0, a->time, 0, 1024);
-    int32_t step = _lv_bezier3(t, 0, 1, 1, 1024);
-
-    int32_t new_value;
-    new_value = step * (a->end - a->start);
-    new_value = new_value >> 10;
-    new_value += a->start;
-
-    return new_value;
+    return anim_ease(ease_in_lut, a);
 }
 
 /**
@@ -264,17 +312,7 @@ lv_anim_value_t lv_anim_path_ease_out(const lv_anim_path_t * path, const lv_anim
 {
     LV_UNUSED(path);
 
-    /*Calculate the current step*/
-
-    uint32_t t = _lv_map(a->act_time, 0, a->time, 0, 1024);
-    int32_t step = _lv_bezier3(t, 0, 1023, 1023, 1024);
-
-    int32_t new_value;
-    new_value = step * (a->end - a->start);
-    new_value = new_value >> 10;
-    new_value += a->start;
-
-    return new_value;
+    return anim_ease(ease_out_lut, a);
 }
 
 /**
@@ -286,17 +324,7 @@ lv_anim_value_t lv_anim_path_ease_in_out(const lv_anim_path_t * path, const lv_a
 {
     LV_UNUSED(path);
 
-    /*Calculate the current step*/
-
-    uint32_t t = _lv_map(a->act_time, 0, a->time, 0, 1024);
-    int32_t step = _lv_bezier3(t, 0, 100, 924, 1024);
-
-    int32_t new_value;
-    new_value = step * (a->end - a->start);
-    new_value = new_value >> 10;
-    new_value += a->start;
-
-    return new_value;
+    return anim_ease(ease_in_out_lut, a);
 }
 
 /**
@@ -308,17 +336,7 @@ lv_anim_value_t lv_anim_path_overshoot(const lv_anim_path_t * path, const lv_ani
 {
     LV_UNUSED(path);
 
-    /*Calculate the current step*/
-
-    uint32_t t = _lv_map(a->act_time, 0, a->time, 0, 1024);
-    int32_t step = _lv_bezier3(t, 0, 1000, 1300, 1024);
-
-    int32_t new_value;
-    new_value = step * (a->end - a->start);
-    new_value = new_value >> 10;
-    new_value += a->start;
-
-    return new_value;
+    return anim_ease(overshoot_lut, a);
 }
 
 /**
@@ -371,7 +389,7 @@ lv_anim_value_t lv_anim_path_bounce(const lv_anim_path_t * path, const lv_anim_t
     if(t > 1024) t = 1024;
 
 
-    int32_t step = _lv_bezier3(t, 1024, 800, 500, 0);
+    int32_t step = lut_step(bounce_lut, t);
 
     int32_t new_value;
     new_value = step * diff;
@@ -403,73 +421,95 @@ lv_anim_value_t lv_anim_path_step(const lv_anim_path_t * path, const lv_anim_t *
 
 /**
  * Periodically handle the animations.
+ * First the time of all animations is stepped and their new value is calculated in one pass.
+ * Then the new values are applied and the callbacks are called in a second pass.
+ * The values of the animations got by `lv_anim_get()` from a callback are calculated again before applied.
  * @param param unused
  */
 static void anim_task(lv_task_t * param)
 {
     (void)param;
 
+    /*Don't step the animations again if `lv_refr_now()` is called from an animation's callback*/
+    if(anim_stepping) return;
+
+    _lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
     uint32_t elaps = lv_tick_elaps(last_task_run);
 
-    /*Flip the run round*/
-    anim_run_round = anim_run_round ? false : true;
+    anim_stepping = true;
+    anim_round++;
+    if(anim_round == 0) anim_round = 1;     /*0 means "not stepping"*/
 
-    lv_anim_t * a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
+    /*The animations started from the callbacks are appended and will run only in the next round*/
+    uint32_t cnt = pool->cnt;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_anim_t * a = pool->act[i];
+        int32_t new_act_time = a->act_time + elaps;
 
-    while(a != NULL) {
-        /*It can be set by `lv_anim_del()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_ready_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        anim_list_changed = false;
+        /*The animation will run now for the first time. `start_cb` might change the values,
+         * so calculate the new value only after calling it*/
+        if(a->act_time <= 0 && new_act_time >= 0 && a->start_cb) a->start_pending = 1;
 
-        if(a->run_round != anim_run_round) {
-            a->run_round = anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
+        a->act_time = new_act_time;
+        a->value_stale = 0;
+        if(a->act_time >= 0 && a->start_pending == 0) anim_step_value(a);
+    }
 
-            /*The animation will run now for the first time. Call `start_cb`*/
-            int32_t new_act_time = a->act_time + elaps;
-            if(a->act_time <= 0 && new_act_time >= 0) {
-                if(a->start_cb) a->start_cb(a);
-            }
-            a->act_time += elaps;
+    for(i = 0; i < cnt; i++) {
+        lv_anim_t * a = pool->act[i];
+        if(a == NULL) continue;     /*Deleted from an other animation's callback*/
+
+        if(a->start_pending) {
+            a->start_pending = 0;
+            a->start_cb(a);
+            if(pool->act[i] != a) continue;     /*Deleted itself*/
+            a->value_stale = 0;
+            if(a->act_time >= 0) anim_step_value(a);
+        }
+
+        /*An other animation's callback might have changed the values since the first pass.
+         *Apply the new value even if it's the same as `current` because e.g. `lv_anim_set_values` sets it too.*/
+        if(a->value_stale) {
+            a->value_stale = 0;
+            a->exec_pending = 0;
             if(a->act_time >= 0) {
-                if(a->act_time > a->time) a->act_time = a->time;
-
-                int32_t new_value;
-                if(a->path.cb) new_value = a->path.cb(&a->path, a);
-                else new_value = lv_anim_path_linear(&a->path, a);
-
-                if(new_value != a->current) {
-                    a->current = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
-                }
-
-                /*If the time is elapsed the animation is ready*/
-                if(a->act_time >= a->time) {
-                    anim_ready_handler(a);
-                }
+                anim_step_value(a);
+                a->exec_pending = 1;
             }
         }
 
-        /* If the linked list changed due to anim. delete then it's not safe to continue
-         * the reading of the list from here -> start from the head*/
-        if(anim_list_changed)
-            a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-        else
-            a = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
+        /*Apply the calculated value*/
+        if(a->exec_pending) {
+            a->exec_pending = 0;
+            if(a->exec_cb) a->exec_cb(a->var, a->current);
+            if(pool->act[i] != a) continue;
+        }
+
+        /*If the time is elapsed the animation is ready*/
+        if(a->act_time >= 0 && a->act_time >= a->time) {
+            anim_ready_handler(i);
+        }
     }
 
+    anim_stepping = false;
+
+    /*Remove the animations deleted in this round*/
+    anim_compact();
+    anim_mark_list_change();
+
     last_task_run = lv_tick_get();
 }
 
 /**
  * Called when an animation is ready to do the necessary thinks
  * e.g. repeat, play back, delete etc.
- * @param a pointer to an animation descriptor
+ * @param id index of the animation in the running animations
  */
-static void anim_ready_handler(lv_anim_t * a)
+static void anim_ready_handler(uint32_t id)
 {
+    lv_anim_t * a = LV_GC_ROOT(_lv_anim_pool).act[id];
+
     /*In the end of a forward anim decrement repeat cnt.*/
     if(a->playback_now == 0 && a->repeat_cnt > 0 && a->repeat_cnt != LV_ANIM_REPEAT_INFINITE) {
         a->repeat_cnt--;
@@ -484,10 +524,7 @@ static void anim_ready_handler(lv_anim_t * a)
          * This way the `ready_cb` will see the animations like it's animation is ready deleted*/
         lv_anim_t a_tmp;
         _lv_memcpy(&a_tmp, a, sizeof(lv_anim_t));
-        _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-        lv_mem_free(a);
-        /*Flag that the list has changed */
-        anim_mark_list_change();
+        anim_free(id);
 
         /* Call the callback function at the end*/
         if(a_tmp.ready_cb != NULL) a_tmp.ready_cb(&a_tmp);
@@ -512,10 +549,151 @@ static void anim_ready_handler(lv_anim_t * a)
         }
     }
 }
+
+/**
+ * Limit the time of an animation to its duration and calculate its new value.
+ * The value is only marked to be applied, no callbacks are called.
+ * @param a pointer to an animation whose `act_time` is not negative
+ */
+static void anim_step_value(lv_anim_t * a)
+{
+    if(a->act_time > a->time) a->act_time = a->time;
+
+    int32_t new_value;
+    if(a->path.cb) new_value = a->path.cb(&a->path, a);
+    else new_value = lv_anim_path_linear(&a->path, a);
+
+    if(new_value != a->current) {
+        a->current = new_value;
+        a->exec_pending = 1;
+    }
+}
+
+/**
+ * Get a slot for a new animation and append it to the running animations.
+ * The slots are allocated in blocks of `LV_ANIM_POOL_BLOCK` and kept until all animations are ready.
+ * @return pointer to the new slot or NULL if out of memory
+ */
+static lv_anim_t * anim_alloc(void)
+{
+    _lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
+
+    if(pool->cnt == pool->size) {
+        if(pool->size >= UINT16_MAX / 2) return NULL;
+        uint16_t new_size = pool->size ? pool->size * 2 : LV_ANIM_POOL_BLOCK;
+        lv_anim_t ** new_act = lv_mem_realloc(pool->act, new_size * sizeof(lv_anim_t *));
+        if(new_act == NULL) return NULL;
+        pool->act = new_act;
+        pool->size = new_size;
+    }
+
+    if(pool->free == NULL) {
+        lv_anim_block_t * block = lv_mem_alloc(sizeof(lv_anim_block_t));
+        if(block == NULL) return NULL;
+        block->next = pool->blocks;
+        pool->blocks = block;
+
+        uint32_t i;
+        for(i = 0; i < LV_ANIM_POOL_BLOCK; i++) {
+            block->slots[i].var = pool->free;
+            pool->free = &block->slots[i];
+        }
+    }
+
+    lv_anim_t * a = pool->free;
+    pool->free = a->var;
+    pool->act[pool->cnt] = a;
+    pool->cnt++;
+    pool->used++;
+
+    return a;
+}
+
+/**
+ * Give back the slot of a running animation to the pool.
+ * Its place in the running animations is set to `NULL` until `anim_compact()` is called.
+ * @param id index of the animation in the running animations
+ */
+static void anim_free(uint32_t id)
+{
+    _lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
+    lv_anim_t * a = pool->act[id];
+
+    pool->act[id] = NULL;
+    a->var = pool->free;
+    pool->free = a;
+    pool->used--;
+}
+
+/**
+ * Remove the deleted animations from the running animations keeping the order of the others.
+ * Free the whole pool if no animations are running.
+ */
+static void anim_compact(void)
+{
+    _lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
+
+    if(pool->used == 0) {
+        lv_anim_block_t * block = pool->blocks;
+        while(block) {
+            lv_anim_block_t * next = block->next;
+            lv_mem_free(block);
+            block = next;
+        }
+        lv_mem_free(pool->act);
+        _lv_memset_00(pool, sizeof(_lv_anim_pool_t));
+        return;
+    }
+
+    uint32_t i;
+    uint32_t j = 0;
+    for(i = 0; i < pool->cnt; i++) {
+        if(pool->act[i]) {
+            pool->act[j] = pool->act[i];
+            j++;
+        }
+    }
+    pool->cnt = j;
+}
+
+/**
+ * Calculate the current value of an animation with an easing table
+ * @param lut an easing table with `LV_ANIM_LUT_SIZE` items
+ * @param a pointer to an animation
+ * @return the current value to set
+ */
+static int32_t anim_ease(const int16_t * lut, const lv_anim_t * a)
+{
+    /*Calculate the current step*/
+    uint32_t t = _lv_map(a->act_time, 0, a->time, 0, LV_ANIM_RESOLUTION);
+    int32_t step = lut_step(lut, t);
+
+    int32_t new_value;
+    new_value = step * (a->end - a->start);
+    new_value = new_value >> LV_ANIM_RES_SHIFT;
+    new_value += a->start;
+
+    return new_value;
+}
+
+/**
+ * Get the step of an easing table interpolating between its items
+ * @param lut an easing table with `LV_ANIM_LUT_SIZE` items
+ * @param t the linear step [0..LV_ANIM_RESOLUTION]
+ * @return the eased step
+ */
+static int32_t lut_step(const int16_t * lut, uint32_t t)
+{
+    uint32_t i = t >> LV_ANIM_LUT_SHIFT;
+    if(i >= LV_ANIM_LUT_SIZE - 1) return lut[LV_ANIM_LUT_SIZE - 1];
+
+    int32_t frac = t & ((1 << LV_ANIM_LUT_SHIFT) - 1);
+    return lut[i] + (((lut[i + 1] - lut[i]) * frac) >> LV_ANIM_LUT_SHIFT);
+}
+
 static void anim_mark_list_change(void)
 {
-    anim_list_changed = true;
-    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL)
+    if(LV_GC_ROOT(_lv_anim_pool).used == 0)
         lv_task_set_prio(_lv_anim_task, LV_TASK_PRIO_OFF);
     else
         lv_task_set_prio(_lv_anim_task, LV_ANIM_TASK_PRIO);
@@ -39,6 +39,18 @@ typedef uint8_t lv_anim_enable_t;
 /** Type of the animated value*/
 typedef lv_coord_t lv_anim_value_t;
 
+struct _lv_anim_t;
+
+/** Storage of the running animations. Used internally by the animation module.*/
+typedef struct {
+    struct _lv_anim_t ** act;  /**< The running animations in the order of their start*/
+    struct _lv_anim_t * free;  /**< Unused slots chained through their `var` field*/
+    void * blocks;             /**< Blocks of slots chained through their first field*/
+    uint16_t cnt;              /**< Number of items in `act` (deleted ones are `NULL` while stepping)*/
+    uint16_t size;             /**< Allocated length of `act`*/
+    uint16_t used;             /**< Number of running animations*/
+} _lv_anim_pool_t;
+
 #if LV_USE_ANIMATION
 
 #define LV_ANIM_REPEAT_INFINITE      0xFFFF
@@ -93,8 +105,10 @@ typedef struct _lv_anim_t {
     uint8_t early_apply  : 1;    /**< 1: Apply start value immediately even is there is `delay` */
 
     /*Animation system use these - user shouldn't set*/
-    uint8_t playback_now : 1; /**< Play back is in progress*/
-    uint8_t run_round : 1;    /**< Indicates the animation has run in this round*/
+    uint8_t playback_now : 1;  /**< Play back is in progress*/
+    uint8_t start_pending : 1; /**< `start_cb` has to be called in this round*/
+    uint8_t exec_pending : 1;  /**< `current` has changed in this round and has to be applied*/
+    uint8_t value_stale : 1;   /**< Got by `lv_anim_get` in this round, `current` might be calculated from old values*/
     uint32_t time_orig;
 } lv_anim_t;
 
@@ -360,6 +374,13 @@ uint32_t lv_anim_speed_to_time(uint32_t speed, lv_anim_value_t start, lv_anim_va
  */
 void lv_anim_refr_now(void);
 
+/**
+ * Get the identifier of the current animation round.
+ * An `exec_cb` can use it to do something only once while the animations are stepped together.
+ * @return a non-zero value while the animations are stepped, 0 otherwise
+ */
+uint32_t _lv_anim_get_round(void);
+
 /**
  * Calculate the current value of an animation applying linear characteristic
  * @param a pointer to an animation
@@ -10,6 +10,7 @@
 #include "lv_bidi.h"
 #include "lv_txt.h"
 #include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_gc.h"
 
 #if LV_USE_BIDI
 
@@ -56,8 +57,8 @@ static uint32_t get_txt_len(const char * txt, uint32_t max_len);
  **********************/
 static const uint8_t bracket_left[] = {"<({["};
 static const uint8_t bracket_right[] = {">)}]"};
-static bracket_stack_t br_stack[LV_BIDI_BRACKLET_DEPTH];
-static uint8_t br_stack_p;
+static _LV_REFR_LOCAL bracket_stack_t br_stack[LV_BIDI_BRACKLET_DEPTH];
+static _LV_REFR_LOCAL uint8_t br_stack_p;
 
 /**********************
  *      MACROS
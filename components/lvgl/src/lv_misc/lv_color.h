@@ -493,8 +493,9 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_color_t lv_color_mix_premult(uint16_t * p
     LV_COLOR_SET_A(ret, 0xFF);
 #else
     /*LV_COLOR_DEPTH == 1*/
-    /*Restore color1*/
+    /*Restore color1. The channels are the same bit so clear the others first.*/
     lv_color_t c1;
+    c1.full = 0;
     LV_COLOR_SET_R(c1, premult_c1[0]);
     LV_COLOR_SET_G(c1, premult_c1[1]);
     LV_COLOR_SET_B(c1, premult_c1[2]);
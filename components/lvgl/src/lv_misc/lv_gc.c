@@ -30,6 +30,10 @@
     LV_ROOTS
 #endif /* LV_ENABLE_GC */
 
+#if LV_USE_REFR_WORKER
+    LV_REFR_WORKER_TLS lv_gc_local_roots_t * _lv_gc_local_roots;
+#endif
+
 /**********************
  *      MACROS
  **********************/
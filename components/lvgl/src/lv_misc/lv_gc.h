@@ -18,8 +18,12 @@ extern "C" {
 #include "lv_mem.h"
 #include "lv_ll.h"
 #include "lv_task.h"
+#include "lv_anim.h"
 #include "../lv_draw/lv_img_cache.h"
 #include "../lv_draw/lv_draw_mask.h"
+#include "../lv_draw/lv_draw_rect.h"
+#include "../lv_font/lv_font_fmt_txt.h"
+#include "../lv_core/lv_indev.h"
 
 /*********************
  *      DEFINES
@@ -27,23 +31,31 @@ extern "C" {
 
 #define LV_ITERATE_ROOTS(f) \
     f(lv_ll_t, _lv_task_ll)  /*Linked list to store the lv_tasks*/ \
+    f(lv_ll_pool_t, _lv_task_ll_pool)                              \
+    f(lv_ll_pool_t, _lv_obj_ll_pool) /*Screens and children*/      \
     f(lv_ll_t, _lv_disp_ll)  /*Linked list of screens*/            \
     f(lv_ll_t, _lv_indev_ll) /*Linked list of input device*/       \
+    f(_lv_indev_hit_index_arr_t, _lv_indev_hit_index)              \
     f(lv_ll_t, _lv_drv_ll)                                         \
     f(lv_ll_t, _lv_file_ll)                                        \
-    f(lv_ll_t, _lv_anim_ll)                                        \
+    f(_lv_anim_pool_t, _lv_anim_pool)                              \
     f(lv_ll_t, _lv_group_ll)                                       \
     f(lv_ll_t, _lv_img_defoder_ll)                                 \
     f(lv_ll_t, _lv_obj_style_trans_ll)                             \
-    f(lv_img_cache_entry_t*, _lv_img_cache_array)                  \
+    f(_lv_img_cache_t, _lv_img_cache)                              \
     f(lv_task_t*, _lv_task_act)                                    \
-    f(lv_mem_buf_arr_t , _lv_mem_buf)                              \
+    f(_lv_task_heap_arr_t , _lv_task_heap)                         \
+    f(lv_mem_buf_pool_t , _lv_mem_buf)                             \
     f(_lv_draw_mask_saved_arr_t , _lv_draw_mask_list)              \
+    f(_lv_draw_mask_radius_cache_t , _lv_draw_mask_radius_cache)   \
+    f(_lv_draw_shadow_cache_t , _lv_draw_shadow_cache)             \
     f(void * , _lv_theme_material_styles)                          \
     f(void * , _lv_theme_template_styles)                          \
     f(void * , _lv_theme_mono_styles)                              \
     f(void * , _lv_theme_empty_styles)                             \
     f(uint8_t *, _lv_font_decompr_buf)                             \
+    f(_lv_font_glyph_cache_t , _lv_font_glyph_cache)               \
+    f(lv_font_fmt_txt_lookup_t *, _lv_font_fmt_txt_lookups)        \
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
 #define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT)
@@ -59,6 +71,33 @@ extern "C" {
 LV_ITERATE_ROOTS(LV_EXTERN_ROOT)
 #endif /* LV_ENABLE_GC */
 
+#if LV_USE_REFR_WORKER
+#if LV_ENABLE_GC == 1
+#error "LV_USE_REFR_WORKER can't be used with LV_ENABLE_GC"
+#endif
+
+/*Roots the render worker thread has its own copy of*/
+#define LV_ITERATE_LOCAL_ROOTS(f) \
+    f(lv_mem_buf_pool_t , _lv_mem_buf)                             \
+    f(_lv_draw_mask_saved_arr_t , _lv_draw_mask_list)              \
+    f(_lv_draw_mask_radius_cache_t , _lv_draw_mask_radius_cache)   \
+    f(uint8_t *, _lv_font_decompr_buf)                             \
+    f(_lv_font_glyph_cache_t , _lv_font_glyph_cache)               \
+
+typedef struct {
+    LV_ITERATE_LOCAL_ROOTS(LV_DEFINE_ROOT)
+} lv_gc_local_roots_t;
+
+/*The worker's own roots on the worker thread, NULL on any other*/
+extern LV_REFR_WORKER_TLS lv_gc_local_roots_t * _lv_gc_local_roots;
+
+#define LV_GC_ROOT_LOCAL(x) (*(_lv_gc_local_roots ? &_lv_gc_local_roots->x : &LV_GC_ROOT(x)))
+#define _LV_REFR_LOCAL LV_REFR_WORKER_TLS
+#else
+#define LV_GC_ROOT_LOCAL(x) LV_GC_ROOT(x)
+#define _LV_REFR_LOCAL
+#endif /* LV_USE_REFR_WORKER */
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -2,6 +2,7 @@
  * @file lv_ll.c
  * Handle linked lists.
  * The nodes are dynamically allocated by the 'lv_mem' module,
+ * or taken from slabs of same sized nodes shared by the lists of a type.
  */
 
 /*********************
@@ -20,15 +21,36 @@
 #define LL_PREV_P_OFFSET(ll_p) (ll_p->n_size)
 #define LL_NEXT_P_OFFSET(ll_p) (ll_p->n_size + sizeof(lv_ll_node_t *))
 
+#define LL_POOL_SLAB_MIN 4      /*Nodes in the first slab of a pool*/
+#define LL_POOL_SLAB_MAX 32     /*The new slabs are as large as the pool up to this many nodes*/
+#define LL_SLAB_HEADER_SIZE ((sizeof(lv_ll_slab_t) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+#define LL_POOL_STRIDE(pool) ((pool)->n_size + LL_NODE_META_SIZE)
+#define LL_POOL_FREE_NEXT(pool, n) (*((lv_ll_node_t **)((n) + (pool)->n_size + sizeof(lv_ll_node_t *))))
+
 /**********************
  *      TYPEDEFS
  **********************/
+/*A block of nodes. The nodes follow the header.*/
+typedef struct _lv_ll_slab_t {
+    struct _lv_ll_slab_t * next;
+    lv_ll_node_t * free;    /*Free nodes chained through their next node pointer*/
+    uint16_t cnt;           /*Number of nodes*/
+    uint16_t used;          /*Number of nodes in lists*/
+} lv_ll_slab_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void node_set_prev(lv_ll_t * ll_p, lv_ll_node_t * act, lv_ll_node_t * prev);
 static void node_set_next(lv_ll_t * ll_p, lv_ll_node_t * act, lv_ll_node_t * next);
+static uint32_t round_size(uint32_t node_size);
+static lv_ll_node_t * node_alloc(lv_ll_t * ll_p);
+#if LV_LL_POOL
+static lv_ll_node_t * pool_alloc(lv_ll_pool_t * pool);
+static void pool_free(lv_ll_pool_t * pool, lv_ll_node_t * node);
+static lv_ll_slab_t * slab_find(lv_ll_slab_t * slab, uint32_t stride, const lv_ll_node_t * node,
+                                lv_ll_slab_t ** prev);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -51,15 +73,41 @@ void _lv_ll_init(lv_ll_t * ll_p, uint32_t node_size)
 {
     ll_p->head = NULL;
     ll_p->tail = NULL;
-#ifdef LV_ARCH_64
-    /*Round the size up to 8*/
-    node_size = (node_size + 7) & (~0x7);
-#else
-    /*Round the size up to 4*/
-    node_size = (node_size + 3) & (~0x3);
+    ll_p->n_size = round_size(node_size);
+#if LV_LL_POOL
+    ll_p->pool = NULL;
 #endif
+}
 
-    ll_p->n_size = node_size;
+/**
+ * Initialize a pool of nodes to share between the linked lists of a type
+ * @param pool pointer to a pool variable
+ * @param node_size the size of 1 node in bytes
+ */
+void _lv_ll_pool_init(lv_ll_pool_t * pool, uint32_t node_size)
+{
+    pool->n_size = round_size(node_size);
+    pool->partial = NULL;
+    pool->full = NULL;
+    pool->node_cnt = 0;
+}
+
+/**
+ * Initialize a linked list taking its nodes from a pool.
+ * Without `LV_LL_POOL` it's the same as `_lv_ll_init` with the node size of the pool.
+ * The nodes can be moved only between the lists of the same pool and
+ * they need to be freed with `_lv_ll_free_node`.
+ * @param ll_p pointer to ll_dsc variable
+ * @param pool pointer to an initialized pool
+ */
+void _lv_ll_init_pooled(lv_ll_t * ll_p, lv_ll_pool_t * pool)
+{
+    ll_p->head = NULL;
+    ll_p->tail = NULL;
+    ll_p->n_size = pool->n_size;
+#if LV_LL_POOL
+    ll_p->pool = pool;
+#endif
 }
 
 /**
@@ -71,7 +119,7 @@ void * _lv_ll_ins_head(lv_ll_t * ll_p)
 {
     lv_ll_node_t * n_new;
 
-    n_new = lv_mem_alloc(ll_p->n_size + LL_NODE_META_SIZE);
+    n_new = node_alloc(ll_p);
 
     if(n_new != NULL) {
         node_set_prev(ll_p, n_new, NULL);       /*No prev. before the new head*/
@@ -107,7 +155,7 @@ void * _lv_ll_ins_prev(lv_ll_t * ll_p, void * n_act)
         if(n_new == NULL) return NULL;
     }
     else {
-        n_new = lv_mem_alloc(ll_p->n_size + LL_NODE_META_SIZE);
+        n_new = node_alloc(ll_p);
         if(n_new == NULL) return NULL;
 
         lv_ll_node_t * n_prev;
@@ -130,7 +178,7 @@ void * _lv_ll_ins_tail(lv_ll_t * ll_p)
 {
     lv_ll_node_t * n_new;
 
-    n_new = lv_mem_alloc(ll_p->n_size + LL_NODE_META_SIZE);
+    n_new = node_alloc(ll_p);
 
     if(n_new != NULL) {
         node_set_next(ll_p, n_new, NULL);       /*No next after the new tail*/
@@ -185,6 +233,25 @@ void _lv_ll_remove(lv_ll_t * ll_p, void * node_p)
     }
 }
 
+/**
+ * Free the memory of a removed node
+ * @param ll_p pointer to the linked list whose node was 'node_p'
+ * @param node_p pointer to a node removed from 'll_p'
+ */
+void _lv_ll_free_node(lv_ll_t * ll_p, void * node_p)
+{
+#if LV_LL_POOL
+    if(ll_p->pool) {
+        pool_free(ll_p->pool, node_p);
+        return;
+    }
+#else
+    (void)ll_p; /*Unused*/
+#endif
+
+    lv_mem_free(node_p);
+}
+
 /**
  * Remove and free all elements from a linked list. The list remain valid but become empty.
  * @param ll_p pointer to linked list
@@ -201,7 +268,7 @@ void _lv_ll_clear(lv_ll_t * ll_p)
         i_next = _lv_ll_get_next(ll_p, i);
 
         _lv_ll_remove(ll_p, i);
-        lv_mem_free(i);
+        _lv_ll_free_node(ll_p, i);
 
         i = i_next;
     }
@@ -421,3 +488,146 @@ static void node_set_next(lv_ll_t * ll_p, lv_ll_node_t * act, lv_ll_node_t * nex
 
     *act_node_p = *next_node_p;
 }
+
+/**
+ * Round the size of the nodes' data up to the alignment of the pointers after it
+ * @param node_size the size of 1 node in bytes
+ * @return the rounded size
+ */
+static uint32_t round_size(uint32_t node_size)
+{
+#ifdef LV_ARCH_64
+    /*Round the size up to 8*/
+    node_size = (node_size + 7) & (~0x7);
+#else
+    /*Round the size up to 4*/
+    node_size = (node_size + 3) & (~0x3);
+#endif
+
+    return node_size;
+}
+
+/**
+ * Allocate a new node for a linked list from its pool or from `lv_mem`
+ * @param ll_p pointer to linked list
+ * @return pointer to the new node or NULL if out of memory
+ */
+static lv_ll_node_t * node_alloc(lv_ll_t * ll_p)
+{
+#if LV_LL_POOL
+    if(ll_p->pool) return pool_alloc(ll_p->pool);
+#endif
+
+    return lv_mem_alloc(ll_p->n_size + LL_NODE_META_SIZE);
+}
+
+#if LV_LL_POOL
+/**
+ * Take a node from the first slab having free nodes or from a new slab.
+ * The nodes of a new slab are given in address order so the nodes created one after the other
+ * are next to each other in the memory.
+ * @param pool pointer to a pool
+ * @return pointer to the node or NULL if out of memory
+ */
+static lv_ll_node_t * pool_alloc(lv_ll_pool_t * pool)
+{
+    uint32_t stride = LL_POOL_STRIDE(pool);
+    lv_ll_slab_t * slab = pool->partial;
+
+    if(slab == NULL) {
+        /*Grow the pool by its current size within the limits*/
+        uint32_t cnt = pool->node_cnt;
+        if(cnt < LL_POOL_SLAB_MIN) cnt = LL_POOL_SLAB_MIN;
+        if(cnt > LL_POOL_SLAB_MAX) cnt = LL_POOL_SLAB_MAX;
+
+        slab = lv_mem_alloc(LL_SLAB_HEADER_SIZE + cnt * stride);
+        if(slab == NULL) return NULL;
+
+        slab->cnt = cnt;
+        slab->used = 0;
+        slab->free = NULL;
+        uint8_t * nodes = (uint8_t *)slab + LL_SLAB_HEADER_SIZE;
+        uint32_t i;
+        for(i = cnt; i > 0; i--) {
+            lv_ll_node_t * n = nodes + (i - 1) * stride;
+            LL_POOL_FREE_NEXT(pool, n) = slab->free;
+            slab->free = n;
+        }
+
+        slab->next = NULL;
+        pool->partial = slab;
+        pool->node_cnt += cnt;
+    }
+
+    lv_ll_node_t * n = slab->free;
+    slab->free = LL_POOL_FREE_NEXT(pool, n);
+    slab->used++;
+
+    /*Move the slab to the full ones if it was the last free node*/
+    if(slab->free == NULL) {
+        pool->partial = slab->next;
+        slab->next = pool->full;
+        pool->full = slab;
+    }
+
+    return n;
+}
+
+/**
+ * Give back a node to its slab. Free the slab if none of its nodes are used.
+ * @param pool pointer to the pool of the node
+ * @param node pointer to a node of the pool
+ */
+static void pool_free(lv_ll_pool_t * pool, lv_ll_node_t * node)
+{
+    if(node == NULL) return;
+
+    uint32_t stride = LL_POOL_STRIDE(pool);
+    lv_ll_slab_t * prev;
+    lv_ll_slab_t ** list = (lv_ll_slab_t **)&pool->partial;
+    lv_ll_slab_t * slab = slab_find(*list, stride, node, &prev);
+    if(slab == NULL) {
+        list = (lv_ll_slab_t **)&pool->full;
+        slab = slab_find(*list, stride, node, &prev);
+        if(slab == NULL) return;    /*Not a node of this pool*/
+    }
+
+    /*Unlink the slab. It will be the first partial slab if still used*/
+    if(prev) prev->next = slab->next;
+    else *list = slab->next;
+
+    slab->used--;
+    if(slab->used == 0) {
+        pool->node_cnt -= slab->cnt;
+        lv_mem_free(slab);
+        return;
+    }
+
+    LL_POOL_FREE_NEXT(pool, node) = slab->free;
+    slab->free = node;
+    slab->next = pool->partial;
+    pool->partial = slab;
+}
+
+/**
+ * Find the slab of a node in a list of slabs
+ * @param slab the first slab of the list
+ * @param stride size of the nodes with the prev/next pointers
+ * @param node pointer to a node
+ * @param prev store the slab before the found one here (NULL if it's the first)
+ * @return the slab containing `node` or NULL if not found
+ */
+static lv_ll_slab_t * slab_find(lv_ll_slab_t * slab, uint32_t stride, const lv_ll_node_t * node,
+                                lv_ll_slab_t ** prev)
+{
+    *prev = NULL;
+    while(slab) {
+        const uint8_t * nodes = (const uint8_t *)slab + LL_SLAB_HEADER_SIZE;
+        if(node >= nodes && node < nodes + slab->cnt * stride) return slab;
+        *prev = slab;
+        slab = slab->next;
+    }
+
+    return NULL;
+}
+#endif
@@ -1,6 +1,7 @@
 /**
  * @file lv_ll.h
- * Handle linked lists. The nodes are dynamically allocated by the 'lv_mem' module.
+ * Handle linked lists. The nodes are dynamically allocated by the 'lv_mem' module
+ * or taken from a pool shared by the lists of the same type.
  */
 
 #ifndef LV_LL_H
@@ -29,11 +30,22 @@ extern "C" {
 /** Dummy type to make handling easier*/
 typedef uint8_t lv_ll_node_t;
 
+/** Nodes of the same size allocated in slabs for the linked lists of a type (`LV_LL_POOL`)*/
+typedef struct {
+    uint32_t n_size;    /**< Size of the nodes' data (without the prev/next pointers)*/
+    void * partial;     /**< Slabs having free nodes*/
+    void * full;        /**< Slabs without free nodes*/
+    uint32_t node_cnt;  /**< Number of nodes in all slabs*/
+} lv_ll_pool_t;
+
 /** Description of a linked list*/
 typedef struct {
     uint32_t n_size;
     lv_ll_node_t * head;
     lv_ll_node_t * tail;
+#if LV_LL_POOL
+    lv_ll_pool_t * pool;    /**< Take the nodes from here. NULL: allocate them one by one*/
+#endif
 } lv_ll_t;
 
 /**********************
@@ -47,6 +59,23 @@ typedef struct {
  */
 void _lv_ll_init(lv_ll_t * ll_p, uint32_t node_size);
 
+/**
+ * Initialize a pool of nodes to share between the linked lists of a type
+ * @param pool pointer to a pool variable
+ * @param node_size the size of 1 node in bytes
+ */
+void _lv_ll_pool_init(lv_ll_pool_t * pool, uint32_t node_size);
+
+/**
+ * Initialize a linked list taking its nodes from a pool.
+ * Without `LV_LL_POOL` it's the same as `_lv_ll_init` with the node size of the pool.
+ * The nodes can be moved only between the lists of the same pool and
+ * they need to be freed with `_lv_ll_free_node`.
+ * @param ll_p pointer to ll_dsc variable
+ * @param pool pointer to an initialized pool
+ */
+void _lv_ll_init_pooled(lv_ll_t * ll_p, lv_ll_pool_t * pool);
+
 /**
  * Add a new head to a linked list
  * @param ll_p pointer to linked list
@@ -77,6 +106,13 @@ void * _lv_ll_ins_tail(lv_ll_t * ll_p);
  */
 void _lv_ll_remove(lv_ll_t * ll_p, void * node_p);
 
+/**
+ * Free the memory of a removed node
+ * @param ll_p pointer to the linked list whose node was 'node_p'
+ * @param node_p pointer to a node removed from 'll_p'
+ */
+void _lv_ll_free_node(lv_ll_t * ll_p, void * node_p);
+
 /**
  * Remove and free all elements from a linked list. The list remain valid but become empty.
  * @param ll_p pointer to linked list
@@ -17,6 +17,14 @@
     #include LV_MEM_CUSTOM_INCLUDE
 #endif
 
+#if LV_USE_REFR_WORKER && LV_MEM_CUSTOM == 0
+    #include "../lv_core/lv_refr.h"
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_USE_POOL_ALLOC
+    #include <stdlib.h>
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -35,6 +43,16 @@
     #define MEM_UNIT uint32_t
 #endif
 
+/*Find the free entries in segregated lists (TLSF) instead of walking the entries*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    #define MEM_TLSF 1
+#else
+    #define MEM_TLSF 0
+#endif
+
+/*Free entries not bigger than this are counted as small by `lv_mem_monitor`*/
+#define MEM_FREE_SMALL_SIZE 64
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -45,7 +63,12 @@
 typedef union {
     struct {
         MEM_UNIT used : 1;    /* 1: if the entry is used*/
+#if MEM_TLSF
+        MEM_UNIT prev_free : 1; /* 1: if the entry before this is free*/
+        MEM_UNIT d_size : 30; /* Size of the data*/
+#else
         MEM_UNIT d_size : 31; /* Size of the data*/
+#endif
     } s;
     MEM_UNIT header; /* The header (used + d_size)*/
 } lv_mem_header_t;
@@ -57,22 +80,81 @@ typedef struct {
 
 #endif /* LV_ENABLE_GC */
 
+#if MEM_TLSF
+/*A free entry. It's in the list of its size class and the last pointer of its data points back to it,
+ *so the next entry can find and join it.*/
+typedef struct _lv_mem_free_ent_t {
+    lv_mem_header_t header;
+    struct _lv_mem_free_ent_t * next;   /*Next free entry of the same size class*/
+    struct _lv_mem_free_ent_t * prev;   /*Previous free entry of the same size class*/
+} lv_mem_free_ent_t;
+#endif
+
 #ifdef LV_ARCH_64
     #define ALIGN_MASK 0x7
+    #define ALIGN_SHIFT 3
 #else
     #define ALIGN_MASK 0x3
+    #define ALIGN_SHIFT 2
+#endif
+
+#if MEM_TLSF
+/*Every power of 2 sizes are divided into `TLSF_SL_CNT` size classes.
+ *Sizes below `TLSF_SMALL_SIZE` are divided linearly by the alignment.*/
+#define TLSF_SL_SHIFT   3
+#define TLSF_SL_CNT     (1 << TLSF_SL_SHIFT)
+#define TLSF_FL_SHIFT   (TLSF_SL_SHIFT + ALIGN_SHIFT)
+#define TLSF_SMALL_SIZE (1U << TLSF_FL_SHIFT)
+#define TLSF_FL_CNT     (31 - TLSF_FL_SHIFT)        /*`d_size` has 30 bits*/
+
+/*A free entry needs room for the links and the back pointer*/
+#define TLSF_MIN_SIZE   (3 * sizeof(void *))
 #endif
 
 #define MEM_BUF_SMALL_SIZE 16
 
+/*Temporary buffers in a size class have `1 << (cls + MEM_BUF_CLASS_SHIFT)` bytes*/
+#define MEM_BUF_CLASS_SHIFT 5
+#define MEM_BUF_CLASS_LARGE LV_MEM_BUF_CLASS_CNT
+#define MEM_BUF_CLASS_SIZE(cls) (1UL << ((cls) + MEM_BUF_CLASS_SHIFT))
+
+#if LV_MEM_BUF_MAX_NUM > 32
+    #error "LV_MEM_BUF_MAX_NUM can be at most 32 (the free buffers are bits of a uint32_t)"
+#endif
+
+/*The built-in heap is shared by the rendering threads*/
+#if LV_USE_REFR_WORKER && LV_MEM_CUSTOM == 0
+    #define MEM_LOCK()    _lv_refr_worker_lock()
+    #define MEM_UNLOCK()  _lv_refr_worker_unlock()
+#else
+    #define MEM_LOCK()
+    #define MEM_UNLOCK()
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 #if LV_MEM_CUSTOM == 0
+    static void mem_reset(void);
     static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e);
+#endif
+#if MEM_TLSF
+    static lv_mem_ent_t * tlsf_alloc(size_t size);
+    static bool tlsf_resize(lv_mem_ent_t * e, size_t size);
+    static void tlsf_trunc(lv_mem_ent_t * e, size_t size);
+    static void tlsf_release(lv_mem_ent_t * e);
+    static void tlsf_insert(lv_mem_free_ent_t * e);
+    static void tlsf_remove(lv_mem_free_ent_t * e);
+    static void tlsf_mapping(uint32_t size, uint32_t * fl, uint32_t * sl);
+#elif LV_MEM_CUSTOM == 0
     static void * ent_alloc(lv_mem_ent_t * e, size_t size);
     static void ent_trunc(lv_mem_ent_t * e, size_t size);
 #endif
+static int32_t mem_buf_alloc(lv_mem_buf_pool_t * pool, uint32_t size, uint32_t cls);
+static void mem_buf_take(lv_mem_buf_pool_t * pool, uint32_t i, uint32_t cls);
+static uint32_t mem_buf_class(uint32_t size);
+static uint32_t bit_fls(uint32_t x);
+static uint32_t bit_ffs(uint32_t x);
 
 /**********************
  *  STATIC VARIABLES
@@ -87,6 +169,12 @@ static uint32_t zero_mem; /*Give the address of this variable if 0 byte should b
     static uint32_t mem_max_size; /*Tracks the maximum total size of memory ever used from the internal heap*/
 #endif
 
+#if MEM_TLSF
+    static uint32_t tlsf_fl_map;                /*Bit `fl` is set if `tlsf_sl_map[fl]` isn't 0*/
+    static uint8_t tlsf_sl_map[TLSF_FL_CNT];   /*Bit `sl` is set if `tlsf_heads[fl][sl]` isn't empty*/
+    static lv_mem_free_ent_t * tlsf_heads[TLSF_FL_CNT][TLSF_SL_CNT];
+#endif
+
 static uint8_t mem_buf1_32[MEM_BUF_SMALL_SIZE];
 static uint8_t mem_buf2_32[MEM_BUF_SMALL_SIZE];
 
@@ -94,6 +182,8 @@ static lv_mem_buf_t mem_buf_small[] = {{.p = mem_buf1_32, .size = MEM_BUF_SMALL_
     {.p = mem_buf2_32, .size = MEM_BUF_SMALL_SIZE, .used = 0}
 };
 
+static lv_mem_buf_stat_t mem_buf_stat_last; /*Counters of the last refresh using buffers (main thread)*/
+
 /**********************
  *      MACROS
  **********************/
@@ -115,18 +205,20 @@ void _lv_mem_init(void)
 {
 #if LV_MEM_CUSTOM == 0
 
-#if LV_MEM_ADR == 0
+#if LV_MEM_ADR != 0
+    work_mem = (uint8_t *)LV_MEM_ADR;
+#elif LV_MEM_USE_POOL_ALLOC
+    /*Allocate the pool from the system once, e.g. from an external RAM*/
+    if(work_mem == NULL) work_mem = LV_MEM_POOL_ALLOC(LV_MEM_SIZE);
+    LV_DEBUG_ASSERT(work_mem != NULL, "Couldn't allocate the memory pool", LV_MEM_SIZE);
+    if(work_mem == NULL) return;
+#else
     /*Allocate a large array to store the dynamically allocated data*/
     static LV_MEM_ATTR MEM_UNIT work_mem_int[LV_MEM_SIZE / sizeof(MEM_UNIT)];
     work_mem = (uint8_t *)work_mem_int;
-#else
-    work_mem = (uint8_t *)LV_MEM_ADR;
 #endif
 
-    lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
-    full->header.s.used = 0;
-    /*The total mem size reduced by the first header and the close patterns */
-    full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
+    mem_reset();
 #endif
 }
 
@@ -137,10 +229,7 @@ void _lv_mem_init(void)
 void _lv_mem_deinit(void)
 {
 #if LV_MEM_CUSTOM == 0
-    lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
-    full->header.s.used = 0;
-    /*The total mem size reduced by the first header and the close patterns */
-    full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
+    mem_reset();
 #endif
 }
 
@@ -163,6 +252,13 @@ void * lv_mem_alloc(size_t size)
     /*Use the built-in allocators*/
     lv_mem_ent_t * e = NULL;
 
+    MEM_LOCK();
+
+#if MEM_TLSF
+    /*Take a free entry from the size classes*/
+    e = tlsf_alloc(size);
+    if(e != NULL) alloc = &e->first_data;
+#else
     /* Search for a appropriate entry*/
     do {
         /* Get the next entry*/
@@ -174,6 +270,15 @@ void * lv_mem_alloc(size_t size)
         }
         /* End if there is not next entry OR the alloc. is successful*/
     } while(e != NULL && alloc == NULL);
+#endif
+
+    if(alloc != NULL && (uintptr_t) alloc > (uintptr_t) work_mem) {
+        if((((uintptr_t) alloc - (uintptr_t) work_mem) + size) > mem_max_size) {
+            mem_max_size = ((uintptr_t) alloc - (uintptr_t) work_mem) + size;
+        }
+    }
+
+    MEM_UNLOCK();
 
 #else
     /*Use custom, user defined malloc function*/
@@ -198,16 +303,6 @@ void * lv_mem_alloc(size_t size)
     if(alloc == NULL) {
         LV_LOG_WARN("Couldn't allocate memory");
     }
-    else {
-#if LV_MEM_CUSTOM == 0
-        /* just a safety check, should always be true */
-        if((uintptr_t) alloc > (uintptr_t) work_mem) {
-            if((((uintptr_t) alloc - (uintptr_t) work_mem) + size) > mem_max_size) {
-                mem_max_size = ((uintptr_t) alloc - (uintptr_t) work_mem) + size;
-            }
-        }
-#endif
-    }
 
     return alloc;
 }
@@ -228,11 +323,15 @@ void lv_mem_free(const void * data)
 #if LV_ENABLE_GC == 0
     /*e points to the header*/
     lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
+    MEM_LOCK();
     e->header.s.used = 0;
 #endif
 
 #if LV_MEM_CUSTOM == 0
-#if LV_MEM_AUTO_DEFRAG
+#if MEM_TLSF
+    /*Join the free neighbors and put the entry into its size class*/
+    tlsf_release(e);
+#elif LV_MEM_AUTO_DEFRAG
     static uint16_t full_defrag_cnt = 0;
     full_defrag_cnt++;
     if(full_defrag_cnt < LV_MEM_FULL_DEFRAG_CNT) {
@@ -256,6 +355,7 @@ void lv_mem_free(const void * data)
 
     }
 #endif /*LV_MEM_AUTO_DEFRAG*/
+    MEM_UNLOCK();
 #else /*Use custom, user defined free function*/
 #if LV_ENABLE_GC == 0
     LV_MEM_CUSTOM_FREE(e);
@@ -291,11 +391,22 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     uint32_t old_size = _lv_mem_get_size(data_p);
     if(old_size == new_size) return data_p; /*Also avoid reallocating the same memory*/
 
-#if LV_MEM_CUSTOM == 0
+#if MEM_TLSF
+    /* Truncate the memory or grow it into the next free entry if possible */
+    if(old_size != 0 && new_size != 0) {
+        lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
+        MEM_LOCK();
+        bool res = tlsf_resize(e, new_size);
+        MEM_UNLOCK();
+        if(res) return data_p;
+    }
+#elif LV_MEM_CUSTOM == 0
     /* Truncate the memory if the new size is smaller. */
     if(new_size < old_size) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
+        MEM_LOCK();
         ent_trunc(e, new_size);
+        MEM_UNLOCK();
         return &e->first_data;
     }
 #endif
@@ -334,7 +445,8 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
  */
 void lv_mem_defrag(void)
 {
-#if LV_MEM_CUSTOM == 0
+    /*With TLSF the free entries are joined already on free*/
+#if LV_MEM_CUSTOM == 0 && MEM_TLSF == 0
     lv_mem_ent_t * e_free;
     lv_mem_ent_t * e_next;
     e_free = ent_get_next(NULL);
@@ -378,6 +490,9 @@ lv_res_t lv_mem_test(void)
 #if LV_MEM_CUSTOM == 0
     lv_mem_ent_t * e;
     e = ent_get_next(NULL);
+#if MEM_TLSF
+    bool prev_free = false;
+#endif
     while(e) {
         if(e->header.s.d_size > LV_MEM_SIZE) {
             return LV_RES_INV;
@@ -386,6 +501,12 @@ lv_res_t lv_mem_test(void)
         if(e8 + e->header.s.d_size > work_mem + LV_MEM_SIZE) {
             return LV_RES_INV;
         }
+#if MEM_TLSF
+        /*Free entries are always joined and the next entry knows about them*/
+        if(e->header.s.prev_free != prev_free) return LV_RES_INV;
+        if(prev_free && e->header.s.used == 0) return LV_RES_INV;
+        prev_free = e->header.s.used == 0;
+#endif
         e = ent_get_next(e);
     }
 #endif
@@ -413,6 +534,10 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
             if(e->header.s.d_size > mon_p->free_biggest_size) {
                 mon_p->free_biggest_size = e->header.s.d_size;
             }
+            if(e->header.s.d_size <= MEM_FREE_SMALL_SIZE) {
+                mon_p->free_small_cnt++;
+                mon_p->free_small_size += e->header.s.d_size;
+            }
         }
         else {
             mon_p->used_cnt++;
@@ -468,9 +593,13 @@ void * _lv_mem_buf_get(uint32_t size)
 {
     if(size == 0) return NULL;
 
-    /*Try small static buffers first*/
+    /*Try small static buffers first. They belong to the main thread.*/
     uint8_t i;
+#if LV_USE_REFR_WORKER
+    if(size <= MEM_BUF_SMALL_SIZE && _lv_gc_local_roots == NULL) {
+#else
     if(size <= MEM_BUF_SMALL_SIZE) {
+#endif
         for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
             if(mem_buf_small[i].used == 0) {
                 mem_buf_small[i].used = 1;
@@ -479,47 +608,37 @@ void * _lv_mem_buf_get(uint32_t size)
         }
     }
 
-    /*Try to find a free buffer with suitable size */
-    int8_t i_guess = -1;
-    for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0 && LV_GC_ROOT(_lv_mem_buf[i]).size >= size) {
-            if(LV_GC_ROOT(_lv_mem_buf[i]).size == size) {
-                LV_GC_ROOT(_lv_mem_buf[i]).used = 1;
-                return LV_GC_ROOT(_lv_mem_buf[i]).p;
-            }
-            else if(i_guess < 0) {
-                i_guess = i;
-            }
-            /*If size of `i` is closer to `size` prefer it*/
-            else if(LV_GC_ROOT(_lv_mem_buf[i]).size < LV_GC_ROOT(_lv_mem_buf[i_guess]).size) {
-                i_guess = i;
-            }
+    lv_mem_buf_pool_t * pool = &LV_GC_ROOT_LOCAL(_lv_mem_buf);
+    pool->stat.get_cnt++;
+
+    /*Take a free buffer from the size class of `size` or from a larger class*/
+    uint32_t cls = mem_buf_class(size);
+    uint32_t c;
+    for(c = cls; c < MEM_BUF_CLASS_LARGE; c++) {
+        if(pool->free_map[c]) {
+            uint32_t buf_i = bit_ffs(pool->free_map[c]);
+            mem_buf_take(pool, buf_i, cls);
+            return pool->bufs[buf_i].p;
         }
     }
 
-    if(i_guess >= 0) {
-        LV_GC_ROOT(_lv_mem_buf[i_guess]).used = 1;
-        return LV_GC_ROOT(_lv_mem_buf[i_guess]).p;
-    }
-
-    /*Reallocate a free buffer*/
-    for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0) {
-            /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
-            void * buf = lv_mem_realloc(LV_GC_ROOT(_lv_mem_buf[i]).p, size);
-            if(buf == NULL) {
-                LV_DEBUG_ASSERT(false, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)", 0x00);
-                return NULL;
-            }
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 1;
-            LV_GC_ROOT(_lv_mem_buf[i]).size = size;
-            LV_GC_ROOT(_lv_mem_buf[i]).p    = buf;
-            return LV_GC_ROOT(_lv_mem_buf[i]).p;
+    /*Take the smallest large buffer which is big enough*/
+    int32_t i_guess = -1;
+    uint32_t map = pool->free_map[MEM_BUF_CLASS_LARGE];
+    while(map) {
+        uint32_t buf_i = bit_ffs(map);
+        map &= map - 1;
+        if(pool->bufs[buf_i].size >= size) {
+            if(i_guess < 0 || pool->bufs[buf_i].size < pool->bufs[i_guess].size) i_guess = buf_i;
         }
     }
 
-    LV_DEBUG_ASSERT(false, "No free buffer. Increase LV_MEM_BUF_MAX_NUM.", 0x00);
-    return NULL;
+    /*Allocate a new buffer*/
+    if(i_guess < 0) i_guess = mem_buf_alloc(pool, size, cls);
+    if(i_guess < 0) return NULL;
+
+    mem_buf_take(pool, i_guess, cls);
+    return pool->bufs[i_guess].p;
 }
 
 /**
@@ -538,9 +657,13 @@ void _lv_mem_buf_release(void * p)
         }
     }
 
+    lv_mem_buf_pool_t * pool = &LV_GC_ROOT_LOCAL(_lv_mem_buf);
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).p == p) {
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
+        lv_mem_buf_t * buf = &pool->bufs[i];
+        if(buf->p == p && buf->used) {
+            buf->used = 0;
+            pool->used_cnt[buf->cls]--;
+            pool->free_map[mem_buf_class(buf->size)] |= 1UL << i;
             return;
         }
     }
@@ -549,7 +672,8 @@ void _lv_mem_buf_release(void * p)
 }
 
 /**
- * Free all memory buffers
+ * Release all memory buffers at the end of a refresh.
+ * The buffers of the most used sizes are kept up to `LV_MEM_BUF_KEEP_SIZE` bytes, the others are freed.
  */
 void _lv_mem_buf_free_all(void)
 {
@@ -558,14 +682,97 @@ void _lv_mem_buf_free_all(void)
         mem_buf_small[i].used = 0;
     }
 
+    lv_mem_buf_pool_t * pool = &LV_GC_ROOT_LOCAL(_lv_mem_buf);
+    uint32_t c;
+
+    /*Halve the excess of the kept counts over the peaks of this refresh so a single large refresh
+     *doesn't pin its buffers. The refreshes without buffers (e.g. nothing was invalid) keep them.*/
+    bool used = false;
+    for(c = 0; c <= LV_MEM_BUF_CLASS_CNT; c++) {
+        if(pool->used_peak[c]) used = true;
+    }
+
+    if(used) {
+        for(c = 0; c <= LV_MEM_BUF_CLASS_CNT; c++) {
+            pool->used_max[c] = pool->used_peak[c] + (pool->used_max[c] - pool->used_peak[c]) / 2;
+        }
+        _lv_memset_00(pool->used_peak, sizeof(pool->used_peak));
+    }
+
+    /*Keep as many buffers of the size classes as were used at most at once. Start with the smallest ones.*/
+    uint8_t keep_cnt[LV_MEM_BUF_CLASS_CNT];
+    uint32_t keep_size = 0;
+    for(c = 0; c < LV_MEM_BUF_CLASS_CNT; c++) {
+        keep_cnt[c] = 0;
+        while(keep_cnt[c] < pool->used_max[c] && keep_size + MEM_BUF_CLASS_SIZE(c) <= LV_MEM_BUF_KEEP_SIZE) {
+            keep_cnt[c]++;
+            keep_size += MEM_BUF_CLASS_SIZE(c);
+        }
+    }
+
+    _lv_memset_00(pool->free_map, sizeof(pool->free_map));
+    _lv_memset_00(pool->used_cnt, sizeof(pool->used_cnt));
+
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).p) {
-            lv_mem_free(LV_GC_ROOT(_lv_mem_buf[i]).p);
-            LV_GC_ROOT(_lv_mem_buf[i]).p = NULL;
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
-            LV_GC_ROOT(_lv_mem_buf[i]).size = 0;
+        lv_mem_buf_t * buf = &pool->bufs[i];
+        buf->used = 0;
+        if(buf->p == NULL) continue;
+
+        c = mem_buf_class(buf->size);
+        if(c < MEM_BUF_CLASS_LARGE && keep_cnt[c] > 0) {
+            keep_cnt[c]--;
+            pool->free_map[c] |= 1UL << i;
+        }
+        else {
+            lv_mem_free(buf->p);
+            buf->p = NULL;
+            buf->size = 0;
+        }
+    }
+
+    /*Allocate the missing ones now to not allocate in the next refresh*/
+    i = 0;
+    for(c = 0; c < LV_MEM_BUF_CLASS_CNT; c++) {
+        for(; keep_cnt[c] > 0; keep_cnt[c]--) {
+            while(i < LV_MEM_BUF_MAX_NUM && pool->bufs[i].p) i++;
+            if(i == LV_MEM_BUF_MAX_NUM) break;
+
+            pool->bufs[i].p = lv_mem_alloc(MEM_BUF_CLASS_SIZE(c));
+            if(pool->bufs[i].p == NULL) break;
+            pool->bufs[i].size = MEM_BUF_CLASS_SIZE(c);
+            pool->free_map[c] |= 1UL << i;
         }
     }
+
+    /*Save the counters of the refresh*/
+    if(pool->stat.get_cnt) {
+        pool->stat.kept_size = 0;
+        for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) pool->stat.kept_size += pool->bufs[i].size;
+        mem_buf_stat_last = pool->stat;
+        _lv_memset_00(&pool->stat, sizeof(pool->stat));
+    }
+}
+
+/**
+ * Add the counters of an other thread's buffers to this thread's and clear them
+ * @param pool pointer to the buffers of an other thread which doesn't use them now
+ */
+void _lv_mem_buf_join_stat(lv_mem_buf_pool_t * pool)
+{
+    lv_mem_buf_stat_t * stat = &LV_GC_ROOT_LOCAL(_lv_mem_buf).stat;
+    stat->get_cnt += pool->stat.get_cnt;
+    stat->miss_cnt += pool->stat.miss_cnt;
+    stat->realloc_cnt += pool->stat.realloc_cnt;
+    _lv_memset_00(&pool->stat, sizeof(pool->stat));
+}
+
+/**
+ * Get the counters of the temporary buffers in the last refresh which used buffers
+ * @param stat store the counters here
+ */
+void lv_mem_buf_get_stat(lv_mem_buf_stat_t * stat)
+{
+    *stat = mem_buf_stat_last;
 }
 
 #if LV_MEMCPY_MEMSET_STD == 0
@@ -758,6 +965,28 @@ LV_ATTRIBUTE_FAST_MEM void _lv_memset_ff(void * dst, size_t len)
  **********************/
 
 #if LV_MEM_CUSTOM == 0
+/**
+ * Make the whole work memory one free entry
+ */
+static void mem_reset(void)
+{
+    lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
+    /*The total mem size reduced by the first header and the close patterns */
+#if MEM_TLSF
+    tlsf_fl_map = 0;
+    _lv_memset_00(tlsf_sl_map, sizeof(tlsf_sl_map));
+    _lv_memset_00(tlsf_heads, sizeof(tlsf_heads));
+
+    full->header.s.used = 1;
+    full->header.s.prev_free = 0;
+    full->header.s.d_size = (LV_MEM_SIZE & ~ALIGN_MASK) - sizeof(lv_mem_header_t);
+    tlsf_release(full);
+#else
+    full->header.s.used = 0;
+    full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
+#endif
+}
+
 /**
  * Give the next entry after 'act_e'
  * @param act_e pointer to an entry
@@ -780,6 +1009,198 @@ static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e)
     return next_e;
 }
 
+#if MEM_TLSF
+
+/**
+ * Take a free entry for an allocation.
+ * The list of the next size class is checked first as all of its entries are big enough.
+ * @param size size of the new memory in bytes (aligned)
+ * @return the allocated entry or NULL if there is no free entry for `size`
+ */
+static lv_mem_ent_t * tlsf_alloc(size_t size)
+{
+    if(size < TLSF_MIN_SIZE) size = TLSF_MIN_SIZE;
+    if(size >= LV_MEM_SIZE) return NULL;
+
+    uint32_t fl;
+    uint32_t sl;
+    uint32_t size_up = size;
+    if(size_up >= TLSF_SMALL_SIZE) size_up += (1U << (bit_fls(size_up) - TLSF_SL_SHIFT)) - 1;
+    tlsf_mapping(size_up, &fl, &sl);
+
+    lv_mem_free_ent_t * e = NULL;
+    if(fl < TLSF_FL_CNT) {
+        uint32_t sl_map = tlsf_sl_map[fl] & (~0U << sl);
+        if(sl_map == 0) {
+            /*Take a bigger power of 2*/
+            uint32_t fl_map = tlsf_fl_map & (~0U << (fl + 1));
+            if(fl_map != 0) {
+                fl = bit_ffs(fl_map);
+                sl_map = tlsf_sl_map[fl];
+            }
+        }
+        if(sl_map != 0) e = tlsf_heads[fl][bit_ffs(sl_map)];
+    }
+
+    /*The entries in the size class of `size` can be big enough too*/
+    if(e == NULL) {
+        tlsf_mapping(size, &fl, &sl);
+        e = tlsf_heads[fl][sl];
+        while(e != NULL && e->header.s.d_size < size) e = e->next;
+        if(e == NULL) return NULL;
+    }
+
+    tlsf_remove(e);
+    lv_mem_ent_t * ent = (lv_mem_ent_t *)e;
+    ent->header.s.used = 1;
+    lv_mem_ent_t * next = ent_get_next(ent);
+    if(next) next->header.s.prev_free = 0;
+
+    tlsf_trunc(ent, size);
+    return ent;
+}
+
+/**
+ * Change the size of an allocated entry in place
+ * @param e pointer to a used entry
+ * @param size the new size in bytes (aligned)
+ * @return true: resized; false: the next entry is not free or not big enough
+ */
+static bool tlsf_resize(lv_mem_ent_t * e, size_t size)
+{
+    if(size < TLSF_MIN_SIZE) size = TLSF_MIN_SIZE;
+
+    if(size > e->header.s.d_size) {
+        lv_mem_ent_t * next = ent_get_next(e);
+        if(next == NULL || next->header.s.used) return false;
+        if(e->header.s.d_size + sizeof(lv_mem_header_t) + next->header.s.d_size < size) return false;
+
+        tlsf_remove((lv_mem_free_ent_t *)next);
+        e->header.s.d_size += sizeof(lv_mem_header_t) + next->header.s.d_size;
+        next = ent_get_next(e);
+        if(next) next->header.s.prev_free = 0;
+
+        uint32_t end = (uintptr_t)&e->first_data + size - (uintptr_t)work_mem;
+        if(end > mem_max_size) mem_max_size = end;
+    }
+
+    tlsf_trunc(e, size);
+    return true;
+}
+
+/**
+ * Free the end of a used entry if it's big enough for a new entry
+ * @param e pointer to a used entry
+ * @param size the size to keep in bytes (aligned)
+ */
+static void tlsf_trunc(lv_mem_ent_t * e, size_t size)
+{
+    if(e->header.s.d_size < size + sizeof(lv_mem_header_t) + TLSF_MIN_SIZE) return;
+
+    lv_mem_ent_t * rest = (lv_mem_ent_t *)(&e->first_data + size);
+    rest->header.s.used = 1;
+    rest->header.s.prev_free = 0;
+    rest->header.s.d_size = e->header.s.d_size - size - sizeof(lv_mem_header_t);
+    e->header.s.d_size = size;
+
+    tlsf_release(rest);
+}
+
+/**
+ * Free an entry: join it with the free neighbors and put it into its size class
+ * @param e pointer to an entry
+ */
+static void tlsf_release(lv_mem_ent_t * e)
+{
+    e->header.s.used = 0;
+
+    lv_mem_ent_t * next = ent_get_next(e);
+    if(next != NULL && next->header.s.used == 0) {
+        tlsf_remove((lv_mem_free_ent_t *)next);
+        e->header.s.d_size += sizeof(lv_mem_header_t) + next->header.s.d_size;
+    }
+
+    if(e->header.s.prev_free) {
+        /*The last pointer of the previous entry points to it*/
+        lv_mem_ent_t * prev = ((lv_mem_ent_t **)e)[-1];
+        tlsf_remove((lv_mem_free_ent_t *)prev);
+        prev->header.s.d_size += sizeof(lv_mem_header_t) + e->header.s.d_size;
+        e = prev;
+    }
+
+    tlsf_insert((lv_mem_free_ent_t *)e);
+}
+
+/**
+ * Add a free entry to the list of its size class
+ * @param e pointer to a free entry
+ */
+static void tlsf_insert(lv_mem_free_ent_t * e)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(e->header.s.d_size, &fl, &sl);
+
+    e->prev = NULL;
+    e->next = tlsf_heads[fl][sl];
+    if(e->next) e->next->prev = e;
+    tlsf_heads[fl][sl] = e;
+    tlsf_sl_map[fl] |= 1U << sl;
+    tlsf_fl_map |= 1U << fl;
+
+    /*Let the next entry find this one*/
+    lv_mem_ent_t * ent = (lv_mem_ent_t *)e;
+    lv_mem_ent_t ** back = (lv_mem_ent_t **)(&ent->first_data + ent->header.s.d_size);
+    back[-1] = ent;
+
+    lv_mem_ent_t * next = ent_get_next(ent);
+    if(next) next->header.s.prev_free = 1;
+}
+
+/**
+ * Remove a free entry from the list of its size class
+ * @param e pointer to a free entry
+ */
+static void tlsf_remove(lv_mem_free_ent_t * e)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(e->header.s.d_size, &fl, &sl);
+
+    if(e->next) e->next->prev = e->prev;
+    if(e->prev) {
+        e->prev->next = e->next;
+    }
+    else {
+        tlsf_heads[fl][sl] = e->next;
+        if(e->next == NULL) {
+            tlsf_sl_map[fl] &= ~(1U << sl);
+            if(tlsf_sl_map[fl] == 0) tlsf_fl_map &= ~(1U << fl);
+        }
+    }
+}
+
+/**
+ * Get the size class of a size
+ * @param size a size in bytes
+ * @param fl store the power of 2 index here
+ * @param sl store the index inside the power of 2 here
+ */
+static void tlsf_mapping(uint32_t size, uint32_t * fl, uint32_t * sl)
+{
+    if(size < TLSF_SMALL_SIZE) {
+        *fl = 0;
+        *sl = size >> ALIGN_SHIFT;
+    }
+    else {
+        uint32_t f = bit_fls(size);
+        *sl = (size >> (f - TLSF_SL_SHIFT)) ^ TLSF_SL_CNT;
+        *fl = f - (TLSF_FL_SHIFT - 1);
+    }
+}
+
+#else /*MEM_TLSF*/
+
 /**
  * Try to do the real allocation with a given size
  * @param e try to allocate to this entry
@@ -829,4 +1250,128 @@ static void ent_trunc(lv_mem_ent_t * e, size_t size)
     }
 }
 
+#endif /*MEM_TLSF*/
+
+#endif
+
+/**
+ * Make room for a new temporary buffer in an empty slot or in a free one of an other size
+ * @param pool pointer to the buffers of a thread
+ * @param size the required size
+ * @param cls the size class of `size`
+ * @return index of the new buffer (it's not in the free maps) or -1 on error
+ */
+static int32_t mem_buf_alloc(lv_mem_buf_pool_t * pool, uint32_t size, uint32_t cls)
+{
+    if(cls < MEM_BUF_CLASS_LARGE) size = MEM_BUF_CLASS_SIZE(cls);
+
+    /*Reallocate a free buffer to not have more buffers than used at once.
+     *They are all smaller than `size` so take the largest.*/
+    int32_t i_empty = -1;
+    int32_t c;
+    for(c = MEM_BUF_CLASS_LARGE; c >= 0; c--) {
+        if(pool->free_map[c]) {
+            i_empty = bit_ffs(pool->free_map[c]);
+            pool->free_map[c] &= ~(1UL << i_empty);
+            pool->stat.realloc_cnt++;
+            break;
+        }
+    }
+
+    /*Or take an empty slot*/
+    if(i_empty < 0) {
+        uint32_t i;
+        for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+            if(pool->bufs[i].p == NULL) {
+                i_empty = i;
+                break;
+            }
+        }
+    }
+
+    if(i_empty < 0) {
+        LV_DEBUG_ASSERT(false, "No free buffer. Increase LV_MEM_BUF_MAX_NUM.", 0x00);
+        return -1;
+    }
+
+    pool->stat.miss_cnt++;
+
+    /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
+    lv_mem_buf_t * buf = &pool->bufs[i_empty];
+    void * p = lv_mem_realloc(buf->p, size);
+    if(p == NULL) {
+        LV_DEBUG_ASSERT(false, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)", 0x00);
+        if(buf->p) pool->free_map[mem_buf_class(buf->size)] |= 1UL << i_empty;
+        return -1;
+    }
+
+    buf->p = p;
+    buf->size = size;
+    buf->used = 0;
+    return i_empty;
+}
+
+/**
+ * Mark a temporary buffer used and remember the most buffers used at once
+ * @param pool pointer to the buffers of a thread
+ * @param i index of the buffer
+ * @param cls the size class of the request
+ */
+static void mem_buf_take(lv_mem_buf_pool_t * pool, uint32_t i, uint32_t cls)
+{
+    lv_mem_buf_t * buf = &pool->bufs[i];
+    pool->free_map[mem_buf_class(buf->size)] &= ~(1UL << i);
+    buf->used = 1;
+    buf->cls = cls;
+    pool->used_cnt[cls]++;
+    if(pool->used_cnt[cls] > pool->used_peak[cls]) pool->used_peak[cls] = pool->used_cnt[cls];
+    if(pool->used_cnt[cls] > pool->used_max[cls]) pool->used_max[cls] = pool->used_cnt[cls];
+}
+
+/**
+ * Get the size class of a temporary buffer
+ * @param size size of the buffer in bytes
+ * @return the power of 2 class which is large enough or `MEM_BUF_CLASS_LARGE`
+ */
+static uint32_t mem_buf_class(uint32_t size)
+{
+    /*Nothing is kept so don't round up the sizes, just find the best fitting buffers*/
+    if(LV_MEM_BUF_KEEP_SIZE == 0) return MEM_BUF_CLASS_LARGE;
+
+    if(size > MEM_BUF_CLASS_SIZE(LV_MEM_BUF_CLASS_CNT - 1)) return MEM_BUF_CLASS_LARGE;
+    if(size <= MEM_BUF_CLASS_SIZE(0)) return 0;
+    return bit_fls(size - 1) + 1 - MEM_BUF_CLASS_SHIFT;
+}
+
+/**
+ * Get the index of the most significant set bit
+ * @param x a non-zero value
+ */
+static uint32_t bit_fls(uint32_t x)
+{
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(x);
+#else
+    uint32_t i = 0;
+    while(x >>= 1) i++;
+    return i;
 #endif
+}
+
+/**
+ * Get the index of the least significant set bit
+ * @param x a non-zero value
+ */
+static uint32_t bit_ffs(uint32_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    uint32_t i = 0;
+    while((x & 1) == 0) {
+        x >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
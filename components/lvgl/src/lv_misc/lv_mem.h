@@ -32,6 +32,9 @@ extern "C" {
 #define LV_MEM_BUF_MAX_NUM    16
 #endif
 
+/*The temporary buffers have power of 2 sizes from 32 bytes to 4 kB. The larger ones have their own size.*/
+#define LV_MEM_BUF_CLASS_CNT  8
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -46,6 +49,8 @@ typedef struct {
     uint32_t free_biggest_size;
     uint32_t used_cnt;
     uint32_t max_used; /**< Max size of Heap memory used */
+    uint32_t free_small_cnt; /**< Number of free cells not bigger than 64 bytes (too small for most objects) */
+    uint32_t free_small_size; /**< Size of the small free cells */
     uint8_t used_pct; /**< Percentage used */
     uint8_t frag_pct; /**< Amount of fragmentation */
 } lv_mem_monitor_t;
@@ -54,10 +59,31 @@ typedef struct {
     void * p;
     uint16_t size;
     uint8_t used    : 1;
+    uint8_t cls     : 4;    /*Size class of the request using the buffer*/
 } lv_mem_buf_t;
 
-typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
-extern lv_mem_buf_arr_t _lv_mem_buf;
+/**
+ * Counters of the temporary buffers in a refresh
+ */
+typedef struct {
+    uint32_t get_cnt;       /**< Buffers given by `_lv_mem_buf_get`*/
+    uint32_t miss_cnt;      /**< Buffers which had to be allocated because no free one was big enough*/
+    uint32_t realloc_cnt;   /**< Buffers of other sizes reallocated among the misses*/
+    uint32_t kept_size;     /**< Bytes of buffers kept for the next refresh*/
+} lv_mem_buf_stat_t;
+
+/*The temporary buffers of a thread*/
+typedef struct {
+    lv_mem_buf_t bufs[LV_MEM_BUF_MAX_NUM];
+    uint32_t free_map[LV_MEM_BUF_CLASS_CNT + 1];  /*Bit `i` is set if `bufs[i]` is free and in this size class.
+                                                    The last one is for the larger buffers.*/
+    uint8_t used_cnt[LV_MEM_BUF_CLASS_CNT + 1];   /*Buffers used now by the size class of the requests*/
+    uint8_t used_max[LV_MEM_BUF_CLASS_CNT + 1];   /*Recent peak of the buffers used at once, kept between refreshes*/
+    uint8_t used_peak[LV_MEM_BUF_CLASS_CNT + 1];  /*Most buffers used at once in the current refresh*/
+    lv_mem_buf_stat_t stat;                     /*Counters of the current refresh*/
+} lv_mem_buf_pool_t;
+
+extern lv_mem_buf_pool_t _lv_mem_buf;
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -134,10 +160,23 @@ void * _lv_mem_buf_get(uint32_t size);
 void _lv_mem_buf_release(void * p);
 
 /**
- * Free all memory buffers
+ * Release all memory buffers at the end of a refresh.
+ * The buffers of the most used sizes are kept up to `LV_MEM_BUF_KEEP_SIZE` bytes, the others are freed.
  */
 void _lv_mem_buf_free_all(void);
 
+/**
+ * Add the counters of an other thread's buffers to this thread's and clear them
+ * @param pool pointer to the buffers of an other thread which doesn't use them now
+ */
+void _lv_mem_buf_join_stat(lv_mem_buf_pool_t * pool);
+
+/**
+ * Get the counters of the temporary buffers in the last refresh which used buffers
+ * @param stat store the counters here
+ */
+void lv_mem_buf_get_stat(lv_mem_buf_stat_t * stat);
+
 //! @cond Doxygen_Suppress
 
 #if LV_MEMCPY_MEMSET_STD
@@ -29,6 +29,15 @@
  **********************/
 static bool lv_task_exec(lv_task_t * task);
 static uint32_t lv_task_time_remaining(lv_task_t * task);
+static bool heap_insert(lv_task_t * task, bool parked);
+static bool heap_remove(lv_task_t * task);
+static void heap_park_top(_lv_task_heap_t * heap);
+static void heap_unpark_all(void);
+static void heap_update(lv_task_t * task);
+static void heap_sift_up(_lv_task_heap_t * heap, uint32_t id);
+static void heap_sift_down(_lv_task_heap_t * heap, uint32_t id);
+static bool heap_resize(_lv_task_heap_t * heap, uint32_t size);
+static inline bool task_is_before(const lv_task_t * t1, const lv_task_t * t2);
 
 /**********************
  *  STATIC VARIABLES
@@ -36,8 +45,6 @@ static uint32_t lv_task_time_remaining(lv_task_t * task);
 static bool lv_task_run  = false;
 static uint8_t idle_last = 0;
 static bool task_deleted;
-static bool task_list_changed;
-static bool task_created;
 
 /**********************
  *      MACROS
@@ -52,7 +59,14 @@ static bool task_created;
  */
 void _lv_task_core_init(void)
 {
-    _lv_ll_init(&LV_GC_ROOT(_lv_task_ll), sizeof(lv_task_t));
+    _lv_ll_pool_init(&LV_GC_ROOT(_lv_task_ll_pool), sizeof(lv_task_t));
+    _lv_ll_init_pooled(&LV_GC_ROOT(_lv_task_ll), &LV_GC_ROOT(_lv_task_ll_pool));
+    _lv_memset_00(LV_GC_ROOT(_lv_task_heap), sizeof(LV_GC_ROOT(_lv_task_heap)));
+    uint8_t prio;
+    for(prio = 0; prio < _LV_TASK_PRIO_NUM; prio++) {
+        LV_GC_ROOT(_lv_task_heap)[prio].tasks = LV_GC_ROOT(_lv_task_heap)[prio].inline_tasks;
+        LV_GC_ROOT(_lv_task_heap)[prio].size = _LV_TASK_HEAP_INLINE;
+    }
 
     /*Initially enable the lv_task handling*/
     lv_task_enable(true);
@@ -81,90 +95,33 @@ LV_ATTRIBUTE_TASK_HANDLER uint32_t lv_task_handler(void)
 
     uint32_t handler_start = lv_tick_get();
 
-    /* Run all task from the highest to the lowest priority
-     * If a lower priority task is executed check task again from the highest priority
-     * but on the priority of executed tasks don't run tasks before the executed*/
-    lv_task_t * task_interrupter = NULL;
-    lv_task_t * next;
-    bool end_flag;
+    /* Run the ready tasks from the highest to the lowest priority.
+     * After a task has run check the higher priorities again.
+     * A task runs only once in a call, the ones already run are parked after the heaps until the end.*/
+    bool exec;
     do {
-        end_flag                 = true;
-        task_deleted             = false;
-        task_created             = false;
-        task_list_changed        = false;
-        LV_GC_ROOT(_lv_task_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_task_ll));
-        while(LV_GC_ROOT(_lv_task_act)) {
-            /* The task might be deleted if it runs only once ('once = 1')
-             * So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_task_ll), LV_GC_ROOT(_lv_task_act));
-
-            /*We reach priority of the turned off task. There is nothing more to do.*/
-            if(LV_GC_ROOT(_lv_task_act)->prio == LV_TASK_PRIO_OFF) {
-                break;
-            }
-
-            /*Here is the interrupter task. Don't execute it again.*/
-            if(LV_GC_ROOT(_lv_task_act) == task_interrupter) {
-                task_interrupter = NULL; /*From this point only task after the interrupter comes, so
-                                            the interrupter is not interesting anymore*/
-                LV_GC_ROOT(_lv_task_act) = next;
-                continue; /*Load the next task*/
-            }
-
-            /*Just try to run the tasks with highest priority.*/
-            if(LV_GC_ROOT(_lv_task_act)->prio == LV_TASK_PRIO_HIGHEST) {
-                lv_task_exec(LV_GC_ROOT(_lv_task_act));
-            }
-            /*Tasks with higher priority than the interrupted shall be run in every case*/
-            else if(task_interrupter) {
-                if(LV_GC_ROOT(_lv_task_act)->prio > task_interrupter->prio) {
-                    if(lv_task_exec(LV_GC_ROOT(_lv_task_act))) {
-                        if(!task_created && !task_deleted) {
-                            /*Check all tasks again from the highest priority */
-                            task_interrupter = LV_GC_ROOT(_lv_task_act);
-                            end_flag = false;
-                            break;
-                        }
-                    }
-                }
-            }
-            /* It is no interrupter task or we already reached it earlier.
-             * Just run the remaining tasks*/
-            else {
-                if(lv_task_exec(LV_GC_ROOT(_lv_task_act))) {
-                    if(!task_created && !task_deleted) {
-                        task_interrupter = LV_GC_ROOT(_lv_task_act); /*Check all tasks again from the highest priority */
-                        end_flag         = false;
-                        break;
-                    }
-                }
-            }
-
-            /*If a task was created or deleted then this or the next item might be corrupted*/
-            if(task_created || task_deleted) {
-                task_interrupter = NULL;
-                break;
-            }
-
-            if(task_list_changed) {
-                task_interrupter = NULL;
-                end_flag = false;
-                break;
-            }
-
-            LV_GC_ROOT(_lv_task_act) = next; /*Load the next task*/
+        exec = false;
+        uint8_t prio;
+        for(prio = LV_TASK_PRIO_HIGHEST; prio > LV_TASK_PRIO_OFF; prio--) {
+            _lv_task_heap_t * heap = &LV_GC_ROOT(_lv_task_heap)[prio];
+            if(heap->cnt == 0) continue;
+
+            lv_task_t * task = heap->tasks[0];
+            if(lv_task_time_remaining(task) != 0) continue;
+
+            heap_park_top(heap);
+            task_deleted = false;
+            LV_GC_ROOT(_lv_task_act) = task;
+            lv_task_exec(task);
+            exec = true;
+            break;
         }
-    } while(!end_flag);
+    } while(exec);
 
-    uint32_t time_till_next = LV_NO_TASK_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_task_ll));
-    while(next && next->prio != LV_TASK_PRIO_OFF) {
-        uint32_t delay = lv_task_time_remaining(next);
-        if(delay < time_till_next)
-            time_till_next = delay;
+    LV_GC_ROOT(_lv_task_act) = NULL;
+    heap_unpark_all();
 
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_task_ll), next); /*Find the next task*/
-    }
+    uint32_t time_till_next = lv_task_get_time_till_next();
 
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
@@ -202,38 +159,9 @@ lv_task_t * lv_task_create_basic(void)
  */
 lv_task_t * lv_task_create(lv_task_cb_t task_xcb, uint32_t period, lv_task_prio_t prio, void * user_data)
 {
-    lv_task_t * new_task = NULL;
-    lv_task_t * tmp;
-
-    /*Create task lists in order of priority from high to low*/
-    tmp = _lv_ll_get_head(&LV_GC_ROOT(_lv_task_ll));
-
-    /*It's the first task*/
-    if(NULL == tmp) {
-        new_task = _lv_ll_ins_head(&LV_GC_ROOT(_lv_task_ll));
-        LV_ASSERT_MEM(new_task);
-        if(new_task == NULL) return NULL;
-    }
-    /*Insert the new task to proper place according to its priority*/
-    else {
-        do {
-            if(tmp->prio <= prio) {
-                new_task = _lv_ll_ins_prev(&LV_GC_ROOT(_lv_task_ll), tmp);
-                LV_ASSERT_MEM(new_task);
-                if(new_task == NULL) return NULL;
-                break;
-            }
-            tmp = _lv_ll_get_next(&LV_GC_ROOT(_lv_task_ll), tmp);
-        } while(tmp != NULL);
-
-        /*Only too high priority tasks were found. Add the task to the end*/
-        if(tmp == NULL) {
-            new_task = _lv_ll_ins_tail(&LV_GC_ROOT(_lv_task_ll));
-            LV_ASSERT_MEM(new_task);
-            if(new_task == NULL) return NULL;
-        }
-    }
-    task_list_changed = true;
+    lv_task_t * new_task = _lv_ll_ins_head(&LV_GC_ROOT(_lv_task_ll));
+    LV_ASSERT_MEM(new_task);
+    if(new_task == NULL) return NULL;
 
     new_task->period  = period;
     new_task->task_cb = task_xcb;
@@ -244,7 +172,11 @@ lv_task_t * lv_task_create(lv_task_cb_t task_xcb, uint32_t period, lv_task_prio_
 
     new_task->user_data = user_data;
 
-    task_created = true;
+    if(heap_insert(new_task, false) == false) {
+        _lv_ll_remove(&LV_GC_ROOT(_lv_task_ll), new_task);
+        _lv_ll_free_node(&LV_GC_ROOT(_lv_task_ll), new_task);
+        return NULL;
+    }
 
     return new_task;
 }
@@ -265,10 +197,10 @@ void lv_task_set_cb(lv_task_t * task, lv_task_cb_t task_cb)
  */
 void lv_task_del(lv_task_t * task)
 {
+    heap_remove(task);
     _lv_ll_remove(&LV_GC_ROOT(_lv_task_ll), task);
-    task_list_changed = true;
 
-    lv_mem_free(task);
+    _lv_ll_free_node(&LV_GC_ROOT(_lv_task_ll), task);
 
     if(LV_GC_ROOT(_lv_task_act) == task) task_deleted = true; /*The active task was deleted*/
 }
@@ -282,22 +214,15 @@ void lv_task_set_prio(lv_task_t * task, lv_task_prio_t prio)
 {
     if(task->prio == prio) return;
 
-    /*Find the tasks with new priority*/
-    lv_task_t * i;
-    _LV_LL_READ(LV_GC_ROOT(_lv_task_ll), i) {
-        if(i->prio <= prio) {
-            if(i != task) _lv_ll_move_before(&LV_GC_ROOT(_lv_task_ll), task, i);
-            break;
-        }
+    /*Make room first to keep the task in the old heap if there is not enough memory*/
+    _lv_task_heap_t * heap = &LV_GC_ROOT(_lv_task_heap)[prio];
+    if(prio != LV_TASK_PRIO_OFF && heap->total == heap->size) {
+        if(heap_resize(heap, heap->size * 2) == false) return;
     }
 
-    /*There was no such a low priority so far then add the node to the tail*/
-    if(i == NULL) {
-        _lv_ll_move_before(&LV_GC_ROOT(_lv_task_ll), task, NULL);
-    }
-    task_list_changed = true;
-
+    bool parked = heap_remove(task);
     task->prio = prio;
+    heap_insert(task, parked);
 }
 
 /**
@@ -308,6 +233,7 @@ void lv_task_set_prio(lv_task_t * task, lv_task_prio_t prio)
 void lv_task_set_period(lv_task_t * task, uint32_t period)
 {
     task->period = period;
+    heap_update(task);
 }
 
 /**
@@ -317,6 +243,7 @@ void lv_task_set_period(lv_task_t * task, uint32_t period)
 void lv_task_ready(lv_task_t * task)
 {
     task->last_run = lv_tick_get() - task->period - 1;
+    heap_update(task);
 }
 
 /**
@@ -337,6 +264,7 @@ void lv_task_set_repeat_count(lv_task_t * task, int32_t repeat_count)
 void lv_task_reset(lv_task_t * task)
 {
     task->last_run = lv_tick_get();
+    heap_update(task);
 }
 
 /**
@@ -357,6 +285,33 @@ uint8_t lv_task_get_idle(void)
     return idle_last;
 }
 
+/**
+ * Get the time until the next task needs to run.
+ * Useful to sleep until then after modifying the tasks outside of `lv_task_handler`.
+ * @return the time in ms, 0 if a task is ready, `LV_NO_TASK_READY` if no task is running
+ */
+uint32_t lv_task_get_time_till_next(void)
+{
+    uint32_t time_till_next = LV_NO_TASK_READY;
+    uint8_t prio;
+    for(prio = LV_TASK_PRIO_LOWEST; prio <= LV_TASK_PRIO_HIGHEST; prio++) {
+        _lv_task_heap_t * heap = &LV_GC_ROOT(_lv_task_heap)[prio];
+        if(heap->cnt) {
+            uint32_t delay = lv_task_time_remaining(heap->tasks[0]);
+            if(delay < time_till_next) time_till_next = delay;
+        }
+
+        /*The tasks parked while `lv_task_handler` runs are not in the heap*/
+        uint32_t i;
+        for(i = heap->cnt; i < heap->total; i++) {
+            uint32_t delay = lv_task_time_remaining(heap->tasks[i]);
+            if(delay < time_till_next) time_till_next = delay;
+        }
+    }
+
+    return time_till_next;
+}
+
 /**
  * Iterate through the tasks
  * @param task NULL to start iteration or the previous return value to get the next task
@@ -413,3 +368,210 @@ static uint32_t lv_task_time_remaining(lv_task_t * task)
         return 0;
     return task->period - elp;
 }
+
+/**
+ * Add a task to the heap of its priority
+ * @param task pointer to a task
+ * @param parked true: park the task after the heap because it has already run in this `lv_task_handler` call
+ * @return false if there was not enough memory
+ */
+static bool heap_insert(lv_task_t * task, bool parked)
+{
+    if(task->prio == LV_TASK_PRIO_OFF) return true;
+
+    _lv_task_heap_t * heap = &LV_GC_ROOT(_lv_task_heap)[task->prio];
+    if(heap->total == heap->size) {
+        if(heap_resize(heap, heap->size * 2) == false) return false;
+    }
+
+    if(parked) {
+        task->heap_id = heap->total;
+        heap->tasks[heap->total] = task;
+        heap->total++;
+        return true;
+    }
+
+    /*Move the first parked task to the end to make room*/
+    if(heap->total > heap->cnt) {
+        heap->tasks[heap->total] = heap->tasks[heap->cnt];
+        heap->tasks[heap->total]->heap_id = heap->total;
+    }
+
+    task->heap_id = heap->cnt;
+    heap->tasks[heap->cnt] = task;
+    heap->cnt++;
+    heap->total++;
+    heap_sift_up(heap, task->heap_id);
+
+    return true;
+}
+
+/**
+ * Remove a task from the heap of its priority
+ * @param task pointer to a task
+ * @return true: the task was parked
+ */
+static bool heap_remove(lv_task_t * task)
+{
+    if(task->prio == LV_TASK_PRIO_OFF) return false;
+
+    _lv_task_heap_t * heap = &LV_GC_ROOT(_lv_task_heap)[task->prio];
+    uint32_t id = task->heap_id;
+    bool parked = id >= heap->cnt;
+
+    if(parked) {
+        heap->total--;
+        heap->tasks[id] = heap->tasks[heap->total];
+        heap->tasks[id]->heap_id = id;
+    }
+    else {
+        heap->cnt--;
+        heap->total--;
+        lv_task_t * last = heap->tasks[heap->cnt];
+
+        /*The last parked task takes the place of the last task of the heap*/
+        if(heap->total > heap->cnt) {
+            heap->tasks[heap->cnt] = heap->tasks[heap->total];
+            heap->tasks[heap->cnt]->heap_id = heap->cnt;
+        }
+
+        /*Fill the hole with the last task of the heap*/
+        if(id < heap->cnt) {
+            heap->tasks[id] = last;
+            last->heap_id = id;
+            heap_update(last);
+        }
+    }
+
+    if(heap->total <= heap->size / 4 && heap->size > _LV_TASK_HEAP_INLINE) heap_resize(heap, heap->size / 2);
+
+    return parked;
+}
+
+/**
+ * Move the first task of a heap to the parked tasks
+ * @param heap pointer to a heap
+ */
+static void heap_park_top(_lv_task_heap_t * heap)
+{
+    lv_task_t * top = heap->tasks[0];
+    heap->cnt--;
+    heap->tasks[0] = heap->tasks[heap->cnt];
+    heap->tasks[0]->heap_id = 0;
+    heap->tasks[heap->cnt] = top;
+    top->heap_id = heap->cnt;
+    heap_sift_down(heap, 0);
+}
+
+/**
+ * Put the parked tasks back into the heaps
+ */
+static void heap_unpark_all(void)
+{
+    uint8_t prio;
+    for(prio = LV_TASK_PRIO_LOWEST; prio <= LV_TASK_PRIO_HIGHEST; prio++) {
+        _lv_task_heap_t * heap = &LV_GC_ROOT(_lv_task_heap)[prio];
+        while(heap->cnt < heap->total) {
+            heap->cnt++;
+            heap_sift_up(heap, heap->cnt - 1);
+        }
+    }
+}
+
+/**
+ * Restore the order of the heap after the next run time of a task has changed
+ * @param task pointer to a task
+ */
+static void heap_update(lv_task_t * task)
+{
+    if(task->prio == LV_TASK_PRIO_OFF) return;
+
+    _lv_task_heap_t * heap = &LV_GC_ROOT(_lv_task_heap)[task->prio];
+    if(task->heap_id >= heap->cnt) return;  /*Parked tasks are sorted when they are put back*/
+
+    uint32_t id = task->heap_id;
+    heap_sift_up(heap, id);
+    if(task->heap_id == id) heap_sift_down(heap, id);
+}
+
+static void heap_sift_up(_lv_task_heap_t * heap, uint32_t id)
+{
+    lv_task_t * task = heap->tasks[id];
+    while(id > 0) {
+        uint32_t parent = (id - 1) / 2;
+        if(!task_is_before(task, heap->tasks[parent])) break;
+        heap->tasks[id] = heap->tasks[parent];
+        heap->tasks[id]->heap_id = id;
+        id = parent;
+    }
+    heap->tasks[id] = task;
+    task->heap_id = id;
+}
+
+static void heap_sift_down(_lv_task_heap_t * heap, uint32_t id)
+{
+    if(id >= heap->cnt) return;
+
+    lv_task_t * task = heap->tasks[id];
+    while(1) {
+        uint32_t child = id * 2 + 1;
+        if(child >= heap->cnt) break;
+        if(child + 1 < heap->cnt && task_is_before(heap->tasks[child + 1], heap->tasks[child])) child++;
+        if(!task_is_before(heap->tasks[child], task)) break;
+        heap->tasks[id] = heap->tasks[child];
+        heap->tasks[id]->heap_id = id;
+        id = child;
+    }
+    heap->tasks[id] = task;
+    task->heap_id = id;
+}
+
+/**
+ * Reallocate the slots of a heap
+ * @param heap pointer to a heap
+ * @param size the new number of slots
+ * @return false if there was not enough memory
+ */
+static bool heap_resize(_lv_task_heap_t * heap, uint32_t size)
+{
+    if(size > UINT16_MAX) return false;
+
+    if(size <= _LV_TASK_HEAP_INLINE) {
+        if(heap->tasks != heap->inline_tasks) {
+            _lv_memcpy_small(heap->inline_tasks, heap->tasks, heap->total * sizeof(lv_task_t *));
+            lv_mem_free(heap->tasks);
+            heap->tasks = heap->inline_tasks;
+        }
+        heap->size = _LV_TASK_HEAP_INLINE;
+        return true;
+    }
+
+    lv_task_t ** tasks;
+    if(heap->tasks == heap->inline_tasks) {
+        tasks = lv_mem_alloc(size * sizeof(lv_task_t *));
+        if(tasks) _lv_memcpy_small(tasks, heap->inline_tasks, heap->total * sizeof(lv_task_t *));
+    }
+    else {
+        tasks = lv_mem_realloc(heap->tasks, size * sizeof(lv_task_t *));
+    }
+    LV_ASSERT_MEM(tasks);
+    if(tasks == NULL) return false;
+
+    heap->tasks = tasks;
+    heap->size = size;
+    return true;
+}
+
+/**
+ * Tell if a task needs to run before an other
+ * @param t1 pointer to a task
+ * @param t2 pointer to an other task
+ * @return true: `t1` is due earlier
+ */
+static inline bool task_is_before(const lv_task_t * t1, const lv_task_t * t2)
+{
+    /*Compare the difference to handle the overflow of the tick*/
+    uint32_t due1 = t1->last_run + t1->period;
+    uint32_t due2 = t2->last_run + t2->period;
+    return (int32_t)(due1 - due2) < 0;
+}
@@ -29,6 +29,7 @@ extern "C" {
 #endif
 
 #define LV_NO_TASK_READY 0xFFFFFFFF
+#define _LV_TASK_HEAP_INLINE 4  /*Slots of a task heap before allocating memory for it*/
 /**********************
  *      TYPEDEFS
  **********************/
@@ -66,8 +67,22 @@ typedef struct _lv_task_t {
 
     int32_t repeat_count; /**< 1: Task times;  -1 : infinity;  0 : stop ;  n>0: residual times */
     uint8_t prio : 3; /**< Task priority */
+    uint16_t heap_id; /**< Index of the task in the heap of its priority. Managed by `lv_task.c` */
 } lv_task_t;
 
+/**
+ * The tasks of a priority ordered by their next run time
+ */
+typedef struct {
+    lv_task_t ** tasks;     /**< A binary min-heap in `[0..cnt)`, then the tasks already run by `lv_task_handler`*/
+    uint16_t cnt;           /**< Number of tasks in the heap*/
+    uint16_t total;         /**< Number of tasks with this priority*/
+    uint16_t size;          /**< Number of slots in `tasks`*/
+    lv_task_t * inline_tasks[_LV_TASK_HEAP_INLINE]; /**< `tasks` points here until more slots are required*/
+} _lv_task_heap_t;
+
+typedef _lv_task_heap_t _lv_task_heap_arr_t[_LV_TASK_PRIO_NUM];
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -165,6 +180,13 @@ void lv_task_enable(bool en);
  */
 uint8_t lv_task_get_idle(void);
 
+/**
+ * Get the time until the next task needs to run.
+ * Useful to sleep until then after modifying the tasks outside of `lv_task_handler`.
+ * @return the time in ms, 0 if a task is ready, `LV_NO_TASK_READY` if no task is running
+ */
+uint32_t lv_task_get_time_till_next(void);
+
 /**
  * Iterate through the tasks
  * @param task NULL to start iteration or the previous return value to get the next task
@@ -12,11 +12,14 @@
 #include "lv_math.h"
 #include "lv_log.h"
 #include "lv_debug.h"
+#include "lv_mem.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
+#define LAYOUT_FLAGS (LV_TXT_FLAG_RECOLOR | LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)  /*The flags changing the lines*/
+#define LAYOUT_LINE_MIN 4
 
 /**********************
  *      TYPEDEFS
@@ -26,6 +29,9 @@
  *  STATIC PROTOTYPES
  **********************/
 static inline bool is_break_char(uint32_t letter);
+static void get_lines(lv_point_t * size_res, const char * text, const lv_font_t * font, lv_coord_t letter_space,
+                      lv_coord_t line_space, lv_coord_t max_width, lv_txt_flag_t flag, lv_txt_layout_t * layout);
+static bool layout_set_line(lv_txt_layout_t * layout, uint32_t id, uint32_t start, lv_coord_t width);
 
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
     static uint8_t lv_txt_utf8_size(const char * str);
@@ -96,49 +102,80 @@ static inline bool is_break_char(uint32_t letter);
 void _lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t * font, lv_coord_t letter_space,
                       lv_coord_t line_space, lv_coord_t max_width, lv_txt_flag_t flag)
 {
-    size_res->x = 0;
-    size_res->y = 0;
-
-    if(text == NULL) return;
-    if(font == NULL) return;
-
-    if(flag & LV_TXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
-
-    uint32_t line_start     = 0;
-    uint32_t new_line_start = 0;
-    uint16_t letter_height = lv_font_get_line_height(font);
-
-    /*Calc. the height and longest line*/
-    while(text[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, flag);
+    get_lines(size_res, text, font, letter_space, line_space, max_width, flag, NULL);
+}
 
-        if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(lv_coord_t)) {
-            LV_LOG_WARN("lv_txt_get_size: integer overflow while calculating text height");
-            return;
-        }
-        else {
-            size_res->y += letter_height;
-            size_res->y += line_space;
+/**
+ * Break a text into lines and save where the lines start and how wide they are.
+ * Single lines are not saved. The size of the text is calculated even if no lines are saved.
+ * @param layout pointer to an initialized (e.g. zeroed) layout. Its old lines are reused or freed.
+ * @param text pointer to a text
+ * @param font pointer to font of the text
+ * @param letter_space letter space of the text
+ * @param line_space line space of the text
+ * @param max_width max with of the text (break the lines to fit this size)
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the lines are saved; false: only `layout->size` is valid
+ */
+bool _lv_txt_layout_update(lv_txt_layout_t * layout, const char * text, const lv_font_t * font,
+                           lv_coord_t letter_space, lv_coord_t line_space, lv_coord_t max_width, lv_txt_flag_t flag)
+{
+    layout->line_cnt = 0;
+    get_lines(&layout->size, text, font, letter_space, line_space, max_width, flag, layout);
+    if(layout->lines == NULL) return false;
+
+    /*Give back the memory of much longer texts*/
+    if(layout->line_alloc > LAYOUT_LINE_MIN && layout->line_alloc > 2 * (layout->line_cnt + 1)) {
+        lv_txt_line_t * lines = lv_mem_realloc(layout->lines, (layout->line_cnt + 1) * sizeof(lv_txt_line_t));
+        if(lines) {
+            layout->lines = lines;
+            layout->line_alloc = layout->line_cnt + 1;
         }
+    }
 
-        /*Calculate the longest line*/
-        lv_coord_t act_line_length = _lv_txt_get_width(&text[line_start], new_line_start - line_start, font, letter_space,
-                                                       flag);
+    layout->txt = text;
+    layout->font = font;
+    layout->letter_space = letter_space;
+    layout->line_space = line_space;
+    layout->max_width = max_width;
+    layout->flag = flag & LAYOUT_FLAGS;
+    return true;
+}
 
-        size_res->x = LV_MATH_MAX(act_line_length, size_res->x);
-        line_start  = new_line_start;
-    }
+/**
+ * Tell if the lines of a layout can be used to draw a text
+ * @param layout pointer to a layout
+ * @param text pointer to the text to draw
+ * @param font pointer to font of the text
+ * @param letter_space letter space of the text
+ * @param max_width max with of the text
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the text has the same lines as saved in the layout
+ */
+bool _lv_txt_layout_is_valid(const lv_txt_layout_t * layout, const char * text, const lv_font_t * font,
+                             lv_coord_t letter_space, lv_coord_t max_width, lv_txt_flag_t flag)
+{
+    if(layout == NULL || layout->lines == NULL) return false;
+    if(layout->txt != text || layout->font != font || layout->letter_space != letter_space) return false;
+    if(layout->flag != (flag & LAYOUT_FLAGS)) return false;
 
-    /*Make the text one line taller if the last character is '\n' or '\r'*/
-    if((line_start != 0) && (text[line_start - 1] == '\n' || text[line_start - 1] == '\r')) {
-        size_res->y += letter_height + line_space;
-    }
+    /*The max. width doesn't matter if the lines are broken only at the new lines*/
+    if((layout->flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) == 0 && layout->max_width != max_width) return false;
 
-    /*Correction with the last line space or set the height manually if the text is empty*/
-    if(size_res->y == 0)
-        size_res->y = letter_height;
-    else
-        size_res->y -= line_space;
+    return true;
+}
+
+/**
+ * Free the lines of a layout and make it invalid
+ * @param layout pointer to a layout
+ */
+void _lv_txt_layout_free(lv_txt_layout_t * layout)
+{
+    if(layout->lines) lv_mem_free(layout->lines);
+    layout->lines = NULL;
+    layout->line_cnt = 0;
+    layout->line_alloc = 0;
+    layout->txt = NULL;
 }
 
 /**
@@ -890,6 +927,108 @@ static uint32_t lv_txt_iso8859_1_get_length(const char * txt)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Calculate the size of a text and save its lines in a layout too
+ * @param layout pointer to a layout to save the lines or NULL
+ * Other parameters are the same as in `_lv_txt_get_size`
+ */
+static void get_lines(lv_point_t * size_res, const char * text, const lv_font_t * font, lv_coord_t letter_space,
+                      lv_coord_t line_space, lv_coord_t max_width, lv_txt_flag_t flag, lv_txt_layout_t * layout)
+{
+    size_res->x = 0;
+    size_res->y = 0;
+
+    if(text == NULL || font == NULL) {
+        if(layout) _lv_txt_layout_free(layout);
+        return;
+    }
+
+    if(flag & LV_TXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
+
+    uint32_t line_start     = 0;
+    uint32_t new_line_start = 0;
+    uint16_t letter_height = lv_font_get_line_height(font);
+    uint32_t line_cnt = 0;
+    lv_coord_t first_line_length = 0;
+
+    /*Calc. the height and longest line*/
+    while(text[line_start] != '\0') {
+        new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, flag);
+
+        if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(lv_coord_t)) {
+            LV_LOG_WARN("lv_txt_get_size: integer overflow while calculating text height");
+            if(layout) _lv_txt_layout_free(layout);
+            return;
+        }
+        else {
+            size_res->y += letter_height;
+            size_res->y += line_space;
+        }
+
+        /*Calculate the longest line*/
+        lv_coord_t act_line_length = _lv_txt_get_width(&text[line_start], new_line_start - line_start, font, letter_space,
+                                                       flag);
+
+        size_res->x = LV_MATH_MAX(act_line_length, size_res->x);
+
+        /*Save the lines from the second one. A single line is found quickly anyway.*/
+        if(line_cnt == 0) {
+            first_line_length = act_line_length;
+        }
+        else if(layout) {
+            bool saved = line_cnt > 1 || layout_set_line(layout, 0, 0, first_line_length);
+            if(saved) saved = layout_set_line(layout, line_cnt, line_start, act_line_length);
+            if(saved == false) layout = NULL;
+        }
+        line_cnt++;
+
+        line_start  = new_line_start;
+    }
+
+    /*Save where the last line ends*/
+    if(layout) {
+        if(line_cnt > 1 && layout_set_line(layout, line_cnt, line_start, 0)) layout->line_cnt = line_cnt;
+        else _lv_txt_layout_free(layout);
+    }
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if((line_start != 0) && (text[line_start - 1] == '\n' || text[line_start - 1] == '\r')) {
+        size_res->y += letter_height + line_space;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(size_res->y == 0)
+        size_res->y = letter_height;
+    else
+        size_res->y -= line_space;
+}
+
+/**
+ * Save a line into a layout. Allocate more memory for the lines if required.
+ * @param layout pointer to a layout
+ * @param id index of the line
+ * @param start byte index of the line's first character
+ * @param width width of the line
+ * @return true: saved; false: out of memory, the layout is freed
+ */
+static bool layout_set_line(lv_txt_layout_t * layout, uint32_t id, uint32_t start, lv_coord_t width)
+{
+    if(id >= layout->line_alloc) {
+        uint32_t line_alloc = layout->line_alloc ? layout->line_alloc * 2 : LAYOUT_LINE_MIN;
+        lv_txt_line_t * lines = lv_mem_realloc(layout->lines, line_alloc * sizeof(lv_txt_line_t));
+        if(lines == NULL) {
+            _lv_txt_layout_free(layout);
+            return false;
+        }
+        layout->lines = lines;
+        layout->line_alloc = line_alloc;
+    }
+
+    layout->lines[id].start = start;
+    layout->lines[id].width = width;
+    return true;
+}
+
 /**
  * Test if char is break char or not (a text can broken here or not)
  * @param letter a letter
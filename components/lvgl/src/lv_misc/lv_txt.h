@@ -56,6 +56,31 @@ enum {
 };
 typedef uint8_t lv_txt_cmd_state_t;
 
+/**
+ * A line of a text broken into lines
+ */
+typedef struct {
+    uint32_t start;         /**< Byte index of the first character of the line*/
+    lv_coord_t width;       /**< Width of the line (as `_lv_txt_get_width` gives it)*/
+} lv_txt_line_t;
+
+/**
+ * The lines of a text to skip breaking the text into lines again while it doesn't change.
+ * It's valid only for the text, font, spaces, max. width and flags it was created with.
+ */
+typedef struct {
+    const char * txt;
+    const lv_font_t * font;
+    lv_txt_line_t * lines;  /**< `line_cnt + 1` lines. The last one only tells where the text ends*/
+    uint32_t line_cnt;
+    uint32_t line_alloc;    /**< `lines` has room for this many lines*/
+    lv_point_t size;        /**< Size of the text (as `_lv_txt_get_size` gives it)*/
+    lv_coord_t letter_space;
+    lv_coord_t line_space;
+    lv_coord_t max_width;   /**< Not used if the lines are broken only at new lines (`EXPAND` or `FIT`)*/
+    lv_txt_flag_t flag;     /**< Only the flags which change the lines (`LV_TXT_FLAG_RECOLOR/EXPAND/FIT`)*/
+} lv_txt_layout_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -74,6 +99,40 @@ typedef uint8_t lv_txt_cmd_state_t;
 void _lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t * font, lv_coord_t letter_space,
                       lv_coord_t line_space, lv_coord_t max_width, lv_txt_flag_t flag);
 
+/**
+ * Break a text into lines and save where the lines start and how wide they are.
+ * Single lines are not saved. The size of the text is calculated even if no lines are saved.
+ * @param layout pointer to an initialized (e.g. zeroed) layout. Its old lines are reused or freed.
+ * @param text pointer to a text
+ * @param font pointer to font of the text
+ * @param letter_space letter space of the text
+ * @param line_space line space of the text
+ * @param max_width max with of the text (break the lines to fit this size)
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the lines are saved; false: only `layout->size` is valid
+ */
+bool _lv_txt_layout_update(lv_txt_layout_t * layout, const char * text, const lv_font_t * font,
+                           lv_coord_t letter_space, lv_coord_t line_space, lv_coord_t max_width, lv_txt_flag_t flag);
+
+/**
+ * Tell if the lines of a layout can be used to draw a text
+ * @param layout pointer to a layout
+ * @param text pointer to the text to draw
+ * @param font pointer to font of the text
+ * @param letter_space letter space of the text
+ * @param max_width max with of the text
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the text has the same lines as saved in the layout
+ */
+bool _lv_txt_layout_is_valid(const lv_txt_layout_t * layout, const char * text, const lv_font_t * font,
+                             lv_coord_t letter_space, lv_coord_t max_width, lv_txt_flag_t flag);
+
+/**
+ * Free the lines of a layout and make it invalid
+ * @param layout pointer to a layout
+ */
+void _lv_txt_layout_free(lv_txt_layout_t * layout);
+
 /**
  * Get the next line of text. Check line length and break chars too.
  * @param txt a '\0' terminated string
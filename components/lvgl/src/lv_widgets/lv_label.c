@@ -11,6 +11,7 @@
 #include "../lv_core/lv_obj.h"
 #include "../lv_misc/lv_debug.h"
 #include "../lv_core/lv_group.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_draw/lv_draw.h"
 #include "../lv_misc/lv_color.h"
 #include "../lv_misc/lv_math.h"
@@ -53,6 +54,8 @@ static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
 static void lv_label_dot_tmp_free(lv_obj_t * label);
 static void get_txt_coords(const lv_obj_t * label, lv_area_t * area);
+static void get_expanded_size(const lv_obj_t * label, const lv_draw_label_dsc_t * dsc, lv_txt_flag_t flag,
+                              lv_point_t * size);
 
 /**********************
  *  STATIC VARIABLES
@@ -112,6 +115,10 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->hint.y          = 0;
 #endif
 
+#if LV_LABEL_LAYOUT_CACHE
+    _lv_memset_00(&ext->layout, sizeof(ext->layout));
+#endif
+
 #if LV_LABEL_TEXT_SEL
     ext->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     ext->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -994,7 +1001,12 @@ void lv_label_refr_text(lv_obj_t * label)
 {
     lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
 
-    if(ext->text == NULL) return;
+    if(ext->text == NULL) {
+#if LV_LABEL_LAYOUT_CACHE
+        _lv_txt_layout_free(&ext->layout);
+#endif
+        return;
+    }
 #if LV_LABEL_LONG_TXT_HINT
     ext->hint.line_start = -1; /*The hint is invalid if the text changes*/
 #endif
@@ -1012,7 +1024,13 @@ void lv_label_refr_text(lv_obj_t * label)
     if(ext->recolor != 0) flag |= LV_TXT_FLAG_RECOLOR;
     if(ext->expand != 0) flag |= LV_TXT_FLAG_EXPAND;
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
+#if LV_LABEL_LAYOUT_CACHE
+    /*Save the lines too while breaking the text to not break it again on every draw*/
+    _lv_txt_layout_update(&ext->layout, ext->text, font, letter_space, line_space, max_w, flag);
+    size = ext->layout.size;
+#else
     _lv_txt_get_size(&size, ext->text, font, letter_space, line_space, max_w, flag);
+#endif
 
     /*Set the full size in expand mode*/
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) {
@@ -1204,6 +1222,11 @@ void lv_label_refr_text(lv_obj_t * label)
                 }
                 ext->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 ext->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+
+#if LV_LABEL_LAYOUT_CACHE
+                /*The text became shorter*/
+                _lv_txt_layout_update(&ext->layout, ext->text, font, letter_space, line_space, max_w, flag);
+#endif
             }
         }
     }
@@ -1282,14 +1305,16 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
         label_draw_dsc.ofs_y = ext->offset.y;
         label_draw_dsc.flag = flag;
         lv_obj_init_draw_label_dsc(label, LV_LABEL_PART_MAIN, &label_draw_dsc);
+#if LV_LABEL_LAYOUT_CACHE
+        label_draw_dsc.layout = &ext->layout;
+#endif
 
         /* In SROLL and SROLL_CIRC mode the CENTER and RIGHT are pointless so remove them.
          * (In addition they will result misalignment is this case)*/
         if((ext->long_mode == LV_LABEL_LONG_SROLL || ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) &&
            (ext->align == LV_LABEL_ALIGN_CENTER || ext->align == LV_LABEL_ALIGN_RIGHT)) {
             lv_point_t size;
-            _lv_txt_get_size(&size, ext->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                             LV_COORD_MAX, flag);
+            get_expanded_size(label, &label_draw_dsc, flag, &size);
             if(size.x > lv_area_get_width(&txt_coords)) {
                 label_draw_dsc.flag &= ~LV_TXT_FLAG_RIGHT;
                 label_draw_dsc.flag &= ~LV_TXT_FLAG_CENTER;
@@ -1300,6 +1325,9 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
         if(ext->long_mode == LV_LABEL_LONG_SROLL_CIRC || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
             hint = NULL;
 
+        /*The hint is updated while drawing so the rendering threads can't share it*/
+        if(_lv_refr_worker_busy()) hint = NULL;
+
 #else
         /*Just for compatibility*/
         lv_draw_label_hint_t * hint = NULL;
@@ -1309,8 +1337,7 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
 
         if(ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) {
             lv_point_t size;
-            _lv_txt_get_size(&size, ext->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                             LV_COORD_MAX, flag);
+            get_expanded_size(label, &label_draw_dsc, flag, &size);
 
             /*Draw the text again next to the original to make an circular effect */
             if(size.x > lv_area_get_width(&txt_coords)) {
@@ -1364,6 +1391,9 @@ static lv_res_t lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param
             ext->text = NULL;
         }
         lv_label_dot_tmp_free(label);
+#if LV_LABEL_LAYOUT_CACHE
+        _lv_txt_layout_free(&ext->layout);
+#endif
     }
     else if(sign == LV_SIGNAL_STYLE_CHG) {
         /*Revert dots for proper refresh*/
@@ -1507,4 +1537,29 @@ static void get_txt_coords(const lv_obj_t * label, lv_area_t * area)
     area->y2 -= bottom;
 }
 
+
+/**
+ * Get the size of the label's text without breaking its lines
+ * @param label pointer to a label object
+ * @param dsc the draw descriptor of the text
+ * @param flag the flags of the text
+ * @param size store the size here
+ */
+static void get_expanded_size(const lv_obj_t * label, const lv_draw_label_dsc_t * dsc, lv_txt_flag_t flag,
+                              lv_point_t * size)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+
+#if LV_LABEL_LAYOUT_CACHE
+    /*The text's size is saved if its lines are broken only at new lines*/
+    if((flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) && ext->layout.line_space == dsc->line_space &&
+       _lv_txt_layout_is_valid(&ext->layout, ext->text, dsc->font, dsc->letter_space, LV_COORD_MAX, flag)) {
+        *size = ext->layout.size;
+        return;
+    }
+#endif
+
+    _lv_txt_get_size(size, ext->text, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX, flag);
+}
+
 #endif
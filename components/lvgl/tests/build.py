@@ -52,6 +52,9 @@ def build(name, defines):
 minimal_monochrome = {
   "LV_DPI":40,
   "LV_MEM_SIZE":4*1024,
+  "LV_MEM_TLSF":0,
+  "LV_MEM_BUF_KEEP_SIZE":0,
+  "LV_STYLE_INDEX":0,
   "LV_HOR_RES_MAX":128,
   "LV_VER_RES_MAX":64,
   "LV_COLOR_DEPTH":1,
@@ -211,6 +214,12 @@ all_obj_all_features = {
   "LV_VER_RES_MAX":320,
   "LV_COLOR_DEPTH":32,
   "LV_COLOR_SCREEN_TRANSP":1,
+  "LV_USE_INV_TILES":1,
+  "LV_USE_REFR_WORKER":1,
+  "LV_USE_REFR_ADAPTIVE_BAND":1,
+  "LV_USE_REFR_OCCLUSION":1,
+  "LV_SHADOW_CACHE_SIZE":40,
+  "LV_IMG_DECODED_MEM_SIZE":4*1024,
   "LV_USE_GROUP":1,
   "LV_USE_ANIMATION":1,
   "LV_ANTIALIAS":1,
@@ -286,11 +295,19 @@ advanced_features = {
   "LV_DPI":100,
   "LV_MEM_SIZE":4*1024*1024,
   "LV_MEM_CUSTOM":1,
+  "LV_STYLE_DSC_CACHE":1,
+  "LV_LL_POOL":1,
+  "LV_INDEV_HIT_INDEX":1,
   "LV_HOR_RES_MAX":800,
   "LV_VER_RES_MAX":480,
   "LV_COLOR_DEPTH":32,
   "LV_COLOR_16_SWAP":0,
   "LV_COLOR_SCREEN_TRANSP":1,
+  "LV_USE_INV_TILES":1,
+  "LV_USE_REFR_WORKER":1,
+  "LV_USE_REFR_ADAPTIVE_BAND":1,
+  "LV_USE_REFR_OCCLUSION":1,
+  "LV_SHADOW_CACHE_SIZE":40,
   "LV_USE_GROUP":1,
   "LV_USE_ANIMATION":1,
   "LV_ANTIALIAS":1,
@@ -300,6 +317,7 @@ advanced_features = {
   "LV_USE_API_EXTENSION_V6":1,
   "LV_USE_USER_DATA":1,
   "LV_IMG_CACHE_DEF_SIZE":32,
+  "LV_IMG_DECODED_MEM_SIZE":64*1024,
   "LV_USE_LOG":1,
   "LV_USE_THEME_MATERIAL":1,
   "LV_USE_THEME_EMPTY":1,
@@ -20,6 +20,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdarg.h>
+#include <time.h>
 
 #define PNG_DEBUG 3
 #include <png.h>
@@ -232,6 +233,17 @@ void lv_test_assert_img_eq(const char * fn_ref, const char * s)
     }
 }
 
+/**
+ * Get a monotonic time stamp for the benchmarks
+ * @return the time in nanoseconds
+ */
+uint64_t lv_test_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -0,0 +1,365 @@
+/**
+ * @file lv_test_anim.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_anim.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LOG_MAX         16
+
+/*Have the animations of the benchmark fit into the heap*/
+#if LV_USE_ANIMATION && (LV_MEM_CUSTOM || LV_MEM_SIZE >= 32 * 1024)
+    #define BENCH_EN        1
+    #define BENCH_ANIMS     200
+    #define BENCH_ROUNDS    2000
+#else
+    #define BENCH_EN        0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_ANIMATION
+static void path_tables(void);
+static void ready_in_order(void);
+static void change_in_cb(void);
+static void start_cb_values(void);
+static void values_in_cb(void);
+#if BENCH_EN
+static void bench_step(void);
+#endif
+static void anim_start(int32_t * var, int32_t end, lv_anim_ready_cb_t ready_cb);
+static void anim_finish(int32_t * var);
+static void set_cb(void * var, lv_anim_value_t v);
+static void log_ready_cb(lv_anim_t * a);
+static void del_other_ready_cb(lv_anim_t * a);
+static void values_to_50_start_cb(lv_anim_t * a);
+static void values_of_other_ready_cb(lv_anim_t * a);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_ANIMATION
+static char log_buf[LOG_MAX + 1];
+static int32_t vars[4];
+static uint32_t exec_cnt;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_anim(void)
+{
+#if LV_USE_ANIMATION
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_anim tests");
+    lv_test_print("===================");
+
+    path_tables();
+    ready_in_order();
+    change_in_cb();
+    start_cb_values();
+    values_in_cb();
+#if BENCH_EN
+    bench_step();
+#endif
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_ANIMATION
+
+static void path_tables(void)
+{
+    lv_test_print("");
+    lv_test_print("Follow the bezier curves with the easing tables:");
+    lv_test_print("------------------------------------------------");
+
+    static const struct {
+        lv_anim_path_cb_t cb;
+        uint32_t u1;
+        uint32_t u2;
+    } paths[] = {
+        {lv_anim_path_ease_in, 1, 1},
+        {lv_anim_path_ease_out, 1023, 1023},
+        {lv_anim_path_ease_in_out, 100, 924},
+        {lv_anim_path_overshoot, 1000, 1300},
+    };
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 0, 1024);
+    lv_anim_set_time(&a, 1024);
+
+    uint32_t i;
+    int32_t max_diff = 0;
+    for(i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        lv_anim_path_t path;
+        lv_anim_path_init(&path);
+        lv_anim_path_set_cb(&path, paths[i].cb);
+
+        int32_t t;
+        for(t = 0; t <= 1024; t++) {
+            a.act_time = t;
+            int32_t diff = path.cb(&path, &a) - (int32_t)_lv_bezier3(t, 0, paths[i].u1, paths[i].u2, 1024);
+            max_diff = LV_MATH_MAX(max_diff, LV_MATH_ABS(diff));
+        }
+
+        a.act_time = 1024;
+        lv_test_assert_int_eq(1024, path.cb(&path, &a), "The end value is reached");
+    }
+
+    lv_test_assert_int_lt(6, max_diff, "Differ from the bezier curves by less than 6/1024");
+}
+
+static void ready_in_order(void)
+{
+    lv_test_print("");
+    lv_test_print("Apply the values and call the ready callbacks in start order:");
+    lv_test_print("-------------------------------------------------------------");
+
+    uint16_t cnt_ori = lv_anim_count_running();
+
+    log_buf[0] = '\0';
+    anim_start(&vars[0], 10, log_ready_cb);
+    anim_start(&vars[1], 20, log_ready_cb);
+    anim_start(&vars[2], 30, log_ready_cb);
+    lv_test_assert_int_eq(cnt_ori + 3, lv_anim_count_running(), "3 animations are running");
+
+    /*Replace the animation of the same variable*/
+    anim_start(&vars[1], 25, log_ready_cb);
+    lv_test_assert_int_eq(cnt_ori + 3, lv_anim_count_running(), "Restarting doesn't add an animation");
+
+    anim_finish(&vars[0]);
+    anim_finish(&vars[1]);
+    anim_finish(&vars[2]);
+    lv_anim_refr_now();
+
+    lv_test_assert_str_eq("ACB", log_buf, "Ready in start order");
+    lv_test_assert_int_eq(10, vars[0], "End value of A");
+    lv_test_assert_int_eq(25, vars[1], "End value of the restarted B");
+    lv_test_assert_int_eq(30, vars[2], "End value of C");
+    lv_test_assert_int_eq(cnt_ori, lv_anim_count_running(), "All animations are deleted");
+}
+
+static void change_in_cb(void)
+{
+    lv_test_print("");
+    lv_test_print("Delete and start animations in a ready callback:");
+    lv_test_print("------------------------------------------------");
+
+    uint16_t cnt_ori = lv_anim_count_running();
+
+    /*A deletes B and starts D when it's ready*/
+    log_buf[0] = '\0';
+    exec_cnt = 0;
+    vars[1] = 0;
+    vars[3] = 0;
+    anim_start(&vars[0], 10, del_other_ready_cb);
+    anim_start(&vars[1], 20, log_ready_cb);
+    anim_start(&vars[2], 30, log_ready_cb);
+
+    anim_finish(&vars[0]);
+    anim_finish(&vars[1]);
+    anim_finish(&vars[2]);
+    lv_anim_refr_now();
+
+    lv_test_assert_str_eq("AC", log_buf, "B is not ready after deleted");
+    lv_test_assert_int_eq(0, vars[1], "B's value is not applied after deleted");
+    lv_test_assert_int_eq(2, exec_cnt, "The values of A and C are applied");
+    lv_test_assert_ptr_eq(NULL, lv_anim_get(&vars[1], set_cb), "B is deleted");
+    lv_test_assert_true(lv_anim_get(&vars[3], set_cb) != NULL, "D is started");
+    lv_test_assert_int_eq(cnt_ori + 1, lv_anim_count_running(), "Only D is running");
+
+    anim_finish(&vars[3]);
+    lv_anim_refr_now();
+    lv_test_assert_str_eq("ACD", log_buf, "D runs in the next round");
+    lv_test_assert_int_eq(40, vars[3], "End value of D");
+    lv_test_assert_int_eq(cnt_ori, lv_anim_count_running(), "All animations are deleted");
+}
+
+static void start_cb_values(void)
+{
+    lv_test_print("");
+    lv_test_print("Calculate the value after start_cb:");
+    lv_test_print("-----------------------------------");
+
+    vars[0] = 0;
+    uint16_t cnt_ori = lv_anim_count_running();
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &vars[0]);
+    lv_anim_set_exec_cb(&a, set_cb);
+    lv_anim_set_start_cb(&a, values_to_50_start_cb);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_time(&a, 1000);
+    lv_anim_start(&a);
+
+    /*`start_cb` is called in the first round as there is no delay*/
+    lv_anim_refr_now();
+    lv_test_assert_int_eq(50, vars[0], "The values set in start_cb are used");
+
+    lv_anim_del(&vars[0], set_cb);
+    lv_test_assert_int_eq(cnt_ori, lv_anim_count_running(), "The animation is deleted");
+}
+
+static void values_in_cb(void)
+{
+    lv_test_print("");
+    lv_test_print("Recalculate the values changed in an other callback:");
+    lv_test_print("----------------------------------------------------");
+
+    vars[1] = 0;
+    uint16_t cnt_ori = lv_anim_count_running();
+
+    /*A sets the values of B when it's ready, B already has its new value from the first pass*/
+    anim_start(&vars[0], 10, values_of_other_ready_cb);
+    anim_start(&vars[1], 20, NULL);
+    anim_finish(&vars[0]);
+    lv_anim_refr_now();
+
+    lv_test_assert_int_eq(70, vars[1], "B's new values are applied in the same round");
+
+    lv_anim_del(&vars[1], set_cb);
+    lv_test_assert_int_eq(cnt_ori, lv_anim_count_running(), "All animations are deleted");
+}
+
+#if BENCH_EN
+static void bench_step(void)
+{
+    lv_test_print("");
+    lv_test_print("Step many animations:");
+    lv_test_print("---------------------");
+
+    static int32_t bench_vars[BENCH_ANIMS];
+    static lv_anim_t * anims[BENCH_ANIMS];
+    static const lv_anim_path_cb_t cbs[] = {lv_anim_path_linear, lv_anim_path_ease_in, lv_anim_path_ease_out,
+                                            lv_anim_path_ease_in_out, lv_anim_path_overshoot
+                                           };
+    uint16_t cnt_ori = lv_anim_count_running();
+
+    uint32_t i;
+    for(i = 0; i < BENCH_ANIMS; i++) {
+        lv_anim_path_t path;
+        lv_anim_path_init(&path);
+        lv_anim_path_set_cb(&path, cbs[i % (sizeof(cbs) / sizeof(cbs[0]))]);
+
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &bench_vars[i]);
+        lv_anim_set_exec_cb(&a, set_cb);
+        lv_anim_set_values(&a, 0, 1000);
+        lv_anim_set_time(&a, 1000);
+        lv_anim_set_path(&a, &path);
+        lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+        lv_anim_start(&a);
+        anims[i] = lv_anim_get(&bench_vars[i], set_cb);
+    }
+    lv_test_assert_int_eq(cnt_ori + BENCH_ANIMS, lv_anim_count_running(), "Animations started");
+
+    uint32_t r;
+    uint64_t t = lv_test_time_ns();
+    for(r = 0; r < BENCH_ROUNDS; r++) {
+        /*Move every animation by a few ms per round independently of the real time*/
+        for(i = 0; i < BENCH_ANIMS; i++) {
+            anims[i]->act_time = (r * 7 + i) % 1000;
+        }
+        lv_anim_refr_now();
+    }
+    t = lv_test_time_ns() - t;
+
+    lv_test_print("%d animations: %d ns per round", BENCH_ANIMS, (int)(t / BENCH_ROUNDS));
+
+    for(i = 0; i < BENCH_ANIMS; i++) lv_anim_del(&bench_vars[i], set_cb);
+    lv_test_assert_int_eq(cnt_ori, lv_anim_count_running(), "All animations are deleted");
+}
+#endif
+
+/**
+ * Start a 1 s animation of `var` from 0 to `end` without applying the start value
+ */
+static void anim_start(int32_t * var, int32_t end, lv_anim_ready_cb_t ready_cb)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, var);
+    lv_anim_set_exec_cb(&a, set_cb);
+    lv_anim_set_ready_cb(&a, ready_cb);
+    lv_anim_set_values(&a, 0, end);
+    lv_anim_set_time(&a, 1000);
+    a.early_apply = 0;
+    lv_anim_start(&a);
+}
+
+/**
+ * Make the animation of `var` ready in the next round
+ */
+static void anim_finish(int32_t * var)
+{
+    lv_anim_t * a = lv_anim_get(var, set_cb);
+    if(a) a->act_time = a->time;
+}
+
+static void set_cb(void * var, lv_anim_value_t v)
+{
+    *((int32_t *)var) = v;
+    exec_cnt++;
+}
+
+static void log_ready_cb(lv_anim_t * a)
+{
+    size_t len = strlen(log_buf);
+    if(len < LOG_MAX) {
+        log_buf[len] = 'A' + ((int32_t *)a->var - vars);
+        log_buf[len + 1] = '\0';
+    }
+}
+
+static void del_other_ready_cb(lv_anim_t * a)
+{
+    log_ready_cb(a);
+    lv_anim_del(&vars[1], set_cb);
+    anim_start(&vars[3], 40, log_ready_cb);
+}
+
+static void values_to_50_start_cb(lv_anim_t * a)
+{
+    a->start = 50;
+    a->end = 50;
+}
+
+static void values_of_other_ready_cb(lv_anim_t * a)
+{
+    (void)a;
+    lv_anim_t * b = lv_anim_get(&vars[1], set_cb);
+    if(b) lv_anim_set_values(b, 70, 70);
+}
+
+#endif /*LV_USE_ANIMATION*/
+#endif /*LV_BUILD_TEST*/
@@ -0,0 +1,265 @@
+/**
+ * @file lv_test_blend.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_blend.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_LEN    40      /*Longer than the widest kernel + its tail*/
+#define BENCH_W     480
+#define BENCH_PX    (2 * 1024 * 1024)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    KERNEL_FILL,
+    KERNEL_FILL_MASK,
+    KERNEL_MAP,
+    KERNEL_MAP_MASK,
+    _KERNEL_NUM
+} kernel_t;
+
+typedef struct {
+    const char * name;
+    kernel_t kernel;
+    lv_opa_t opa;
+    bool uniform;       /*Same background in every pixel*/
+} bench_case_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void same_as_mix(void);
+#if LV_COLOR_DEPTH != 1
+static void benchmark(void);
+static uint32_t bench_mpx(kernel_t kernel, lv_opa_t opa, bool ref);
+#endif
+static void run_kernel(kernel_t kernel, lv_color_t * dest, int32_t len, lv_opa_t opa);
+static void run_ref(kernel_t kernel, lv_color_t * dest, int32_t len, lv_opa_t opa);
+static void random_colors(lv_color_t * buf, int32_t len);
+static void random_mask(lv_opa_t * buf, int32_t len);
+static uint32_t rnd(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t dest_buf[BENCH_W + 4];
+static lv_color_t ref_buf[BENCH_W + 4];
+static lv_color_t src_buf[BENCH_W + 4];
+static lv_opa_t mask_buf[BENCH_W + 4];
+static lv_color_t fill_color;
+static uint32_t rnd_seed = 0x12345678;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_blend(void)
+{
+    lv_test_print("");
+    lv_test_print("====================");
+    lv_test_print("Start lv_blend tests");
+    lv_test_print("====================");
+
+    same_as_mix();
+#if LV_COLOR_DEPTH != 1
+    /*1 bpp mixing only selects one of the colors, nothing to measure*/
+    benchmark();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void same_as_mix(void)
+{
+    lv_test_print("Blend rows like lv_color_mix (" _LV_BLEND_SIMD_NAME ")");
+
+    static const lv_opa_t opas[] = {LV_OPA_MIN, 60, LV_OPA_50, 200, LV_OPA_MAX, 254, LV_OPA_COVER};
+    uint32_t diff_cnt = 0;
+    uint32_t k;
+    uint32_t i;
+    int32_t ofs;
+    int32_t len;
+
+    for(k = 0; k < _KERNEL_NUM; k++) {
+        for(i = 0; i < sizeof(opas); i++) {
+            /*Try every alignment and the tails after the vectors*/
+            for(ofs = 0; ofs < 4; ofs++) {
+                for(len = 0; len <= TEST_LEN; len++) {
+                    fill_color = LV_COLOR_MAKE(rnd() & 0xFF, rnd() & 0xFF, rnd() & 0xFF);
+                    random_colors(src_buf, len + ofs);
+                    random_colors(dest_buf, len + ofs);
+                    random_mask(mask_buf, len + ofs);
+                    _lv_memcpy(ref_buf, dest_buf, sizeof(dest_buf));
+
+                    run_kernel(k, dest_buf + ofs, len, opas[i]);
+                    run_ref(k, ref_buf + ofs, len, opas[i]);
+                    if(memcmp(dest_buf, ref_buf, sizeof(dest_buf))) diff_cnt++;
+                }
+            }
+        }
+    }
+
+    lv_test_assert_int_eq(0, diff_cnt, "Same pixels with every kernel, opacity and length");
+}
+
+#if LV_COLOR_DEPTH != 1
+static void benchmark(void)
+{
+    static const bench_case_t cases[] = {
+        {"fill, opa, uniform bg", KERNEL_FILL, LV_OPA_50, true},
+        {"fill, opa", KERNEL_FILL, LV_OPA_50, false},
+        {"fill, mask", KERNEL_FILL_MASK, LV_OPA_COVER, false},
+        {"fill, mask + opa", KERNEL_FILL_MASK, LV_OPA_50, false},
+        {"map, opa", KERNEL_MAP, LV_OPA_50, false},
+        {"map, mask", KERNEL_MAP_MASK, LV_OPA_COVER, false},
+        {"map, mask + opa", KERNEL_MAP_MASK, LV_OPA_50, false},
+    };
+
+    uint32_t i;
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        fill_color = LV_COLOR_MAKE(0x20, 0x80, 0xE0);
+        random_colors(src_buf, BENCH_W);
+        random_mask(mask_buf, BENCH_W);
+        if(cases[i].uniform) lv_color_fill(dest_buf, LV_COLOR_MAKE(0x40, 0x40, 0x40), BENCH_W);
+        else random_colors(dest_buf, BENCH_W);
+        _lv_memcpy(ref_buf, dest_buf, sizeof(dest_buf));
+
+        uint32_t mpx_kernel = bench_mpx(cases[i].kernel, cases[i].opa, false);
+        uint32_t mpx_ref = bench_mpx(cases[i].kernel, cases[i].opa, true);
+        lv_test_print("%s: %d Mpx/s (%d Mpx/s by pixel with lv_color_mix)",
+                      cases[i].name, (int)mpx_kernel, (int)mpx_ref);
+    }
+}
+
+#endif
+
+static void run_kernel(kernel_t kernel, lv_color_t * dest, int32_t len, lv_opa_t opa)
+{
+    int32_t ofs = dest - dest_buf;
+    switch(kernel) {
+        case KERNEL_FILL:
+            _lv_blend_fill_row(dest, len, fill_color, opa);
+            break;
+        case KERNEL_FILL_MASK:
+            _lv_blend_fill_row_mask(dest, len, fill_color, mask_buf + ofs, opa);
+            break;
+        case KERNEL_MAP:
+            _lv_blend_map_row(dest, src_buf + ofs, len, opa);
+            break;
+        default:
+            _lv_blend_map_row_mask(dest, src_buf + ofs, len, mask_buf + ofs, opa);
+            break;
+    }
+}
+
+/**
+ * Blend pixel by pixel the way the row kernels should
+ */
+static void run_ref(kernel_t kernel, lv_color_t * dest, int32_t len, lv_opa_t opa)
+{
+    int32_t ofs = dest - ref_buf;
+    const lv_color_t * src = src_buf + ofs;
+    const lv_opa_t * mask = mask_buf + ofs;
+    int32_t x;
+    for(x = 0; x < len; x++) {
+        lv_color_t fg = kernel == KERNEL_FILL || kernel == KERNEL_FILL_MASK ? fill_color : src[x];
+        if(kernel == KERNEL_FILL || kernel == KERNEL_MAP) {
+            dest[x] = opa > LV_OPA_MAX ? fg : lv_color_mix(fg, dest[x], opa);
+        }
+        else if(mask[x] == LV_OPA_TRANSP) {
+            continue;
+        }
+        else if(opa > LV_OPA_MAX) {
+            dest[x] = mask[x] == LV_OPA_COVER ? fg : lv_color_mix(fg, dest[x], mask[x]);
+        }
+        else {
+            /*Fills use `opa` as it is only with fully covering mask, maps from `LV_OPA_MAX`*/
+            lv_opa_t full = kernel == KERNEL_FILL_MASK ? LV_OPA_COVER : LV_OPA_MAX;
+            lv_opa_t opa_tmp = mask[x] >= full ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+            dest[x] = lv_color_mix(fg, dest[x], opa_tmp);
+        }
+    }
+}
+
+#if LV_COLOR_DEPTH != 1
+/**
+ * Blend `BENCH_PX` pixels in rows of `BENCH_W`
+ * @param ref true: blend pixel by pixel with `run_ref`
+ * @return million pixels per second
+ */
+static uint32_t bench_mpx(kernel_t kernel, lv_opa_t opa, bool ref)
+{
+    uint32_t rows = BENCH_PX / BENCH_W;
+    uint64_t t = lv_test_time_ns();
+    uint32_t i;
+    for(i = 0; i < rows; i++) {
+        if(ref) run_ref(kernel, ref_buf, BENCH_W, opa);
+        else run_kernel(kernel, dest_buf, BENCH_W, opa);
+    }
+    t = lv_test_time_ns() - t;
+    if(t == 0) t = 1;
+
+    return (uint64_t)rows * BENCH_W * 1000 / t;
+}
+#endif
+
+static void random_colors(lv_color_t * buf, int32_t len)
+{
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        uint32_t r = rnd();
+        buf[i] = LV_COLOR_MAKE(r & 0xFF, (r >> 8) & 0xFF, (r >> 16) & 0xFF);
+    }
+}
+
+/**
+ * Runs of transparent, covering and random mask values like at the edges of anti-aliased shapes
+ */
+static void random_mask(lv_opa_t * buf, int32_t len)
+{
+    int32_t i = 0;
+    while(i < len) {
+        uint32_t r = rnd();
+        int32_t run = 1 + (r >> 8) % 12;
+        for(; run > 0 && i < len; run--, i++) {
+            switch(r & 0x3) {
+                case 0:
+                    buf[i] = LV_OPA_TRANSP;
+                    break;
+                case 1:
+                    buf[i] = LV_OPA_COVER;
+                    break;
+                default:
+                    buf[i] = rnd() & 0xFF;
+                    break;
+            }
+        }
+    }
+}
+
+static uint32_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return rnd_seed >> 8;
+}
+
+#endif
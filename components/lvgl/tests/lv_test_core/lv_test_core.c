@@ -13,6 +13,18 @@
 #include "lv_test_obj.h"
 #include "lv_test_style.h"
 #include "lv_test_font_loader.h"
+#include "lv_test_refr.h"
+#include "lv_test_blend.h"
+#include "lv_test_draw_mask.h"
+#include "lv_test_draw_rect.h"
+#include "lv_test_img_cache.h"
+#include "lv_test_img_decoder.h"
+#include "lv_test_font_fmt_txt.h"
+#include "lv_test_mem.h"
+#include "lv_test_task.h"
+#include "lv_test_anim.h"
+#include "lv_test_ll.h"
+#include "lv_test_indev.h"
 
 /*********************
  *      DEFINES
@@ -45,9 +57,21 @@ void lv_test_core(void)
     lv_test_print("Start lv_core tests");
     lv_test_print("*******************");
 
+    lv_test_mem();
+    lv_test_task();
+    lv_test_anim();
+    lv_test_ll();
     lv_test_obj();
+    lv_test_indev();
     lv_test_style();
     lv_test_font_loader();
+    lv_test_refr();
+    lv_test_blend();
+    lv_test_draw_mask();
+    lv_test_draw_rect();
+    lv_test_img_cache();
+    lv_test_img_decoder();
+    lv_test_font_fmt_txt();
 }
 
 /**********************
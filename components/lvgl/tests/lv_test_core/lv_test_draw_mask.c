@@ -0,0 +1,263 @@
+/**
+ * @file lv_test_draw_mask.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../../src/lv_misc/lv_gc.h"
+#include "../lv_test_assert.h"
+#include "lv_test_draw_mask.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_PAD        3       /*Pixels checked around the rectangles*/
+#define TEST_RADIUS_MAX 80
+#define TEST_ROWS       410     /*Enough for the largest radius' corner too*/
+#define BENCH_RECTS     2000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * name;
+    lv_coord_t w;
+    lv_coord_t h;
+    lv_coord_t radius;
+    lv_coord_t border_width;
+    lv_coord_t shadow_width;
+} bench_case_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void same_as_calc(void);
+static void cache_size(void);
+static void benchmark(void);
+static uint32_t compare_radius(lv_coord_t radius, lv_coord_t w, lv_coord_t h, bool outer);
+static uint32_t compare_rows(lv_draw_mask_radius_param_t * p, lv_coord_t abs_x, lv_coord_t len, lv_coord_t row_cnt);
+static void apply(lv_draw_mask_radius_param_t * p, lv_opa_t * buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                  lv_coord_t len);
+static uint32_t bench_rects_per_s(const bench_case_t * bench, const lv_area_t * clip);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_opa_t cached_rows[TEST_ROWS][TEST_ROWS];
+static lv_opa_t calc_buf[TEST_ROWS];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_draw_mask(void)
+{
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start lv_draw_mask tests");
+    lv_test_print("========================");
+
+    same_as_calc();
+    cache_size();
+    benchmark();
+
+    lv_draw_mask_radius_cache_set_size(LV_RADIUS_CACHE_SIZE);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void same_as_calc(void)
+{
+    lv_test_print("The cached corners are the same as the calculated ones");
+
+    static const lv_coord_t radii[] = {255, 256, 257, 400};
+    uint32_t diff_cnt = 0;
+    lv_coord_t r;
+    uint32_t i;
+    for(r = 1; r <= TEST_RADIUS_MAX; r++) {
+        diff_cnt += compare_radius(r, 2 * r, 2 * r, false);
+        diff_cnt += compare_radius(r, 2 * r, 2 * r, true);
+        diff_cnt += compare_radius(r, 2 * r + 9, 2 * r + 1, false);
+        diff_cnt += compare_radius(r, 2 * r + 9, 2 * r + 1, true);
+        diff_cnt += compare_radius(r, 2 * r + 1, 4 * r, false);
+        diff_cnt += compare_radius(r, 2 * r + 1, 4 * r, true);
+    }
+    lv_test_assert_int_eq(0, diff_cnt, "Same masks up to 80 px radius");
+
+    /*Only the top left corners fit into the buffers*/
+    diff_cnt = 0;
+    for(i = 0; i < sizeof(radii) / sizeof(radii[0]); i++) {
+        lv_draw_mask_radius_param_t p;
+        lv_area_t rect;
+        lv_area_set(&rect, TEST_PAD, TEST_PAD, TEST_PAD + 2 * radii[i] - 1, TEST_PAD + 2 * radii[i] - 1);
+        lv_draw_mask_radius_init(&p, &rect, radii[i], false);
+        diff_cnt += compare_rows(&p, 0, radii[i] + 2 * TEST_PAD, radii[i] + TEST_PAD);
+    }
+    lv_test_assert_int_eq(0, diff_cnt, "Same masks with large radii");
+}
+
+static void cache_size(void)
+{
+    lv_test_print("The circles fit into the cache");
+
+    lv_draw_mask_radius_cache_set_size(LV_RADIUS_CACHE_SIZE);
+
+    lv_area_t rect;
+    lv_area_set(&rect, 0, 0, 99, 99);
+    lv_opa_t buf[100];
+    uint32_t size_max = 0;
+    lv_coord_t r;
+    for(r = 1; r <= 50; r++) {
+        lv_draw_mask_radius_param_t p;
+        lv_draw_mask_radius_init(&p, &rect, r, false);
+        apply(&p, buf, 0, 0, 100);
+        size_max = LV_MATH_MAX(size_max, LV_GC_ROOT(_lv_draw_mask_radius_cache).size);
+    }
+    lv_test_assert_int_lt(LV_RADIUS_CACHE_SIZE + 1, size_max, "Not larger than LV_RADIUS_CACHE_SIZE");
+
+    lv_draw_mask_radius_cache_set_size(0);
+    lv_test_assert_int_eq(0, LV_GC_ROOT(_lv_draw_mask_radius_cache).size, "Free all circles");
+    lv_test_assert_int_eq(0, LV_GC_ROOT(_lv_draw_mask_radius_cache).first == NULL ? 0 : 1, "No circles left");
+}
+
+static void benchmark(void)
+{
+    static const bench_case_t cases[] = {
+        {"radius 8", 60, 30, 8, 0, 0},
+        {"circle", 64, 64, LV_RADIUS_CIRCLE, 0, 0},
+        {"large radius", 200, 120, 40, 0, 0},
+        {"radius 12 + border", 100, 40, 12, 3, 0},
+        {"radius 10 + shadow", 80, 40, 10, 0, 8},
+    };
+
+    /*Draw into the whole display buffer as if the display were refreshed*/
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    lv_area_t vdb_area_ori = vdb->area;
+    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+    lv_area_set(&vdb->area, 0, 0, lv_disp_get_hor_res(disp) - 1, vdb->size / lv_disp_get_hor_res(disp) - 1);
+    _lv_refr_set_disp_refreshing(disp);
+
+    uint32_t i;
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        /*Calculate the circles and warm up the CPU caches before measuring*/
+        lv_draw_mask_radius_cache_set_size(LV_RADIUS_CACHE_SIZE);
+        bench_rects_per_s(&cases[i], &vdb->area);
+        uint32_t cached = bench_rects_per_s(&cases[i], &vdb->area);
+        lv_draw_mask_radius_cache_set_size(0);
+        uint32_t calc = bench_rects_per_s(&cases[i], &vdb->area);
+
+        lv_test_print("%s: %d rect/s (%d rect/s without the radius cache)",
+                      cases[i].name, (int)cached, (int)calc);
+    }
+
+    _lv_refr_set_disp_refreshing(refr_ori);
+    vdb->area = vdb_area_ori;
+}
+
+/**
+ * Compare the cached and the calculated masks of every row of a rectangle with many parts of the rows
+ * @return number of different rows
+ */
+static uint32_t compare_radius(lv_coord_t radius, lv_coord_t w, lv_coord_t h, bool outer)
+{
+    lv_draw_mask_radius_param_t p;
+    lv_area_t rect;
+    lv_area_set(&rect, TEST_PAD, TEST_PAD, TEST_PAD + w - 1, TEST_PAD + h - 1);
+    lv_draw_mask_radius_init(&p, &rect, radius, outer);
+
+    /*The whole row, the left and right corners, a part of a corner and the middle*/
+    lv_coord_t xs[] = {0, 0, TEST_PAD + w - radius - 1, TEST_PAD + radius / 2, TEST_PAD + radius - 1};
+    lv_coord_t lens[] = {w + 2 * TEST_PAD, TEST_PAD + radius + 1, radius + TEST_PAD + 1, 2, w - 2 * radius + 2};
+
+    uint32_t diff_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < sizeof(xs) / sizeof(xs[0]); i++) {
+        diff_cnt += compare_rows(&p, xs[i], lens[i], h + 2 * TEST_PAD);
+    }
+
+    return diff_cnt;
+}
+
+/**
+ * Compare the cached and the calculated masks of the same part of the first rows
+ * @return number of different rows
+ */
+static uint32_t compare_rows(lv_draw_mask_radius_param_t * p, lv_coord_t abs_x, lv_coord_t len, lv_coord_t row_cnt)
+{
+    lv_coord_t y;
+    lv_draw_mask_radius_cache_set_size(UINT32_MAX);
+    for(y = 0; y < row_cnt; y++) apply(p, cached_rows[y], abs_x, y, len);
+
+    uint32_t diff_cnt = 0;
+    lv_draw_mask_radius_cache_set_size(0);
+    for(y = 0; y < row_cnt; y++) {
+        apply(p, calc_buf, abs_x, y, len);
+        if(memcmp(cached_rows[y], calc_buf, len)) diff_cnt++;
+    }
+
+    return diff_cnt;
+}
+
+/**
+ * Apply a radius mask on a row of a pattern. Clear the row if it's transparent.
+ */
+static void apply(lv_draw_mask_radius_param_t * p, lv_opa_t * buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                  lv_coord_t len)
+{
+    lv_coord_t i;
+    for(i = 0; i < len; i++) buf[i] = i % 3 ? LV_OPA_COVER : (lv_opa_t)(i * 37);
+
+    lv_draw_mask_res_t res = p->dsc.cb(buf, abs_x, abs_y, len, p);
+    if(res == LV_DRAW_MASK_RES_TRANSP) _lv_memset_00(buf, len);
+}
+
+/**
+ * Draw a rounded rectangle many times with `lv_draw_rect`
+ * @param bench what to draw
+ * @param clip draw only here
+ * @return the rectangles drawn in a second
+ */
+static uint32_t bench_rects_per_s(const bench_case_t * bench, const lv_area_t * clip)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.radius = bench->radius;
+    dsc.bg_color = LV_COLOR_MAKE(0x20, 0x80, 0xE0);
+    dsc.border_width = bench->border_width;
+    dsc.border_color = LV_COLOR_MAKE(0xE0, 0x80, 0x20);
+#if LV_USE_SHADOW
+    dsc.shadow_width = bench->shadow_width;
+#endif
+
+    /*Move the rectangles around but let them be clipped on small displays*/
+    lv_coord_t hres = LV_MATH_MAX(lv_area_get_width(clip) - bench->w - 2 * bench->shadow_width, 1);
+    lv_coord_t vres = LV_MATH_MAX(lv_area_get_height(clip) - bench->h - 2 * bench->shadow_width, 1);
+    uint64_t t = lv_test_time_ns();
+    uint32_t i;
+    for(i = 0; i < BENCH_RECTS; i++) {
+        lv_area_t coords;
+        coords.x1 = bench->shadow_width + (i * 37) % hres;
+        coords.y1 = bench->shadow_width + (i * 23) % vres;
+        coords.x2 = coords.x1 + bench->w - 1;
+        coords.y2 = coords.y1 + bench->h - 1;
+        lv_draw_rect(&coords, clip, &dsc);
+    }
+    t = lv_test_time_ns() - t;
+    if(t == 0) t = 1;
+
+    return (uint64_t)BENCH_RECTS * 1000000000 / t;
+}
+#endif
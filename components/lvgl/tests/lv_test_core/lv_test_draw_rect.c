@@ -0,0 +1,298 @@
+/**
+ * @file lv_test_draw_rect.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../../src/lv_misc/lv_gc.h"
+#include "../lv_test_assert.h"
+#include "lv_test_draw_rect.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_W          200     /*The shadows are drawn into this part of the display buffer*/
+#define TEST_H          140
+#define TEST_CASE_MAX   512
+#define BENCH_SHADOWS   2000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * name;
+    lv_coord_t w;
+    lv_coord_t h;
+    lv_coord_t radius;
+    lv_coord_t shadow_width;
+    lv_coord_t shadow_spread;
+} bench_case_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+static void same_as_calc(void);
+static void cache_size(void);
+static void benchmark(void);
+static void draw_begin(void);
+static void draw_end(void);
+static uint32_t draw_shadow(const lv_area_t * coords, const lv_draw_rect_dsc_t * dsc);
+static uint32_t bench_shadows_per_s(const bench_case_t * bench);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+static uint32_t calc_hash[TEST_CASE_MAX];
+static lv_area_t vdb_area_ori;
+static lv_disp_t * refr_ori;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_draw_rect(void)
+{
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start lv_draw_rect tests");
+    lv_test_print("========================");
+
+    draw_begin();
+    same_as_calc();
+    cache_size();
+    benchmark();
+    draw_end();
+
+    lv_draw_rect_shadow_cache_set_size(LV_SHADOW_CACHE_MEM_SIZE);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+
+static void same_as_calc(void)
+{
+    lv_test_print("The shadows drawn from the cache are the same as the calculated ones");
+
+    static const lv_coord_t sws[] = {2, 5, 8, 15, 24};
+    static const lv_coord_t radii[] = {0, 5, 12, LV_RADIUS_CIRCLE};
+    static const lv_coord_t spreads[] = {0, 3, -2};
+    static const lv_point_t sizes[] = {{6, 5}, {30, 22}, {90, 60}};
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_opa = LV_OPA_TRANSP;
+    dsc.border_width = 0;
+
+    uint32_t hit_start;
+    lv_draw_rect_shadow_cache_get_hit_rate(&hit_start, NULL);
+
+    /*Calculate every shadow first, then draw them twice from an other cache every time*/
+    uint32_t diff_cnt = 0;
+    uint32_t pass;
+    for(pass = 0; pass < 2; pass++) {
+        lv_draw_rect_shadow_cache_set_size(0);
+        if(pass == 1) lv_draw_rect_shadow_cache_set_size(LV_SHADOW_CACHE_MEM_SIZE);
+
+        uint32_t case_cnt = 0;
+        uint32_t a, b, c, d;
+        for(a = 0; a < sizeof(sws) / sizeof(sws[0]); a++) {
+            for(b = 0; b < sizeof(radii) / sizeof(radii[0]); b++) {
+                for(c = 0; c < sizeof(spreads) / sizeof(spreads[0]); c++) {
+                    for(d = 0; d < sizeof(sizes) / sizeof(sizes[0]); d++) {
+                        dsc.shadow_width = sws[a];
+                        dsc.radius = radii[b];
+                        dsc.shadow_spread = spreads[c];
+                        dsc.shadow_ofs_x = (case_cnt % 3) * 2;
+                        dsc.shadow_ofs_y = (case_cnt % 2) * 3;
+
+                        lv_area_t coords;
+                        lv_area_set(&coords, 50, 40, 50 + sizes[d].x - 1, 40 + sizes[d].y - 1);
+                        uint32_t hash = draw_shadow(&coords, &dsc);
+                        if(pass == 0) {
+                            calc_hash[case_cnt] = hash;
+                        }
+                        else {
+                            /*The first one might have been calculated*/
+                            hash = draw_shadow(&coords, &dsc);
+                            if(hash != calc_hash[case_cnt]) diff_cnt++;
+                        }
+                        case_cnt++;
+                    }
+                }
+            }
+        }
+    }
+
+    lv_test_assert_int_eq(0, diff_cnt, "Same shadows with any width, radius, spread and size");
+
+    uint32_t hit_end;
+    lv_draw_rect_shadow_cache_get_hit_rate(&hit_end, NULL);
+    lv_test_assert_int_gt(0, hit_end - hit_start, "Shadows drawn from the cache");
+}
+
+static void cache_size(void)
+{
+    lv_test_print("The corners fit into the cache");
+
+    lv_draw_rect_shadow_cache_set_size(LV_SHADOW_CACHE_MEM_SIZE);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_opa = LV_OPA_TRANSP;
+    dsc.border_width = 0;
+
+    lv_area_t coords;
+    lv_area_set(&coords, 50, 40, 149, 99);
+    uint32_t size_max = 0;
+    lv_coord_t sw;
+    for(sw = 2; sw <= LV_SHADOW_CACHE_SIZE; sw++) {
+        dsc.shadow_width = sw;
+        draw_shadow(&coords, &dsc);
+        size_max = LV_MATH_MAX(size_max, LV_GC_ROOT(_lv_draw_shadow_cache).size);
+    }
+    lv_test_assert_int_lt(LV_SHADOW_CACHE_MEM_SIZE + 1, size_max, "Not larger than LV_SHADOW_CACHE_MEM_SIZE");
+    lv_test_assert_int_eq(1, LV_GC_ROOT(_lv_draw_shadow_cache).first->sw == LV_SHADOW_CACHE_SIZE ? 1 : 0,
+                          "The last corner is the first");
+
+    lv_draw_rect_shadow_cache_set_size(0);
+    lv_test_assert_int_eq(0, LV_GC_ROOT(_lv_draw_shadow_cache).size, "Free all corners");
+    lv_test_assert_int_eq(0, LV_GC_ROOT(_lv_draw_shadow_cache).first == NULL ? 0 : 1, "No corners left");
+}
+
+static void benchmark(void)
+{
+    static const bench_case_t cases[] = {
+        {"button", 100, 40, 8, 10, 0},
+        {"card", 180, 100, 10, 20, 2},
+        {"round", 40, 40, LV_RADIUS_CIRCLE, 8, 0},
+        {"large blur", 120, 80, 6, 30, 0},
+    };
+
+    uint32_t i;
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        uint32_t hit_start;
+        uint32_t miss_start;
+        lv_draw_rect_shadow_cache_get_hit_rate(&hit_start, &miss_start);
+
+        /*Calculate the corner and warm up the CPU caches before measuring*/
+        lv_draw_rect_shadow_cache_set_size(LV_SHADOW_CACHE_MEM_SIZE);
+        bench_shadows_per_s(&cases[i]);
+        uint32_t cached = bench_shadows_per_s(&cases[i]);
+
+        uint32_t hit_end;
+        uint32_t miss_end;
+        lv_draw_rect_shadow_cache_get_hit_rate(&hit_end, &miss_end);
+        uint32_t hit_rate = (uint64_t)(hit_end - hit_start) * 100 / (hit_end - hit_start + miss_end - miss_start);
+
+        lv_draw_rect_shadow_cache_set_size(0);
+        uint32_t calc = bench_shadows_per_s(&cases[i]);
+
+        lv_test_print("%s: %d shadow/s, hit rate %d percent (%d shadow/s without the shadow cache)",
+                      cases[i].name, (int)cached, (int)hit_rate, (int)calc);
+    }
+}
+
+/**
+ * Draw into the display buffer as if the display were refreshed
+ */
+static void draw_begin(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    vdb_area_ori = vdb->area;
+    refr_ori = _lv_refr_get_disp_refreshing();
+    lv_area_set(&vdb->area, 0, 0, lv_disp_get_hor_res(disp) - 1, vdb->size / lv_disp_get_hor_res(disp) - 1);
+    _lv_refr_set_disp_refreshing(disp);
+}
+
+static void draw_end(void)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(lv_disp_get_default());
+    _lv_refr_set_disp_refreshing(refr_ori);
+    vdb->area = vdb_area_ori;
+}
+
+/**
+ * Clear the test area of the display buffer and draw a rectangle into it
+ * @return hash of the test area
+ */
+static uint32_t draw_shadow(const lv_area_t * coords, const lv_draw_rect_dsc_t * dsc)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(lv_disp_get_default());
+    lv_coord_t vdb_w = lv_area_get_width(&vdb->area);
+    lv_color_t * buf = vdb->buf_act;
+    lv_coord_t y;
+    for(y = 0; y < TEST_H; y++) lv_color_fill(&buf[y * vdb_w], LV_COLOR_WHITE, TEST_W);
+
+    lv_area_t clip;
+    lv_area_set(&clip, 0, 0, TEST_W - 1, TEST_H - 1);
+    lv_draw_rect(coords, &clip, dsc);
+
+    uint32_t hash = 2166136261u;
+    for(y = 0; y < TEST_H; y++) {
+        lv_coord_t x;
+        for(x = 0; x < TEST_W; x++) {
+            hash = (hash ^ lv_color_to32(buf[y * vdb_w + x])) * 16777619u;
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * Draw the shadow of a rectangle many times with `lv_draw_rect`
+ * @param bench what to draw
+ * @return the shadows drawn in a second
+ */
+static uint32_t bench_shadows_per_s(const bench_case_t * bench)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_opa = LV_OPA_TRANSP;
+    dsc.border_width = 0;
+    dsc.radius = bench->radius;
+    dsc.shadow_width = bench->shadow_width;
+    dsc.shadow_spread = bench->shadow_spread;
+    dsc.shadow_ofs_y = 2;
+
+    /*Move the shadows around in the test area*/
+    lv_area_t clip;
+    lv_area_set(&clip, 0, 0, TEST_W - 1, TEST_H - 1);
+    lv_coord_t hres = LV_MATH_MAX(TEST_W - bench->w, 1);
+    lv_coord_t vres = LV_MATH_MAX(TEST_H - bench->h, 1);
+    uint64_t t = lv_test_time_ns();
+    uint32_t i;
+    for(i = 0; i < BENCH_SHADOWS; i++) {
+        lv_area_t coords;
+        coords.x1 = (i * 37) % hres;
+        coords.y1 = (i * 23) % vres;
+        coords.x2 = coords.x1 + bench->w - 1;
+        coords.y2 = coords.y1 + bench->h - 1;
+        lv_draw_rect(&coords, &clip, &dsc);
+    }
+    t = lv_test_time_ns() - t;
+    if(t == 0) t = 1;
+
+    return (uint64_t)BENCH_SHADOWS * 1000000000 / t;
+}
+#endif /*LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE*/
+
+#endif
@@ -0,0 +1,525 @@
+/**
+ * @file lv_test_font_fmt_txt.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../../src/lv_misc/lv_gc.h"
+#include "../lv_test_assert.h"
+#include "lv_test_font_fmt_txt.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define GLYPH_CACHE_EN  (LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_SIZE && LV_FONT_MONTSERRAT_28_COMPRESSED)
+#define BENCH_LINES     8       /*Lines of text on a screen*/
+#define BENCH_SCREENS   100
+
+/*Have the lookup tables of the test font fit into the heap*/
+#if LV_FONT_FMT_TXT_LOOKUP && (LV_MEM_CUSTOM || LV_MEM_SIZE >= 12 * 1024)
+    #define LOOKUP_EN   1
+#else
+    #define LOOKUP_EN   0
+#endif
+
+#define TEST_GLYPH_CNT  162     /*Glyph 0 is reserved*/
+#define TEST_TINY_CNT   20      /*Letters of the sparse tiny cmap*/
+#define TEST_FULL_CNT   30      /*Letters of the sparse full cmap*/
+#define TEST_KERN_MAX   ((TEST_GLYPH_CNT / 3 + 1) * (TEST_GLYPH_CNT / 7 + 1))
+#define BENCH_LOOKUPS   200000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LOOKUP_EN
+static void lookup_same_as_search(void);
+static void lookup_size(void);
+static void lookup_benchmark(void);
+static uint32_t bench_lookup_ns(const lv_font_t * font, const uint32_t * letters, uint32_t letter_cnt, bool search);
+static uint32_t compare_lookup(const lv_font_t * font, uint32_t letter_max);
+static uint32_t glyph_diff(const lv_font_t * font, uint32_t letter, uint32_t letter_next);
+static void make_font(bool kern_16);
+#endif
+#if GLYPH_CACHE_EN
+static void same_as_decompressed(void);
+static void cache_size(void);
+static void glyph_cache_benchmark(void);
+static uint32_t bench_screens_per_s(const lv_font_t * font);
+static uint32_t glyph_size(const lv_font_t * font, uint32_t letter);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LOOKUP_EN
+static lv_font_fmt_txt_lookup_t lookup_search;  /*Not built so the letters are searched*/
+static lv_font_fmt_txt_glyph_dsc_t test_glyph_dsc[TEST_GLYPH_CNT];
+static const uint8_t test_format0_ofs[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+static uint16_t test_tiny_list[TEST_TINY_CNT];
+static uint16_t test_full_list[TEST_FULL_CNT];
+static uint16_t test_full_ofs[TEST_FULL_CNT];
+static uint8_t test_kern_ids_8[TEST_KERN_MAX * 2];
+static uint16_t test_kern_ids_16[TEST_KERN_MAX * 2];
+static int8_t test_kern_values[TEST_KERN_MAX];
+static lv_font_fmt_txt_kern_pair_t test_kern;
+static lv_font_fmt_txt_dsc_t test_dsc;
+static lv_font_t test_font;
+
+/*ASCII, Latin-1, Cyrillic and CJK letters*/
+static const lv_font_fmt_txt_cmap_t test_cmaps[] = {
+    {
+        .range_start = 0x20, .range_length = 95, .glyph_id_start = 1,
+        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0,
+        .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
+    },
+    {
+        .range_start = 0xA0, .range_length = 16, .glyph_id_start = 96,
+        .unicode_list = NULL, .glyph_id_ofs_list = test_format0_ofs, .list_length = 16,
+        .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL
+    },
+    {
+        .range_start = 0x400, .range_length = 0x100, .glyph_id_start = 112,
+        .unicode_list = test_tiny_list, .glyph_id_ofs_list = NULL, .list_length = TEST_TINY_CNT,
+        .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY
+    },
+    {
+        .range_start = 0x4E00, .range_length = 0x5000, .glyph_id_start = 132,
+        .unicode_list = test_full_list, .glyph_id_ofs_list = test_full_ofs, .list_length = TEST_FULL_CNT,
+        .type = LV_FONT_FMT_TXT_CMAP_SPARSE_FULL
+    },
+};
+#endif
+#if GLYPH_CACHE_EN
+static uint8_t decompressed[64 * 64];
+static const char * bench_txt = "The quick brown fox jumps over the lazy dog 0123456789";
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_font_fmt_txt(void)
+{
+#if LOOKUP_EN || GLYPH_CACHE_EN
+    lv_test_print("");
+    lv_test_print("==========================");
+    lv_test_print("Start lv_font_fmt_txt tests");
+    lv_test_print("==========================");
+#endif
+
+#if LOOKUP_EN
+    lookup_same_as_search();
+    lookup_size();
+    lookup_benchmark();
+#endif
+
+#if GLYPH_CACHE_EN
+    same_as_decompressed();
+    cache_size();
+    glyph_cache_benchmark();
+
+    lv_font_glyph_cache_set_size(LV_FONT_GLYPH_CACHE_SIZE);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LOOKUP_EN
+
+static void lookup_same_as_search(void)
+{
+    lv_test_print("The glyphs found with the lookup tables are the same as the searched ones");
+
+    uint32_t diff_cnt = 0;
+    make_font(false);
+    diff_cnt += compare_lookup(&test_font, 0x10000);
+    make_font(true);
+    diff_cnt += compare_lookup(&test_font, 0x10000);
+    lv_test_assert_int_eq(0, diff_cnt, "Same glyphs and kern pairs in every cmap format");
+
+    diff_cnt = 0;
+#if LV_FONT_MONTSERRAT_16
+    diff_cnt += compare_lookup(&lv_font_montserrat_16, 0x10000);
+#endif
+#if LV_FONT_MONTSERRAT_28_COMPRESSED
+    diff_cnt += compare_lookup(&lv_font_montserrat_28_compressed, 0x10000);
+#endif
+#if LV_FONT_UNSCII_8
+    diff_cnt += compare_lookup(&lv_font_unscii_8, 0x10000);
+#endif
+    lv_test_assert_int_eq(0, diff_cnt, "Same glyphs in the built-in fonts");
+
+    _lv_font_fmt_txt_lookup_free(&test_dsc);
+}
+
+static void lookup_size(void)
+{
+    lv_test_print("Build the lookup tables when the font is first used");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    make_font(false);
+    lv_test_assert_int_eq(0, test_dsc.lookup ? 1 : 0, "Not built until used");
+
+    lv_font_glyph_dsc_t g;
+    lv_font_get_glyph_dsc(&test_font, &g, 'A', 0);
+    lv_test_assert_int_eq(1, test_dsc.lookup && test_dsc.lookup->direct_gid ? 1 : 0, "Built on the first use");
+    lv_test_assert_int_eq(0xB0, test_dsc.lookup->direct_cnt, "Direct table until the last Latin-1 letter");
+    lv_test_assert_int_eq(128, test_dsc.lookup->hash_mask + 1, "Twice as many slots as sparse letters");
+    lv_test_assert_int_eq(test_kern_ids_8[(test_kern.pair_cnt - 1) * 2] + 1, test_dsc.lookup->kern_glyph_cnt,
+                          "Index the kern pairs until the last left glyph");
+
+    _lv_font_fmt_txt_lookup_free(&test_dsc);
+    lv_test_assert_int_eq(0, test_dsc.lookup ? 1 : 0, "Freed");
+
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "No memory leak");
+}
+
+static void lookup_benchmark(void)
+{
+    uint32_t lookup_ns;
+    uint32_t search_ns;
+
+    /*A song title and the player's symbols*/
+#if LV_FONT_MONTSERRAT_16
+    static const uint32_t title[] = {
+        'N', 'o', 'w', ' ', 'p', 'l', 'a', 'y', 'i', 'n', 'g', ':', ' ', 'T', 'h', 'e', ' ', 'B', 'e', 'a', 't', 'l', 'e', 's',
+        ' ', '-', ' ', 'H', 'e', 'l', 'p', '!', ' ', 0xB0, 0xF04B, 0xF04C, 0xF028, 0xF001, 0xF027, 0xF051, 0xF048
+    };
+    lookup_ns = bench_lookup_ns(&lv_font_montserrat_16, title, sizeof(title) / sizeof(title[0]), false);
+    search_ns = bench_lookup_ns(&lv_font_montserrat_16, title, sizeof(title) / sizeof(title[0]), true);
+    lv_test_print("montserrat_16, song title and symbols: %d ns/glyph (%d ns/glyph searching)",
+                  (int)lookup_ns, (int)search_ns);
+#endif
+
+    /*Every letter of the test font in a shuffled order*/
+    static uint32_t letters[TEST_GLYPH_CNT];
+    uint32_t letter_cnt = 0;
+    uint32_t i;
+    make_font(false);
+    for(i = 0; i < sizeof(test_cmaps) / sizeof(test_cmaps[0]); i++) {
+        uint32_t j;
+        uint32_t cnt = test_cmaps[i].list_length ? test_cmaps[i].list_length : test_cmaps[i].range_length;
+        for(j = 0; j < cnt; j++) {
+            uint32_t rcp = test_cmaps[i].unicode_list ? test_cmaps[i].unicode_list[j] : j;
+            letters[(letter_cnt * 67) % (TEST_GLYPH_CNT - 1)] = test_cmaps[i].range_start + rcp;
+            letter_cnt++;
+        }
+    }
+
+    lookup_ns = bench_lookup_ns(&test_font, letters, letter_cnt, false);
+    search_ns = bench_lookup_ns(&test_font, letters, letter_cnt, true);
+    lv_test_print("Latin, Cyrillic and CJK with %d kern pairs: %d ns/glyph (%d ns/glyph searching)",
+                  (int)test_kern.pair_cnt, (int)lookup_ns, (int)search_ns);
+
+    _lv_font_fmt_txt_lookup_free(&test_dsc);
+}
+
+/**
+ * Get the glyphs of a text with the next letters for kerning many times
+ * @param font the font to use
+ * @param letters the letters of the text
+ * @param letter_cnt number of letters
+ * @param search true: search the letters instead of using the lookup tables
+ * @return the average time of a glyph in ns
+ */
+static uint32_t bench_lookup_ns(const lv_font_t * font, const uint32_t * letters, uint32_t letter_cnt, bool search)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    lv_font_glyph_dsc_t g;
+    lv_font_get_glyph_dsc(font, &g, letters[0], 0);     /*Build the lookup tables*/
+    lv_font_fmt_txt_lookup_t * lookup = fdsc->lookup;
+    if(search) fdsc->lookup = &lookup_search;
+
+    uint64_t t = lv_test_time_ns();
+    uint32_t i;
+    for(i = 0; i < BENCH_LOOKUPS; i++) {
+        uint32_t l = i % letter_cnt;
+        lv_font_get_glyph_dsc(font, &g, letters[l], letters[l + 1 < letter_cnt ? l + 1 : 0]);
+    }
+    t = lv_test_time_ns() - t;
+
+    fdsc->lookup = lookup;
+    return t / BENCH_LOOKUPS;
+}
+
+/**
+ * Compare the glyphs found with the lookup tables with the searched ones
+ * @param font the font to check
+ * @param letter_max check the letters below this
+ * @return number of different glyphs
+ */
+static uint32_t compare_lookup(const lv_font_t * font, uint32_t letter_max)
+{
+    static uint32_t letters[256];
+    uint32_t letter_cnt = 0;
+    uint32_t diff_cnt = 0;
+    uint32_t letter;
+    for(letter = 1; letter < letter_max; letter++) {
+        diff_cnt += glyph_diff(font, letter, 'A');
+
+        lv_font_glyph_dsc_t g;
+        if(letter_cnt < 256 && lv_font_get_glyph_dsc(font, &g, letter, 0)) letters[letter_cnt++] = letter;
+    }
+
+    /*Kern every pair of the first letters*/
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < letter_cnt; i++) {
+        for(j = 0; j < letter_cnt; j++) diff_cnt += glyph_diff(font, letters[i], letters[j]);
+    }
+
+    return diff_cnt;
+}
+
+/**
+ * Get a glyph with the lookup tables and by searching it
+ * @return 1: they are different; 0: same
+ */
+static uint32_t glyph_diff(const lv_font_t * font, uint32_t letter, uint32_t letter_next)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    lv_font_glyph_dsc_t g_lookup;
+    lv_font_glyph_dsc_t g_search;
+    lv_font_glyph_dsc_t g_dummy;
+    _lv_memset_00(&g_lookup, sizeof(g_lookup));
+    _lv_memset_00(&g_search, sizeof(g_search));
+
+    /*Drop the last letter from the glyph id cache with a letter not in the font*/
+    lv_font_get_glyph_dsc(font, &g_dummy, 1, 0);
+    bool found_lookup = lv_font_get_glyph_dsc(font, &g_lookup, letter, letter_next);
+
+    lv_font_fmt_txt_lookup_t * lookup = fdsc->lookup;
+    fdsc->lookup = &lookup_search;
+    lv_font_get_glyph_dsc(font, &g_dummy, 1, 0);
+    bool found_search = lv_font_get_glyph_dsc(font, &g_search, letter, letter_next);
+    fdsc->lookup = lookup;
+
+    if(lookup == NULL || lookup->direct_gid == NULL) return 1;  /*Not built*/
+    if(found_lookup != found_search) return 1;
+    return memcmp(&g_lookup, &g_search, sizeof(lv_font_glyph_dsc_t)) ? 1 : 0;
+}
+
+/**
+ * Fill `test_font` with every cmap format and kern pairs
+ * @param kern_16 true: store the kern pairs' glyph ids as `uint16_t`
+ */
+static void make_font(bool kern_16)
+{
+    _lv_font_fmt_txt_lookup_free(&test_dsc);
+
+    uint32_t i;
+    for(i = 0; i < TEST_GLYPH_CNT; i++) {
+        _lv_memset_00(&test_glyph_dsc[i], sizeof(lv_font_fmt_txt_glyph_dsc_t));
+        test_glyph_dsc[i].adv_w = (8 + i % 24) * 16;
+        test_glyph_dsc[i].box_w = i % 13;
+        test_glyph_dsc[i].box_h = i % 11;
+    }
+
+    for(i = 0; i < TEST_TINY_CNT; i++) test_tiny_list[i] = i * 12 + i % 3;
+    for(i = 0; i < TEST_FULL_CNT; i++) {
+        test_full_list[i] = i * 331 + i % 5;
+        test_full_ofs[i] = TEST_FULL_CNT - 1 - i;
+    }
+
+    /*The pairs are ordered by the left then the right glyph id*/
+    uint32_t pair_cnt = 0;
+    uint32_t left;
+    uint32_t right;
+    for(left = 1; left < TEST_GLYPH_CNT; left += 3) {
+        for(right = 1; right < TEST_GLYPH_CNT; right += 7) {
+            test_kern_ids_8[pair_cnt * 2] = left;
+            test_kern_ids_8[pair_cnt * 2 + 1] = right;
+            test_kern_ids_16[pair_cnt * 2] = left;
+            test_kern_ids_16[pair_cnt * 2 + 1] = right;
+            test_kern_values[pair_cnt] = (int8_t)((left * right) % 9) - 4;
+            pair_cnt++;
+        }
+    }
+    test_kern.glyph_ids = kern_16 ? (const void *)test_kern_ids_16 : (const void *)test_kern_ids_8;
+    test_kern.values = test_kern_values;
+    test_kern.pair_cnt = pair_cnt;
+    test_kern.glyph_ids_size = kern_16 ? 1 : 0;
+
+    _lv_memset_00(&test_dsc, sizeof(test_dsc));
+    test_dsc.glyph_bitmap = test_format0_ofs;
+    test_dsc.glyph_dsc = test_glyph_dsc;
+    test_dsc.cmaps = test_cmaps;
+    test_dsc.kern_dsc = &test_kern;
+    test_dsc.kern_scale = 16;
+    test_dsc.cmap_num = sizeof(test_cmaps) / sizeof(test_cmaps[0]);
+    test_dsc.bpp = 4;
+    test_dsc.kern_classes = 0;
+    test_dsc.bitmap_format = LV_FONT_FMT_TXT_PLAIN;
+
+    _lv_memset_00(&test_font, sizeof(test_font));
+    test_font.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    test_font.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    test_font.line_height = 20;
+    test_font.base_line = 4;
+    test_font.dsc = &test_dsc;
+}
+
+#endif /*LOOKUP_EN*/
+
+#if GLYPH_CACHE_EN
+
+static void same_as_decompressed(void)
+{
+    lv_test_print("The cached glyphs are the same as the decompressed ones");
+
+    const lv_font_t * font = &lv_font_montserrat_28_compressed;
+    uint32_t hit_start;
+    lv_font_glyph_cache_get_hit_rate(&hit_start, NULL);
+
+    uint32_t diff_cnt = 0;
+    uint32_t letter;
+    for(letter = 0x20; letter < 0x7F; letter++) {
+        uint32_t size = glyph_size(font, letter);
+        if(size == 0) continue;
+
+        lv_font_glyph_cache_set_size(0);
+        _lv_memcpy(decompressed, lv_font_get_glyph_bitmap(font, letter), size);
+
+        /*Cache it first then find it*/
+        lv_font_glyph_cache_set_size(LV_FONT_GLYPH_CACHE_SIZE);
+        if(memcmp(decompressed, lv_font_get_glyph_bitmap(font, letter), size)) diff_cnt++;
+        if(memcmp(decompressed, lv_font_get_glyph_bitmap(font, letter), size)) diff_cnt++;
+    }
+    lv_test_assert_int_eq(0, diff_cnt, "Same bitmaps of every ASCII letter");
+
+    uint32_t hit_end;
+    lv_font_glyph_cache_get_hit_rate(&hit_end, NULL);
+    lv_test_assert_int_gt(0, hit_end - hit_start, "Glyphs found in the cache");
+}
+
+static void cache_size(void)
+{
+    lv_test_print("The glyphs fit into the cache");
+
+    const lv_font_t * font = &lv_font_montserrat_28_compressed;
+    lv_font_glyph_cache_set_size(LV_FONT_GLYPH_CACHE_SIZE);
+
+    uint32_t size_max = 0;
+    uint32_t letter;
+    for(letter = 0x20; letter < 0x7F; letter++) {
+        lv_font_get_glyph_bitmap(font, letter);
+        size_max = LV_MATH_MAX(size_max, LV_GC_ROOT(_lv_font_glyph_cache).size);
+    }
+    lv_test_assert_int_lt(LV_FONT_GLYPH_CACHE_SIZE + 1, size_max, "Not larger than LV_FONT_GLYPH_CACHE_SIZE");
+
+    lv_font_glyph_cache_invalidate();
+    lv_test_assert_int_eq(0, LV_GC_ROOT(_lv_font_glyph_cache).size, "Free all glyphs on invalidate");
+
+    lv_font_get_glyph_bitmap(font, 'A');
+    lv_font_glyph_cache_set_size(0);
+    lv_test_assert_int_eq(0, LV_GC_ROOT(_lv_font_glyph_cache).size, "Free all glyphs");
+    lv_test_assert_int_eq(0, LV_GC_ROOT(_lv_font_glyph_cache).lru_first == NULL ? 0 : 1, "No glyphs left");
+}
+
+static void glyph_cache_benchmark(void)
+{
+    uint32_t hit_start;
+    uint32_t miss_start;
+    lv_font_glyph_cache_get_hit_rate(&hit_start, &miss_start);
+
+    /*Warm up the caches before measuring*/
+    lv_font_glyph_cache_set_size(LV_FONT_GLYPH_CACHE_SIZE);
+    bench_screens_per_s(&lv_font_montserrat_28_compressed);
+    uint32_t cached = bench_screens_per_s(&lv_font_montserrat_28_compressed);
+
+    uint32_t hit_end;
+    uint32_t miss_end;
+    lv_font_glyph_cache_get_hit_rate(&hit_end, &miss_end);
+    uint32_t hit_rate = (uint64_t)(hit_end - hit_start) * 100 / (hit_end - hit_start + miss_end - miss_start);
+
+    lv_font_glyph_cache_set_size(0);
+    uint32_t decompressed_cnt = bench_screens_per_s(&lv_font_montserrat_28_compressed);
+
+#if LV_FONT_MONTSERRAT_28
+    uint32_t plain = bench_screens_per_s(&lv_font_montserrat_28);
+#else
+    uint32_t plain = 0;
+#endif
+
+    lv_test_print("%d lines of %d letters, compressed font: %d screen/s, hit rate %d percent",
+                  BENCH_LINES, (int)strlen(bench_txt), (int)cached, (int)hit_rate);
+    lv_test_print("without the glyph cache: %d screen/s, uncompressed font: %d screen/s",
+                  (int)decompressed_cnt, (int)plain);
+}
+
+/**
+ * Draw lines of text many times with `lv_draw_label` as if the display were refreshed
+ * @param font the font to use
+ * @return the screens drawn in a second
+ */
+static uint32_t bench_screens_per_s(const lv_font_t * font)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    lv_area_t vdb_area_ori = vdb->area;
+    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+    lv_area_set(&vdb->area, 0, 0, lv_disp_get_hor_res(disp) - 1, vdb->size / lv_disp_get_hor_res(disp) - 1);
+    _lv_refr_set_disp_refreshing(disp);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = font;
+
+    lv_coord_t line_h = lv_font_get_line_height(font);
+    uint64_t t = lv_test_time_ns();
+    uint32_t i;
+    for(i = 0; i < BENCH_SCREENS; i++) {
+        uint32_t l;
+        for(l = 0; l < BENCH_LINES; l++) {
+            /*The lines are clipped on small display buffers but the letters are still drawn*/
+            lv_area_t coords;
+            lv_area_set(&coords, 0, (l * line_h) % lv_area_get_height(&vdb->area), LV_COORD_MAX / 2, LV_COORD_MAX / 2);
+            lv_draw_label(&coords, &vdb->area, &dsc, bench_txt, NULL);
+        }
+    }
+    t = lv_test_time_ns() - t;
+    if(t == 0) t = 1;
+
+    _lv_refr_set_disp_refreshing(refr_ori);
+    vdb->area = vdb_area_ori;
+
+    return (uint64_t)BENCH_SCREENS * 1000000000 / t;
+}
+
+/**
+ * Get the size of a glyph's bitmap as it's decompressed
+ * @return the size in bytes or 0 if there is no bitmap
+ */
+static uint32_t glyph_size(const lv_font_t * font, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    if(lv_font_get_glyph_dsc(font, &g, letter, 0) == false) return 0;
+
+    /*3 bpp glyphs are decompressed to 4 bpp*/
+    uint32_t bpp = g.bpp == 3 ? 4 : g.bpp;
+    uint32_t size = (g.box_w * g.box_h * bpp + 7) >> 3;
+    return size <= sizeof(decompressed) ? size : 0;
+}
+#endif /*GLYPH_CACHE_EN*/
+
+#endif
@@ -0,0 +1,307 @@
+/**
+ * @file lv_test_img_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img_cache.h"
+
+#if LV_BUILD_TEST
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_IMG_SIZE   64      /*Bytes allocated by the test decoder for an image*/
+#define BENCH_OPENS     200000
+
+/*Have the images of the benchmark fit into the heap*/
+#if LV_MEM_CUSTOM
+    #define BENCH_ENTRY_MAX 1024
+#elif LV_MEM_SIZE >= 32 * 1024
+    #define BENCH_ENTRY_MAX 64
+#else
+    #define BENCH_ENTRY_MAX 0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_IMG_CACHE_DEF_SIZE
+static void hit_and_miss(void);
+static void lru(void);
+static void mem_size(void);
+static void invalidate(void);
+#if BENCH_ENTRY_MAX
+static void benchmark(void);
+#endif
+static bool open_img(uint32_t size, uint32_t id);
+static void src_name(char * buf, uint32_t size, uint32_t id);
+static lv_res_t test_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
+static lv_res_t test_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static void test_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_IMG_CACHE_DEF_SIZE
+static uint32_t open_cnt;
+static int32_t last_closed_id;
+#endif
+#if LV_IMG_CACHE_DEF_SIZE && BENCH_ENTRY_MAX
+static char bench_names[BENCH_ENTRY_MAX][16];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img_cache(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_test_print("");
+    lv_test_print("=========================");
+    lv_test_print("Start lv_img_cache tests");
+    lv_test_print("=========================");
+
+    /*Decodes the "T:<size>/<id>" files*/
+    lv_img_decoder_t * dec = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(dec, test_info);
+    lv_img_decoder_set_open_cb(dec, test_open);
+    lv_img_decoder_set_close_cb(dec, test_close);
+
+    hit_and_miss();
+    lru();
+    mem_size();
+    invalidate();
+#if BENCH_ENTRY_MAX
+    benchmark();
+#endif
+
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_cache_set_mem_size(LV_IMG_CACHE_MEM_SIZE);
+    lv_img_decoder_delete(dec);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_IMG_CACHE_DEF_SIZE
+
+static void hit_and_miss(void)
+{
+    lv_test_print("Find the opened images");
+
+    lv_img_cache_set_size(8);
+    lv_img_cache_set_mem_size(0);
+
+    lv_img_cache_stat_t stat_start;
+    lv_img_cache_get_stat(&stat_start);
+    uint32_t open_start = open_cnt;
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) open_img(TEST_IMG_SIZE, i);
+    for(i = 0; i < 4; i++) open_img(TEST_IMG_SIZE, i);
+
+    /*The same source with an other color is an other image*/
+    char src[16];
+    src_name(src, TEST_IMG_SIZE, 0);
+    _lv_img_cache_open(src, LV_COLOR_RED);
+
+    lv_img_cache_stat_t stat;
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(4, stat.hit_cnt - stat_start.hit_cnt, "Hits");
+    lv_test_assert_int_eq(5, stat.miss_cnt - stat_start.miss_cnt, "Misses");
+    lv_test_assert_int_eq(5, open_cnt - open_start, "Open only the missing images");
+    lv_test_assert_int_eq(5, stat.entry_cnt, "Images in the cache");
+}
+
+static void lru(void)
+{
+    lv_test_print("Close the least recently used image");
+
+    lv_img_cache_set_size(4);
+    lv_img_cache_set_mem_size(0);
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) open_img(TEST_IMG_SIZE, i);
+
+    /*Image 1 becomes the least recently used*/
+    open_img(TEST_IMG_SIZE, 0);
+    last_closed_id = -1;
+    open_img(TEST_IMG_SIZE, 4);
+    lv_test_assert_int_eq(1, last_closed_id, "Image 1 is closed");
+
+    lv_img_cache_stat_t stat_start;
+    lv_img_cache_get_stat(&stat_start);
+    open_img(TEST_IMG_SIZE, 0);
+    open_img(TEST_IMG_SIZE, 2);
+    open_img(TEST_IMG_SIZE, 3);
+    open_img(TEST_IMG_SIZE, 4);
+
+    lv_img_cache_stat_t stat;
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(4, stat.hit_cnt - stat_start.hit_cnt, "Others are still opened");
+    lv_test_assert_int_eq(4, stat.entry_cnt, "Not more images than the cache size");
+}
+
+static void mem_size(void)
+{
+    lv_test_print("Fit the images into the RAM limit");
+
+    lv_img_cache_set_size(16);
+    lv_img_cache_set_mem_size(0);
+
+    /*Get how much RAM an image needs with its entry*/
+    lv_img_cache_stat_t stat;
+    open_img(TEST_IMG_SIZE, 0);
+    lv_img_cache_get_stat(&stat);
+    uint32_t img_size = stat.size;
+    lv_test_assert_int_gt(TEST_IMG_SIZE, img_size, "Count the decoder's memory");
+
+    lv_img_cache_stat_t stat_start;
+    lv_img_cache_get_stat(&stat_start);
+    lv_img_cache_set_mem_size(3 * img_size + img_size / 2);
+    uint32_t i;
+    for(i = 1; i < 8; i++) open_img(TEST_IMG_SIZE, i);
+
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(3, stat.entry_cnt, "Only 3 images fit");
+    lv_test_assert_int_lt(3 * img_size + img_size / 2 + 1, stat.size, "Not larger than the limit");
+    lv_test_assert_int_eq(5, stat.evict_cnt - stat_start.evict_cnt, "Closed the others");
+
+    /*A too large image is kept alone*/
+    lv_test_assert_int_eq(1, open_img(4 * img_size, 100) ? 1 : 0, "Open a too large image");
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.entry_cnt, "Keep only the large image");
+}
+
+static void invalidate(void)
+{
+    lv_test_print("Invalidate images");
+
+    lv_img_cache_set_size(8);
+    lv_img_cache_set_mem_size(0);
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) open_img(TEST_IMG_SIZE, i);
+
+    char src[16];
+    src_name(src, TEST_IMG_SIZE, 2);
+    last_closed_id = -1;
+    lv_img_cache_invalidate_src(src);
+    lv_test_assert_int_eq(2, last_closed_id, "Image 2 is closed");
+
+    lv_img_cache_stat_t stat_start;
+    lv_img_cache_get_stat(&stat_start);
+    open_img(TEST_IMG_SIZE, 2);
+    lv_img_cache_stat_t stat;
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.miss_cnt - stat_start.miss_cnt, "Open it again");
+
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.entry_cnt, "Close all images");
+    lv_test_assert_int_eq(0, stat.size, "No memory is used");
+}
+
+#if BENCH_ENTRY_MAX
+static void benchmark(void)
+{
+    uint32_t entry_cnt;
+    for(entry_cnt = 16; entry_cnt <= BENCH_ENTRY_MAX; entry_cnt *= 4) {
+        lv_img_cache_set_size(entry_cnt);
+        lv_img_cache_set_mem_size(0);
+
+        /*Open every image once then find them again and again*/
+        uint32_t i;
+        for(i = 0; i < entry_cnt; i++) {
+            src_name(bench_names[i], 0, i);
+            _lv_img_cache_open(bench_names[i], LV_COLOR_BLACK);
+        }
+
+        lv_img_cache_stat_t stat_start;
+        lv_img_cache_get_stat(&stat_start);
+        uint64_t t = lv_test_time_ns();
+        for(i = 0; i < BENCH_OPENS; i++) {
+            _lv_img_cache_open(bench_names[(i * 7) % entry_cnt], LV_COLOR_BLACK);
+        }
+        t = lv_test_time_ns() - t;
+
+        lv_img_cache_stat_t stat;
+        lv_img_cache_get_stat(&stat);
+        lv_test_print("%d images: %d ns/open, %d hits of %d opens",
+                      (int)entry_cnt, (int)(t / BENCH_OPENS), (int)(stat.hit_cnt - stat_start.hit_cnt), BENCH_OPENS);
+    }
+}
+#endif
+
+/**
+ * Open a test image through the cache
+ * @param size bytes the decoder allocates for the image
+ * @param id to make the source unique
+ * @return true: opened
+ */
+static bool open_img(uint32_t size, uint32_t id)
+{
+    char src[16];
+    src_name(src, size, id);
+    return _lv_img_cache_open(src, LV_COLOR_BLACK) != NULL;
+}
+
+static void src_name(char * buf, uint32_t size, uint32_t id)
+{
+    lv_snprintf(buf, 16, "T:%d/%d", (int)size, (int)id);
+}
+
+static lv_res_t test_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_FILE || strncmp(src, "T:", 2)) return LV_RES_INV;
+
+    header->w = 1;
+    header->h = 1;
+    header->cf = LV_IMG_CF_TRUE_COLOR;
+    return LV_RES_OK;
+}
+
+static lv_res_t test_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    uint32_t size = strtol((const char *)dsc->src + 2, NULL, 10);
+    if(size) {
+        dsc->user_data = lv_mem_alloc(size);
+        if(dsc->user_data == NULL) return LV_RES_INV;
+        dsc->mem_size = size;
+    }
+
+    open_cnt++;
+    return LV_RES_OK;
+}
+
+static void test_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    if(dsc->user_data) lv_mem_free(dsc->user_data);
+    last_closed_id = strtol(strchr(dsc->src, '/') + 1, NULL, 10);
+}
+
+#endif /*LV_IMG_CACHE_DEF_SIZE*/
+
+#endif
@@ -0,0 +1,306 @@
+/**
+ * @file lv_test_img_decoder.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img_decoder.h"
+
+#if LV_BUILD_TEST
+#include <stdio.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_W          13      /*Odd size to have partial bytes at the end of the lines*/
+#define TEST_H          7
+#define TEST_FILE       "f:lv_test_img_decoder.bin"   /*In the working directory like the fonts*/
+#define BENCH_W         48
+#define BENCH_H         48
+#define BENCH_IMGS      500
+
+/*Have the decoded images of the benchmark fit into the heap*/
+#if LV_MEM_CUSTOM || LV_MEM_SIZE >= 64 * 1024
+    #define BENCH_EN    1
+#else
+    #define BENCH_EN    0
+#endif
+
+#define TEST_EN     (LV_IMG_CACHE_DEF_SIZE && LV_IMG_CF_INDEXED && LV_IMG_CF_ALPHA)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if TEST_EN
+static void same_as_lines(void);
+static void mem_size(void);
+#if BENCH_EN
+static void benchmark(void);
+static uint32_t bench_imgs_per_s(const void * src, bool decoded);
+#endif
+static uint32_t compare(const void * src);
+static void make_img(lv_img_dsc_t * img, lv_img_cf_t cf, lv_coord_t w, lv_coord_t h);
+#if LV_USE_FILESYSTEM
+static bool write_file(const lv_img_dsc_t * img);
+#endif
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if TEST_EN
+static uint8_t img_data[BENCH_W * BENCH_H * LV_IMG_PX_SIZE_ALPHA_BYTE];    /*Enough for any format*/
+static uint8_t line_buf[TEST_H][TEST_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img_decoder(void)
+{
+#if TEST_EN
+    lv_test_print("");
+    lv_test_print("===========================");
+    lv_test_print("Start lv_img_decoder tests");
+    lv_test_print("===========================");
+
+    same_as_lines();
+    mem_size();
+#if BENCH_EN
+    benchmark();
+#endif
+
+    lv_img_decoder_set_decoded_mem_size(LV_IMG_DECODED_MEM_SIZE);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if TEST_EN
+
+static void same_as_lines(void)
+{
+    lv_test_print("The decoded images are the same as their lines");
+
+    static const lv_img_cf_t cfs[] = {
+        LV_IMG_CF_INDEXED_1BIT, LV_IMG_CF_INDEXED_2BIT, LV_IMG_CF_INDEXED_4BIT, LV_IMG_CF_INDEXED_8BIT,
+        LV_IMG_CF_ALPHA_1BIT, LV_IMG_CF_ALPHA_2BIT, LV_IMG_CF_ALPHA_4BIT, LV_IMG_CF_ALPHA_8BIT,
+    };
+
+    lv_img_dsc_t img;
+    uint32_t diff_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < sizeof(cfs) / sizeof(cfs[0]); i++) {
+        make_img(&img, cfs[i], TEST_W, TEST_H);
+        diff_cnt += compare(&img);
+    }
+    lv_test_assert_int_eq(0, diff_cnt, "Same pixels with every indexed and alpha format");
+
+#if LV_USE_FILESYSTEM
+    diff_cnt = 0;
+    make_img(&img, LV_IMG_CF_INDEXED_4BIT, TEST_W, TEST_H);
+    if(write_file(&img)) diff_cnt += compare(TEST_FILE);
+    else diff_cnt++;
+
+    make_img(&img, LV_IMG_CF_TRUE_COLOR_ALPHA, TEST_W, TEST_H);
+    if(write_file(&img)) diff_cnt += compare(TEST_FILE);
+    else diff_cnt++;
+    remove(TEST_FILE + 2);
+    lv_test_assert_int_eq(0, diff_cnt, "Same pixels from files");
+#endif
+
+    lv_test_assert_int_eq(0, lv_img_decoder_get_decoded_mem_used(), "Free the decoded images");
+}
+
+static void mem_size(void)
+{
+    lv_test_print("Decode only the images fitting into the RAM limit");
+
+    lv_img_dsc_t img1;
+    lv_img_dsc_t img2;
+    make_img(&img1, LV_IMG_CF_ALPHA_8BIT, TEST_W, TEST_H);
+    img2 = img1;
+
+    uint32_t img_size = TEST_W * TEST_H * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    lv_img_decoder_set_decoded_mem_size(img_size + img_size / 2);
+
+    lv_img_decoder_dsc_t dsc1;
+    lv_img_decoder_dsc_t dsc2;
+    lv_img_decoder_open(&dsc1, &img1, LV_COLOR_BLACK);
+    lv_img_decoder_open(&dsc2, &img2, LV_COLOR_BLACK);
+
+    lv_test_assert_int_eq(1, dsc1.img_data ? 1 : 0, "The first image is decoded");
+    lv_test_assert_int_eq(0, dsc2.img_data ? 1 : 0, "The second one is read line by line");
+    lv_test_assert_int_eq(img_size, lv_img_decoder_get_decoded_mem_used(), "Count the decoded image");
+    lv_test_assert_int_gt(img_size, dsc1.mem_size, "Report the decoded image to the cache");
+
+    lv_img_decoder_close(&dsc1);
+    lv_img_decoder_close(&dsc2);
+    lv_test_assert_int_eq(0, lv_img_decoder_get_decoded_mem_used(), "Nothing is used after close");
+}
+
+#if BENCH_EN
+static void benchmark(void)
+{
+    static const lv_img_cf_t cfs[] = {LV_IMG_CF_INDEXED_4BIT, LV_IMG_CF_INDEXED_8BIT, LV_IMG_CF_ALPHA_4BIT,
+                                      LV_IMG_CF_INDEXED_4BIT, LV_IMG_CF_TRUE_COLOR_ALPHA
+                                     };
+    static const char * names[] = {"indexed 4 bit", "indexed 8 bit", "alpha 4 bit",
+                                   "indexed 4 bit file", "true color alpha file"
+                                  };
+
+    uint32_t i;
+    for(i = 0; i < sizeof(cfs) / sizeof(cfs[0]); i++) {
+        lv_img_dsc_t img;
+        const void * src = &img;
+        make_img(&img, cfs[i], BENCH_W, BENCH_H);
+        if(strstr(names[i], "file")) {
+#if LV_USE_FILESYSTEM
+            if(write_file(&img) == false) continue;
+            src = TEST_FILE;
+#else
+            continue;
+#endif
+        }
+
+        uint32_t decoded = bench_imgs_per_s(src, true);
+        uint32_t lines = bench_imgs_per_s(src, false);
+        lv_test_print("%s %dx%d: %d img/s (%d img/s line by line)",
+                      names[i], BENCH_W, BENCH_H, (int)decoded, (int)lines);
+    }
+#if LV_USE_FILESYSTEM
+    remove(TEST_FILE + 2);
+#endif
+}
+
+/**
+ * Draw an image many times with `lv_draw_img` through the image cache
+ * @param src the image to draw
+ * @param decoded true: decode the whole image; false: decode it line by line
+ * @return the images drawn in a second
+ */
+static uint32_t bench_imgs_per_s(const void * src, bool decoded)
+{
+    lv_img_decoder_set_decoded_mem_size(decoded ? UINT32_MAX : 0);
+    lv_img_cache_invalidate_src(NULL);
+
+    /*Draw into the display buffer as if the display were refreshed*/
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    lv_area_t vdb_area_ori = vdb->area;
+    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+    lv_area_set(&vdb->area, 0, 0, lv_disp_get_hor_res(disp) - 1, vdb->size / lv_disp_get_hor_res(disp) - 1);
+    _lv_refr_set_disp_refreshing(disp);
+
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+    lv_area_t coords;
+    lv_area_set(&coords, 0, 0, BENCH_W - 1, BENCH_H - 1);
+
+    /*Open the image first*/
+    lv_draw_img(&coords, &vdb->area, src, &dsc);
+
+    uint64_t t = lv_test_time_ns();
+    uint32_t i;
+    for(i = 0; i < BENCH_IMGS; i++) {
+        lv_draw_img(&coords, &vdb->area, src, &dsc);
+    }
+    t = lv_test_time_ns() - t;
+    if(t == 0) t = 1;
+
+    _lv_refr_set_disp_refreshing(refr_ori);
+    vdb->area = vdb_area_ori;
+    lv_img_cache_invalidate_src(NULL);
+
+    return (uint64_t)BENCH_IMGS * 1000000000 / t;
+}
+#endif
+
+/**
+ * Compare the lines of an image with its decoded pixels
+ * @param src the image to compare
+ * @return number of different lines
+ */
+static uint32_t compare(const void * src)
+{
+    lv_img_decoder_dsc_t dsc;
+    lv_color_t color = LV_COLOR_MAKE(0x30, 0x60, 0x90);
+
+    lv_img_decoder_set_decoded_mem_size(0);
+    if(lv_img_decoder_open(&dsc, src, color) != LV_RES_OK) return TEST_H;
+    lv_coord_t y;
+    for(y = 0; y < TEST_H; y++) lv_img_decoder_read_line(&dsc, 0, y, TEST_W, line_buf[y]);
+    lv_img_decoder_close(&dsc);
+
+    lv_img_decoder_set_decoded_mem_size(UINT32_MAX);
+    if(lv_img_decoder_open(&dsc, src, color) != LV_RES_OK) return TEST_H;
+
+    uint32_t diff_cnt = 0;
+    if(dsc.img_data == NULL) {
+        diff_cnt = TEST_H;
+    }
+    else {
+        /*The indexed and alpha images are converted to color + alpha byte like the lines*/
+        uint32_t line_size = TEST_W * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        if(dsc.header.cf != LV_IMG_CF_TRUE_COLOR_ALPHA) diff_cnt++;
+        for(y = 0; y < TEST_H; y++) {
+            if(memcmp(line_buf[y], dsc.img_data + y * line_size, line_size)) diff_cnt++;
+        }
+    }
+    lv_img_decoder_close(&dsc);
+
+    return diff_cnt;
+}
+
+/**
+ * Fill `img_data` with a palette and pixels
+ */
+static void make_img(lv_img_dsc_t * img, lv_img_cf_t cf, lv_coord_t w, lv_coord_t h)
+{
+    _lv_memset_00(img, sizeof(lv_img_dsc_t));
+    img->header.always_zero = 0;
+    img->header.cf = cf;
+    img->header.w = w;
+    img->header.h = h;
+    img->data_size = lv_img_buf_get_img_size(w, h, cf);
+    img->data = img_data;
+
+    uint32_t i;
+    for(i = 0; i < img->data_size; i++) img_data[i] = (uint8_t)(i * 131 + (i >> 3) * 7);
+}
+
+#if LV_USE_FILESYSTEM
+/**
+ * Save an image to `TEST_FILE` in the built-in decoder's "*.bin" format
+ */
+static bool write_file(const lv_img_dsc_t * img)
+{
+    FILE * f = fopen(TEST_FILE + 2, "wb");
+    if(f == NULL) return false;
+
+    bool ok = fwrite(&img->header, sizeof(lv_img_header_t), 1, f) == 1 &&
+              fwrite(img->data, img->data_size, 1, f) == 1;
+    fclose(f);
+    return ok;
+}
+#endif
+
+#endif /*TEST_EN*/
+
+#endif
@@ -0,0 +1,318 @@
+/**
+ * @file lv_test_indev.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_indev.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define POINT_STEP      2       /*Distance of the tested points*/
+
+/*Have the objects of the benchmark fit into the heap*/
+#if LV_MEM_CUSTOM
+    #define BENCH_EN        1
+    #define BENCH_PARENTS   20
+    #define BENCH_CHILDREN  20
+#elif LV_MEM_SIZE >= 32 * 1024
+    #define BENCH_EN        1
+    #define BENCH_PARENTS   6
+    #define BENCH_CHILDREN  8
+#else
+    #define BENCH_EN        0
+#endif
+
+#define BENCH_QUERIES   2000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void search_same_as_recursive(void);
+#if LV_INDEV_HIT_INDEX
+static void rebuild_on_change(void);
+#endif
+#if BENCH_EN
+static void bench_search(void);
+#endif
+static lv_obj_t * create_obj(lv_obj_t * parent, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h);
+static uint32_t mismatch_cnt(lv_obj_t * scr);
+static lv_obj_t * ref_search(lv_obj_t * obj, lv_point_t * point, uint32_t * visit_cnt);
+static lv_res_t left_half_signal(lv_obj_t * obj, lv_signal_t sign, void * param);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_signal_cb_t ancestor_signal;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_indev(void)
+{
+    lv_test_print("");
+    lv_test_print("====================");
+    lv_test_print("Start lv_indev tests");
+    lv_test_print("====================");
+
+    search_same_as_recursive();
+#if LV_INDEV_HIT_INDEX
+    rebuild_on_change();
+#endif
+#if BENCH_EN
+    bench_search();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void search_same_as_recursive(void)
+{
+    lv_test_print("");
+    lv_test_print("Find the same object as the recursive search:");
+    lv_test_print("---------------------------------------------");
+
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+
+    lv_obj_t * a = create_obj(scr, 5, 5, 60, 50);
+    lv_obj_t * a1 = create_obj(a, 5, 5, 20, 20);
+    lv_obj_t * a2 = create_obj(a, 15, 15, 20, 20);
+    lv_obj_t * a3 = create_obj(a, 40, 5, 15, 15);
+    lv_obj_set_hidden(a3, true);
+    lv_obj_t * a4 = create_obj(a, 40, 25, 15, 15);
+    lv_obj_add_state(a4, LV_STATE_DISABLED);
+    lv_obj_t * a5 = create_obj(a, 50, 40, 20, 20);  /*Out of its parent partly*/
+
+    lv_obj_t * b = create_obj(scr, 70, 5, 50, 50);
+    lv_obj_set_click(b, false);
+    lv_obj_t * b1 = create_obj(b, 5, 5, 40, 20);
+    ancestor_signal = lv_obj_get_signal_cb(b1);
+    lv_obj_set_signal_cb(b1, left_half_signal);
+    lv_obj_set_adv_hittest(b1, true);
+    lv_obj_t * b2 = create_obj(b, 5, 30, 40, 15);
+    lv_obj_set_ext_click_area(b2, 5, 5, 5, 5);
+
+    lv_test_assert_int_eq(0, mismatch_cnt(scr), "Same objects found");
+
+    lv_point_t p = {30, 30};
+    lv_test_assert_ptr_eq(a2, lv_indev_search_obj(scr, &p), "The newer object is found");
+
+    lv_obj_set_pos(a1, 20, 20);
+    lv_obj_move_foreground(a1);
+    lv_test_assert_ptr_eq(a1, lv_indev_search_obj(scr, &p), "The object moved to the foreground is found");
+    lv_test_assert_int_eq(0, mismatch_cnt(scr), "Same objects found after moving");
+
+    lv_obj_set_click(a2, false);
+    lv_obj_clear_state(a4, LV_STATE_DISABLED);
+    lv_obj_set_hidden(a3, false);
+    lv_test_assert_int_eq(0, mismatch_cnt(scr), "Same objects found after changing the clickability");
+
+    lv_obj_del(a5);
+    lv_obj_set_size(b, 30, 50);
+    lv_obj_set_parent(a1, b);
+    lv_test_assert_int_eq(0, mismatch_cnt(scr), "Same objects found after changing the tree");
+
+#if LV_USE_CONT
+    /*The fit sets the coordinates of the container directly*/
+    lv_obj_t * c = lv_cont_create(scr, NULL);
+    lv_obj_set_pos(c, 10, 60);
+    lv_obj_set_size(c, 20, 20);
+    lv_test_assert_int_eq(0, mismatch_cnt(scr), "Same objects found with a container");
+    lv_cont_set_fit(c, LV_FIT_PARENT);
+    lv_test_assert_int_eq(0, mismatch_cnt(scr), "Same objects found after fitting the container");
+#endif
+
+    lv_obj_del(scr);
+}
+
+#if LV_INDEV_HIT_INDEX
+static void rebuild_on_change(void)
+{
+    lv_test_print("");
+    lv_test_print("Rebuild the index only after a change:");
+    lv_test_print("--------------------------------------");
+
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_obj_t * a = create_obj(scr, 10, 10, 30, 30);
+
+    lv_indev_hit_monitor_t mon_start;
+    lv_indev_hit_monitor(&mon_start);
+
+    lv_point_t p = {20, 20};
+    uint32_t i;
+    for(i = 0; i < 10; i++) lv_indev_search_obj(scr, &p);
+
+    lv_indev_hit_monitor_t mon;
+    lv_indev_hit_monitor(&mon);
+    lv_test_assert_int_eq(10, mon.query_cnt - mon_start.query_cnt, "Searches counted");
+    lv_test_assert_int_eq(1, mon.build_cnt - mon_start.build_cnt, "Built once for the searches");
+
+    lv_obj_set_pos(a, 50, 10);
+    lv_test_assert_ptr_eq(scr, lv_indev_search_obj(scr, &p), "The moved object is not found at its old place");
+    p.x = 60;
+    lv_test_assert_ptr_eq(a, lv_indev_search_obj(scr, &p), "The moved object is found at its new place");
+
+    lv_indev_hit_monitor(&mon);
+    lv_test_assert_int_eq(2, mon.build_cnt - mon_start.build_cnt, "Rebuilt once after the change");
+
+    lv_obj_del(scr);
+}
+#endif
+
+#if BENCH_EN
+static void bench_search(void)
+{
+    lv_test_print("");
+    lv_test_print("Search the pressed object among many:");
+    lv_test_print("-------------------------------------");
+
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_coord_t w = lv_obj_get_width(scr) / BENCH_PARENTS;
+    lv_coord_t h = lv_obj_get_height(scr) / BENCH_CHILDREN;
+    uint32_t i;
+    for(i = 0; i < BENCH_PARENTS; i++) {
+        /*Columns of rows, like lists next to each other*/
+        lv_obj_t * par = create_obj(scr, i * w, 0, w, lv_obj_get_height(scr));
+        uint32_t j;
+        for(j = 0; j < BENCH_CHILDREN; j++) create_obj(par, 2, j * h + 1, w - 4, h - 2);
+    }
+
+    /*The same pseudo random points for both searches*/
+    lv_point_t * points = lv_mem_alloc(BENCH_QUERIES * sizeof(lv_point_t));
+    uint32_t seed = 1;
+    for(i = 0; i < BENCH_QUERIES; i++) {
+        seed = seed * 1103515245 + 12345;
+        points[i].x = (seed >> 16) % lv_obj_get_width(scr);
+        seed = seed * 1103515245 + 12345;
+        points[i].y = (seed >> 16) % lv_obj_get_height(scr);
+    }
+
+    uint32_t ref_visit_cnt = 0;
+    uint64_t t = lv_test_time_ns();
+    for(i = 0; i < BENCH_QUERIES; i++) ref_search(scr, &points[i], &ref_visit_cnt);
+    uint64_t t_ref = lv_test_time_ns() - t;
+
+    /*Build the index before the measurement*/
+    lv_indev_search_obj(scr, &points[0]);
+
+#if LV_INDEV_HIT_INDEX
+    lv_indev_hit_monitor_t mon_start;
+    lv_indev_hit_monitor(&mon_start);
+#endif
+
+    t = lv_test_time_ns();
+    for(i = 0; i < BENCH_QUERIES; i++) lv_indev_search_obj(scr, &points[i]);
+    uint64_t t_search = lv_test_time_ns() - t;
+
+    uint32_t mismatch = 0;
+    for(i = 0; i < BENCH_QUERIES; i++) {
+        uint32_t visit_cnt = 0;
+        if(lv_indev_search_obj(scr, &points[i]) != ref_search(scr, &points[i], &visit_cnt)) mismatch++;
+    }
+    lv_test_assert_int_eq(0, mismatch, "Same objects found");
+
+#if LV_INDEV_HIT_INDEX
+    lv_indev_hit_monitor_t mon;
+    lv_indev_hit_monitor(&mon);
+    uint32_t visit_cnt = mon.visit_cnt - mon_start.visit_cnt;
+    uint32_t query_cnt = mon.query_cnt - mon_start.query_cnt;
+    lv_test_assert_int_lt(ref_visit_cnt / BENCH_QUERIES, visit_cnt / query_cnt,
+                          "Fewer objects checked than by the recursive search");
+
+    lv_test_print("%d objects: %d checked per search with the index",
+                  1 + BENCH_PARENTS * (1 + BENCH_CHILDREN), (int)(visit_cnt / query_cnt));
+#endif
+
+    lv_test_print("Recursive: %d checked, %d ns per search; lv_indev_search_obj: %d ns per search",
+                  (int)(ref_visit_cnt / BENCH_QUERIES), (int)(t_ref / BENCH_QUERIES), (int)(t_search / BENCH_QUERIES));
+
+    lv_mem_free(points);
+    lv_obj_del(scr);
+}
+#endif
+
+static lv_obj_t * create_obj(lv_obj_t * parent, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h)
+{
+    lv_obj_t * obj = lv_obj_create(parent, NULL);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    return obj;
+}
+
+/**
+ * Count the points, also around the screen, where `lv_indev_search_obj` finds an other object
+ * than the recursive search
+ */
+static uint32_t mismatch_cnt(lv_obj_t * scr)
+{
+    uint32_t cnt = 0;
+    lv_point_t p;
+    for(p.y = scr->coords.y1 - 4; p.y <= scr->coords.y2 + 4; p.y += POINT_STEP) {
+        for(p.x = scr->coords.x1 - 4; p.x <= scr->coords.x2 + 4; p.x += POINT_STEP) {
+            uint32_t visit_cnt = 0;
+            if(lv_indev_search_obj(scr, &p) != ref_search(scr, &p, &visit_cnt)) cnt++;
+        }
+    }
+
+    return cnt;
+}
+
+/**
+ * The topmost clickable object on a point: children first from the newest, then the object itself
+ */
+static lv_obj_t * ref_search(lv_obj_t * obj, lv_point_t * point, uint32_t * visit_cnt)
+{
+    (*visit_cnt)++;
+    if(lv_obj_hittest(obj, point) == false) return NULL;
+
+    lv_obj_t * child;
+    _LV_LL_READ(obj->child_ll, child) {
+        lv_obj_t * found = ref_search(child, point, visit_cnt);
+        if(found) return found;
+    }
+
+    if(lv_obj_get_click(obj) == false) return NULL;
+    if(lv_obj_get_state(obj, LV_OBJ_PART_MAIN) & LV_STATE_DISABLED) return NULL;
+
+    lv_obj_t * par = obj;
+    while(par) {
+        if(lv_obj_get_hidden(par)) return NULL;
+        par = lv_obj_get_parent(par);
+    }
+
+    return obj;
+}
+
+/**
+ * Let the object be clicked only on its left half
+ */
+static lv_res_t left_half_signal(lv_obj_t * obj, lv_signal_t sign, void * param)
+{
+    if(sign == LV_SIGNAL_HIT_TEST) {
+        lv_hit_test_info_t * info = param;
+        info->result = info->point->x < obj->coords.x1 + lv_obj_get_width(obj) / 2;
+        return LV_RES_OK;
+    }
+
+    return ancestor_signal(obj, sign, param);
+}
+
+#endif /*LV_BUILD_TEST*/
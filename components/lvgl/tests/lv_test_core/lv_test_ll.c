@@ -0,0 +1,221 @@
+/**
+ * @file lv_test_ll.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_ll.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define NODE_CNT        40      /*More than a slab to have a few of them*/
+
+/*Have the objects of the benchmark fit into the heap*/
+#if LV_MEM_CUSTOM
+    #define BENCH_EN        1
+    #define BENCH_PARENTS   20
+    #define BENCH_CHILDREN  50
+    #define BENCH_ROUNDS    50
+#elif LV_MEM_SIZE >= 32 * 1024
+    #define BENCH_EN        1
+    #define BENCH_PARENTS   5
+    #define BENCH_CHILDREN  10
+    #define BENCH_ROUNDS    1000
+#else
+    #define BENCH_EN        0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    intptr_t v;     /*Pointer sized to need no padding*/
+} node_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void pooled_lists(void);
+#if BENCH_EN
+static void bench_obj_tree(void);
+static uint32_t tree_walk(lv_obj_t * obj);
+#endif
+static void list_fill(lv_ll_t * ll, int32_t start, uint32_t cnt);
+static bool list_check(lv_ll_t * ll, int32_t start, uint32_t cnt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_ll(void)
+{
+    lv_test_print("");
+    lv_test_print("=================");
+    lv_test_print("Start lv_ll tests");
+    lv_test_print("=================");
+
+    pooled_lists();
+#if BENCH_EN
+    bench_obj_tree();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void pooled_lists(void)
+{
+    lv_test_print("");
+    lv_test_print("Share a pool between lists:");
+    lv_test_print("---------------------------");
+
+    /*Join the free cells to compare the free size at the end*/
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    lv_ll_pool_t pool;
+    _lv_ll_pool_init(&pool, sizeof(node_t));
+
+    lv_ll_t ll1;
+    lv_ll_t ll2;
+    _lv_ll_init_pooled(&ll1, &pool);
+    _lv_ll_init_pooled(&ll2, &pool);
+
+    list_fill(&ll1, 0, NODE_CNT);
+    lv_test_assert_true(list_check(&ll1, 0, NODE_CNT), "Nodes added to the tail in order");
+
+#if LV_LL_POOL
+    node_t * n1 = _lv_ll_get_head(&ll1);
+    node_t * n2 = _lv_ll_get_next(&ll1, n1);
+    lv_test_assert_int_eq(sizeof(node_t) + 2 * sizeof(void *), (uint8_t *)n2 - (uint8_t *)n1,
+                          "The new nodes are next to each other");
+#endif
+
+    /*Move every second node to the other list*/
+    uint32_t i;
+    node_t * n = _lv_ll_get_head(&ll1);
+    for(i = 0; n; i++) {
+        node_t * n_next = _lv_ll_get_next(&ll1, n);
+        if(i % 2) _lv_ll_chg_list(&ll1, &ll2, n, false);
+        n = n_next;
+    }
+    lv_test_assert_int_eq(NODE_CNT / 2, _lv_ll_get_len(&ll1), "Half of the nodes remain");
+    lv_test_assert_int_eq(NODE_CNT / 2, _lv_ll_get_len(&ll2), "Half of the nodes are moved");
+
+    /*Delete the remaining ones from the first list and add new ones in their place*/
+    while(!_lv_ll_is_empty(&ll1)) {
+        n = _lv_ll_get_head(&ll1);
+        _lv_ll_remove(&ll1, n);
+        _lv_ll_free_node(&ll1, n);
+    }
+    list_fill(&ll1, 100, NODE_CNT);
+    lv_test_assert_true(list_check(&ll1, 100, NODE_CNT), "The freed nodes are reused");
+
+    n = _lv_ll_get_head(&ll2);
+    lv_test_assert_int_eq(1, n->v, "The moved nodes are kept");
+    n = _lv_ll_ins_prev(&ll2, n);
+    n->v = -1;
+    lv_test_assert_int_eq(-1, ((node_t *)_lv_ll_get_head(&ll2))->v, "Inserted before the head");
+
+    _lv_ll_clear(&ll1);
+    _lv_ll_clear(&ll2);
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "The empty slabs are freed");
+}
+
+#if BENCH_EN
+static void bench_obj_tree(void)
+{
+    lv_test_print("");
+    lv_test_print("Create, walk and delete an object tree:");
+    lv_test_print("---------------------------------------");
+
+    uint64_t t_create = 0;
+    uint64_t t_walk = 0;
+    uint64_t t_del = 0;
+    uint32_t cnt = 0;
+    uint32_t r;
+    for(r = 0; r < BENCH_ROUNDS; r++) {
+        uint64_t t = lv_test_time_ns();
+        lv_obj_t * root = lv_obj_create(lv_scr_act(), NULL);
+        uint32_t i;
+        for(i = 0; i < BENCH_PARENTS; i++) {
+            lv_obj_t * par = lv_obj_create(root, NULL);
+            uint32_t j;
+            for(j = 0; j < BENCH_CHILDREN; j++) lv_obj_create(par, NULL);
+        }
+        t_create += lv_test_time_ns() - t;
+
+        t = lv_test_time_ns();
+        for(i = 0; i < 100; i++) cnt = tree_walk(root);
+        t_walk += lv_test_time_ns() - t;
+
+        t = lv_test_time_ns();
+        lv_obj_del(root);
+        t_del += lv_test_time_ns() - t;
+    }
+
+    lv_test_assert_int_eq(1 + BENCH_PARENTS * (1 + BENCH_CHILDREN), cnt, "All objects are walked");
+
+    lv_test_print("%d objects: create %d ns, walk %d ns, delete %d ns per object", cnt,
+                  (int)(t_create / BENCH_ROUNDS / cnt), (int)(t_walk / BENCH_ROUNDS / 100 / cnt),
+                  (int)(t_del / BENCH_ROUNDS / cnt));
+}
+
+/**
+ * Count the objects of a tree reading a few fields of each like the refresher
+ */
+static uint32_t tree_walk(lv_obj_t * obj)
+{
+    uint32_t cnt = 1;
+    lv_obj_t * child;
+    _LV_LL_READ(obj->child_ll, child) {
+        if(child->hidden == 0 && child->coords.x1 <= child->coords.x2) cnt += tree_walk(child);
+    }
+
+    return cnt;
+}
+#endif
+
+static void list_fill(lv_ll_t * ll, int32_t start, uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        node_t * n = _lv_ll_ins_tail(ll);
+        if(n) n->v = start + i;
+    }
+}
+
+static bool list_check(lv_ll_t * ll, int32_t start, uint32_t cnt)
+{
+    uint32_t i = 0;
+    node_t * n;
+    _LV_LL_READ(*ll, n) {
+        if(n->v != start + (intptr_t)i) return false;
+        i++;
+    }
+
+    return i == cnt;
+}
+
+#endif /*LV_BUILD_TEST*/
@@ -0,0 +1,361 @@
+/**
+ * @file lv_test_mem.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_mem.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CHURN_PTRS      24
+#define CHURN_STEPS     3000
+#define CHURN_SIZE_MAX  96
+#define HOLE_CNT        16
+#define BENCH_LIVE      128     /*Allocations kept during the benchmark*/
+#define BENCH_ALLOCS    200000
+#define BENCH_BG_OBJS   48      /*Objects kept during the widget churn*/
+#define BENCH_BTNS      12      /*Buttons with a label created and deleted in a cycle*/
+#define BENCH_CYCLES    2000
+
+#define BUF_OBJS        4       /*Objects drawn to test the temporary buffers*/
+
+/*Only the built-in allocators are tested*/
+#define TEST_EN     (LV_MEM_CUSTOM == 0)
+
+/*The temporary buffers are kept between refreshes*/
+#define BUF_TEST_EN (LV_MEM_BUF_KEEP_SIZE > 0)
+
+/*Have the objects of the benchmark fit into the heap*/
+#if TEST_EN && LV_MEM_SIZE >= 32 * 1024 && LV_USE_BTN && LV_USE_LABEL
+    #define BENCH_EN    1
+#else
+    #define BENCH_EN    0
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    #define ALLOCATOR_NAME  "TLSF"
+#else
+    #define ALLOCATOR_NAME  "first fit"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if TEST_EN
+static void churn(void);
+static void small_free(void);
+#if BENCH_EN
+static void bench_alloc(void);
+static void bench_widgets(void);
+#endif
+static void fill(uint8_t * p, uint32_t size, uint32_t id);
+static bool check(const uint8_t * p, uint32_t size, uint32_t id);
+static uint32_t rnd(void);
+#endif
+#if BUF_TEST_EN
+static void buf_keep(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if TEST_EN
+static uint32_t rnd_seed;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_mem(void)
+{
+#if TEST_EN || BUF_TEST_EN
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_mem tests");
+    lv_test_print("===================");
+#endif
+
+#if TEST_EN
+    churn();
+    small_free();
+#if BENCH_EN
+    bench_alloc();
+    bench_widgets();
+#endif
+#endif
+
+#if BUF_TEST_EN
+    buf_keep();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if TEST_EN
+
+static void churn(void)
+{
+    lv_test_print("Allocate, reallocate and free randomly (" ALLOCATOR_NAME ")");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor_t mon;
+    lv_mem_defrag();
+    lv_mem_monitor(&mon_start);
+
+    uint8_t * p[CHURN_PTRS];
+    uint32_t size[CHURN_PTRS];
+    _lv_memset_00(p, sizeof(p));
+
+    rnd_seed = 1;
+    uint32_t err_cnt = 0;
+    uint32_t step;
+    uint32_t i;
+    for(step = 0; step < CHURN_STEPS; step++) {
+        i = rnd() % CHURN_PTRS;
+        if(p[i] == NULL) {
+            size[i] = 1 + rnd() % CHURN_SIZE_MAX;
+            p[i] = lv_mem_alloc(size[i]);
+            if(p[i]) fill(p[i], size[i], i);
+        }
+        else if(rnd() & 1) {
+            if(!check(p[i], size[i], i)) err_cnt++;
+            lv_mem_free(p[i]);
+            p[i] = NULL;
+        }
+        else {
+            uint32_t new_size = 1 + rnd() % CHURN_SIZE_MAX;
+            uint8_t * new_p = lv_mem_realloc(p[i], new_size);
+            if(new_p) {
+                /*The start of the data is kept*/
+                if(!check(new_p, LV_MATH_MIN(size[i], new_size), i)) err_cnt++;
+                p[i] = new_p;
+                size[i] = new_size;
+                fill(p[i], size[i], i);
+            }
+        }
+
+        if(lv_mem_test() != LV_RES_OK) err_cnt++;
+    }
+
+    for(i = 0; i < CHURN_PTRS; i++) {
+        if(p[i] == NULL) continue;
+        if(!check(p[i], size[i], i)) err_cnt++;
+        lv_mem_free(p[i]);
+    }
+
+    lv_test_assert_int_eq(0, err_cnt, "The data is kept and the heap is valid");
+
+    lv_mem_defrag();
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.free_size, mon.free_size, "Everything is freed");
+    lv_test_assert_int_eq(mon_start.free_cnt, mon.free_cnt, "The free cells are joined");
+}
+
+static void small_free(void)
+{
+    lv_test_print("Count the small free cells");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor_t mon;
+    lv_mem_defrag();
+    lv_mem_monitor(&mon_start);
+
+    void * p[2 * HOLE_CNT];
+    uint32_t i;
+    for(i = 0; i < 2 * HOLE_CNT; i++) p[i] = lv_mem_alloc(32);
+
+    /*Leave holes between the used cells*/
+    for(i = 0; i < 2 * HOLE_CNT; i += 2) lv_mem_free(p[i]);
+
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_gt(mon_start.free_small_cnt, mon.free_small_cnt, "The holes are small free cells");
+    lv_test_assert_int_lt(mon.free_size + 1, mon.free_small_size, "Not more than the free memory");
+    lv_test_assert_int_lt(mon.free_cnt + 1, mon.free_small_cnt, "Not more than the free cells");
+
+    for(i = 1; i < 2 * HOLE_CNT; i += 2) lv_mem_free(p[i]);
+
+    lv_mem_defrag();
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.free_size, mon.free_size, "Everything is freed");
+}
+
+#if BENCH_EN
+static void bench_alloc(void)
+{
+    void * live[BENCH_LIVE];
+    uint32_t i;
+    for(i = 0; i < BENCH_LIVE; i++) live[i] = lv_mem_alloc(8 + (i % 4) * 8);
+
+    /*Free every 4th to have holes among the living cells*/
+    for(i = 0; i < BENCH_LIVE; i += 4) {
+        lv_mem_free(live[i]);
+        live[i] = NULL;
+    }
+
+    rnd_seed = 1;
+    uint64_t t = lv_test_time_ns();
+    for(i = 0; i < BENCH_ALLOCS; i++) {
+        void * p = lv_mem_alloc(16 + rnd() % 256);
+        lv_mem_free(p);
+    }
+    t = lv_test_time_ns() - t;
+
+    for(i = 0; i < BENCH_LIVE; i++) lv_mem_free(live[i]);
+
+    lv_test_print("Allocate and free with %d cells in use (" ALLOCATOR_NAME "): %d ns",
+                  BENCH_LIVE - BENCH_LIVE / 4, (int)(t / BENCH_ALLOCS));
+}
+
+static void bench_widgets(void)
+{
+    /*Let the first widgets allocate what's kept afterwards (e.g. buffers)*/
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_label_create(lv_btn_create(scr, NULL), NULL);
+    lv_obj_del(scr);
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor_t mon;
+    lv_mem_defrag();
+    lv_mem_monitor(&mon_start);
+
+    scr = lv_obj_create(NULL, NULL);
+    uint32_t i;
+    for(i = 0; i < BENCH_BG_OBJS; i++) lv_obj_create(scr, NULL);
+
+    lv_obj_t * cont = lv_obj_create(scr, NULL);
+    uint32_t c;
+    uint64_t t = lv_test_time_ns();
+    for(c = 0; c < BENCH_CYCLES; c++) {
+        lv_obj_t * btns[BENCH_BTNS];
+        for(i = 0; i < BENCH_BTNS; i++) {
+            btns[i] = lv_btn_create(cont, NULL);
+            lv_label_create(btns[i], NULL);
+        }
+
+        /*Delete every other first to free cells between the used ones*/
+        for(i = 0; i < BENCH_BTNS; i += 2) lv_obj_del(btns[i]);
+        lv_obj_clean(cont);
+    }
+    t = lv_test_time_ns() - t;
+
+    lv_mem_monitor(&mon);
+    lv_obj_del(scr);
+
+    lv_test_print("Create and delete %d buttons with labels among %d objects (%s): %d us",
+                  BENCH_BTNS, BENCH_BG_OBJS, ALLOCATOR_NAME, (int)(t / BENCH_CYCLES / 1000));
+    lv_test_print("  Free cells: %d, small: %d, biggest: %d bytes, fragmentation: %d percent",
+                  (int)mon.free_cnt, (int)mon.free_small_cnt, (int)mon.free_biggest_size, (int)mon.frag_pct);
+
+    lv_mem_defrag();
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.free_size, mon.free_size, "The widgets are freed");
+}
+#endif
+
+/**
+ * Fill a memory with a pattern of an allocation
+ */
+static void fill(uint8_t * p, uint32_t size, uint32_t id)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) p[i] = (uint8_t)(id * 31 + i);
+}
+
+/**
+ * Check the pattern of an allocation
+ * @return true: the pattern is not changed
+ */
+static bool check(const uint8_t * p, uint32_t size, uint32_t id)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        if(p[i] != (uint8_t)(id * 31 + i)) return false;
+    }
+    return true;
+}
+
+/**
+ * A simple reproducible pseudo random number
+ */
+static uint32_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return rnd_seed >> 8;
+}
+
+#endif /*TEST_EN*/
+
+#if BUF_TEST_EN
+static void buf_keep(void)
+{
+    lv_test_print("Keep the temporary buffers for the next refresh");
+
+    lv_obj_t * scr_ori = lv_scr_act();
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_scr_load(scr);
+
+    /*Rounded corners and borders need mask buffers*/
+    uint32_t i;
+    for(i = 0; i < BUF_OBJS; i++) {
+        lv_obj_t * obj = lv_obj_create(scr, NULL);
+        lv_obj_set_pos(obj, i * 10, i * 10);
+        lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 10);
+        lv_obj_set_style_local_border_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 3);
+#if LV_USE_LABEL
+        lv_label_create(obj, NULL);
+#endif
+    }
+
+    lv_mem_buf_stat_t stat1;
+    lv_mem_buf_stat_t stat2;
+    lv_obj_invalidate(scr);
+    lv_refr_now(NULL);
+    lv_mem_buf_get_stat(&stat1);
+    lv_obj_invalidate(scr);
+    lv_refr_now(NULL);
+    lv_mem_buf_get_stat(&stat2);
+
+    lv_test_print("%d buffers in a refresh, %d misses in the first, %d in the second, %d bytes kept",
+                  (int)stat2.get_cnt, (int)stat1.miss_cnt, (int)stat2.miss_cnt, (int)stat2.kept_size);
+
+    lv_test_assert_int_gt(0, stat2.get_cnt, "Buffers are used");
+    lv_test_assert_int_eq(0, stat2.miss_cnt, "No buffer is allocated in the second refresh");
+    lv_test_assert_int_eq(0, stat2.realloc_cnt, "No buffer is reallocated in the second refresh");
+    lv_test_assert_int_lt(LV_MEM_BUF_KEEP_SIZE + 1, stat2.kept_size, "Not more than LV_MEM_BUF_KEEP_SIZE is kept");
+
+    /*Smaller refreshes shouldn't keep the buffers of the large one forever*/
+    lv_obj_t * small = lv_obj_get_child_back(scr, NULL);
+    for(i = 0; i < 8; i++) {
+        lv_obj_invalidate(small);
+        lv_refr_now(NULL);
+    }
+    lv_mem_buf_get_stat(&stat1);
+
+    lv_test_print("%d bytes kept after small refreshes", (int)stat1.kept_size);
+    lv_test_assert_int_lt(stat2.kept_size, stat1.kept_size, "Less is kept after small refreshes");
+
+    lv_scr_load(scr_ori);
+    lv_obj_del(scr);
+}
+#endif
+
+#endif
@@ -11,10 +11,12 @@
 #include "lv_test_obj.h"
 
 #if LV_BUILD_TEST
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
+#define DSC_BENCH_ROUNDS    2000
 
 /**********************
  *      TYPEDEFS
@@ -24,6 +26,8 @@
  *  STATIC PROTOTYPES
  **********************/
 static void create_delete_change_parent(void);
+static void draw_dsc_cache(void);
+static void check_draw_dsc(lv_obj_t * obj, const char * msg);
 
 /**********************
  *  STATIC VARIABLES
@@ -45,6 +49,7 @@ void lv_test_obj(void)
     lv_test_print("==================");
 
     create_delete_change_parent();
+    draw_dsc_cache();
 }
 
 /**********************
@@ -85,4 +90,130 @@ static void create_delete_change_parent(void)
     lv_obj_del(obj_parent);
     lv_test_assert_int_eq(0, lv_obj_count_children(lv_scr_act()), "Screen's children count after delete");
 }
+
+static void draw_dsc_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("Initialize draw descriptors from the styles:");
+    lv_test_print("--------------------------------------------");
+
+    lv_obj_t * parent = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_t * obj = lv_obj_create(parent, NULL);
+    lv_obj_t * other = lv_obj_create(lv_scr_act(), NULL);
+
+    lv_obj_set_style_local_bg_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_RED);
+    lv_obj_set_style_local_border_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 3);
+    lv_obj_set_style_local_line_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 2);
+    lv_obj_set_style_local_text_sel_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLUE);
+    lv_obj_set_style_local_image_recolor_opa(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_50);
+    lv_obj_set_style_local_bg_color(obj, LV_OBJ_PART_MAIN, LV_STATE_PRESSED, LV_COLOR_GREEN);
+    lv_obj_set_style_local_text_sel_color(obj, LV_OBJ_PART_MAIN, LV_STATE_PRESSED, LV_COLOR_YELLOW);
+    check_draw_dsc(obj, "Local styles");
+
+    lv_obj_set_style_local_bg_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_NAVY);
+    check_draw_dsc(obj, "Changed local style");
+
+    lv_obj_set_style_local_text_color(parent, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_MAROON);
+    lv_obj_set_style_local_text_letter_space(parent, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 5);
+    check_draw_dsc(obj, "Inherited from the parent");
+
+    lv_obj_set_state(obj, LV_STATE_PRESSED);
+    check_draw_dsc(obj, "Pressed state");
+
+    lv_obj_set_state(obj, LV_STATE_DEFAULT);
+    check_draw_dsc(obj, "Default state again");
+
+    lv_obj_set_style_local_text_color(other, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_OLIVE);
+    lv_obj_set_parent(obj, other);
+    check_draw_dsc(obj, "Inherited from the new parent");
+
+    lv_obj_remove_style_local_prop(obj, LV_OBJ_PART_MAIN, LV_STYLE_BORDER_WIDTH);
+    check_draw_dsc(obj, "Removed local property");
+
+    lv_obj_set_style_local_opa_scale(other, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_50);
+    check_draw_dsc(obj, "Opacity scale of the parent");
+
+    lv_test_print("Keep the parts disabled by the caller");
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_opa = LV_OPA_TRANSP;
+    rect_dsc.shadow_opa = LV_OPA_TRANSP;
+    rect_dsc.border_post = 1;
+    lv_obj_init_draw_rect_dsc(obj, LV_OBJ_PART_MAIN, &rect_dsc);
+    lv_test_assert_int_eq(LV_OPA_TRANSP, rect_dsc.bg_opa, "Disabled background");
+    lv_test_assert_int_eq(LV_OPA_TRANSP, rect_dsc.shadow_opa, "Disabled shadow");
+    lv_test_assert_int_eq(1, rect_dsc.border_post, "Border drawn later");
+
+    lv_test_print("Measure the time of initializing a rectangle and a label descriptor");
+    uint32_t r;
+    uint64_t t_cached = lv_test_time_ns();
+    for(r = 0; r < DSC_BENCH_ROUNDS; r++) {
+        lv_draw_rect_dsc_init(&rect_dsc);
+        lv_obj_init_draw_rect_dsc(obj, LV_OBJ_PART_MAIN, &rect_dsc);
+        lv_draw_label_dsc_t label_dsc;
+        lv_draw_label_dsc_init(&label_dsc);
+        lv_obj_init_draw_label_dsc(obj, LV_OBJ_PART_MAIN, &label_dsc);
+    }
+    t_cached = lv_test_time_ns() - t_cached;
+
+    _lv_obj_disable_style_caching(obj, true);
+    uint64_t t_styles = lv_test_time_ns();
+    for(r = 0; r < DSC_BENCH_ROUNDS; r++) {
+        lv_draw_rect_dsc_init(&rect_dsc);
+        lv_obj_init_draw_rect_dsc(obj, LV_OBJ_PART_MAIN, &rect_dsc);
+        lv_draw_label_dsc_t label_dsc;
+        lv_draw_label_dsc_init(&label_dsc);
+        lv_obj_init_draw_label_dsc(obj, LV_OBJ_PART_MAIN, &label_dsc);
+    }
+    t_styles = lv_test_time_ns() - t_styles;
+    _lv_obj_disable_style_caching(obj, false);
+
+    lv_test_print("%d ns with the caches, %d ns reading the styles",
+                  (int)(t_cached / DSC_BENCH_ROUNDS), (int)(t_styles / DSC_BENCH_ROUNDS));
+
+    lv_obj_del(parent);
+    lv_obj_del(other);
+}
+
+/**
+ * Compare the draw descriptors of an object with the ones initialized while ignoring the caches
+ */
+static void check_draw_dsc(lv_obj_t * obj, const char * msg)
+{
+    lv_draw_rect_dsc_t rect[2];
+    lv_draw_label_dsc_t label[2];
+    lv_draw_label_dsc_t label_sel[2];
+    lv_draw_img_dsc_t img[2];
+    lv_draw_line_dsc_t line[2];
+
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        /*Initialize twice with caches to use the resolved descriptors too*/
+        _lv_obj_disable_style_caching(obj, i == 1);
+        uint32_t k;
+        for(k = 0; k < 2 - i; k++) {
+            lv_draw_rect_dsc_init(&rect[i]);
+            lv_obj_init_draw_rect_dsc(obj, LV_OBJ_PART_MAIN, &rect[i]);
+            lv_draw_label_dsc_init(&label[i]);
+            lv_obj_init_draw_label_dsc(obj, LV_OBJ_PART_MAIN, &label[i]);
+            lv_draw_label_dsc_init(&label_sel[i]);
+            label_sel[i].sel_start = 1;
+            label_sel[i].sel_end = 3;
+            lv_obj_init_draw_label_dsc(obj, LV_OBJ_PART_MAIN, &label_sel[i]);
+            lv_draw_img_dsc_init(&img[i]);
+            lv_obj_init_draw_img_dsc(obj, LV_OBJ_PART_MAIN, &img[i]);
+            lv_draw_line_dsc_init(&line[i]);
+            lv_obj_init_draw_line_dsc(obj, LV_OBJ_PART_MAIN, &line[i]);
+        }
+    }
+    _lv_obj_disable_style_caching(obj, false);
+
+    lv_test_print(msg);
+    lv_test_assert_int_eq(0, memcmp(&rect[0], &rect[1], sizeof(rect[0])), "Same rectangle descriptor");
+    lv_test_assert_int_eq(0, memcmp(&label[0], &label[1], sizeof(label[0])), "Same label descriptor");
+    lv_test_assert_int_eq(0, memcmp(&label_sel[0], &label_sel[1], sizeof(label_sel[0])),
+                          "Same label descriptor with selection");
+    lv_test_assert_int_eq(0, memcmp(&img[0], &img[1], sizeof(img[0])), "Same image descriptor");
+    lv_test_assert_int_eq(0, memcmp(&line[0], &line[1], sizeof(line[0])), "Same line descriptor");
+}
 #endif
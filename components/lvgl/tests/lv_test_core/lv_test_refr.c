@@ -0,0 +1,580 @@
+/**
+ * @file lv_test_refr.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_refr.h"
+
+#if LV_BUILD_TEST
+#include <stdlib.h>
+#include <string.h>
+#if LV_USE_REFR_WORKER || LV_USE_REFR_ADAPTIVE_BAND
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void many_small_areas(void);
+static void adjacent_areas(void);
+static void clear_areas(void);
+#if LV_USE_REFR_OCCLUSION
+static void occlusion(void);
+#endif
+#if LV_USE_REFR_WORKER
+static void worker(void);
+static void * worker_thread(void * p);
+static void worker_start_cb(lv_disp_drv_t * disp_drv, void (*job)(void *), void * job_p);
+static void worker_wait_cb(lv_disp_drv_t * disp_drv);
+static void worker_lock_cb(lv_disp_drv_t * disp_drv, bool lock);
+static uint32_t redraw_time_us(lv_obj_t * scr, uint32_t frame_cnt, clockid_t clock);
+#endif
+#if LV_USE_REFR_ADAPTIVE_BAND
+static void adaptive_band(void);
+static void add_shadows(lv_obj_t * scr);
+static uint32_t adaptive_redraw_us(lv_obj_t * scr, uint32_t frame_cnt);
+static void * dma_thread(void * p);
+static void dma_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void dma_copy(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void yield_wait_cb(lv_disp_drv_t * disp_drv);
+#endif
+#if LV_USE_REFR_WORKER || LV_USE_REFR_ADAPTIVE_BAND
+static uint64_t time_ns(clockid_t clock);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_REFR_WORKER
+static pthread_mutex_t job_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_cond = PTHREAD_COND_INITIALIZER;
+static pthread_mutex_t lock_mutex;
+static void (*job_cb)(void *);
+static void * job_param;
+static bool job_done = true;    /*No job is pending*/
+static uint32_t job_cnt;
+static uint64_t job_cpu_ns;         /*CPU time of the worker thread in the jobs*/
+#endif
+#if LV_USE_REFR_ADAPTIVE_BAND
+static pthread_mutex_t dma_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t dma_cond = PTHREAD_COND_INITIALIZER;
+static lv_disp_drv_t * dma_drv;     /*Set while a flush is pending*/
+static lv_area_t dma_area;
+static lv_color_t * dma_color_p;
+static bool dma_exit;
+static uint32_t dma_ns_per_px;      /*0: flush in `flush_cb`*/
+static lv_color_t * dma_fb;         /*What the display shows*/
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_refr(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_refr tests");
+    lv_test_print("===================");
+
+    many_small_areas();
+    adjacent_areas();
+    clear_areas();
+#if LV_USE_REFR_OCCLUSION
+    occlusion();
+#endif
+#if LV_USE_REFR_WORKER
+    worker();
+#endif
+#if LV_USE_REFR_ADAPTIVE_BAND
+    adaptive_band();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void many_small_areas(void)
+{
+    lv_test_print("Invalidate more small areas than LV_INV_BUF_SIZE");
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_coord_t hres = lv_disp_get_hor_res(disp);
+    lv_coord_t vres = lv_disp_get_ver_res(disp);
+    uint32_t i;
+
+    /*Like a progress bar or a marquee: many small updates in a strip*/
+    lv_refr_now(disp);
+    for(i = 0; i < LV_INV_BUF_SIZE * 2; i++) {
+        lv_area_t a;
+        a.x1 = (i * 3) % (hres - 1);
+        a.y1 = 10;
+        a.x2 = a.x1 + 1;
+        a.y2 = a.y1 + 1;
+        _lv_inv_area(disp, &a);
+    }
+    lv_refr_now(disp);
+
+#if LV_USE_INV_TILES
+    lv_test_assert_int_lt(hres * disp->inv_tile_h + 1, lv_disp_get_refr_px_num(disp), "Only a tile row is redrawn");
+#else
+    lv_test_assert_int_eq(hres * vres, lv_disp_get_refr_px_num(disp), "The whole screen is redrawn");
+#endif
+
+    /*Scattered all around the screen*/
+    for(i = 0; i < LV_INV_BUF_SIZE * 2; i++) {
+        lv_area_t a;
+        a.x1 = (i * 37) % (hres - 1);
+        a.y1 = (i * 53) % (vres - 1);
+        a.x2 = a.x1 + 1;
+        a.y2 = a.y1 + 1;
+        _lv_inv_area(disp, &a);
+    }
+    lv_refr_now(disp);
+
+#if LV_USE_INV_TILES
+    lv_test_assert_int_lt(hres * vres, lv_disp_get_refr_px_num(disp), "Not the whole screen is redrawn");
+#else
+    lv_test_assert_int_eq(hres * vres, lv_disp_get_refr_px_num(disp), "The whole screen is redrawn");
+#endif
+}
+
+static void adjacent_areas(void)
+{
+    lv_test_print("Invalidate two touching areas");
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_refr_now(disp);
+
+    lv_area_t a = {0, 0, 31, 15};
+    lv_area_t b = {0, 16, 31, 31};
+    _lv_inv_area(disp, &a);
+    _lv_inv_area(disp, &b);
+    lv_refr_now(disp);
+
+    lv_test_assert_int_eq(32 * 32, lv_disp_get_refr_px_num(disp), "Exactly the two areas are redrawn");
+}
+
+static void clear_areas(void)
+{
+    lv_test_print("Clear the invalidated areas");
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_refr_now(disp);
+
+    lv_area_t a = {0, 0, 31, 31};
+    _lv_inv_area(disp, &a);
+    lv_test_assert_int_eq(1, lv_disp_get_inv_buf_size(disp), "One area is saved");
+
+    _lv_disp_pop_from_inv_buf(disp, 1);
+    lv_test_assert_int_eq(0, lv_disp_get_inv_buf_size(disp), "Nothing is left after pop");
+}
+
+#if LV_USE_REFR_OCCLUSION
+static void occlusion(void)
+{
+    lv_test_print("Skip the objects covered by opaque objects");
+
+    extern lv_color_t test_fb[];
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_coord_t hres = lv_disp_get_hor_res(disp);
+    lv_coord_t vres = lv_disp_get_ver_res(disp);
+    uint32_t fb_size = hres * vres * sizeof(lv_color_t);
+
+    lv_obj_t * scr_ori = lv_scr_act();
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_scr_load(scr);
+
+    /*A rounded card under two panels which together cover everything but the top rows of the screen*/
+    lv_obj_t * card = lv_obj_create(scr, NULL);
+    lv_obj_set_pos(card, 10, 40);
+    lv_obj_set_size(card, hres - 20, vres - 60);
+    lv_obj_set_style_local_radius(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 10);
+    lv_obj_t * label = lv_label_create(card, NULL);
+    lv_label_set_text(label, "Covered");
+
+    lv_obj_t * panels[2];
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        panels[i] = lv_obj_create(scr, NULL);
+        lv_obj_set_pos(panels[i], i * hres / 2, 20);
+        lv_obj_set_size(panels[i], hres - i * hres / 2, vres - 20);
+        lv_obj_set_style_local_radius(panels[i], LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+        lv_obj_set_style_local_border_width(panels[i], LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+        lv_obj_set_style_local_bg_opa(panels[i], LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
+    }
+
+    lv_obj_invalidate(scr);
+    lv_refr_now(disp);
+    uint32_t overdraw = lv_disp_get_refr_overdraw(disp);
+    lv_color_t * ref_fb = malloc(fb_size);
+    memcpy(ref_fb, test_fb, fb_size);
+
+    lv_test_print("Overdraw: %d (100: every pixel is drawn once)", (int)overdraw);
+
+    /*The screen is drawn only above the panels and the first panel only next to the second*/
+    lv_test_assert_int_gt(99, overdraw, "Every pixel is drawn");
+    lv_test_assert_int_lt(120, overdraw, "The card and the covered part of the first panel are not drawn");
+
+    /*The image and the drawn areas are the same without the covered card*/
+    lv_obj_set_hidden(card, true);
+    lv_obj_invalidate(scr);
+    lv_refr_now(disp);
+    lv_test_assert_int_eq(overdraw, lv_disp_get_refr_overdraw(disp), "Same overdraw without the card");
+    lv_test_assert_int_eq(0, memcmp(ref_fb, test_fb, fb_size), "Same image without the card");
+
+    /*The card is visible at the corners of a rounded panel*/
+    lv_obj_set_style_local_radius(panels[0], LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_RADIUS_CIRCLE);
+    lv_obj_invalidate(scr);
+    lv_refr_now(disp);
+    memcpy(ref_fb, test_fb, fb_size);
+    lv_obj_set_hidden(card, false);
+    lv_obj_invalidate(scr);
+    lv_refr_now(disp);
+    lv_test_assert_int_gt(overdraw, lv_disp_get_refr_overdraw(disp), "The card is drawn");
+    lv_test_assert_true(memcmp(ref_fb, test_fb, fb_size) != 0, "The card is visible");
+
+    free(ref_fb);
+    lv_scr_load(scr_ori);
+    lv_obj_del(scr);
+}
+#endif
+
+#if LV_USE_REFR_WORKER
+static void worker(void)
+{
+    lv_test_print("Render on two threads");
+
+    extern lv_color_t test_fb[];
+    lv_disp_t * disp = lv_disp_get_default();
+    uint32_t fb_size = lv_disp_get_hor_res(disp) * lv_disp_get_ver_res(disp) * sizeof(lv_color_t);
+
+    lv_obj_t * scr_ori = lv_scr_act();
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_scr_load(scr);
+
+    /*Something with masks, shadows, text and images on every line*/
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * obj = lv_obj_create(scr, NULL);
+        lv_obj_set_size(obj, lv_disp_get_hor_res(disp) / 2, 40);
+        lv_obj_set_pos(obj, (i % 2) * lv_disp_get_hor_res(disp) / 2, i * 25);
+        lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 12);
+        lv_obj_set_style_local_shadow_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 10);
+        lv_obj_set_style_local_bg_grad_dir(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_GRAD_DIR_VER);
+        lv_obj_set_style_local_bg_grad_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_RED);
+        lv_obj_set_style_local_bg_opa(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_70);
+
+        lv_obj_t * label = lv_label_create(obj, NULL);
+        lv_label_set_text_fmt(label, "Row %d " LV_SYMBOL_AUDIO, (int)i);
+        lv_obj_align(label, NULL, LV_ALIGN_CENTER, 0, 0);
+    }
+
+    lv_obj_invalidate(scr);
+    lv_refr_now(disp);
+    lv_color_t * ref_fb = malloc(fb_size);
+    memcpy(ref_fb, test_fb, fb_size);
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&lock_mutex, &attr);
+    pthread_t thread;
+    pthread_create(&thread, NULL, worker_thread, NULL);
+
+    disp->driver.worker_start_cb = worker_start_cb;
+    disp->driver.worker_wait_cb = worker_wait_cb;
+    disp->driver.worker_lock_cb = worker_lock_cb;
+
+    lv_obj_invalidate(scr);
+    lv_refr_now(disp);
+    lv_test_assert_int_gt(0, job_cnt, "The worker rendered");
+    lv_test_assert_int_eq(0, memcmp(ref_fb, test_fb, fb_size), "Same image as on one thread");
+
+    /*Full screen redraws on one and two threads. On two cores a frame takes about as long as
+     *the busier thread's CPU time.*/
+    job_cpu_ns = 0;
+    uint32_t t_two_main = redraw_time_us(scr, 50, CLOCK_THREAD_CPUTIME_ID);
+    uint32_t t_two_worker = job_cpu_ns / 1000 / 50;
+    disp->driver.worker_start_cb = NULL;
+    uint32_t t_one = redraw_time_us(scr, 50, CLOCK_THREAD_CPUTIME_ID);
+
+    lv_test_print("Full screen redraw: %d us on one thread, %d + %d us on two",
+                  (int)t_one, (int)t_two_main, (int)t_two_worker);
+
+    disp->driver.worker_wait_cb = NULL;
+    disp->driver.worker_lock_cb = NULL;
+    worker_start_cb(&disp->driver, NULL, NULL);     /*NULL job: exit*/
+    pthread_join(thread, NULL);
+    pthread_mutex_destroy(&lock_mutex);
+    pthread_mutexattr_destroy(&attr);
+    free(ref_fb);
+
+    lv_scr_load(scr_ori);
+    lv_obj_del(scr);
+}
+
+static uint32_t redraw_time_us(lv_obj_t * scr, uint32_t frame_cnt, clockid_t clock)
+{
+    uint64_t t = time_ns(clock);
+
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        lv_obj_invalidate(scr);
+        lv_refr_now(lv_obj_get_disp(scr));
+    }
+
+    return (time_ns(clock) - t) / 1000 / frame_cnt;
+}
+
+static void * worker_thread(void * p)
+{
+    LV_UNUSED(p);
+    while(1) {
+        pthread_mutex_lock(&job_mutex);
+        while(job_done) pthread_cond_wait(&job_cond, &job_mutex);
+        void (*job)(void *) = job_cb;
+        void * param = job_param;
+        pthread_mutex_unlock(&job_mutex);
+
+        if(job == NULL) break;
+        uint64_t t = time_ns(CLOCK_THREAD_CPUTIME_ID);
+        job(param);
+        job_cpu_ns += time_ns(CLOCK_THREAD_CPUTIME_ID) - t;
+        job_cnt++;
+
+        pthread_mutex_lock(&job_mutex);
+        job_done = true;
+        pthread_cond_broadcast(&job_cond);
+        pthread_mutex_unlock(&job_mutex);
+    }
+    return NULL;
+}
+
+static void worker_start_cb(lv_disp_drv_t * disp_drv, void (*job)(void *), void * job_p)
+{
+    LV_UNUSED(disp_drv);
+    pthread_mutex_lock(&job_mutex);
+    job_cb = job;
+    job_param = job_p;
+    job_done = false;
+    pthread_cond_broadcast(&job_cond);
+    pthread_mutex_unlock(&job_mutex);
+}
+
+static void worker_wait_cb(lv_disp_drv_t * disp_drv)
+{
+    LV_UNUSED(disp_drv);
+    pthread_mutex_lock(&job_mutex);
+    while(!job_done) pthread_cond_wait(&job_cond, &job_mutex);
+    pthread_mutex_unlock(&job_mutex);
+}
+
+static void worker_lock_cb(lv_disp_drv_t * disp_drv, bool lock)
+{
+    LV_UNUSED(disp_drv);
+    if(lock) pthread_mutex_lock(&lock_mutex);
+    else pthread_mutex_unlock(&lock_mutex);
+}
+#endif
+
+#if LV_USE_REFR_ADAPTIVE_BAND
+static void adaptive_band(void)
+{
+    lv_test_print("Adapt the band height to the refresh time");
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_coord_t hres = lv_disp_get_hor_res(disp);
+    lv_coord_t vres = lv_disp_get_ver_res(disp);
+    uint32_t fb_size = hres * vres * sizeof(lv_color_t);
+
+    /*Two buffers of 40 lines flushed by a "DMA" thread*/
+    lv_coord_t buf_rows = 40;
+    lv_color_t * buf1 = malloc(hres * buf_rows * sizeof(lv_color_t));
+    lv_color_t * buf2 = malloc(hres * buf_rows * sizeof(lv_color_t));
+    lv_disp_buf_t disp_buf;
+    lv_disp_buf_init(&disp_buf, buf1, buf2, hres * buf_rows);
+    dma_fb = malloc(fb_size);
+    lv_color_t * ref_fb = malloc(fb_size);
+
+    lv_disp_drv_t drv_ori = disp->driver;
+    lv_disp_drv_t drv = disp->driver;
+    drv.buffer = &disp_buf;
+    drv.flush_cb = dma_flush_cb;
+    drv.wait_cb = yield_wait_cb;
+#if LV_COLOR_SCREEN_TRANSP
+    drv.screen_transp = 0;  /*`lv_disp_flush_ready()` would clear the buffer being drawn*/
+#endif
+    lv_disp_drv_update(disp, &drv);
+
+    dma_exit = false;
+    pthread_t thread;
+    pthread_create(&thread, NULL, dma_thread, NULL);
+
+    lv_obj_t * scr_ori = lv_scr_act();
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_scr_load(scr);
+
+    /*A plain screen and a slow display: drawing waits for the flushing*/
+    dma_ns_per_px = 100;
+    lv_test_assert_int_eq(buf_rows, lv_disp_get_band_height(disp), "Start with the whole buffer");
+    adaptive_redraw_us(scr, 1);
+    lv_test_assert_int_gt(0, lv_disp_get_refr_stall_us(disp), "Waited for the slow flush");
+
+    uint32_t t_start = adaptive_redraw_us(scr, 5);
+    adaptive_redraw_us(scr, 60);
+    uint32_t t_end = adaptive_redraw_us(scr, 5);
+    lv_test_print("Slow flush: %d lines, %d us -> %d lines, %d us (stall %d us)",
+                  (int)buf_rows, (int)t_start, (int)lv_disp_get_band_height(disp), (int)t_end,
+                  (int)lv_disp_get_refr_stall_us(disp));
+
+    /*A lot to draw*/
+    add_shadows(scr);
+    dma_ns_per_px = 0;
+    t_start = adaptive_redraw_us(scr, 5);
+    adaptive_redraw_us(scr, 60);
+    t_end = adaptive_redraw_us(scr, 5);
+    lv_test_print("Fast flush: %d lines, %d us -> %d lines, %d us (stall %d us)",
+                  (int)buf_rows, (int)t_start, (int)lv_disp_get_band_height(disp), (int)t_end,
+                  (int)lv_disp_get_refr_stall_us(disp));
+
+    /*The image can't depend on the band height*/
+    disp->band_px = hres * buf_rows;
+    adaptive_redraw_us(scr, 1);
+    memcpy(ref_fb, dma_fb, fb_size);
+    disp->band_px = hres * 7;
+    adaptive_redraw_us(scr, 1);
+    lv_test_assert_int_eq(0, memcmp(ref_fb, dma_fb, fb_size), "Same image with any band height");
+
+    pthread_mutex_lock(&dma_mutex);
+    dma_exit = true;
+    pthread_cond_broadcast(&dma_cond);
+    pthread_mutex_unlock(&dma_mutex);
+    pthread_join(thread, NULL);
+
+    lv_disp_drv_update(disp, &drv_ori);
+    lv_scr_load(scr_ori);
+    lv_obj_del(scr);
+    free(buf1);
+    free(buf2);
+    free(dma_fb);
+    free(ref_fb);
+}
+
+static void add_shadows(lv_obj_t * scr)
+{
+    lv_coord_t hres = lv_disp_get_hor_res(lv_obj_get_disp(scr));
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * obj = lv_obj_create(scr, NULL);
+        lv_obj_set_size(obj, hres / 2, 40);
+        lv_obj_set_pos(obj, (i % 2) * hres / 2, i * 25);
+        lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 12);
+        lv_obj_set_style_local_shadow_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 10);
+        lv_obj_set_style_local_bg_opa(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_70);
+    }
+}
+
+/*Return the average time of a frame in us*/
+static uint32_t adaptive_redraw_us(lv_obj_t * scr, uint32_t frame_cnt)
+{
+    lv_disp_t * disp = lv_obj_get_disp(scr);
+    uint64_t t = time_ns(CLOCK_MONOTONIC);
+
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        lv_obj_invalidate(scr);
+        lv_refr_now(disp);
+    }
+
+    /*Wait for the last band to appear*/
+    while(disp->driver.buffer->flushing) sched_yield();
+
+    return (time_ns(CLOCK_MONOTONIC) - t) / 1000 / frame_cnt;
+}
+
+static void * dma_thread(void * p)
+{
+    LV_UNUSED(p);
+    while(1) {
+        pthread_mutex_lock(&dma_mutex);
+        while(dma_drv == NULL && dma_exit == false) pthread_cond_wait(&dma_cond, &dma_mutex);
+        lv_disp_drv_t * drv = dma_drv;
+        pthread_mutex_unlock(&dma_mutex);
+
+        if(drv == NULL) break;
+
+        dma_copy(drv, &dma_area, dma_color_p);
+        struct timespec t = {0, lv_area_get_size(&dma_area) * dma_ns_per_px};
+        nanosleep(&t, NULL);
+
+        pthread_mutex_lock(&dma_mutex);
+        dma_drv = NULL;
+        pthread_mutex_unlock(&dma_mutex);
+        lv_disp_flush_ready(drv);
+    }
+    return NULL;
+}
+
+static void dma_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    if(dma_ns_per_px == 0) {
+        dma_copy(disp_drv, area, color_p);
+        lv_disp_flush_ready(disp_drv);
+        return;
+    }
+
+    pthread_mutex_lock(&dma_mutex);
+    dma_area = *area;
+    dma_color_p = color_p;
+    dma_drv = disp_drv;
+    pthread_cond_broadcast(&dma_cond);
+    pthread_mutex_unlock(&dma_mutex);
+}
+
+static void dma_copy(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&dma_fb[y * disp_drv->hor_res + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+}
+
+static void yield_wait_cb(lv_disp_drv_t * disp_drv)
+{
+    LV_UNUSED(disp_drv);
+    sched_yield();
+}
+#endif
+
+#if LV_USE_REFR_WORKER || LV_USE_REFR_ADAPTIVE_BAND
+static uint64_t time_ns(clockid_t clock)
+{
+    struct timespec t;
+    clock_gettime(clock, &t);
+    return t.tv_sec * 1000000000ULL + t.tv_nsec;
+}
+#endif
+#endif
@@ -15,6 +15,17 @@
 /*********************
  *      DEFINES
  *********************/
+/*Read the properties of the default theme's styles*/
+#if LV_USE_THEME_MATERIAL && LV_USE_BTN && LV_USE_LABEL && LV_USE_SLIDER && LV_USE_SWITCH && LV_USE_CHECKBOX
+#define BENCH_EN        1
+#define BENCH_ROUNDS    200
+#define BENCH_LIST_MAX  32
+#else
+#define BENCH_EN        0
+#endif
+
+/*Growing a style with a lot of properties fragments the smallest heaps too much*/
+#define MANY_EN         (LV_MEM_CUSTOM || LV_MEM_SIZE >= 8 * 1024)
 
 /**********************
  *      TYPEDEFS
@@ -29,6 +40,13 @@ static void cascade(void);
 static void copy(void);
 static void states(void);
 static void mem_leak(void);
+#if MANY_EN
+static void many_props(void);
+#endif
+#if BENCH_EN
+static void bench_theme(void);
+static uint32_t bench_read(lv_style_list_t * list, lv_state_t state);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -55,6 +73,12 @@ void lv_test_style(void)
     copy();
     states();
     mem_leak();
+#if MANY_EN
+    many_props();
+#endif
+#if BENCH_EN
+    bench_theme();
+#endif
 }
 
 /**********************
@@ -621,4 +645,184 @@ static void mem_leak(void)
     lv_mem_monitor(&mon_end);
     lv_test_assert_int_lt(sizeof(void*) * 8, mon_start.free_size - mon_end.free_size, "Style memory leak");
 }
+
+#if MANY_EN
+static void many_props(void)
+{
+    lv_test_print("");
+    lv_test_print("Many properties in a style:");
+    lv_test_print("---------------------------");
+
+    lv_style_t style;
+    lv_style_init(&style);
+
+    lv_style_property_t pr = LV_STATE_PRESSED << LV_STYLE_STATE_POS;
+    lv_style_property_t foc = LV_STATE_FOCUSED << LV_STYLE_STATE_POS;
+    lv_style_int_t value;
+    lv_color_t color;
+    int32_t g;
+    int32_t i;
+
+    /*Leave gaps between the 'int' IDs*/
+    lv_test_print("Set 'int' properties in all groups backwards in normal and pressed state");
+    for(g = 0xC; g >= 0; g--) {
+        for(i = LV_STYLE_ID_COLOR - 1; i >= 0; i -= 2) {
+            lv_style_property_t prop = (g << 4) + i;
+            _lv_style_set_int(&style, prop, g * 100 + i);
+            _lv_style_set_int(&style, prop | pr, -(g * 100 + i));
+        }
+        _lv_style_set_color(&style, (g << 4) + LV_STYLE_ID_COLOR, LV_COLOR_MAKE(g, 0, 0));
+    }
+
+    bool ok = true;
+    for(g = 0; g <= 0xC; g++) {
+        for(i = 0; i < LV_STYLE_ID_COLOR; i += 2) {
+            lv_style_property_t prop = (g << 4) + i;
+            if(_lv_style_get_int(&style, prop, &value) < 0 || value != g * 100 + i) ok = false;
+            if(_lv_style_get_int(&style, prop | pr, &value) < 0 || value != -(g * 100 + i)) ok = false;
+            if(_lv_style_get_int(&style, prop | foc, &value) < 0 || value != g * 100 + i) ok = false;
+        }
+        if(_lv_style_get_color(&style, (g << 4) + LV_STYLE_ID_COLOR, &color) < 0) ok = false;
+        else if(color.full != LV_COLOR_MAKE(g, 0, 0).full) ok = false;
+        if(_lv_style_get_color(&style, (g << 4) + LV_STYLE_ID_COLOR + 1, &color) >= 0) ok = false;
+    }
+    lv_test_assert_int_eq(1, ok, "Read back all properties in normal, pressed and focused state");
+
+    lv_test_print("Remove the pressed state of every other property and the normal state of every 3rd");
+    for(g = 0; g <= 0xC; g++) {
+        for(i = 0; i < LV_STYLE_ID_COLOR; i += 2) {
+            lv_style_property_t prop = (g << 4) + i;
+            if((i / 2) % 2) lv_style_remove_prop(&style, prop | pr);
+            if((i / 2) % 3 == 0) lv_style_remove_prop(&style, prop);
+        }
+    }
+
+    lv_style_t style_copy;
+    lv_style_init(&style_copy);
+    lv_style_copy(&style_copy, &style);
+
+    ok = true;
+    for(g = 0; g <= 0xC; g++) {
+        for(i = 0; i < LV_STYLE_ID_COLOR; i += 2) {
+            lv_style_property_t prop = (g << 4) + i;
+            int16_t w = _lv_style_get_int(&style_copy, prop, &value);
+            if((i / 2) % 3 == 0 && w >= 0) ok = false;
+            if((i / 2) % 3 != 0 && (w < 0 || value != g * 100 + i)) ok = false;
+
+            w = _lv_style_get_int(&style_copy, prop | pr, &value);
+            if((i / 2) % 2 == 0 && (w < 0 || value != -(g * 100 + i))) ok = false;
+            if((i / 2) % 2 && (i / 2) % 3 == 0 && w >= 0) ok = false;
+            if((i / 2) % 2 && (i / 2) % 3 != 0 && (w < 0 || value != g * 100 + i)) ok = false;
+        }
+        if(_lv_style_get_color(&style_copy, (g << 4) + LV_STYLE_ID_COLOR, &color) < 0) ok = false;
+    }
+    lv_test_assert_int_eq(1, ok, "Read the remaining properties from a copy of the style");
+
+    lv_test_print("Remove all properties");
+    for(g = 0; g <= 0xC; g++) {
+        for(i = 0; i < LV_STYLE_ID_COLOR; i += 2) {
+            lv_style_remove_prop(&style, (g << 4) + i);
+            lv_style_remove_prop(&style, ((g << 4) + i) | pr);
+        }
+        lv_style_remove_prop(&style, (g << 4) + LV_STYLE_ID_COLOR);
+    }
+
+    ok = true;
+    for(g = 0; g <= 0xC; g++) {
+        for(i = 0; i < LV_STYLE_ID_COLOR; i += 2) {
+            if(_lv_style_get_int(&style, ((g << 4) + i) | pr, &value) >= 0) ok = false;
+        }
+    }
+    lv_test_assert_int_eq(1, ok, "No properties are found after removing them");
+    lv_test_assert_int_lt(sizeof(lv_style_property_t) + 1, _lv_style_get_mem_size(&style),
+                          "No memory is used by the properties");
+
+    lv_style_reset(&style);
+    lv_style_reset(&style_copy);
+}
+#endif
+
+#if BENCH_EN
+static void bench_theme(void)
+{
+    lv_test_print("");
+    lv_test_print("Read the properties of themed widgets:");
+    lv_test_print("--------------------------------------");
+
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_obj_t * objs[6];
+    objs[0] = scr;
+    objs[1] = lv_btn_create(scr, NULL);
+    objs[2] = lv_label_create(objs[1], NULL);
+    objs[3] = lv_slider_create(scr, NULL);
+    objs[4] = lv_switch_create(scr, NULL);
+    objs[5] = lv_checkbox_create(scr, NULL);
+
+    /*Collect the style lists of all parts like `_lv_obj_disable_style_caching` does*/
+    lv_style_list_t * lists[BENCH_LIST_MAX];
+    uint32_t list_cnt = 0;
+    uint32_t style_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < sizeof(objs) / sizeof(objs[0]); i++) {
+        uint8_t part;
+        for(part = 0; part < _LV_OBJ_PART_REAL_FIRST; part++) {
+            lv_style_list_t * list = lv_obj_get_style_list(objs[i], part);
+            if(list == NULL || list_cnt == BENCH_LIST_MAX) break;
+            lists[list_cnt++] = list;
+            style_cnt += list->style_cnt;
+        }
+        for(part = _LV_OBJ_PART_REAL_FIRST; part < 0xFF; part++) {
+            lv_style_list_t * list = lv_obj_get_style_list(objs[i], part);
+            if(list == NULL || list_cnt == BENCH_LIST_MAX) break;
+            lists[list_cnt++] = list;
+            style_cnt += list->style_cnt;
+        }
+    }
+
+    uint32_t found = 0;
+    uint32_t r;
+    uint64_t t = lv_test_time_ns();
+    for(r = 0; r < BENCH_ROUNDS; r++) {
+        for(i = 0; i < list_cnt; i++) {
+            found += bench_read(lists[i], LV_STATE_DEFAULT);
+            found += bench_read(lists[i], LV_STATE_PRESSED | LV_STATE_FOCUSED);
+        }
+    }
+    t = lv_test_time_ns() - t;
+
+    /*All IDs of the 13 groups in 2 states*/
+    uint32_t read_cnt = BENCH_ROUNDS * list_cnt * 13 * 16 * 2;
+    lv_test_print("%d style lists with %d styles, %d of %d reads found: %d ns per read",
+                  (int)list_cnt, (int)style_cnt, (int)(found / BENCH_ROUNDS), (int)(read_cnt / BENCH_ROUNDS),
+                  (int)(t / read_cnt));
+    lv_test_assert_int_gt(0, found, "Properties of the theme are found");
+
+    lv_obj_del(scr);
+}
+
+/**
+ * Read every property ID of the 13 groups from a style list
+ * @return number of properties found
+ */
+static uint32_t bench_read(lv_style_list_t * list, lv_state_t state)
+{
+    uint32_t found = 0;
+    lv_style_property_t prop;
+    for(prop = 0; prop < 13 * 16; prop++) {
+        lv_style_property_t prop_state = prop | (state << LV_STYLE_STATE_POS);
+        lv_style_int_t v;
+        lv_color_t c;
+        lv_opa_t o;
+        const void * p;
+        lv_res_t res;
+        uint8_t id = prop & 0xF;
+        if(id < LV_STYLE_ID_COLOR) res = _lv_style_list_get_int(list, prop_state, &v);
+        else if(id < LV_STYLE_ID_OPA) res = _lv_style_list_get_color(list, prop_state, &c);
+        else if(id < LV_STYLE_ID_PTR) res = _lv_style_list_get_opa(list, prop_state, &o);
+        else res = _lv_style_list_get_ptr(list, prop_state, &p);
+        if(res == LV_RES_OK) found++;
+    }
+    return found;
+}
+#endif
 #endif
@@ -0,0 +1,331 @@
+/**
+ * @file lv_test_task.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_task.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SYS_TASK_MAX    16      /*Tasks of the library stopped during the tests*/
+#define LOG_MAX         16
+
+/*Have the tasks of the benchmark fit into the heap*/
+#if LV_MEM_CUSTOM || LV_MEM_SIZE >= 32 * 1024
+    #define BENCH_EN        1
+    #define BENCH_TASKS     200
+    #define BENCH_READY     8       /*Tasks made ready before each `lv_task_handler` call*/
+    #define BENCH_ROUNDS    2000
+#else
+    #define BENCH_EN        0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void sys_tasks_stop(void);
+static void sys_tasks_restore(void);
+static void priority_order(void);
+static void once_per_call(void);
+static void time_till_next(void);
+static void change_in_cb(void);
+#if BENCH_EN
+static void bench_handler(void);
+#endif
+static uint32_t task_cnt(void);
+static void log_cb(lv_task_t * task);
+static void del_self_cb(lv_task_t * task);
+static void del_other_cb(lv_task_t * task);
+static void create_cb(lv_task_t * task);
+static void count_cb(lv_task_t * task);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_task_t * sys_tasks[SYS_TASK_MAX];
+static lv_task_prio_t sys_prios[SYS_TASK_MAX];
+static uint32_t sys_task_cnt;
+static char log_buf[LOG_MAX + 1];
+static uint32_t run_cnt;
+static lv_task_t * created_task;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_task(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_task tests");
+    lv_test_print("===================");
+
+    sys_tasks_stop();
+
+    priority_order();
+    once_per_call();
+    time_till_next();
+    change_in_cb();
+#if BENCH_EN
+    bench_handler();
+#endif
+
+    sys_tasks_restore();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Stop the tasks of the library (refresh, input devices, animations) to see only the tasks of the tests
+ */
+static void sys_tasks_stop(void)
+{
+    sys_task_cnt = 0;
+    lv_task_t * task = lv_task_get_next(NULL);
+    while(task && sys_task_cnt < SYS_TASK_MAX) {
+        sys_tasks[sys_task_cnt] = task;
+        sys_prios[sys_task_cnt] = task->prio;
+        sys_task_cnt++;
+        lv_task_set_prio(task, LV_TASK_PRIO_OFF);
+        task = lv_task_get_next(task);
+    }
+}
+
+static void sys_tasks_restore(void)
+{
+    uint32_t i;
+    for(i = 0; i < sys_task_cnt; i++) {
+        lv_task_set_prio(sys_tasks[i], sys_prios[i]);
+    }
+}
+
+static void priority_order(void)
+{
+    lv_test_print("");
+    lv_test_print("Run the ready tasks by priority:");
+    lv_test_print("--------------------------------");
+
+    log_buf[0] = '\0';
+    lv_task_t * low = lv_task_create(log_cb, 10000, LV_TASK_PRIO_LOW, "L");
+    lv_task_t * highest = lv_task_create(log_cb, 10000, LV_TASK_PRIO_HIGHEST, "H");
+    lv_task_t * mid = lv_task_create(log_cb, 10000, LV_TASK_PRIO_MID, "M");
+    lv_task_t * mid_later = lv_task_create(log_cb, 10000, LV_TASK_PRIO_MID, "m");
+
+    lv_task_handler();
+    lv_test_assert_str_eq("", log_buf, "No task is ready");
+
+    lv_task_ready(mid_later);
+    lv_task_ready(low);
+    lv_task_ready(highest);
+    /*Make `mid` due earlier with a shorter period*/
+    lv_task_ready(mid);
+    lv_task_set_period(mid, 5000);
+    lv_task_handler();
+    lv_test_assert_str_eq("HMmL", log_buf, "Higher priority first, then earlier due first");
+
+    log_buf[0] = '\0';
+    lv_task_set_prio(low, LV_TASK_PRIO_HIGH);
+    lv_task_ready(low);
+    lv_task_ready(mid);
+    lv_task_handler();
+    lv_test_assert_str_eq("LM", log_buf, "Changed priority");
+
+    log_buf[0] = '\0';
+    lv_task_set_prio(low, LV_TASK_PRIO_OFF);
+    lv_task_ready(low);
+    lv_task_handler();
+    lv_test_assert_str_eq("", log_buf, "Stopped task");
+
+    lv_task_del(low);
+    lv_task_del(highest);
+    lv_task_del(mid);
+    lv_task_del(mid_later);
+}
+
+static void once_per_call(void)
+{
+    lv_test_print("");
+    lv_test_print("Run a task only once in a handler call:");
+    lv_test_print("---------------------------------------");
+
+    run_cnt = 0;
+    uint32_t task_cnt_ori = task_cnt();
+    lv_task_t * task = lv_task_create(count_cb, 0, LV_TASK_PRIO_MID, NULL);
+    lv_task_handler();
+    lv_test_assert_int_eq(1, run_cnt, "Zero period task run once");
+    lv_task_handler();
+    lv_test_assert_int_eq(2, run_cnt, "Zero period task run again in the next call");
+
+    lv_task_set_repeat_count(task, 2);
+    lv_task_handler();
+    lv_task_handler();
+    lv_task_handler();
+    lv_test_assert_int_eq(4, run_cnt, "Repeated 2 more times");
+    lv_test_assert_int_eq(task_cnt_ori, task_cnt(), "Deleted after the last repeat");
+}
+
+static void time_till_next(void)
+{
+    lv_test_print("");
+    lv_test_print("Get the time till the next task:");
+    lv_test_print("--------------------------------");
+
+    lv_test_assert_int_eq(LV_NO_TASK_READY, lv_task_get_time_till_next(), "No running task");
+
+    lv_task_t * slow = lv_task_create(log_cb, 10000, LV_TASK_PRIO_MID, "S");
+    lv_task_t * fast = lv_task_create(log_cb, 300, LV_TASK_PRIO_LOW, "F");
+    uint32_t t = lv_task_handler();
+    lv_test_assert_int_lt(301, t, "The faster task is the next");
+    lv_test_assert_int_gt(200, t, "The faster task is the next");
+
+    lv_task_set_period(fast, 20000);
+    t = lv_task_get_time_till_next();
+    lv_test_assert_int_lt(10001, t, "The slower task is the next after changing the period");
+    lv_test_assert_int_gt(9900, t, "The slower task is the next after changing the period");
+
+    lv_task_ready(fast);
+    lv_test_assert_int_eq(0, lv_task_get_time_till_next(), "Ready task");
+
+    lv_task_set_prio(fast, LV_TASK_PRIO_OFF);
+    lv_task_set_prio(slow, LV_TASK_PRIO_OFF);
+    lv_test_assert_int_eq(LV_NO_TASK_READY, lv_task_get_time_till_next(), "Stopped tasks");
+
+    lv_task_del(slow);
+    lv_task_del(fast);
+}
+
+static void change_in_cb(void)
+{
+    lv_test_print("");
+    lv_test_print("Create and delete tasks in a task:");
+    lv_test_print("----------------------------------");
+
+    log_buf[0] = '\0';
+    uint32_t task_cnt_ori = task_cnt();
+    lv_task_t * victim = lv_task_create(log_cb, 0, LV_TASK_PRIO_LOWEST, "V");
+    lv_task_t * killer = lv_task_create(del_other_cb, 0, LV_TASK_PRIO_MID, victim);
+    lv_task_create(del_self_cb, 0, LV_TASK_PRIO_HIGH, NULL);
+    created_task = NULL;
+    lv_task_t * creator = lv_task_create(create_cb, 0, LV_TASK_PRIO_HIGHEST, NULL);
+
+    lv_task_handler();
+    lv_test_assert_str_eq("CDXc", log_buf, "Tasks run in order while the others change");
+    lv_test_assert_true(created_task != NULL, "Task created in a task");
+
+    log_buf[0] = '\0';
+    lv_task_del(creator);
+    lv_task_handler();
+    lv_test_assert_str_eq("Xc", log_buf, "Created task runs, the deleted ones don't");
+
+    lv_task_del(killer);
+    lv_task_del(created_task);
+    lv_test_assert_int_eq(task_cnt_ori, task_cnt(), "All deleted");
+    lv_test_assert_int_eq(LV_NO_TASK_READY, lv_task_get_time_till_next(), "No running task");
+}
+
+#if BENCH_EN
+static void bench_handler(void)
+{
+    lv_test_print("");
+    lv_test_print("Run a few of many tasks:");
+    lv_test_print("------------------------");
+
+    lv_task_t * tasks[BENCH_TASKS];
+    uint32_t created = 0;
+    uint32_t i;
+    for(i = 0; i < BENCH_TASKS; i++) {
+        tasks[i] = lv_task_create(count_cb, 10000 + i * 10, LV_TASK_PRIO_LOWEST + (i % 4), NULL);
+        if(tasks[i]) created++;
+    }
+    lv_test_assert_int_eq(BENCH_TASKS, created, "Tasks created");
+
+    run_cnt = 0;
+    uint32_t r;
+    uint64_t t = lv_test_time_ns();
+    for(r = 0; r < BENCH_ROUNDS; r++) {
+        for(i = 0; i < BENCH_READY; i++) {
+            lv_task_ready(tasks[(r * BENCH_READY + i) * 7 % BENCH_TASKS]);
+        }
+        lv_task_handler();
+    }
+    t = lv_test_time_ns() - t;
+
+    lv_test_assert_int_eq(BENCH_ROUNDS * BENCH_READY, run_cnt, "All ready tasks run");
+
+    lv_test_print("%d tasks, %d ready: %d ns per lv_task_handler",
+                  BENCH_TASKS, BENCH_READY, (int)(t / BENCH_ROUNDS));
+
+    for(i = 0; i < BENCH_TASKS; i++) lv_task_del(tasks[i]);
+}
+#endif
+
+static uint32_t task_cnt(void)
+{
+    uint32_t cnt = 0;
+    lv_task_t * task = lv_task_get_next(NULL);
+    while(task) {
+        cnt++;
+        task = lv_task_get_next(task);
+    }
+    return cnt;
+}
+
+/**
+ * Append the letter of the task to the log
+ */
+static void log_cb(lv_task_t * task)
+{
+    size_t len = strlen(log_buf);
+    if(len < LOG_MAX) {
+        log_buf[len] = *(const char *)task->user_data;
+        log_buf[len + 1] = '\0';
+    }
+}
+
+static void del_self_cb(lv_task_t * task)
+{
+    strcat(log_buf, "D");
+    lv_task_del(task);
+}
+
+static void del_other_cb(lv_task_t * task)
+{
+    strcat(log_buf, "X");
+    if(task->user_data) {
+        lv_task_del(task->user_data);
+        task->user_data = NULL;
+    }
+}
+
+static void create_cb(lv_task_t * task)
+{
+    (void)task;
+    created_task = lv_task_create(log_cb, 0, LV_TASK_PRIO_LOW, "c");
+    strcat(log_buf, "C");
+}
+
+static void count_cb(lv_task_t * task)
+{
+    (void)task;
+    run_cnt++;
+}
+#endif
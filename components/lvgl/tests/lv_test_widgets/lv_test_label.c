@@ -11,10 +11,28 @@
 #include "lv_test_label.h"
 
 #if LV_BUILD_TEST
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
+#define TEST_W          200     /*The texts are drawn into this part of the display buffer*/
+#define TEST_H          140
+#define BENCH_DRAWS     200
+#define BENCH_VISIBLE   10      /*Lines drawn by the benchmark*/
+
+#define LAYOUT_EN       (LV_USE_LABEL && LV_LABEL_LAYOUT_CACHE)
+
+/*Have the lines of the benchmark's texts fit into the heap*/
+#if LV_MEM_CUSTOM
+    #define BENCH_LINE_MAX  800     /*Keep the texts lower than `LV_COORD_MAX`*/
+#elif LV_MEM_SIZE >= 32 * 1024
+    #define BENCH_LINE_MAX  200
+#else
+    #define BENCH_LINE_MAX  0
+#endif
+
+#define BENCH_TXT_SIZE  (BENCH_LINE_MAX * 40 + 1)
 
 /**********************
  *      TYPEDEFS
@@ -24,10 +42,31 @@
  *  STATIC PROTOTYPES
  **********************/
 static void create_copy(void);
+#if LAYOUT_EN
+static void layout_same_as_break(void);
+static void layout_of_labels(void);
+#if BENCH_LINE_MAX
+static void layout_benchmark(void);
+static uint32_t bench_draw_ns(const char * txt, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords);
+#endif
+static void draw_begin(void);
+static void draw_end(void);
+static uint32_t draw_txt(const char * txt, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords,
+                         const lv_area_t * clip);
+static uint32_t line_cnt_of(const char * txt, const lv_font_t * font, lv_coord_t letter_space, lv_coord_t max_w,
+                            lv_txt_flag_t flag);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LAYOUT_EN
+static lv_area_t vdb_area_ori;
+static lv_disp_t * refr_ori;
+#endif
+#if LAYOUT_EN && BENCH_LINE_MAX
+static char bench_txt[BENCH_TXT_SIZE];
+#endif
 
 /**********************
  *      MACROS
@@ -46,6 +85,13 @@ void lv_test_label(void)
 
 #if LV_USE_LABEL
     create_copy();
+#if LV_LABEL_LAYOUT_CACHE
+    layout_same_as_break();
+    layout_of_labels();
+#if BENCH_LINE_MAX
+    layout_benchmark();
+#endif
+#endif
 #else
     lv_test_print("Skip label test: LV_USE_LABEL == 0");
 #endif
@@ -66,4 +112,282 @@ static void create_copy(void)
     lv_test_assert_img_eq("lv_test_img32_label_1.png", "Create a label and leave the default settings");
 #endif
 }
+#if LAYOUT_EN
+
+static void layout_same_as_break(void)
+{
+    lv_test_print("");
+    lv_test_print("Draw the same text with the saved lines");
+    lv_test_print("---------------------------");
+
+    static const char * txts[] = {
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et "
+        "dolore magna aliqua.\nUt enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip\n\n"
+        "Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur.\n",
+        "A #ff0000 red# and a #00ff00 green# word in a long enough line to be broken.\r\nAnother #0000ff blue# line "
+        "with averyveryveryverylongwordwhichdoesnotfitintoasingleline and more words after it",
+        "\xC3\x81rv\xC3\xADzt\xC5\xB1r\xC5\x91 t\xC3\xBCk\xC3\xB6rf\xC3\xBAr\xC3\xB3g\xC3\xA9p\n"
+        "\xC3\x81RV\xC3\x8DZT\xC5\xB0R\xC5\x90 T\xC3\x9CK\xC3\x96RF\xC3\x9AR\xC3\x93G\xC3\x89P a b c d e f g h i j",
+    };
+    static const lv_txt_flag_t flags[] = {
+        LV_TXT_FLAG_NONE, LV_TXT_FLAG_CENTER, LV_TXT_FLAG_RIGHT, LV_TXT_FLAG_RECOLOR | LV_TXT_FLAG_CENTER,
+        LV_TXT_FLAG_EXPAND, LV_TXT_FLAG_FIT | LV_TXT_FLAG_RIGHT,
+    };
+    static const lv_coord_t clip_y1s[] = {0, 7, 33, 90};
+    static const lv_coord_t ofs_ys[] = {0, -25};
+
+    draw_begin();
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.letter_space = 1;
+    dsc.line_space = 3;
+
+    lv_area_t coords;
+    lv_area_set(&coords, 10, 5, 150, TEST_H - 1);
+
+    lv_txt_layout_t layout;
+    _lv_memset_00(&layout, sizeof(layout));
+
+    uint32_t diff_cnt = 0;
+    uint32_t invalid_cnt = 0;
+    uint32_t a, b, c, d;
+    for(a = 0; a < sizeof(txts) / sizeof(txts[0]); a++) {
+        for(b = 0; b < sizeof(flags) / sizeof(flags[0]); b++) {
+            _lv_txt_layout_update(&layout, txts[a], dsc.font, dsc.letter_space, dsc.line_space,
+                                  lv_area_get_width(&coords), flags[b]);
+            if(!_lv_txt_layout_is_valid(&layout, txts[a], dsc.font, dsc.letter_space, lv_area_get_width(&coords),
+                                        flags[b])) {
+                invalid_cnt++;
+            }
+
+            for(c = 0; c < sizeof(clip_y1s) / sizeof(clip_y1s[0]); c++) {
+                for(d = 0; d < sizeof(ofs_ys) / sizeof(ofs_ys[0]); d++) {
+                    lv_area_t clip;
+                    lv_area_set(&clip, 0, clip_y1s[c], TEST_W - 1, clip_y1s[c] + 40);
+                    dsc.flag = flags[b];
+                    dsc.ofs_y = ofs_ys[d];
+                    dsc.layout = NULL;
+                    uint32_t hash_break = draw_txt(txts[a], &dsc, &coords, &clip);
+                    dsc.layout = &layout;
+                    uint32_t hash_layout = draw_txt(txts[a], &dsc, &coords, &clip);
+                    if(hash_break != hash_layout) diff_cnt++;
+                }
+            }
+        }
+    }
+
+    lv_test_assert_int_eq(0, invalid_cnt, "The lines are saved");
+    lv_test_assert_int_eq(0, diff_cnt, "Same pixels with every align, flag, clip area and offset");
+
+    /*Not for other texts or settings*/
+    uint32_t valid_cnt = 0;
+    lv_coord_t w = lv_area_get_width(&coords);
+    _lv_txt_layout_update(&layout, txts[0], dsc.font, 1, 3, w, LV_TXT_FLAG_NONE);
+    if(_lv_txt_layout_is_valid(&layout, txts[1], dsc.font, 1, w, LV_TXT_FLAG_NONE)) valid_cnt++;
+    if(_lv_txt_layout_is_valid(&layout, txts[0], dsc.font, 2, w, LV_TXT_FLAG_NONE)) valid_cnt++;
+    if(_lv_txt_layout_is_valid(&layout, txts[0], dsc.font, 1, w + 1, LV_TXT_FLAG_NONE)) valid_cnt++;
+    if(_lv_txt_layout_is_valid(&layout, txts[0], dsc.font, 1, w, LV_TXT_FLAG_RECOLOR)) valid_cnt++;
+    if(_lv_txt_layout_is_valid(&layout, txts[0], dsc.font, 1, w, LV_TXT_FLAG_EXPAND)) valid_cnt++;
+    lv_test_assert_int_eq(0, valid_cnt, "Not valid for an other text, letter space, width or flags");
+    lv_test_assert_int_eq(1, _lv_txt_layout_is_valid(&layout, txts[0], dsc.font, 1, w, LV_TXT_FLAG_CENTER) ? 1 : 0,
+                          "Valid with an other align");
+
+    lv_point_t size;
+    _lv_txt_get_size(&size, txts[0], dsc.font, 1, 3, w, LV_TXT_FLAG_NONE);
+    lv_test_assert_int_eq(size.x, layout.size.x, "Same width as _lv_txt_get_size");
+    lv_test_assert_int_eq(size.y, layout.size.y, "Same height as _lv_txt_get_size");
+
+    _lv_txt_layout_free(&layout);
+    lv_test_assert_int_eq(0, _lv_txt_layout_is_valid(&layout, txts[0], dsc.font, 1, w, LV_TXT_FLAG_NONE) ? 1 : 0,
+                          "Not valid after free");
+
+    draw_end();
+}
+
+static void layout_of_labels(void)
+{
+    lv_test_print("");
+    lv_test_print("Update the lines of labels");
+    lv_test_print("---------------------------");
+
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+    lv_obj_set_width(label, 120);
+    lv_label_set_text(label, "The lines of this text are saved when the text, the width or the style changes.");
+
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(label, LV_LABEL_PART_MAIN);
+    lv_coord_t w = lv_obj_get_width(label);
+    lv_test_assert_int_eq(1, _lv_txt_layout_is_valid(&ext->layout, ext->text, font, letter_space, w,
+                                                     LV_TXT_FLAG_NONE) ? 1 : 0, "Valid after set text");
+    lv_test_assert_int_eq(line_cnt_of(ext->text, font, letter_space, w, LV_TXT_FLAG_NONE), ext->layout.line_cnt,
+                          "Same line count");
+    lv_test_assert_int_eq(ext->layout.size.y, lv_obj_get_height(label), "The label is as high as the text");
+
+    uint32_t line_cnt_ori = ext->layout.line_cnt;
+    lv_obj_set_width(label, 60);
+    w = lv_obj_get_width(label);
+    lv_test_assert_int_eq(60, ext->layout.max_width, "Updated on width change");
+    lv_test_assert_int_gt(line_cnt_ori, ext->layout.line_cnt, "More lines in narrower label");
+    lv_test_assert_int_eq(line_cnt_of(ext->text, font, letter_space, w, LV_TXT_FLAG_NONE), ext->layout.line_cnt,
+                          "Same line count after width change");
+
+    lv_obj_set_style_local_text_letter_space(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, 4);
+    lv_test_assert_int_eq(4, ext->layout.letter_space, "Updated on style change");
+
+    lv_label_set_text(label, "An other text which is long enough to have more lines.");
+    lv_test_assert_int_eq(1, ext->layout.txt == ext->text ? 1 : 0, "Updated on text change");
+
+    lv_label_set_text(label, "1");
+    lv_test_assert_int_eq(0, ext->layout.lines == NULL ? 0 : 1, "Nothing is saved for a single line");
+
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, " text\nand new lines\nafter it");
+    lv_test_assert_int_eq(strlen(ext->text), ext->layout.lines ? ext->layout.lines[ext->layout.line_cnt].start : 0,
+                          "Updated on insert");
+
+    /*The dots make the text shorter*/
+    lv_label_set_long_mode(label, LV_LABEL_LONG_DOT);
+    lv_obj_set_height(label, 2 * lv_font_get_line_height(font));
+    lv_test_assert_int_eq(strlen(ext->text), ext->layout.lines ? ext->layout.lines[ext->layout.line_cnt].start : 0,
+                          "Updated in dot mode");
+
+    lv_obj_del(label);
+}
+
+#if BENCH_LINE_MAX
+static void layout_benchmark(void)
+{
+    lv_test_print("");
+    lv_test_print("Draw long texts");
+    lv_test_print("---------------------------");
+
+    draw_begin();
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.flag = LV_TXT_FLAG_CENTER;
+
+    /*Draw the last lines of the text where breaking the text takes the longest*/
+    lv_area_t coords;
+    coords.x1 = 0;
+    coords.x2 = TEST_W - 1;
+
+    lv_txt_layout_t layout;
+    _lv_memset_00(&layout, sizeof(layout));
+
+    uint32_t line_cnt;
+    for(line_cnt = 50; line_cnt <= BENCH_LINE_MAX; line_cnt *= 4) {
+        uint32_t i;
+        uint32_t len = 0;
+        for(i = 0; i < line_cnt; i++) {
+            len += lv_snprintf(&bench_txt[len], BENCH_TXT_SIZE - len, "Line %d of a long label text\n", (int)i);
+        }
+
+        lv_coord_t line_h = lv_font_get_line_height(dsc.font) + dsc.line_space;
+        coords.y2 = BENCH_VISIBLE * line_h - 1;
+        coords.y1 = coords.y2 - line_cnt * line_h;
+
+        if(!_lv_txt_layout_update(&layout, bench_txt, dsc.font, dsc.letter_space, dsc.line_space,
+                                  lv_area_get_width(&coords), dsc.flag)) {
+            lv_test_print("No memory for the lines");
+            break;
+        }
+        dsc.layout = &layout;
+        uint32_t layout_ns = bench_draw_ns(bench_txt, &dsc, &coords);
+        dsc.layout = NULL;
+        uint32_t break_ns = bench_draw_ns(bench_txt, &dsc, &coords);
+
+        lv_test_print("%d lines, %d visible: %d us/draw (%d us/draw breaking the lines)",
+                      (int)line_cnt, BENCH_VISIBLE, (int)(layout_ns / 1000), (int)(break_ns / 1000));
+    }
+
+    _lv_txt_layout_free(&layout);
+    draw_end();
+}
+
+/**
+ * Draw a text many times with `lv_draw_label`
+ * @return the average time of a draw
+ */
+static uint32_t bench_draw_ns(const char * txt, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_area_t clip;
+    lv_area_set(&clip, 0, 0, TEST_W - 1, TEST_H - 1);
+
+    uint64_t t = lv_test_time_ns();
+    uint32_t i;
+    for(i = 0; i < BENCH_DRAWS; i++) {
+        lv_draw_label(coords, &clip, dsc, txt, NULL);
+    }
+    t = lv_test_time_ns() - t;
+
+    return t / BENCH_DRAWS;
+}
+#endif
+
+/**
+ * Draw into the display buffer as if the display were refreshed
+ */
+static void draw_begin(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    vdb_area_ori = vdb->area;
+    refr_ori = _lv_refr_get_disp_refreshing();
+    lv_area_set(&vdb->area, 0, 0, lv_disp_get_hor_res(disp) - 1, vdb->size / lv_disp_get_hor_res(disp) - 1);
+    _lv_refr_set_disp_refreshing(disp);
+}
+
+static void draw_end(void)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(lv_disp_get_default());
+    _lv_refr_set_disp_refreshing(refr_ori);
+    vdb->area = vdb_area_ori;
+}
+
+/**
+ * Clear the test area of the display buffer and draw a text into it
+ * @return hash of the test area
+ */
+static uint32_t draw_txt(const char * txt, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords,
+                         const lv_area_t * clip)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(lv_disp_get_default());
+    lv_coord_t vdb_w = lv_area_get_width(&vdb->area);
+    lv_color_t * buf = vdb->buf_act;
+    lv_coord_t y;
+    for(y = 0; y < TEST_H; y++) lv_color_fill(&buf[y * vdb_w], LV_COLOR_WHITE, TEST_W);
+
+    lv_draw_label(coords, clip, dsc, txt, NULL);
+
+    uint32_t hash = 2166136261u;
+    for(y = 0; y < TEST_H; y++) {
+        lv_coord_t x;
+        for(x = 0; x < TEST_W; x++) {
+            hash = (hash ^ lv_color_to32(buf[y * vdb_w + x])) * 16777619u;
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * Count the lines of a text with `_lv_txt_get_next_line`
+ */
+static uint32_t line_cnt_of(const char * txt, const lv_font_t * font, lv_coord_t letter_space, lv_coord_t max_w,
+                            lv_txt_flag_t flag)
+{
+    uint32_t cnt = 0;
+    uint32_t i = 0;
+    while(txt[i] != '\0') {
+        i += _lv_txt_get_next_line(&txt[i], font, letter_space, max_w, flag);
+        cnt++;
+    }
+    return cnt;
+}
+
+#endif /*LAYOUT_EN*/
+
 #endif
@@ -34,6 +34,7 @@ pandora_helper_handle_t pandora_helper_init(const char *username, const char *pa
 esp_err_t pandora_helper_get_stations(pandora_helper_handle_t pandora, pandora_station_t **stations, size_t *stations_len);
 esp_err_t pandora_helper_set_station(pandora_helper_handle_t h,	int iStation);
 esp_err_t pandora_helper_get_next_track(pandora_helper_handle_t helper, char **url);
+esp_err_t pandora_helper_get_current_track(pandora_helper_handle_t helper, const pandora_track_t **track);
 void pandora_helper_cleanup(pandora_helper_handle_t helper);
 
 
@@ -504,6 +504,23 @@ error:
 }
 
 
+// The track whose url was last returned by pandora_helper_get_next_track().
+// Valid until the next call to get_next_track or set_station.
+esp_err_t
+pandora_helper_get_current_track(
+	pandora_helper_handle_t h,
+	const pandora_track_t **track)
+{
+	esp_err_t err = ESP_OK;
+
+	CHKB(h->i_next_track > 0 && h->i_next_track <= h->tracks_len);
+	*track = &h->tracks[h->i_next_track - 1];
+
+error:
+	return err;
+}
+
+
 esp_err_t 
 pandora_helper_get_stations(
 	pandora_helper_handle_t h,
@@ -18,6 +18,7 @@
 #include "esp_freertos_hooks.h"
 #include "freertos/semphr.h"
 #include "esp_system.h"
+#include "esp_attr.h"
 #include "driver/gpio.h"
 
 /* Littlevgl specific */
@@ -29,6 +30,10 @@
 
 #include "lvgl_helpers.h"
 #include "gui.h"
+#include "keypad.h"
+#include "station_list.h"
+#include "now_playing.h"
+#include "refr_worker.h"
 
 #if 0
 #ifndef CONFIG_LV_TFT_DISPLAY_MONOCHROME
@@ -50,141 +55,351 @@
  *      DEFINES
  *********************/
 #define TAG "demo"
-#define LV_TICK_PERIOD_MS 1 /* increase this ?? */
+
+/* Length of the cross-task command ring. Must be a power of 2. */
+#define GUI_CMD_QUEUE_LEN 16
+
+/* With the render worker the GUI task needs a core of its own next to it.
+ * Wi-Fi runs on core 0, so that's where the (shorter lived) worker goes. */
+#if LV_USE_REFR_WORKER
+    #define GUI_TASK_CORE   1
+    #define GUI_WORKER_CORE 0
+#else
+    #define GUI_TASK_CORE   tskNO_AFFINITY
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    GUI_CMD_SET_SELECTED,
+    GUI_CMD_STEP_SELECTED,
+    GUI_CMD_ASYNC,
+    GUI_CMD_SET_TRACK,
+    GUI_CMD_SET_PROGRESS,
+} gui_cmd_type_t;
+
+typedef struct {
+    gui_cmd_type_t type;
+    union {
+        uint16_t index;     /* GUI_CMD_SET_SELECTED */
+        int16_t delta;      /* GUI_CMD_STEP_SELECTED */
+        struct {            /* GUI_CMD_ASYNC */
+            gui_async_cb_t cb;
+            void *user_data;
+        } async;
+        char *track;        /* GUI_CMD_SET_TRACK: "song\0artist\0", freed by the GUI task */
+        struct {            /* GUI_CMD_SET_PROGRESS */
+            uint32_t elapsed_ms;
+            uint32_t total_ms;
+            uint8_t buffer_pct;
+        } progress;
+    };
+} gui_cmd_t;
+
+/* One ring slot. `seq` tells producers and the consumer whose turn it is
+ * (bounded MPMC queue after D. Vyukov, used here with a single consumer). */
+typedef struct {
+    uint32_t seq;
+    gui_cmd_t cmd;
+} gui_cmd_slot_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static void lv_tick_task(void *arg);
 static void guiTask(void *pvParameter);
-static lv_obj_t * s_roller;
+static void gui_cmd_init(void);
+static bool gui_cmd_post(const gui_cmd_t *cmd);
+static lv_obj_t * s_list;
+static lv_obj_t * s_now_playing;
+static TaskHandle_t s_gui_task;
+
+/* Where the station list gets its rows from; set by gui_init() */
+static uint16_t s_row_cnt;
+static gui_row_cb_t s_row_cb;
+static void *s_row_user_data;
+
+static gui_cmd_slot_t s_cmd_ring[GUI_CMD_QUEUE_LEN];
+static uint32_t s_cmd_head;   /* next position a producer claims */
+static uint32_t s_cmd_tail;   /* next position the GUI task reads; GUI task only */
+static uint32_t s_cmd_dropped;    /* commands refused on a full ring or by lv_async_call(); reported by the GUI task */
 
 /**********************
  *   APPLICATION MAIN
  **********************/
 void gui_init(
-    char* options) 
+    uint16_t row_cnt, 
+    gui_row_cb_t row_cb, 
+    void *user_data) 
 {
+    s_row_cnt = row_cnt;
+    s_row_cb = row_cb;
+    s_row_user_data = user_data;
+    gui_cmd_init();
 
     /* If you want to use a task to create the graphic, you NEED to create a Pinned task
      * Otherwise there can be problem such as memory corruption and so on.
      * NOTE: When not using Wi-Fi nor Bluetooth you can pin the guiTask to core 0 */
     xTaskCreatePinnedToCore(guiTask, "gui", 4096*2, 
-        /*parameters*/options, 
+        /*parameters*/NULL, 
         /*uxPriority*/tskIDLE_PRIORITY, 
-        /*pvCreatedTask*/NULL, 
-        /*xCoreID*//*1*/tskNO_AFFINITY);
+        /*pvCreatedTask*/&s_gui_task, 
+        /*xCoreID*/GUI_TASK_CORE);
 }
 
 
-void gui_button(
-    audio_event_iface_msg_t msg)
+/* Wake the GUI task so it runs lv_task_handler now instead of sleeping
+ * until the next LVGL deadline. Call it after touching LVGL state from
+ * another task (while holding xGuiSemaphore) or when input arrives. */
+void gui_wake(void)
 {
-    uint16_t index = lv_roller_get_selected(s_roller);
-    uint16_t count = lv_roller_get_option_cnt(s_roller);
-    char string[128];
-                
-    if (msg.cmd == PERIPH_BUTTON_PRESSED) {
-        switch ((int)msg.data) {
-            case GPIO_NUM_36:
-                lv_roller_get_selected_str(s_roller, string, sizeof(string));
-                printf ("Activate %d %s\n", index, string);
-                break;
+    if (s_gui_task) {
+        xTaskNotifyGive(s_gui_task);
+    }
+}
 
-            case GPIO_NUM_19:
-                if (0 == index) {
-                    index = count - 1;
-                } else {
-                    index--;
-                }
-                printf ("Up: Set selected %d \n", index);
-                lv_roller_set_selected(s_roller, index, LV_ANIM_ON);
-                break;
 
-            case GPIO_NUM_23:
-                index = (index + 1) % count;
-                printf ("Down: Set selected %d \n", index);
-                lv_roller_set_selected(s_roller, index, LV_ANIM_ON);
-                break;
+void IRAM_ATTR gui_wake_from_isr(void)
+{
+    BaseType_t higher_prio_woken = pdFALSE;
+
+    if (s_gui_task) {
+        vTaskNotifyGiveFromISR(s_gui_task, &higher_prio_woken);
+        if (higher_prio_woken) {
+            portYIELD_FROM_ISR();
         }
     }
 }
 
 
-static void 
-roller_event_handler(lv_obj_t * obj, lv_event_t event)
+/* Ask the GUI task to select station `index`. Never blocks; returns false
+ * if the command queue is full. */
+bool gui_set_selected(
+    uint16_t index)
 {
-    //printf("roller_event %d\n", event);
-    if(event == LV_EVENT_VALUE_CHANGED) {
-        char buf[64];
-        lv_roller_get_selected_str(obj, buf, sizeof(buf));
-        printf("Selected month: %s\n", buf);
+    gui_cmd_t cmd = { .type = GUI_CMD_SET_SELECTED, .index = index };
+
+    return gui_cmd_post(&cmd);
+}
+
+
+/* Ask the GUI task to move the selection by `delta` rows, wrapping around.
+ * Consecutive steps posted within one frame are summed. */
+bool gui_step_selected(
+    int16_t delta)
+{
+    gui_cmd_t cmd = { .type = GUI_CMD_STEP_SELECTED, .delta = delta };
+
+    return gui_cmd_post(&cmd);
+}
+
+
+/* Run `cb(user_data)` in the GUI task with LVGL safely accessible.
+ * The callback is handed to lv_async_call() when the queue is drained. */
+bool gui_async_call(
+    gui_async_cb_t cb, 
+    void *user_data)
+{
+    gui_cmd_t cmd = { .type = GUI_CMD_ASYNC, .async = { cb, user_data } };
+
+    return gui_cmd_post(&cmd);
+}
+
+
+/* Show a new song and artist on the now-playing panel. Both strings are
+ * copied, so the caller may free them once this returns. */
+bool gui_set_track(
+    const char *song, 
+    const char *artist)
+{
+    size_t song_len = strlen(song) + 1;
+    size_t artist_len = strlen(artist) + 1;
+    gui_cmd_t cmd = { .type = GUI_CMD_SET_TRACK };
+
+    cmd.track = malloc(song_len + artist_len);
+    if (!cmd.track) {
+        return false;
+    }
+    memcpy(cmd.track, song, song_len);
+    memcpy(cmd.track + song_len, artist, artist_len);
+
+    if (!gui_cmd_post(&cmd)) {
+        free(cmd.track);
+        return false;
     }
+    return true;
 }
 
 
+/* Update the playback position and the stream buffer level. Cheap to call
+ * often: the panel only redraws what actually moved. */
+bool gui_set_progress(
+    uint32_t elapsed_ms, 
+    uint32_t total_ms, 
+    uint8_t buffer_pct)
+{
+    gui_cmd_t cmd = { .type = GUI_CMD_SET_PROGRESS, 
+                      .progress = { elapsed_ms, total_ms, buffer_pct } };
 
+    return gui_cmd_post(&cmd);
+}
+
+
+/* Multi-producer, lock-free enqueue. Safe from any task; does not wait on
+ * the GUI task or xGuiSemaphore. */
 static bool 
-input_device_read_callback(
-    lv_indev_drv_t* drv, 
-    lv_indev_data_t* data)
+gui_cmd_post(
+    const gui_cmd_t *cmd)
 {
-    #ifdef CONFIG_ESP_AI_THINKER_V2_2_BOARD
-        #define NUM_KEYS 6
-        const gpio_num_t key_to_gpio[NUM_KEYS] = { 
-            GPIO_NUM_36, // 1 works
-            GPIO_NUM_13, // 2 Used for MTCK 
-            GPIO_NUM_19, // 3 works.
-            GPIO_NUM_23, // 4         on pin header. connected to red led on pcb
-            GPIO_NUM_18, // 5         on pin header. 
-            GPIO_NUM_5 };// 6 works.  on pin header. 
-    #else
-        #error Need keyboard mapping for audio board
-    #endif
+    gui_cmd_slot_t *slot;
+    uint32_t pos;
 
-    static int prev_states[NUM_KEYS];
-    static int prev_key; // the last key returned
-  /////////  const uint32_t key_to_lvgl_key[NUM_KEYS] = {LV_KEY_LEFT, 0, LV_KEY_ENTER, LV_KEY_ESC, 0, LV_KEY_RIGHT};
-
-    // If we don't find a key that actually changed state,
-    // just return the same key we returned last time.
-    data->key = prev_key;
-    data->state = prev_states[prev_key];
-
-    // But look for one that changed state
-    for (int i=0; i < NUM_KEYS; i++) {
-        gpio_set_direction(key_to_gpio[i], GPIO_MODE_INPUT);/////
-        int new_state = gpio_get_level(key_to_gpio[i]) ? LV_INDEV_STATE_REL : LV_INDEV_STATE_PR;
-        if (new_state != prev_states[i]) {
-#if 0 /////////////////////
-            printf("Key %d changed to %s\n", i+1, new_state == LV_INDEV_STATE_PR ? "Pressed" : "Released");
-            // state changed, so can return this key
-            data->key = key_to_lvgl_key[i];
-            data->state = new_state;
-            // Remember state
-            prev_states[i] = new_state;
-            prev_key = i;
-#endif
+    /* The ring is initialized in gui_init() before the task exists */
+    if (!s_gui_task) {
+        return false;
+    }
+
+    pos = __atomic_load_n(&s_cmd_head, __ATOMIC_RELAXED);
+    while (true) {
+        slot = &s_cmd_ring[pos & (GUI_CMD_QUEUE_LEN - 1)];
+        int32_t dif = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+
+        if (0 == dif) {
+            /* Slot is free for this position; try to claim it */
+            if (__atomic_compare_exchange_n(&s_cmd_head, &pos, pos + 1, 
+                    /*weak*/true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (dif < 0) {
+            /* No printf here: it takes the stdout lock. The GUI task reports it. */
+            __atomic_fetch_add(&s_cmd_dropped, 1, __ATOMIC_RELAXED);
+            return false;
+        } else {
+            pos = __atomic_load_n(&s_cmd_head, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->cmd = *cmd;
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+
+    gui_wake();
+    return true;
+}
+
+
+/* Single-consumer dequeue. GUI task only. */
+static bool 
+gui_cmd_take(
+    gui_cmd_t *cmd)
+{
+    gui_cmd_slot_t *slot = &s_cmd_ring[s_cmd_tail & (GUI_CMD_QUEUE_LEN - 1)];
+
+    if ((int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - (s_cmd_tail + 1)) < 0) {
+        return false;
+    }
+
+    *cmd = slot->cmd;
+    __atomic_store_n(&slot->seq, s_cmd_tail + GUI_CMD_QUEUE_LEN, __ATOMIC_RELEASE);
+    s_cmd_tail++;
+    return true;
+}
+
+
+static void 
+gui_cmd_init(void)
+{
+    for (uint32_t i = 0; i < GUI_CMD_QUEUE_LEN; i++) {
+        s_cmd_ring[i].seq = i;
+    }
+}
+
+
+/* Drain everything posted since the last frame and apply it once.
+ * Selection commands are coalesced: the last absolute selection wins and
+ * relative steps after it are summed, so a burst of key presses results in
+ * a single station_list_set_selected(). Must be called with xGuiSemaphore held. */
+static void 
+gui_cmd_drain(void)
+{
+    gui_cmd_t cmd;
+    bool have_select = false;
+    uint16_t select_index = 0;
+    int32_t step = 0;
+    uint32_t dropped = __atomic_exchange_n(&s_cmd_dropped, 0, __ATOMIC_RELAXED);
+
+    if (dropped) {
+        printf("GUI dropped %u commands (queue full or out of memory)\n", (unsigned)dropped);
+    }
+
+    while (gui_cmd_take(&cmd)) {
+        switch (cmd.type) {
+            case GUI_CMD_SET_SELECTED:
+                have_select = true;
+                select_index = cmd.index;
+                step = 0;
+                break;
+
+            case GUI_CMD_STEP_SELECTED:
+                step += cmd.delta;
+                break;
+
+            case GUI_CMD_ASYNC:
+                if (LV_RES_OK != lv_async_call(cmd.async.cb, cmd.async.user_data)) {
+                    /* Out of LVGL memory; reported with the next drain */
+                    __atomic_fetch_add(&s_cmd_dropped, 1, __ATOMIC_RELAXED);
+                }
+                break;
+
+            case GUI_CMD_SET_TRACK:
+                now_playing_set_track(s_now_playing, cmd.track, cmd.track + strlen(cmd.track) + 1);
+                free(cmd.track);
+                break;
+
+            case GUI_CMD_SET_PROGRESS:
+                now_playing_set_progress(s_now_playing, cmd.progress.elapsed_ms, cmd.progress.total_ms);
+                now_playing_set_buffer(s_now_playing, cmd.progress.buffer_pct);
+                break;
         }
     }
 
+    if (have_select || step) {
+        int32_t count = station_list_get_row_count(s_list);
+        int32_t index = have_select ? select_index : station_list_get_selected(s_list);
 
-    return false; /*No buffering now so no more data read*/
+        if (count > 0) {
+            index = ((index + step) % count + count) % count;
+            station_list_set_selected(s_list, index, LV_ANIM_ON);
+        }
+    }
 }
 
 
+static void 
+list_event_handler(lv_obj_t * obj, lv_event_t event)
+{
+    if(event == LV_EVENT_VALUE_CHANGED) {
+        printf("Activate %d %s\n", station_list_get_selected(obj), station_list_get_selected_str(obj));
+    }
+}
+
+
+static const char *
+list_row_cb(
+    lv_obj_t *list, 
+    uint16_t row, 
+    void *user_data)
+{
+    return s_row_cb(row, s_row_user_data);
+}
+
+
+
 static void
 setup_input_device(
     lv_obj_t *obj)
 {
-    lv_indev_drv_t indev_drv;
-
-    // Create input device
-    lv_indev_drv_init(&indev_drv);      
-    indev_drv.type = LV_INDEV_TYPE_KEYPAD;
-    indev_drv.read_cb = input_device_read_callback;
-    // Register the driver in LVGL and save the created input device object
-    lv_indev_t * my_indev = lv_indev_drv_register(&indev_drv);
+    // Create the interrupt driven keypad input device
+    lv_indev_t * my_indev = keypad_indev_register();
 
     // Associate input device with gui object
     lv_group_t * group = lv_group_create();
@@ -195,32 +410,45 @@ setup_input_device(
 
 
 void 
-create_widgets(
-    char* options)
+create_widgets(void)
 {
+    // Only the visible rows exist as labels; names are pulled from list_row_cb
+    s_list = station_list_create(/*parent*/lv_scr_act());
 
-    s_roller = lv_roller_create(/*parent*/lv_scr_act(), NULL);
-
-    lv_roller_set_options(s_roller, options, LV_ROLLER_MODE_INFINITE);
-    //printf("\nReceived options:\n%s\n", options);
-    free(options);
-    #if 0
-    lv_obj_add_style(s_roller, LV_CONT_PART_MAIN, &style_box);
-    lv_obj_set_style_local_value_str(s_roller, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, "Roller");
-    lv_roller_set_auto_fit(s_roller, false);
-    #endif
+    lv_obj_set_width(s_list, LV_HOR_RES_MAX);
+    station_list_set_visible_row_count(s_list, 5);
+    station_list_set_source(s_list, s_row_cnt, list_row_cb, NULL);
+    lv_obj_set_event_cb(s_list, list_event_handler);
 
-    lv_roller_set_align(s_roller, LV_LABEL_ALIGN_LEFT);
-    lv_roller_set_visible_row_count(s_roller, 9);
-    lv_obj_set_width(s_roller, LV_HOR_RES_MAX);
-    lv_obj_set_event_cb(s_roller, roller_event_handler);
+    // Song, artist and progress below the list. It redraws only what changed.
+    s_now_playing = now_playing_create(/*parent*/lv_scr_act());
+    lv_obj_set_width(s_now_playing, LV_HOR_RES_MAX);
+    lv_obj_align(s_now_playing, NULL, LV_ALIGN_IN_BOTTOM_MID, 0, 0);
 
-    setup_input_device(s_roller);
+    setup_input_device(s_list);
 }
 
 
 
 
+/* Convert the delay returned by lv_task_handler() into FreeRTOS ticks.
+ * Rounds up so a deadline shorter than one tick doesn't turn into a
+ * zero-tick busy loop. */
+static TickType_t
+gui_ms_to_ticks(
+    uint32_t ms)
+{
+    TickType_t ticks;
+
+    if (LV_NO_TASK_READY == ms) {
+        return portMAX_DELAY;
+    }
+
+    ticks = (ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+    return ticks ? ticks : 1;
+}
+
+
 /* Creates a semaphore to handle concurrent call to lvgl stuff
  * If you wish to call *any* lvgl function from other threads/tasks
  * you should lock on the very same semaphore! */
@@ -230,7 +458,6 @@ static void
 guiTask(
     void *pvParameter) 
 {
-    char *options = (char*)pvParameter;
     xGuiSemaphore = xSemaphoreCreateMutex();
 
     lv_init();
@@ -279,6 +506,12 @@ guiTask(
 #endif
 
     disp_drv.buffer = &disp_buf;
+
+#if LV_USE_REFR_WORKER
+    /* Draw half of every band on the other core */
+    refr_worker_init(&disp_drv, GUI_WORKER_CORE);
+#endif
+
     lv_disp_drv_register(&disp_drv);
 
     /* Register an input device when enabled on the menuconfig */
@@ -290,27 +523,25 @@ guiTask(
     lv_indev_drv_register(&indev_drv);
 #endif
 
-    /* Create and start a periodic timer interrupt to call lv_tick_inc */
-    const esp_timer_create_args_t periodic_timer_args = {
-        .callback = &lv_tick_task,
-        .name = "periodic_gui"
-    };
-    esp_timer_handle_t periodic_timer;
-    ESP_ERROR_CHECK(esp_timer_create(&periodic_timer_args, &periodic_timer));
-    ESP_ERROR_CHECK(esp_timer_start_periodic(periodic_timer, LV_TICK_PERIOD_MS * 1000));
+    /* No periodic lv_tick_inc() interrupt: LV_TICK_CUSTOM derives the
+     * LVGL tick from esp_timer_get_time() (see sdkconfig.defaults). */
 
     /* Create the demo application */
-    create_widgets(options);
+    create_widgets();
 
     while (1) {
-        /* Delay 1 tick (assumes FreeRTOS tick is 10ms */
-        vTaskDelay(pdMS_TO_TICKS(10));
+        uint32_t wait_ms = LV_NO_TASK_READY;
 
         /* Try to take the semaphore, call lvgl related function on success */
         if (pdTRUE == xSemaphoreTake(xGuiSemaphore, portMAX_DELAY)) {
-            lv_task_handler();
+            gui_cmd_drain();
+            keypad_indev_kick();
+            wait_ms = lv_task_handler();
             xSemaphoreGive(xGuiSemaphore);
-       }
+        }
+
+        /* Sleep until the next LVGL task is due, or until gui_wake() */
+        ulTaskNotifyTake(pdTRUE, gui_ms_to_ticks(wait_ms));
     }
 
     /* A task should NEVER return */
@@ -320,10 +551,3 @@ guiTask(
 #endif
     vTaskDelete(NULL);
 }
-
-
-static void lv_tick_task(void *arg) {
-    (void) arg;
-
-    lv_tick_inc(LV_TICK_PERIOD_MS);
-}
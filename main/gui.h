@@ -1,5 +1,20 @@
-#include "audio_event_iface.h"
-#include "periph_button.h"
-
-void gui_init(char* options);
-void gui_button(audio_event_iface_msg_t msg);
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Same signature as lv_async_cb_t */
+typedef void (*gui_async_cb_t)(void *user_data);
+
+/* Returns the name of station `row`. Called from the GUI task for rows
+ * scrolling into view; the string must stay valid while displayed. */
+typedef const char *(*gui_row_cb_t)(uint16_t row, void *user_data);
+
+void gui_init(uint16_t row_cnt, gui_row_cb_t row_cb, void *user_data);
+void gui_wake(void);
+void gui_wake_from_isr(void);
+
+/* Cross-task commands. Safe to call from any task, never block. */
+bool gui_set_selected(uint16_t index);
+bool gui_step_selected(int16_t delta);
+bool gui_async_call(gui_async_cb_t cb, void *user_data);
+bool gui_set_track(const char *song, const char *artist);
+bool gui_set_progress(uint32_t elapsed_ms, uint32_t total_ms, uint8_t buffer_pct);
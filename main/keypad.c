@@ -0,0 +1,257 @@
+/* Keypad input device
+ *
+ * Interrupt driven driver for the board's push buttons. Edges are
+ * debounced with a hardware timer and the settled key changes are queued
+ * in a ring buffer that LVGL drains through a buffered keypad indev.
+ * Nothing runs while no key is touched.
+ *
+ * This example code is in the Public Domain (or CC0 licensed, at your option.)
+ *
+ * Unless required by applicable law or agreed to in writing, this
+ * software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.
+ */
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "esp_attr.h"
+#include "esp_err.h"
+#include "driver/gpio.h"
+#include "driver/timer.h"
+
+#include "keypad.h"
+#include "gui.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifdef CONFIG_ESP_AI_THINKER_V2_2_BOARD
+    #define NUM_KEYS 6
+#else
+    #error Need keyboard mapping for audio board
+#endif
+
+/* Time the level must be stable before a key change is reported */
+#define KEYPAD_DEBOUNCE_US 20000
+
+/* 80 MHz APB / 80 = 1 tick per microsecond */
+#define KEYPAD_TIMER_GROUP   TIMER_GROUP_1
+#define KEYPAD_TIMER_IDX     TIMER_0
+#define KEYPAD_TIMER_DIVIDER 80
+
+/* Length of the event ring. Must be a power of 2. */
+#define KEYPAD_RING_LEN 16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    gpio_num_t gpio;
+    uint32_t key;       /* LV_KEY_* sent to LVGL, 0 to ignore the pin */
+} keypad_key_t;
+
+typedef struct {
+    uint32_t key;
+    lv_indev_state_t state;
+} keypad_event_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void keypad_gpio_isr(void *arg);
+static void keypad_timer_isr(void *arg);
+static bool keypad_read(lv_indev_drv_t *drv, lv_indev_data_t *data);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const keypad_key_t s_keys[NUM_KEYS] = {
+    { GPIO_NUM_36, LV_KEY_ENTER },  // 1 works
+    { GPIO_NUM_13, 0 },             // 2 Used for MTCK
+    { GPIO_NUM_19, LV_KEY_UP },     // 3 works.
+    { GPIO_NUM_23, LV_KEY_DOWN },   // 4         on pin header. connected to red led on pcb
+    { GPIO_NUM_18, 0 },             // 5         on pin header.
+    { GPIO_NUM_5,  0 },             // 6 works.  on pin header.
+};
+
+/* Debounced state of each key. Written by the timer ISR only. */
+static lv_indev_state_t s_stable[NUM_KEYS];
+
+/* Single producer (timer ISR), single consumer (GUI task) */
+static keypad_event_t s_ring[KEYPAD_RING_LEN];
+static volatile uint32_t s_ring_head;
+static volatile uint32_t s_ring_tail;
+
+static lv_indev_t *s_indev;
+static keypad_event_t s_last = { 0, LV_INDEV_STATE_REL };
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/* Set up the GPIO and timer interrupts and register the LVGL keypad indev.
+ * Call from the GUI task after lv_init(). */
+lv_indev_t*
+keypad_indev_register(void)
+{
+    lv_indev_drv_t indev_drv;
+    esp_err_t err;
+
+    timer_config_t timer_cfg = {
+        .divider = KEYPAD_TIMER_DIVIDER,
+        .counter_dir = TIMER_COUNT_UP,
+        .counter_en = TIMER_START,
+        .alarm_en = TIMER_ALARM_DIS,
+        .auto_reload = TIMER_AUTORELOAD_DIS,
+    };
+    ESP_ERROR_CHECK(timer_init(KEYPAD_TIMER_GROUP, KEYPAD_TIMER_IDX, &timer_cfg));
+    ESP_ERROR_CHECK(timer_enable_intr(KEYPAD_TIMER_GROUP, KEYPAD_TIMER_IDX));
+    ESP_ERROR_CHECK(timer_isr_register(KEYPAD_TIMER_GROUP, KEYPAD_TIMER_IDX, keypad_timer_isr,
+        NULL, ESP_INTR_FLAG_IRAM, NULL));
+
+    // Another driver may already have installed the service
+    err = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_ERROR_CHECK(err);
+    }
+
+    for (int i = 0; i < NUM_KEYS; i++) {
+        s_stable[i] = LV_INDEV_STATE_REL;
+        if (0 == s_keys[i].key) {
+            continue;
+        }
+
+        gpio_config_t io_cfg = {
+            .pin_bit_mask = 1ULL << s_keys[i].gpio,
+            .mode = GPIO_MODE_INPUT,
+            // GPIO 34-39 have no internal pull-ups; the board provides them
+            .pull_up_en = GPIO_IS_VALID_OUTPUT_GPIO(s_keys[i].gpio) ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE,
+            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+            .intr_type = GPIO_INTR_ANYEDGE,
+        };
+        ESP_ERROR_CHECK(gpio_config(&io_cfg));
+        ESP_ERROR_CHECK(gpio_isr_handler_add(s_keys[i].gpio, keypad_gpio_isr, NULL));
+    }
+
+    lv_indev_drv_init(&indev_drv);
+    indev_drv.type = LV_INDEV_TYPE_KEYPAD;
+    indev_drv.read_cb = keypad_read;
+    s_indev = lv_indev_drv_register(&indev_drv);
+
+    return s_indev;
+}
+
+
+/* Restart LVGL polling of the keypad if the ISR queued events while it
+ * was parked. Call from the GUI task before lv_task_handler(). */
+void
+keypad_indev_kick(void)
+{
+    lv_task_t *read_task;
+
+    if (!s_indev || s_ring_head == s_ring_tail) {
+        return;
+    }
+
+    read_task = s_indev->driver.read_task;
+    if (read_task->prio == LV_TASK_PRIO_OFF) {
+        lv_task_set_prio(read_task, LV_TASK_PRIO_HIGH);
+        lv_task_ready(read_task);
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/* Any edge on any key (re)starts the debounce window. Bounces keep pushing
+ * the alarm out, so the timer fires once the lines have been quiet for
+ * KEYPAD_DEBOUNCE_US. */
+static void IRAM_ATTR
+keypad_gpio_isr(
+    void *arg)
+{
+    uint64_t now = timer_group_get_counter_value_in_isr(KEYPAD_TIMER_GROUP, KEYPAD_TIMER_IDX);
+
+    timer_group_set_alarm_value_in_isr(KEYPAD_TIMER_GROUP, KEYPAD_TIMER_IDX, now + KEYPAD_DEBOUNCE_US);
+    timer_group_enable_alarm_in_isr(KEYPAD_TIMER_GROUP, KEYPAD_TIMER_IDX);
+}
+
+
+/* Sample the settled levels and queue every key that changed state.
+ * If the ring is full, the alarm is re-armed so the remaining changes are
+ * sampled again once the GUI task has drained some events. */
+static void IRAM_ATTR
+keypad_timer_isr(
+    void *arg)
+{
+    bool wake = false;
+
+    timer_group_clr_intr_status_in_isr(KEYPAD_TIMER_GROUP, KEYPAD_TIMER_IDX);
+
+    for (int i = 0; i < NUM_KEYS; i++) {
+        lv_indev_state_t state;
+
+        if (0 == s_keys[i].key) {
+            continue;
+        }
+
+        // Keys are active low
+        state = gpio_get_level(s_keys[i].gpio) ? LV_INDEV_STATE_REL : LV_INDEV_STATE_PR;
+        if (state == s_stable[i]) {
+            continue;
+        }
+
+        // The GUI task has fallen this far behind: retry after it has caught up
+        if (s_ring_head - s_ring_tail >= KEYPAD_RING_LEN) {
+            uint64_t now = timer_group_get_counter_value_in_isr(KEYPAD_TIMER_GROUP, KEYPAD_TIMER_IDX);
+
+            timer_group_set_alarm_value_in_isr(KEYPAD_TIMER_GROUP, KEYPAD_TIMER_IDX, now + KEYPAD_DEBOUNCE_US);
+            timer_group_enable_alarm_in_isr(KEYPAD_TIMER_GROUP, KEYPAD_TIMER_IDX);
+            wake = true;
+            break;
+        }
+
+        s_stable[i] = state;
+        s_ring[s_ring_head & (KEYPAD_RING_LEN - 1)] = (keypad_event_t){ s_keys[i].key, state };
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        s_ring_head++;
+        wake = true;
+    }
+
+    if (wake) {
+        gui_wake_from_isr();
+    }
+}
+
+
+/* LVGL keypad read callback in buffered mode: returns true while more
+ * events are queued so LVGL calls it again in the same cycle and no press
+ * is lost. Once the ring is empty and every key is released, the indev's
+ * read task is parked until keypad_indev_kick() sees new events. */
+static bool
+keypad_read(
+    lv_indev_drv_t *drv,
+    lv_indev_data_t *data)
+{
+    if (s_ring_head != s_ring_tail) {
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        s_last = s_ring[s_ring_tail & (KEYPAD_RING_LEN - 1)];
+        s_ring_tail++;
+    }
+
+    data->key = s_last.key;
+    data->state = s_last.state;
+
+    if (s_ring_head != s_ring_tail) {
+        return true;
+    }
+
+    // Keep polling while a key is held so LVGL can detect long presses
+    if (LV_INDEV_STATE_REL == s_last.state) {
+        lv_task_set_prio(drv->read_task, LV_TASK_PRIO_OFF);
+    }
+
+    return false;
+}
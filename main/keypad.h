@@ -0,0 +1,11 @@
+#pragma once
+
+/* Littlevgl specific */
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+lv_indev_t* keypad_indev_register(void);
+void keypad_indev_kick(void);
@@ -0,0 +1,547 @@
+/**
+ * @file now_playing.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "now_playing.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_OBJX_NAME "now_playing"
+
+#define NOW_PLAYING_BAR_H 6
+#define NOW_PLAYING_BUFFER_H 2
+#define NOW_PLAYING_REFR_PERIOD 100
+#define NOW_PLAYING_BUDGET_WINDOW 1000
+
+/*Flags of `dirty`*/
+#define DIRTY_TRACK    0x01
+#define DIRTY_PROGRESS 0x02
+#define DIRTY_TIME     0x04
+#define DIRTY_BUFFER   0x08
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_design_res_t now_playing_design(lv_obj_t * np, const lv_area_t * clip_area, lv_design_mode_t mode);
+static lv_res_t now_playing_signal(lv_obj_t * np, lv_signal_t sign, void * param);
+static void refr_task(lv_task_t * task);
+static void refr_layout(lv_obj_t * np);
+static void mark_dirty(lv_obj_t * np, uint8_t flags);
+static bool budget_take(now_playing_ext_t * ext, uint32_t px);
+static bool apply_track(lv_obj_t * np);
+static bool apply_time(lv_obj_t * np);
+static bool apply_meter(lv_obj_t * np, lv_coord_t * drawn_w, lv_coord_t new_w, lv_coord_t y, lv_coord_t h);
+static void get_bar_area(lv_obj_t * np, lv_area_t * area);
+static lv_coord_t progress_width(lv_obj_t * np);
+static lv_coord_t buffer_width(lv_obj_t * np);
+static char * text_dup(char * old, const char * txt);
+static uint32_t text_hash(const char * txt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_design_cb_t ancestor_design;
+static lv_signal_cb_t ancestor_signal;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Create a now playing object
+ * @param par pointer to an object, it will be the parent of the new object
+ * @return pointer to the created object
+ */
+lv_obj_t * now_playing_create(lv_obj_t * par)
+{
+    LV_LOG_TRACE("now playing create started");
+
+    /*Create the ancestor basic object*/
+    lv_obj_t * np = lv_obj_create(par, NULL);
+    LV_ASSERT_MEM(np);
+    if(np == NULL) return NULL;
+
+    if(ancestor_signal == NULL) ancestor_signal = lv_obj_get_signal_cb(np);
+    if(ancestor_design == NULL) ancestor_design = lv_obj_get_design_cb(np);
+
+    /*Allocate the object type specific extended data*/
+    now_playing_ext_t * ext = lv_obj_allocate_ext_attr(np, sizeof(now_playing_ext_t));
+    LV_ASSERT_MEM(ext);
+    if(ext == NULL) {
+        lv_obj_del(np);
+        return NULL;
+    }
+
+    _lv_memset_00(ext, sizeof(now_playing_ext_t));
+    lv_style_list_init(&ext->style_indic);
+    ext->budget_start = lv_tick_get();
+
+    ext->task = lv_task_create(refr_task, NOW_PLAYING_REFR_PERIOD, LV_TASK_PRIO_OFF, np);
+    LV_ASSERT_MEM(ext->task);
+    if(ext->task == NULL) {
+        lv_obj_del(np);
+        return NULL;
+    }
+
+    lv_obj_set_signal_cb(np, now_playing_signal);
+    lv_obj_set_design_cb(np, now_playing_design);
+
+    /*The labels keep their size whatever the text so a change never moves a neighbour*/
+    ext->song = lv_label_create(np, NULL);
+    lv_label_set_long_mode(ext->song, LV_LABEL_LONG_DOT);
+    lv_label_set_text_static(ext->song, "");
+
+    ext->artist = lv_label_create(np, NULL);
+    lv_label_set_long_mode(ext->artist, LV_LABEL_LONG_DOT);
+    lv_label_set_text_static(ext->artist, "");
+
+    ext->elapsed = lv_label_create(np, NULL);
+    lv_label_set_long_mode(ext->elapsed, LV_LABEL_LONG_CROP);
+    lv_label_set_text_static(ext->elapsed, "");
+
+    ext->remaining = lv_label_create(np, NULL);
+    lv_label_set_long_mode(ext->remaining, LV_LABEL_LONG_CROP);
+    lv_label_set_align(ext->remaining, LV_LABEL_ALIGN_RIGHT);
+    lv_label_set_text_static(ext->remaining, "");
+
+    lv_theme_apply(np, LV_THEME_CONT);
+    lv_obj_set_style_local_bg_color(np, NOW_PLAYING_PART_INDIC, LV_STATE_DEFAULT, LV_THEME_DEFAULT_COLOR_PRIMARY);
+    lv_obj_set_style_local_bg_opa(np, NOW_PLAYING_PART_INDIC, LV_STATE_DEFAULT, LV_OPA_COVER);
+    refr_layout(np);
+
+    LV_LOG_INFO("now playing created");
+
+    return np;
+}
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set the song and the artist. Both strings are copied.
+ * @param np pointer to a now playing object
+ * @param song name of the song
+ * @param artist name of the artist
+ */
+void now_playing_set_track(lv_obj_t * np, const char * song, const char * artist)
+{
+    LV_ASSERT_OBJ(np, LV_OBJX_NAME);
+
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+    ext->song_txt   = text_dup(ext->song_txt, song ? song : "");
+    ext->artist_txt = text_dup(ext->artist_txt, artist ? artist : "");
+    mark_dirty(np, DIRTY_TRACK);
+}
+
+/**
+ * Set the playback position
+ * @param np pointer to a now playing object
+ * @param elapsed_ms time played so far
+ * @param total_ms length of the track, 0 if unknown
+ */
+void now_playing_set_progress(lv_obj_t * np, uint32_t elapsed_ms, uint32_t total_ms)
+{
+    LV_ASSERT_OBJ(np, LV_OBJX_NAME);
+
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+    if(total_ms && elapsed_ms > total_ms) elapsed_ms = total_ms;
+
+    /*The labels show whole seconds, most calls change nothing visible*/
+    bool time_chg = ext->elapsed_ms / 1000 != elapsed_ms / 1000 || ext->total_ms / 1000 != total_ms / 1000;
+    ext->elapsed_ms = elapsed_ms;
+    ext->total_ms   = total_ms;
+
+    uint8_t flags = 0;
+    if(time_chg) flags |= DIRTY_TIME;
+    if(progress_width(np) != ext->progress_w) flags |= DIRTY_PROGRESS;
+    mark_dirty(np, flags);
+}
+
+/**
+ * Set how full the stream buffer is
+ * @param np pointer to a now playing object
+ * @param pct 0..100
+ */
+void now_playing_set_buffer(lv_obj_t * np, uint8_t pct)
+{
+    LV_ASSERT_OBJ(np, LV_OBJX_NAME);
+
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+    if(pct > 100) pct = 100;
+    ext->buffer_pct = pct;
+
+    mark_dirty(np, buffer_width(np) != ext->buffer_w ? DIRTY_BUFFER : 0);
+}
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the number of pixels the object invalidated since it was created
+ * @param np pointer to a now playing object
+ * @return number of pixels
+ */
+uint32_t now_playing_get_redraw_px(const lv_obj_t * np)
+{
+    LV_ASSERT_OBJ(np, LV_OBJX_NAME);
+
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+    return ext->redraw_px;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Handle the drawing related tasks of the now playing object
+ * @param np pointer to an object
+ * @param clip_area the object will be drawn only in this area
+ * @param mode LV_DESIGN_COVER_CHK: only check if the object fully covers the 'mask_p' area
+ *                                  (return 'true' if yes)
+ *             LV_DESIGN_DRAW: draw the object (always return 'true')
+ *             LV_DESIGN_DRAW_POST: drawing after every children are drawn
+ * @param return an element of `lv_design_res_t`
+ */
+static lv_design_res_t now_playing_design(lv_obj_t * np, const lv_area_t * clip_area, lv_design_mode_t mode)
+{
+    if(mode != LV_DESIGN_DRAW_MAIN) return ancestor_design(np, clip_area, mode);
+
+    ancestor_design(np, clip_area, mode);
+
+    /*Draw what `progress_w` and `buffer_w` say, not the latest values, so the
+     *pixels on the screen always match what the next update will invalidate*/
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+    lv_area_t bar;
+    get_bar_area(np, &bar);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    lv_obj_init_draw_rect_dsc(np, NOW_PLAYING_PART_INDIC, &dsc);
+    /*Square ends: a moving rounded end would change more than the strip in between*/
+    dsc.radius = 0;
+
+    lv_opa_t opa = dsc.bg_opa;
+    dsc.bg_opa = opa / 4;
+    lv_draw_rect(&bar, clip_area, &dsc);
+
+    lv_area_t indic = bar;
+    dsc.bg_opa = opa;
+    if(ext->progress_w > 0) {
+        indic.y2 = bar.y1 + NOW_PLAYING_BAR_H - 1;
+        indic.x2 = bar.x1 + ext->progress_w - 1;
+        lv_draw_rect(&indic, clip_area, &dsc);
+    }
+
+    if(ext->buffer_w > 0) {
+        dsc.bg_opa = opa / 2;
+        indic.y1 = bar.y2 - NOW_PLAYING_BUFFER_H + 1;
+        indic.y2 = bar.y2;
+        indic.x2 = bar.x1 + ext->buffer_w - 1;
+        lv_draw_rect(&indic, clip_area, &dsc);
+    }
+
+    return LV_DESIGN_RES_OK;
+}
+
+/**
+ * Signal function of the now playing object
+ * @param np pointer to a now playing object
+ * @param sign a signal type from lv_signal_t enum
+ * @param param pointer to a signal specific variable
+ * @return LV_RES_OK: the object is not deleted in the function; LV_RES_INV: the object is deleted
+ */
+static lv_res_t now_playing_signal(lv_obj_t * np, lv_signal_t sign, void * param)
+{
+    lv_res_t res;
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+
+    if(sign == LV_SIGNAL_GET_STYLE) {
+        lv_get_style_info_t * info = param;
+        if(info->part == NOW_PLAYING_PART_INDIC) {
+            info->result = &ext->style_indic;
+            return LV_RES_OK;
+        }
+        return ancestor_signal(np, sign, param);
+    }
+
+    /* Include the ancient signal function */
+    res = ancestor_signal(np, sign, param);
+    if(res != LV_RES_OK) return res;
+    if(sign == LV_SIGNAL_GET_TYPE) return lv_obj_handle_get_type_signal(param, LV_OBJX_NAME);
+
+    if(sign == LV_SIGNAL_STYLE_CHG) {
+        refr_layout(np);
+    }
+    else if(sign == LV_SIGNAL_COORD_CHG) {
+        if(lv_obj_get_width(np) != lv_area_get_width(param)) refr_layout(np);
+    }
+    else if(sign == LV_SIGNAL_CLEANUP) {
+        lv_obj_clean_style_list(np, NOW_PLAYING_PART_INDIC);
+        if(ext->task) lv_task_del(ext->task);
+        ext->task = NULL;
+        lv_mem_free(ext->song_txt);
+        lv_mem_free(ext->artist_txt);
+        ext->song_txt = NULL;
+        ext->artist_txt = NULL;
+    }
+
+    return res;
+}
+
+/**
+ * Apply the pending changes that fit into this second's budget, most
+ * important first. Parks itself once nothing is left.
+ * @param task the widget's refresh task, `user_data` is the object
+ */
+static void refr_task(lv_task_t * task)
+{
+    lv_obj_t * np = task->user_data;
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+
+    if(lv_tick_elaps(ext->budget_start) >= NOW_PLAYING_BUDGET_WINDOW) {
+        ext->budget_start = lv_tick_get();
+        ext->budget_used = 0;
+    }
+
+    if((ext->dirty & DIRTY_TRACK) && apply_track(np)) ext->dirty &= ~DIRTY_TRACK;
+    if((ext->dirty & DIRTY_PROGRESS) &&
+       apply_meter(np, &ext->progress_w, progress_width(np), ext->bar_y, NOW_PLAYING_BAR_H)) {
+        ext->dirty &= ~DIRTY_PROGRESS;
+    }
+    if((ext->dirty & DIRTY_TIME) && apply_time(np)) ext->dirty &= ~DIRTY_TIME;
+    if((ext->dirty & DIRTY_BUFFER) &&
+       apply_meter(np, &ext->buffer_w, buffer_width(np), ext->bar_y + NOW_PLAYING_BAR_H, NOW_PLAYING_BUFFER_H)) {
+        ext->dirty &= ~DIRTY_BUFFER;
+    }
+
+    if(ext->dirty == 0) lv_task_set_prio(task, LV_TASK_PRIO_OFF);
+}
+
+/**
+ * Place the labels and the bars after a style or width change
+ * @param np pointer to a now playing object
+ */
+static void refr_layout(lv_obj_t * np)
+{
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+    if(ext->remaining == NULL) return;
+
+    const lv_font_t * font = lv_obj_get_style_text_font(np, NOW_PLAYING_PART_BG);
+    lv_style_int_t top = lv_obj_get_style_pad_top(np, NOW_PLAYING_PART_BG);
+    lv_style_int_t bottom = lv_obj_get_style_pad_bottom(np, NOW_PLAYING_PART_BG);
+    lv_style_int_t left = lv_obj_get_style_pad_left(np, NOW_PLAYING_PART_BG);
+    lv_style_int_t right = lv_obj_get_style_pad_right(np, NOW_PLAYING_PART_BG);
+    lv_style_int_t inner = lv_obj_get_style_pad_inner(np, NOW_PLAYING_PART_BG);
+    lv_coord_t line_h = lv_font_get_line_height(font);
+    lv_coord_t w = lv_obj_get_width(np) - left - right;
+    lv_coord_t y = top;
+
+    lv_obj_set_size(ext->song, w, line_h);
+    lv_obj_set_pos(ext->song, left, y);
+    y += line_h;
+
+    lv_obj_set_size(ext->artist, w, line_h);
+    lv_obj_set_pos(ext->artist, left, y);
+    y += line_h + inner;
+
+    ext->bar_y = y;
+    y += NOW_PLAYING_BAR_H + NOW_PLAYING_BUFFER_H + inner;
+
+    lv_obj_set_size(ext->elapsed, w / 2, line_h);
+    lv_obj_set_pos(ext->elapsed, left, y);
+    lv_obj_set_size(ext->remaining, w - w / 2, line_h);
+    lv_obj_set_pos(ext->remaining, left + w / 2, y);
+    y += line_h;
+
+    lv_obj_set_height(np, y + bottom);
+
+    /*The whole object is redrawn anyway, catch up with the current values*/
+    ext->progress_w = progress_width(np);
+    ext->buffer_w = buffer_width(np);
+    ext->dirty &= ~(DIRTY_PROGRESS | DIRTY_BUFFER);
+    lv_obj_invalidate(np);
+}
+
+static void mark_dirty(lv_obj_t * np, uint8_t flags)
+{
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+    if(flags == 0) return;
+
+    ext->dirty |= flags;
+    if(ext->task->prio == LV_TASK_PRIO_OFF) {
+        lv_task_set_prio(ext->task, LV_TASK_PRIO_LOW);
+        lv_task_ready(ext->task);
+    }
+}
+
+/**
+ * Charge `px` invalidated pixels to the current window.
+ * The first change of a window always passes so a change larger than the
+ * whole budget is delayed, never starved.
+ * @return true: the change may be applied now
+ */
+static bool budget_take(now_playing_ext_t * ext, uint32_t px)
+{
+    if(ext->budget_used && ext->budget_used + px > NOW_PLAYING_REDRAW_BUDGET_PX) return false;
+
+    ext->budget_used += px;
+    ext->redraw_px += px;
+    return true;
+}
+
+static bool apply_track(lv_obj_t * np)
+{
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+    /*LV_LABEL_LONG_DOT rewrites the label's text, so compare against hashes of what was set*/
+    uint32_t song_hash = ext->song_txt ? text_hash(ext->song_txt) : ext->song_hash;
+    uint32_t artist_hash = ext->artist_txt ? text_hash(ext->artist_txt) : ext->artist_hash;
+    bool song_chg = song_hash != ext->song_hash;
+    bool artist_chg = artist_hash != ext->artist_hash;
+
+    uint32_t px = 0;
+    if(song_chg) px += lv_area_get_size(&ext->song->coords);
+    if(artist_chg) px += lv_area_get_size(&ext->artist->coords);
+    if(px && !budget_take(ext, px)) return false;
+
+    if(song_chg) lv_label_set_text(ext->song, ext->song_txt);
+    if(artist_chg) lv_label_set_text(ext->artist, ext->artist_txt);
+    ext->song_hash = song_hash;
+    ext->artist_hash = artist_hash;
+
+    lv_mem_free(ext->song_txt);
+    lv_mem_free(ext->artist_txt);
+    ext->song_txt = NULL;
+    ext->artist_txt = NULL;
+    return true;
+}
+
+static bool apply_time(lv_obj_t * np)
+{
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+    char elapsed[16];
+    char remaining[16];
+    uint32_t s = ext->elapsed_ms / 1000;
+
+    lv_snprintf(elapsed, sizeof(elapsed), "%d:%02d", (int)(s / 60), (int)(s % 60));
+    remaining[0] = '\0';
+    if(ext->total_ms) {
+        s = ext->total_ms / 1000 - s;
+        lv_snprintf(remaining, sizeof(remaining), "-%d:%02d", (int)(s / 60), (int)(s % 60));
+    }
+
+    bool elapsed_chg = strcmp(lv_label_get_text(ext->elapsed), elapsed) != 0;
+    bool remaining_chg = strcmp(lv_label_get_text(ext->remaining), remaining) != 0;
+
+    uint32_t px = 0;
+    if(elapsed_chg) px += lv_area_get_size(&ext->elapsed->coords);
+    if(remaining_chg) px += lv_area_get_size(&ext->remaining->coords);
+    if(px && !budget_take(ext, px)) return false;
+
+    if(elapsed_chg) lv_label_set_text(ext->elapsed, elapsed);
+    if(remaining_chg) lv_label_set_text(ext->remaining, remaining);
+    return true;
+}
+
+/**
+ * Move the end of a bar to `new_w` and invalidate only the columns between
+ * the old and the new end.
+ * @param np pointer to a now playing object
+ * @param drawn_w width of the indicator as currently drawn, updated
+ * @param new_w the new width of the indicator
+ * @param y offset of the bar from the top of the object
+ * @param h height of the bar
+ * @return true: applied; false: over budget, try again later
+ */
+static bool apply_meter(lv_obj_t * np, lv_coord_t * drawn_w, lv_coord_t new_w, lv_coord_t y, lv_coord_t h)
+{
+    if(new_w == *drawn_w) return true;
+
+    lv_area_t strip;
+    get_bar_area(np, &strip);
+    strip.x2 = strip.x1 + LV_MATH_MAX(new_w, *drawn_w) - 1;
+    strip.x1 = strip.x1 + LV_MATH_MIN(new_w, *drawn_w);
+    strip.y1 = np->coords.y1 + y;
+    strip.y2 = strip.y1 + h - 1;
+
+    if(!budget_take(lv_obj_get_ext_attr(np), lv_area_get_size(&strip))) return false;
+
+    *drawn_w = new_w;
+    lv_obj_invalidate_area(np, &strip);
+    return true;
+}
+
+static void get_bar_area(lv_obj_t * np, lv_area_t * area)
+{
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+    area->x1 = np->coords.x1 + lv_obj_get_style_pad_left(np, NOW_PLAYING_PART_BG);
+    area->x2 = np->coords.x2 - lv_obj_get_style_pad_right(np, NOW_PLAYING_PART_BG);
+    area->y1 = np->coords.y1 + ext->bar_y;
+    area->y2 = area->y1 + NOW_PLAYING_BAR_H + NOW_PLAYING_BUFFER_H - 1;
+}
+
+static lv_coord_t progress_width(lv_obj_t * np)
+{
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+    if(ext->total_ms == 0) return 0;
+
+    lv_area_t bar;
+    get_bar_area(np, &bar);
+    return (uint64_t)lv_area_get_width(&bar) * ext->elapsed_ms / ext->total_ms;
+}
+
+static lv_coord_t buffer_width(lv_obj_t * np)
+{
+    now_playing_ext_t * ext = lv_obj_get_ext_attr(np);
+
+    lv_area_t bar;
+    get_bar_area(np, &bar);
+    return (int32_t)lv_area_get_width(&bar) * ext->buffer_pct / 100;
+}
+
+/**
+ * Replace a pending text, reusing the old buffer
+ * @param old the previous copy or NULL
+ * @param txt the new text
+ * @return the new copy or NULL if out of memory
+ */
+static char * text_dup(char * old, const char * txt)
+{
+    size_t len = strlen(txt) + 1;
+    char * copy = lv_mem_realloc(old, len);
+    LV_ASSERT_MEM(copy);
+    if(copy == NULL) {
+        lv_mem_free(old);
+        return NULL;
+    }
+
+    _lv_memcpy(copy, txt, len);
+    return copy;
+}
+
+/*FNV-1a*/
+static uint32_t text_hash(const char * txt)
+{
+    uint32_t h = 2166136261u;
+    while(*txt) {
+        h ^= (uint8_t) * txt++;
+        h *= 16777619u;
+    }
+    return h;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file now_playing.h
+ * Song, artist, elapsed/remaining time, a progress bar and the stream
+ * buffer level. Updates are queued and applied by an internal task that
+ * invalidates only what changed, within a fixed number of redrawn pixels
+ * per second.
+ */
+
+#ifndef NOW_PLAYING_H
+#define NOW_PLAYING_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Pixels the widget may invalidate per second. Changes over the budget wait for the next second.*/
+#ifndef NOW_PLAYING_REDRAW_BUDGET_PX
+#define NOW_PLAYING_REDRAW_BUDGET_PX (LV_HOR_RES_MAX * 48)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Data of now playing*/
+typedef struct {
+    /*New data for this type */
+    lv_obj_t * song;
+    lv_obj_t * artist;
+    lv_obj_t * elapsed;
+    lv_obj_t * remaining;
+    lv_task_t * task;           /*Applies pending changes, parked while there are none*/
+    lv_style_list_t style_indic;
+    char * song_txt;            /*Pending texts, NULL if unchanged*/
+    char * artist_txt;
+    uint32_t song_hash;         /*Hash of the texts shown, 0 before the first track*/
+    uint32_t artist_hash;
+    uint32_t elapsed_ms;
+    uint32_t total_ms;
+    uint32_t budget_start;      /*Tick when the current one second window started*/
+    uint32_t budget_used;       /*Pixels invalidated in the current window*/
+    uint32_t redraw_px;         /*Pixels invalidated in total, for profiling*/
+    lv_coord_t bar_y;           /*Offset of the progress bar from the top of the object*/
+    lv_coord_t progress_w;      /*Width of the progress indicator as drawn*/
+    lv_coord_t buffer_w;        /*Width of the buffer indicator as drawn*/
+    uint8_t buffer_pct;
+    uint8_t dirty;
+} now_playing_ext_t;
+
+enum {
+    NOW_PLAYING_PART_BG = LV_OBJ_PART_MAIN,
+    NOW_PLAYING_PART_INDIC = _LV_OBJ_PART_VIRTUAL_LAST,
+};
+typedef uint8_t now_playing_part_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a now playing object
+ * @param par pointer to an object, it will be the parent of the new object
+ * @return pointer to the created object
+ */
+lv_obj_t * now_playing_create(lv_obj_t * par);
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set the song and the artist. Both strings are copied.
+ * @param np pointer to a now playing object
+ * @param song name of the song
+ * @param artist name of the artist
+ */
+void now_playing_set_track(lv_obj_t * np, const char * song, const char * artist);
+
+/**
+ * Set the playback position
+ * @param np pointer to a now playing object
+ * @param elapsed_ms time played so far
+ * @param total_ms length of the track, 0 if unknown
+ */
+void now_playing_set_progress(lv_obj_t * np, uint32_t elapsed_ms, uint32_t total_ms);
+
+/**
+ * Set how full the stream buffer is
+ * @param np pointer to a now playing object
+ * @param pct 0..100
+ */
+void now_playing_set_buffer(lv_obj_t * np, uint8_t pct);
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the number of pixels the object invalidated since it was created
+ * @param np pointer to a now playing object
+ * @return number of pixels
+ */
+uint32_t now_playing_get_redraw_px(const lv_obj_t * np);
+
+#endif /*NOW_PLAYING_H*/
@@ -26,6 +26,7 @@
 #include "periph_wifi.h"
 #include "periph_button.h"
 #include "board.h"
+#include "ringbuf.h"
 
 #if __has_include("esp_idf_version.h")
 #include "esp_idf_version.h"
@@ -55,38 +56,87 @@ static bool s_wifi_connected;
 static const char *TAG = "PANDORAS BOX";
 
 #ifdef PITUZOL_GUI
+// Tracks are requested as HTTP_128_MP3, a constant 128 kbit/s
+#define TRACK_BYTES_PER_MS (128 / 8)
+
+// How often the now-playing progress is updated. The event loop waits at
+// most this long so it can post the update.
+#define NOW_PLAYING_PERIOD_MS 500
+#define EVENT_WAIT_TICKS pdMS_TO_TICKS(NOW_PLAYING_PERIOD_MS)
+#else
+#define EVENT_WAIT_TICKS portMAX_DELAY
+#endif
+
+#ifdef PITUZOL_GUI
+static const char *
+station_name(
+    uint16_t row,
+    void *user_data)
+{
+    pandora_station_t *stations = (pandora_station_t *)user_data;
+
+    return stations[row].name;
+}
+
+
 static void 
 setup_gui(
     pandora_helper_handle_t pandora_helper)
 {
     pandora_station_t *stations;
     size_t stations_len = 0;
-    size_t options_len = 1;
-    size_t i;
-    char *options;
 
     if (ESP_OK != pandora_helper_get_stations(pandora_helper, &stations, &stations_len))
     {
         return;
     }
 
-    // Concatenate all the station names into on string, delimited by newlines
-    for (i=0; i < stations_len; i++) {
-        options_len += strlen(stations[i].name) + 1;
+    // The station list counts its rows in 16 bits
+    if (stations_len > UINT16_MAX) {
+        ESP_LOGW(TAG, "Showing only the first %u of %u stations", UINT16_MAX, (unsigned)stations_len);
+        stations_len = UINT16_MAX;
     }
 
-    options = calloc(1, options_len);
+    // The station list pulls names on demand as rows scroll into view.
+    // The helper owns the stations array and keeps it until cleanup.
+    gui_init((uint16_t)stations_len, station_name, stations);
+}
 
-    for (i=0; i < stations_len; i++) {
-        strcat(options, stations[i].name);
-        if (i < stations_len - 1) {
-            strcat(options,"\n");
-        }
+
+static void
+post_track(
+    pandora_helper_handle_t pandora_helper)
+{
+    const pandora_track_t *track;
+
+    if (ESP_OK == pandora_helper_get_current_track(pandora_helper, &track)) {
+        gui_set_track(track->song, track->artist);
     }
+}
 
-    gui_init(options);
 
-    // Do not free options here because ownership gets transferred to a different thread.
+// Derive the position from the stream: whatever http has read minus what
+// still waits in the decoder's input buffer has been played.
+static void
+post_progress(
+    audio_element_handle_t http_stream_reader,
+    audio_element_handle_t mp3_decoder)
+{
+    audio_element_info_t info = {0};
+    ringbuf_handle_t rb = audio_element_get_input_ringbuf(mp3_decoder);
+    int buffered = rb ? rb_bytes_filled(rb) : 0;
+    int rb_size = rb ? rb_get_size(rb) : 0;
+    int64_t played;
+
+    audio_element_getinfo(http_stream_reader, &info);
+    played = info.byte_pos - buffered;
+    if (played < 0) {
+        played = 0;
+    }
+
+    gui_set_progress(played / TRACK_BYTES_PER_MS, 
+                     info.total_bytes / TRACK_BYTES_PER_MS,
+                     rb_size > 0 ? buffered * 100 / rb_size : 0);
 }
 #endif
 
@@ -205,12 +255,14 @@ void app_main(void)
     ESP_LOGI(TAG, "is Connected = %08x", periph_wifi_is_connected(wifi_handle));
     
 
-    // Buttons
+    // Buttons. With the GUI enabled they are owned by its keypad driver instead.
+    #ifndef PITUZOL_GUI
     periph_button_cfg_t btn_cfg = {
         .gpio_mask = GPIO_SEL_36 | GPIO_SEL_13 | GPIO_SEL_19 | GPIO_SEL_23 | GPIO_SEL_18 | GPIO_SEL_5
     };
     esp_periph_handle_t button_handle = periph_button_init(&btn_cfg);
     esp_periph_start(set, button_handle);
+    #endif
 
     // Pandora Helper
     pandora_helper = pandora_helper_init(CONFIG_PANDORA_USERNAME, CONFIG_PANDORA_PASSWORD);
@@ -234,13 +286,31 @@ void app_main(void)
 
     #ifdef PITUZOL_GUI
     setup_gui(pandora_helper);
+    post_track(pandora_helper);
+    TickType_t progress_ticks = xTaskGetTickCount();
     #endif
 
     while (true) {
         audio_event_iface_msg_t msg;
-        esp_err_t ret = audio_event_iface_listen(evt, &msg, portMAX_DELAY);
+        TickType_t listen_ticks = xTaskGetTickCount();
+        esp_err_t ret = audio_event_iface_listen(evt, &msg, EVENT_WAIT_TICKS);
+
+        #ifdef PITUZOL_GUI
+        if (xTaskGetTickCount() - progress_ticks >= EVENT_WAIT_TICKS) {
+            progress_ticks = xTaskGetTickCount();
+            post_progress(http_stream_reader, mp3_decoder);
+        }
+        #endif
+
         if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "[ * ] Event interface error : %d", ret);
+            // With the GUI a timeout is expected, it's the progress tick.
+            // The interface reports a timeout as ESP_FAIL too, so tell it by the time waited.
+            bool timed_out = ret == ESP_ERR_TIMEOUT
+                             || (EVENT_WAIT_TICKS != portMAX_DELAY
+                                 && xTaskGetTickCount() - listen_ticks >= EVENT_WAIT_TICKS);
+            if (!timed_out) {
+                ESP_LOGE(TAG, "[ * ] Event interface error : %d", ret);
+            }
             continue;
         }
 
@@ -276,6 +346,9 @@ void app_main(void)
                 audio_pipeline_reset_ringbuffer(pipeline);
                 audio_pipeline_reset_elements(pipeline);
                 audio_pipeline_run(pipeline);
+                #ifdef PITUZOL_GUI
+                post_track(pandora_helper);
+                #endif
                 continue;            
             } else {
                 // Something went wrong, can't get next track, just bail.
@@ -283,11 +356,6 @@ void app_main(void)
                 break;
             }
         }
-        #ifdef PITUZOL_GUI
-        if (msg.source_type == PERIPH_ID_BUTTON) {
-            gui_button(msg);
-        }
-        #endif
     }
  
 
@@ -0,0 +1,116 @@
+/* Render worker
+ *
+ * Lets LVGL draw the bottom half of every band on the other core while
+ * the GUI task draws the top half (CONFIG_LV_USE_REFR_WORKER). A pinned
+ * task waits for a job notification, runs it and gives a semaphore back.
+ *
+ * This example code is in the Public Domain (or CC0 licensed, at your option.)
+ *
+ * Unless required by applicable law or agreed to in writing, this
+ * software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, either express or implied.
+ */
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#include "refr_worker.h"
+
+#if LV_USE_REFR_WORKER
+
+/*********************
+ *      DEFINES
+ *********************/
+/* Draws like the GUI task so it needs the same stack */
+#define REFR_WORKER_STACK (4096*2)
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void worker_task(void *pvParameter);
+static void worker_start(lv_disp_drv_t *drv, void (*job)(void *), void *job_p);
+static void worker_wait(lv_disp_drv_t *drv);
+static void worker_lock(lv_disp_drv_t *drv, bool lock);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static TaskHandle_t s_task;
+static SemaphoreHandle_t s_done;
+static SemaphoreHandle_t s_lock;    /* recursive: the heap is locked inside the image cache's lock */
+static void (*s_job)(void *);
+static void *s_job_p;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/* Start the worker on `core_id` and hook it into the display driver.
+ * Call before lv_disp_drv_register(). The GUI task should be pinned to
+ * the other core. */
+void refr_worker_init(lv_disp_drv_t *drv, int core_id)
+{
+    s_done = xSemaphoreCreateBinary();
+    s_lock = xSemaphoreCreateRecursiveMutex();
+    assert(s_done != NULL && s_lock != NULL);
+
+    /* Same priority as the caller so neither half waits for the other */
+    BaseType_t res = xTaskCreatePinnedToCore(worker_task, "lv_worker", REFR_WORKER_STACK,
+        /*parameters*/NULL,
+        /*uxPriority*/uxTaskPriorityGet(NULL),
+        /*pvCreatedTask*/&s_task,
+        /*xCoreID*/core_id);
+    assert(res == pdPASS);
+
+    drv->worker_start_cb = worker_start;
+    drv->worker_wait_cb = worker_wait;
+    drv->worker_lock_cb = worker_lock;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void worker_task(void *pvParameter)
+{
+    (void) pvParameter;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        s_job(s_job_p);
+        xSemaphoreGive(s_done);
+    }
+}
+
+static void worker_start(lv_disp_drv_t *drv, void (*job)(void *), void *job_p)
+{
+    (void) drv;
+
+    s_job = job;
+    s_job_p = job_p;
+    xTaskNotifyGive(s_task);
+}
+
+static void worker_wait(lv_disp_drv_t *drv)
+{
+    (void) drv;
+
+    xSemaphoreTake(s_done, portMAX_DELAY);
+}
+
+static void worker_lock(lv_disp_drv_t *drv, bool lock)
+{
+    (void) drv;
+
+    if (lock) {
+        xSemaphoreTakeRecursive(s_lock, portMAX_DELAY);
+    } else {
+        xSemaphoreGiveRecursive(s_lock);
+    }
+}
+
+#endif /* LV_USE_REFR_WORKER */
@@ -0,0 +1,12 @@
+#pragma once
+
+/* Littlevgl specific */
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+#if LV_USE_REFR_WORKER
+void refr_worker_init(lv_disp_drv_t *drv, int core_id);
+#endif
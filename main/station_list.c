@@ -0,0 +1,455 @@
+/**
+ * @file station_list.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "station_list.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_OBJX_NAME "station_list"
+
+/*Off-screen rows kept above and below the visible ones so a scroll has content to slide in*/
+#define STATION_LIST_MARGIN 1
+#define STATION_LIST_VISIBLE_DEF 5
+#define STATION_LIST_ANIM_TIME 200
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_design_res_t station_list_design(lv_obj_t * list, const lv_area_t * clip_area, lv_design_mode_t mode);
+static lv_res_t station_list_signal(lv_obj_t * list, lv_signal_t sign, void * param);
+static void select_row(lv_obj_t * list, uint16_t sel, int32_t delta, lv_anim_enable_t anim);
+static void refr_rows(lv_obj_t * list);
+static void refr_layout(lv_obj_t * list);
+static void refr_pos(lv_obj_t * list);
+static uint16_t wrap_row(const station_list_ext_t * ext, int32_t row);
+#if LV_USE_ANIMATION
+    static void scroll_anim_cb(void * list, lv_anim_value_t v);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_design_cb_t ancestor_design;
+static lv_signal_cb_t ancestor_signal;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Create a station list object
+ * @param par pointer to an object, it will be the parent of the new list
+ * @return pointer to the created list
+ */
+lv_obj_t * station_list_create(lv_obj_t * par)
+{
+    LV_LOG_TRACE("station list create started");
+
+    /*Create the ancestor basic object*/
+    lv_obj_t * list = lv_obj_create(par, NULL);
+    LV_ASSERT_MEM(list);
+    if(list == NULL) return NULL;
+
+    if(ancestor_signal == NULL) ancestor_signal = lv_obj_get_signal_cb(list);
+    if(ancestor_design == NULL) ancestor_design = lv_obj_get_design_cb(list);
+
+    /*Allocate the object type specific extended data*/
+    station_list_ext_t * ext = lv_obj_allocate_ext_attr(list, sizeof(station_list_ext_t));
+    LV_ASSERT_MEM(ext);
+    if(ext == NULL) {
+        lv_obj_del(list);
+        return NULL;
+    }
+
+    _lv_memset_00(ext, sizeof(station_list_ext_t));
+    lv_style_list_init(&ext->style_sel);
+
+    lv_obj_set_signal_cb(list, station_list_signal);
+    lv_obj_set_design_cb(list, station_list_design);
+
+    lv_theme_apply(list, LV_THEME_ROLLER);
+    station_list_set_visible_row_count(list, STATION_LIST_VISIBLE_DEF);
+
+    LV_LOG_INFO("station list created");
+
+    return list;
+}
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set where the rows come from. Selects the first row.
+ * @param list pointer to a station list object
+ * @param row_cnt number of rows
+ * @param row_cb called for every row that scrolls into view
+ * @param user_data passed to `row_cb`
+ */
+void station_list_set_source(lv_obj_t * list, uint16_t row_cnt, station_list_row_cb_t row_cb, void * user_data)
+{
+    LV_ASSERT_OBJ(list, LV_OBJX_NAME);
+
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    ext->row_cnt   = row_cnt;
+    ext->row_cb    = row_cb;
+    ext->user_data = user_data;
+
+    select_row(list, 0, 0, LV_ANIM_OFF);
+}
+
+/**
+ * Set the height to show the given number of rows
+ * @param list pointer to a station list object
+ * @param row_cnt number of visible rows, an odd number keeps the selection centered
+ */
+void station_list_set_visible_row_count(lv_obj_t * list, uint8_t row_cnt)
+{
+    LV_ASSERT_OBJ(list, LV_OBJX_NAME);
+
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(row_cnt == 0) row_cnt = 1;
+    if(ext->slots && ext->visible_cnt == row_cnt) return;
+
+    /*Recreate the slot labels. Their number doesn't depend on the row count.*/
+    uint32_t i;
+    uint32_t slot_cnt = ext->visible_cnt + 2 * STATION_LIST_MARGIN;
+    if(ext->slots) {
+        for(i = 0; i < slot_cnt; i++) lv_obj_del(ext->slots[i]);
+    }
+
+    ext->visible_cnt = row_cnt;
+    slot_cnt = ext->visible_cnt + 2 * STATION_LIST_MARGIN;
+    ext->slots = lv_mem_realloc(ext->slots, slot_cnt * sizeof(lv_obj_t *));
+    LV_ASSERT_MEM(ext->slots);
+    if(ext->slots == NULL) return;
+
+    for(i = 0; i < slot_cnt; i++) {
+        lv_obj_t * label = lv_label_create(list, NULL);
+        lv_label_set_long_mode(label, LV_LABEL_LONG_CROP);
+        lv_label_set_text_static(label, "");
+        ext->slots[i] = label;
+    }
+
+    refr_layout(list);
+    refr_rows(list);
+}
+
+/**
+ * Select a row. The list wraps around like an infinite roller.
+ * @param list pointer to a station list object
+ * @param sel index of the row to select
+ * @param anim LV_ANIM_ON: slide when moving by one row
+ */
+void station_list_set_selected(lv_obj_t * list, uint16_t sel, lv_anim_enable_t anim)
+{
+    LV_ASSERT_OBJ(list, LV_OBJX_NAME);
+
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->row_cnt == 0) return;
+    if(sel >= ext->row_cnt) sel = ext->row_cnt - 1;
+
+    /*Take the shorter way around*/
+    int32_t delta = (int32_t)sel - ext->sel;
+    if(delta > ext->row_cnt / 2) delta -= ext->row_cnt;
+    else if(delta < -(ext->row_cnt / 2)) delta += ext->row_cnt;
+
+    select_row(list, sel, delta, anim);
+}
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the index of the selected row
+ * @param list pointer to a station list object
+ * @return index of the selected row
+ */
+uint16_t station_list_get_selected(const lv_obj_t * list)
+{
+    LV_ASSERT_OBJ(list, LV_OBJX_NAME);
+
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    return ext->sel;
+}
+
+/**
+ * Get the number of rows
+ * @param list pointer to a station list object
+ * @return number of rows
+ */
+uint16_t station_list_get_row_count(const lv_obj_t * list)
+{
+    LV_ASSERT_OBJ(list, LV_OBJX_NAME);
+
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    return ext->row_cnt;
+}
+
+/**
+ * Get the text of the selected row
+ * @param list pointer to a station list object
+ * @return the string from the data-source callback, or "" if there are no rows
+ */
+const char * station_list_get_selected_str(lv_obj_t * list)
+{
+    LV_ASSERT_OBJ(list, LV_OBJX_NAME);
+
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->row_cnt == 0 || ext->row_cb == NULL) return "";
+
+    const char * txt = ext->row_cb(list, ext->sel, ext->user_data);
+    return txt ? txt : "";
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Handle the drawing related tasks of the station list
+ * @param list pointer to an object
+ * @param clip_area the object will be drawn only in this area
+ * @param mode LV_DESIGN_COVER_CHK: only check if the object fully covers the 'mask_p' area
+ *                                  (return 'true' if yes)
+ *             LV_DESIGN_DRAW: draw the object (always return 'true')
+ *             LV_DESIGN_DRAW_POST: drawing after every children are drawn
+ * @param return an element of `lv_design_res_t`
+ */
+static lv_design_res_t station_list_design(lv_obj_t * list, const lv_area_t * clip_area, lv_design_mode_t mode)
+{
+    if(mode != LV_DESIGN_DRAW_MAIN) return ancestor_design(list, clip_area, mode);
+
+    ancestor_design(list, clip_area, mode);
+
+    /*The selection bar stays in the middle, the slot labels slide under it*/
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    lv_area_t sel_area;
+    lv_obj_get_coords(list, &sel_area);
+    lv_obj_get_inner_coords(list, &sel_area);
+    sel_area.y1 = list->coords.y1 + lv_obj_get_style_pad_top(list, STATION_LIST_PART_BG) +
+                  (ext->visible_cnt / 2) * ext->row_h;
+    sel_area.y2 = sel_area.y1 + ext->row_h - 1;
+
+    lv_draw_rect_dsc_t sel_dsc;
+    lv_draw_rect_dsc_init(&sel_dsc);
+    lv_obj_init_draw_rect_dsc(list, STATION_LIST_PART_SELECTED, &sel_dsc);
+    lv_draw_rect(&sel_area, clip_area, &sel_dsc);
+
+    return LV_DESIGN_RES_OK;
+}
+
+/**
+ * Signal function of the station list
+ * @param list pointer to a station list object
+ * @param sign a signal type from lv_signal_t enum
+ * @param param pointer to a signal specific variable
+ * @return LV_RES_OK: the object is not deleted in the function; LV_RES_INV: the object is deleted
+ */
+static lv_res_t station_list_signal(lv_obj_t * list, lv_signal_t sign, void * param)
+{
+    lv_res_t res;
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+
+    if(sign == LV_SIGNAL_GET_STYLE) {
+        lv_get_style_info_t * info = param;
+        if(info->part == STATION_LIST_PART_SELECTED) {
+            info->result = &ext->style_sel;
+            return LV_RES_OK;
+        }
+        return ancestor_signal(list, sign, param);
+    }
+
+    /* Include the ancient signal function */
+    res = ancestor_signal(list, sign, param);
+    if(res != LV_RES_OK) return res;
+    if(sign == LV_SIGNAL_GET_TYPE) return lv_obj_handle_get_type_signal(param, LV_OBJX_NAME);
+
+    if(sign == LV_SIGNAL_STYLE_CHG) {
+        refr_layout(list);
+    }
+    else if(sign == LV_SIGNAL_COORD_CHG) {
+        if(lv_obj_get_width(list) != lv_area_get_width(param)) refr_layout(list);
+    }
+    else if(sign == LV_SIGNAL_CONTROL) {
+#if LV_USE_GROUP
+        char c = *((char *)param);
+        int32_t delta = 0;
+        if(c == LV_KEY_RIGHT || c == LV_KEY_DOWN) delta = 1;
+        else if(c == LV_KEY_LEFT || c == LV_KEY_UP) delta = -1;
+
+        if(delta && ext->row_cnt) {
+            select_row(list, wrap_row(ext, ext->sel + delta), delta, LV_ANIM_ON);
+        }
+#endif
+    }
+    else if(sign == LV_SIGNAL_RELEASED) {
+        uint32_t id = ext->sel; /*Just to use uint32_t in event data*/
+        res = lv_event_send(list, LV_EVENT_VALUE_CHANGED, &id);
+        if(res != LV_RES_OK) return res;
+    }
+    else if(sign == LV_SIGNAL_GET_EDITABLE) {
+        bool * editable = (bool *)param;
+        *editable       = true;
+    }
+    else if(sign == LV_SIGNAL_CLEANUP) {
+        lv_obj_clean_style_list(list, STATION_LIST_PART_SELECTED);
+        lv_mem_free(ext->slots);
+        ext->slots = NULL;
+    }
+
+    return res;
+}
+
+/**
+ * Change the selected row and rebind the slot labels around it.
+ * @param list pointer to a station list object
+ * @param sel the new selected row
+ * @param delta signed distance moved, used for the direction of the slide
+ * @param anim LV_ANIM_ON: slide if `delta` fits into the margin
+ */
+static void select_row(lv_obj_t * list, uint16_t sel, int32_t delta, lv_anim_enable_t anim)
+{
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+
+    ext->sel = sel;
+    refr_rows(list);
+
+#if LV_USE_ANIMATION
+    lv_anim_del(list, (lv_anim_exec_xcb_t)scroll_anim_cb);
+
+    /*Start from where the rows appear now: shifted by `delta` rows plus what's left of a running slide*/
+    lv_coord_t start = ext->scroll_ofs + delta * ext->row_h;
+    lv_coord_t max   = STATION_LIST_MARGIN * ext->row_h;
+    if(anim == LV_ANIM_ON && delta != 0 && LV_MATH_ABS(delta) <= STATION_LIST_MARGIN) {
+        if(start > max) start = max;
+        if(start < -max) start = -max;
+
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, list);
+        lv_anim_set_exec_cb(&a, scroll_anim_cb);
+        lv_anim_set_values(&a, start, 0);
+        lv_anim_set_time(&a, STATION_LIST_ANIM_TIME);
+        lv_anim_set_path(&a, &lv_anim_path_def);
+        scroll_anim_cb(list, start);
+        lv_anim_start(&a);
+        return;
+    }
+#else
+    LV_UNUSED(delta);
+    LV_UNUSED(anim);
+#endif
+
+    ext->scroll_ofs = 0;
+    refr_pos(list);
+}
+
+/**
+ * Ask the data source for the text of every slot. Only the slots are
+ * touched, so the cost is independent of the row count.
+ * @param list pointer to a station list object
+ */
+static void refr_rows(lv_obj_t * list)
+{
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->slots == NULL) return;
+
+    int32_t first = (int32_t)ext->sel - ext->visible_cnt / 2 - STATION_LIST_MARGIN;
+    uint32_t slot_cnt = ext->visible_cnt + 2 * STATION_LIST_MARGIN;
+    uint32_t i;
+    for(i = 0; i < slot_cnt; i++) {
+        const char * txt = NULL;
+        if(ext->row_cnt && ext->row_cb) txt = ext->row_cb(list, wrap_row(ext, first + (int32_t)i), ext->user_data);
+        if(txt == NULL) txt = "";
+
+        /*Skip the relayout if the slot already shows this row*/
+        if(lv_label_get_text(ext->slots[i]) != txt) lv_label_set_text_static(ext->slots[i], txt);
+    }
+}
+
+/**
+ * Recalculate the row height, the list's height and the slots' size after a
+ * style or width change.
+ * @param list pointer to a station list object
+ */
+static void refr_layout(lv_obj_t * list)
+{
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->slots == NULL) return;
+
+    const lv_font_t * font = lv_obj_get_style_text_font(list, STATION_LIST_PART_BG);
+    lv_style_int_t line_space = lv_obj_get_style_text_line_space(list, STATION_LIST_PART_BG);
+    lv_style_int_t top = lv_obj_get_style_pad_top(list, STATION_LIST_PART_BG);
+    lv_style_int_t bottom = lv_obj_get_style_pad_bottom(list, STATION_LIST_PART_BG);
+    lv_style_int_t left = lv_obj_get_style_pad_left(list, STATION_LIST_PART_BG);
+    lv_style_int_t right = lv_obj_get_style_pad_right(list, STATION_LIST_PART_BG);
+
+    ext->row_h = lv_font_get_line_height(font) + line_space;
+    lv_obj_set_height(list, ext->visible_cnt * ext->row_h + top + bottom);
+
+    lv_coord_t w = lv_obj_get_width(list) - left - right;
+    uint32_t slot_cnt = ext->visible_cnt + 2 * STATION_LIST_MARGIN;
+    uint32_t i;
+    for(i = 0; i < slot_cnt; i++) {
+        lv_obj_set_size(ext->slots[i], w, ext->row_h);
+    }
+
+    /*The middle slot always holds the selected row*/
+    lv_obj_t * sel_label = ext->slots[STATION_LIST_MARGIN + ext->visible_cnt / 2];
+    lv_obj_set_style_local_text_color(sel_label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT,
+                                      lv_obj_get_style_text_color(list, STATION_LIST_PART_SELECTED));
+
+    refr_pos(list);
+}
+
+/**
+ * Position the slots according to the current scroll offset
+ * @param list pointer to a station list object
+ */
+static void refr_pos(lv_obj_t * list)
+{
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    if(ext->slots == NULL) return;
+
+    lv_style_int_t top = lv_obj_get_style_pad_top(list, STATION_LIST_PART_BG);
+    lv_style_int_t left = lv_obj_get_style_pad_left(list, STATION_LIST_PART_BG);
+    uint32_t slot_cnt = ext->visible_cnt + 2 * STATION_LIST_MARGIN;
+    uint32_t i;
+    for(i = 0; i < slot_cnt; i++) {
+        lv_coord_t y = top + ((int32_t)i - STATION_LIST_MARGIN) * ext->row_h + ext->scroll_ofs;
+        lv_obj_set_pos(ext->slots[i], left, y);
+    }
+}
+
+static uint16_t wrap_row(const station_list_ext_t * ext, int32_t row)
+{
+    if(ext->row_cnt == 0) return 0;
+    row %= ext->row_cnt;
+    if(row < 0) row += ext->row_cnt;
+    return (uint16_t)row;
+}
+
+#if LV_USE_ANIMATION
+static void scroll_anim_cb(void * list, lv_anim_value_t v)
+{
+    station_list_ext_t * ext = lv_obj_get_ext_attr(list);
+    ext->scroll_ofs = v;
+    refr_pos(list);
+}
+#endif
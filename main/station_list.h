@@ -0,0 +1,119 @@
+/**
+ * @file station_list.h
+ * Virtualized, roller-like list. Only the visible rows (plus a small
+ * margin used while scrolling) exist as labels; their text is pulled from
+ * a data-source callback, so the row count doesn't cost RAM or layout time.
+ */
+
+#ifndef STATION_LIST_H
+#define STATION_LIST_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Returns the text of row `row`. The string is shown with
+ * `lv_label_set_text_static`, so it must stay valid while the row is visible.
+ */
+typedef const char * (*station_list_row_cb_t)(lv_obj_t * list, uint16_t row, void * user_data);
+
+/*Data of station list*/
+typedef struct {
+    /*New data for this type */
+    station_list_row_cb_t row_cb;
+    void * user_data;
+    lv_obj_t ** slots;          /*Labels, `visible_cnt + 2 * STATION_LIST_MARGIN` of them*/
+    lv_style_list_t style_sel;  /*Style of the selected row*/
+    lv_coord_t row_h;
+    lv_coord_t scroll_ofs;      /*Offset of every slot while the scroll animation runs*/
+    uint16_t row_cnt;
+    uint16_t sel;
+    uint8_t visible_cnt;
+} station_list_ext_t;
+
+/* Parts are numbered like the roller's so the theme's roller styles apply */
+enum {
+    STATION_LIST_PART_BG = LV_ROLLER_PART_BG,
+    STATION_LIST_PART_SELECTED = LV_ROLLER_PART_SELECTED,
+};
+typedef uint8_t station_list_part_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a station list object
+ * @param par pointer to an object, it will be the parent of the new list
+ * @return pointer to the created list
+ */
+lv_obj_t * station_list_create(lv_obj_t * par);
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set where the rows come from. Selects the first row.
+ * @param list pointer to a station list object
+ * @param row_cnt number of rows
+ * @param row_cb called for every row that scrolls into view
+ * @param user_data passed to `row_cb`
+ */
+void station_list_set_source(lv_obj_t * list, uint16_t row_cnt, station_list_row_cb_t row_cb, void * user_data);
+
+/**
+ * Set the height to show the given number of rows
+ * @param list pointer to a station list object
+ * @param row_cnt number of visible rows, an odd number keeps the selection centered
+ */
+void station_list_set_visible_row_count(lv_obj_t * list, uint8_t row_cnt);
+
+/**
+ * Select a row. The list wraps around like an infinite roller.
+ * @param list pointer to a station list object
+ * @param sel index of the row to select
+ * @param anim LV_ANIM_ON: slide when moving by one row
+ */
+void station_list_set_selected(lv_obj_t * list, uint16_t sel, lv_anim_enable_t anim);
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the index of the selected row
+ * @param list pointer to a station list object
+ * @return index of the selected row
+ */
+uint16_t station_list_get_selected(const lv_obj_t * list);
+
+/**
+ * Get the number of rows
+ * @param list pointer to a station list object
+ * @return number of rows
+ */
+uint16_t station_list_get_row_count(const lv_obj_t * list);
+
+/**
+ * Get the text of the selected row
+ * @param list pointer to a station list object
+ * @return the string from the data-source callback, or "" if there are no rows
+ */
+const char * station_list_get_selected_str(lv_obj_t * list);
+
+#endif /*STATION_LIST_H*/